@@ -3,19 +3,27 @@
 xH_FILES  += adts.h
 xH_FILES  += adts_rbt.h
 xH_FILES  += adts_eyec.h
+xH_FILES  += adts_arena.h
 xH_FILES  += adts_bits.h
 xH_FILES  += adts_hash.h
 xH_FILES  += adts_heap.h
+xH_FILES  += adts_multiq.h
 xH_FILES  += adts_list.h
+xH_FILES  += adts_ulist.h
 xH_FILES  += adts_math.h
 xH_FILES  += adts_meas.h
+xH_FILES  += adts_pheap.h
+xH_FILES  += adts_pool.h
 xH_FILES  += adts_sort.h
 xH_FILES  += adts_time.h
 xH_FILES  += adts_tree.h
+xH_FILES  += adts_btree.h
 xH_FILES  += adts_trie.h
 xH_FILES  += adts_graph.h
 xH_FILES  += adts_stack.h
 xH_FILES  += adts_queue.h
+xH_FILES  += adts_ring.h
+xH_FILES  += adts_region.h
 xH_FILES  += adts_matrix.h
 xH_FILES  += adts_sanity.h
 xH_FILES  += adts_memory.h
@@ -28,19 +36,27 @@ xH_FILES  += adts_snapshot.h
 xC_FILES  += adts_rbt.c
 xC_FILES  += adts_test.c
 xC_FILES  += adts_eyec.c
+xC_FILES  += adts_arena.c
 xC_FILES  += adts_bits.c
 xC_FILES  += adts_hash.c
 xC_FILES  += adts_heap.c
+xC_FILES  += adts_multiq.c
 xC_FILES  += adts_list.c
+xC_FILES  += adts_ulist.c
 xC_FILES  += adts_math.c
 xC_FILES  += adts_meas.c
+xC_FILES  += adts_pheap.c
+xC_FILES  += adts_pool.c
 xC_FILES  += adts_sort.c
 xC_FILES  += adts_time.c
 xC_FILES  += adts_tree.c
+xC_FILES  += adts_btree.c
 xC_FILES  += adts_trie.c
 xC_FILES  += adts_graph.c
 xC_FILES  += adts_stack.c
 xC_FILES  += adts_queue.c
+xC_FILES  += adts_ring.c
+xC_FILES  += adts_region.c
 xC_FILES  += adts_matrix.c
 xC_FILES  += adts_memory.c
 xC_FILES  += adts_cycles.c
@@ -1,14 +1,23 @@
 #pragma once
 
+#include <adts_arena.h>
 #include <adts_bits.h>
 #include <adts_heap.h>
+#include <adts_multiq.h>
 #include <adts_list.h>
+#include <adts_ulist.h>
 #include <adts_sort.h>
 #include <adts_time.h>
 #include <adts_hash.h>
 #include <adts_math.h>
 #include <adts_meas.h>
+#include <adts_memory.h>
+#include <adts_pheap.h>
+#include <adts_pool.h>
 #include <adts_tree.h>
+#include <adts_btree.h>
+#include <adts_ring.h>
+#include <adts_region.h>
 #include <adts_trie.h>
 #include <adts_graph.h>
 #include <adts_queue.h>
@@ -0,0 +1,900 @@
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Toolbox */
+#include <adts_list.h>
+#include <adts_hash.h>
+#include <adts_time.h>
+#include <adts_arena.h>
+#include <adts_stack.h>
+#include <adts_queue.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - release blocks beyond a high watermark on reset
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Block header, resident at the base of every block.  The header is
+ *   padded such that the first allocation honors ADTS_ARENA_ALIGN.
+ *
+ ****************************************************************************
+ */
+typedef union arena_block_u {
+    struct {
+        union arena_block_u *p_next;
+        size_t               bytes;  /**< usable bytes following header */
+        size_t               used;
+    };
+    char pad[ 32 ];
+} arena_block_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    arena_block_t *p_block;
+    size_t         used;
+} arena_mark_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    arena_block_t *p_head;
+    arena_block_t *p_curr;      /**< block currently carved from */
+    size_t         block_bytes; /**< default block size */
+    size_t         blocks;
+    size_t         reserved;    /**< usable bytes across all blocks */
+    size_t            allocs;
+    adts_mem_stats_t  mem;
+    adts_sanity_t     sanity;
+} arena_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline char *
+arena_block_base( arena_block_t *p_block )
+{
+    return (char *) (p_block + 1);
+} /* arena_block_base() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Offset within the block satisfying the requested alignment, or SIZE_MAX
+ *   if the block cannot accommodate the request.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+arena_block_fit( arena_block_t *p_block,
+                 size_t         bytes,
+                 size_t         align )
+{
+    uintptr_t base   = (uintptr_t) arena_block_base(p_block);
+    uintptr_t addr   = (base + p_block->used + align - 1) & ~(align - 1);
+    size_t    offset = addr - base;
+
+    if ((offset > p_block->bytes) || (bytes > (p_block->bytes - offset))) {
+        offset = SIZE_MAX;
+    }
+
+    return offset;
+} /* arena_block_fit() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Allocate a new block, spliced in following the current block such that
+ *   retained blocks further down the chain remain reachable.
+ *
+ ****************************************************************************
+ */
+static arena_block_t *
+arena_block_grow( arena_t *p_arena,
+                  size_t   bytes )
+{
+    arena_block_t *p_block = NULL;
+
+    bytes   = MAX(bytes, p_arena->block_bytes);
+    p_block = adts_mem_zalloc_acct(&(p_arena->mem), sizeof(*p_block) + bytes,
+                                   ADTS_MEM_ALIGN_DEFAULT);
+    if (unlikely(NULL == p_block)) {
+        goto exception;
+    }
+
+    p_block->bytes = bytes;
+    if (p_arena->p_curr) {
+        p_block->p_next         = p_arena->p_curr->p_next;
+        p_arena->p_curr->p_next = p_block;
+    }else {
+        p_arena->p_head = p_block;
+    }
+
+    p_arena->blocks++;
+    p_arena->reserved += bytes;
+
+exception:
+    return p_block;
+} /* arena_block_grow() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Slow path: advance to the next retained block if it fits, otherwise
+ *   grow the chain.
+ *
+ ****************************************************************************
+ */
+static void *
+arena_alloc_slow( arena_t *p_arena,
+                  size_t   bytes,
+                  size_t   align )
+{
+    void          *p_mem   = NULL;
+    size_t         offset  = 0;
+    arena_block_t *p_block = p_arena->p_curr->p_next;
+
+    if (p_block) {
+        p_block->used = 0;
+        offset        = arena_block_fit(p_block, bytes, align);
+    }
+
+    if ((NULL == p_block) || (SIZE_MAX == offset)) {
+        p_block = arena_block_grow(p_arena, bytes + align);
+        if (unlikely(NULL == p_block)) {
+            goto exception;
+        }
+        offset = arena_block_fit(p_block, bytes, align);
+    }
+
+    p_arena->p_curr = p_block;
+    p_block->used   = offset + bytes;
+    p_mem           = arena_block_base(p_block) + offset;
+
+exception:
+    return p_mem;
+} /* arena_alloc_slow() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_arena_bytes_used( adts_arena_t *p_adts_arena )
+{
+    size_t         used    = 0;
+    arena_t       *p_arena = (arena_t *) p_adts_arena;
+    arena_block_t *p_block = p_arena->p_head;
+
+    /* blocks following the current block are retained but unused */
+    while (p_block) {
+        used += p_block->used;
+        if (p_block == p_arena->p_curr) {
+            break;
+        }
+        p_block = p_block->p_next;
+    }
+
+    return used;
+} /* adts_arena_bytes_used() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_arena_bytes_reserved( adts_arena_t *p_adts_arena )
+{
+    arena_t *p_arena = (arena_t *) p_adts_arena;
+
+    return p_arena->reserved;
+} /* adts_arena_bytes_reserved() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_display( adts_arena_t *p_adts_arena )
+{
+    arena_t *p_arena = (arena_t *) p_adts_arena;
+
+    printf("arena: %p  blocks: %zu  reserved: %zu  used: %zu  allocs: %zu \n",
+            p_arena,
+            p_arena->blocks,
+            p_arena->reserved,
+            adts_arena_bytes_used(p_adts_arena),
+            p_arena->allocs);
+
+    return;
+} /* adts_arena_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Blocks are charged as a whole, independent of how much has been
+ *   carved from them.
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_mem_stats( adts_arena_t     *p_adts_arena,
+                      adts_mem_stats_t *p_stats )
+{
+    arena_t *p_arena = (arena_t *) p_adts_arena;
+
+    *p_stats = p_arena->mem;
+
+    return;
+} /* adts_arena_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Alignment must be a power of 2.
+ *
+ ****************************************************************************
+ */
+void *
+adts_arena_alloc_aligned( adts_arena_t *p_adts_arena,
+                          size_t        bytes,
+                          size_t        align )
+{
+    void          *p_mem    = NULL;
+    size_t         offset   = 0;
+    arena_t       *p_arena  = (arena_t *) p_adts_arena;
+    arena_block_t *p_block  = p_arena->p_curr;
+    adts_sanity_t *p_sanity = &(p_arena->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely((0 == align) || (align & (align - 1)))) {
+        goto exception;
+    }
+
+    offset = arena_block_fit(p_block, bytes, align);
+    if (likely(SIZE_MAX != offset)) {
+        p_block->used = offset + bytes;
+        p_mem         = arena_block_base(p_block) + offset;
+    }else {
+        p_mem = arena_alloc_slow(p_arena, bytes, align);
+    }
+
+    if (likely(p_mem)) {
+        p_arena->allocs++;
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return p_mem;
+} /* adts_arena_alloc_aligned() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void *
+adts_arena_alloc( adts_arena_t *p_adts_arena,
+                  size_t        bytes )
+{
+    return adts_arena_alloc_aligned(p_adts_arena, bytes, ADTS_ARENA_ALIGN);
+} /* adts_arena_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Blocks are recycled across reset/rewind, thus memory is cleared on
+ *   every allocation.
+ *
+ ****************************************************************************
+ */
+void *
+adts_arena_zalloc( adts_arena_t *p_adts_arena,
+                   size_t        bytes )
+{
+    void *p_mem = adts_arena_alloc(p_adts_arena, bytes);
+
+    if (likely(p_mem)) {
+        memset(p_mem, 0, bytes);
+    }
+
+    return p_mem;
+} /* adts_arena_zalloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_mark( adts_arena_t      *p_adts_arena,
+                 adts_arena_mark_t *p_adts_mark )
+{
+    arena_t       *p_arena  = (arena_t *) p_adts_arena;
+    arena_mark_t  *p_mark   = (arena_mark_t *) p_adts_mark;
+    adts_sanity_t *p_sanity = &(p_arena->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_mark->p_block = p_arena->p_curr;
+    p_mark->used    = p_arena->p_curr->used;
+
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_arena_mark() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release every allocation performed since the mark was taken.  Any ADT
+ *   created from the released memory must no longer be referenced.
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_rewind( adts_arena_t            *p_adts_arena,
+                   const adts_arena_mark_t *p_adts_mark )
+{
+    arena_t            *p_arena  = (arena_t *) p_adts_arena;
+    const arena_mark_t *p_mark   = (const arena_mark_t *) p_adts_mark;
+    adts_sanity_t      *p_sanity = &(p_arena->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_arena->p_curr       = p_mark->p_block;
+    p_arena->p_curr->used = p_mark->used;
+
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_arena_rewind() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release every allocation in a single operation, blocks are retained.
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_reset( adts_arena_t *p_adts_arena )
+{
+    arena_t       *p_arena  = (arena_t *) p_adts_arena;
+    adts_sanity_t *p_sanity = &(p_arena->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_arena->p_curr       = p_arena->p_head;
+    p_arena->p_curr->used = 0;
+
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_arena_reset() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_arena_destroy( adts_arena_t *p_adts_arena )
+{
+    arena_t          *p_arena  = (arena_t *) p_adts_arena;
+    arena_block_t    *p_block  = NULL;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_arena->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_block = p_arena->p_head;
+    while (p_block) {
+        arena_block_t *p_next = p_block->p_next;
+
+        adts_mem_free_acct(&(p_arena->mem), p_block,
+                           sizeof(*p_block) + p_block->bytes,
+                           ADTS_MEM_ALIGN_DEFAULT);
+        p_block = p_next;
+    }
+
+    /* the record is released along with the handle */
+    mem = p_arena->mem;
+    adts_mem_free_acct(&(mem), p_arena, sizeof(adts_arena_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_arena_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   block_bytes of 0 selects ADTS_ARENA_BLOCK_BYTES.  The first block is
+ *   reserved at create time.
+ *
+ ****************************************************************************
+ */
+adts_arena_t *
+adts_arena_create( size_t block_bytes )
+{
+    int32_t           rc           = 0;
+    arena_t          *p_arena      = NULL;
+    adts_arena_t     *p_adts_arena = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_ARENA);
+
+    p_adts_arena = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_arena),
+                                        ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_arena) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_arena              = (arena_t *) p_adts_arena;
+    p_arena->mem         = mem;
+    p_arena->block_bytes = block_bytes ? block_bytes : ADTS_ARENA_BLOCK_BYTES;
+
+    p_arena->p_curr = arena_block_grow(p_arena, p_arena->block_bytes);
+    if (NULL == p_arena->p_curr) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+exception:
+    if (rc) {
+        if (p_adts_arena) {
+            mem = p_arena->mem;
+            adts_mem_free_acct(&(mem), p_adts_arena, sizeof(*p_adts_arena),
+                               ADTS_MEM_ALIGN_DEFAULT);
+            p_adts_arena = NULL;
+        }
+    }
+
+    return p_adts_arena;
+} /* adts_arena_create() */
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+#define UTEST_ARENA_ELEMS      (1024)
+#define UTEST_ARENA_ITERS       (256)
+#define UTEST_ARENA_HASH_ELEMS (2039)
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_arena_bytes( void )
+{
+    CDISPLAY("[%u]", sizeof(arena_t));
+    CDISPLAY("[%u]", sizeof(adts_arena_t));
+
+    _Static_assert(sizeof(arena_t) <= sizeof(adts_arena_t),
+        "Mismatch structs detected");
+    _Static_assert(sizeof(arena_mark_t) <= sizeof(adts_arena_mark_t),
+        "Mismatch structs detected");
+    _Static_assert(0 == (sizeof(arena_block_t) % ADTS_ARENA_ALIGN),
+        "Misaligned block header");
+
+    return;
+} /* utest_arena_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static hash_idx_t
+utest_arena_hash( struct hash_s *p_hash,
+                  const void    *p_key )
+{
+    adts_hash_t *p_adts_hash = (adts_hash_t *) p_hash;
+
+    return (uintptr_t) p_key % p_adts_hash->pub.elems_limit;
+} /* utest_arena_hash() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Request scoped workload: build a temporary hash, stack and queue then
+ *   tear everything down.  When an arena is provided the teardown is a
+ *   single reset.
+ *
+ ****************************************************************************
+ */
+static void
+utest_arena_workload( adts_arena_t     *p_arena,
+                      adts_hash_node_t *p_nodes )
+{
+    int32_t             rc      = 0;
+    adts_hash_t        *p_hash  = NULL;
+    adts_stack_t       *p_stack = NULL;
+    adts_queue_t       *p_queue = NULL;
+    adts_hash_create_t  op      = {0};
+
+    /* fixed table, isolate allocation cost from resize cost */
+    op.p_func                    = utest_arena_hash;
+    op.options                   = ADTS_HASH_OPTS_DISABLE_RESIZE;
+    op.opts.disable_resize.elems = UTEST_ARENA_HASH_ELEMS;
+    if (p_arena) {
+        p_hash  = adts_hash_create_arena(&op, p_arena);
+        p_stack = adts_stack_create_arena(p_arena);
+        p_queue = adts_queue_create_arena(p_arena);
+    }else {
+        p_hash  = adts_hash_create(&op);
+        p_stack = adts_stack_create();
+        p_queue = adts_queue_create();
+    }
+    assert(p_hash && p_stack && p_queue);
+
+    for (uintptr_t idx = 0; idx < UTEST_ARENA_ELEMS; idx++) {
+        adts_hash_node_public_t input = {0};
+
+        input.p_key  = (void *) idx;
+        input.p_data = (void *) idx;
+        rc = adts_hash_insert(p_hash, &(p_nodes[idx]), &(input));
+        assert(0 == rc);
+
+        rc = adts_stack_push(p_stack, (void *) idx, 0);
+        assert(0 == rc);
+
+        rc = adts_queue_enqueue(p_queue, (void *) idx, 0);
+        assert(0 == rc);
+    }
+    assert(UTEST_ARENA_ELEMS == adts_hash_entries(p_hash));
+    assert(UTEST_ARENA_ELEMS == adts_stack_entries(p_stack));
+    assert(UTEST_ARENA_ELEMS == adts_queue_entries(p_queue));
+
+    if (p_arena) {
+        adts_hash_destroy(p_hash);
+        adts_stack_destroy(p_stack);
+        adts_queue_destroy(p_queue);
+        adts_arena_reset(p_arena);
+    }else {
+        /* element by element teardown */
+        for (uintptr_t idx = 0; idx < UTEST_ARENA_ELEMS; idx++) {
+            (void) adts_hash_remove(p_hash, (void *) idx);
+            (void) adts_stack_pop(p_stack);
+            (void) adts_queue_dequeue(p_queue);
+        }
+        adts_hash_destroy(p_hash);
+        adts_stack_destroy(p_stack);
+        adts_queue_destroy(p_queue);
+    }
+
+    return;
+} /* utest_arena_workload() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+utest_arena_benchmark( void )
+{
+    adts_hash_node_t *p_nodes = NULL;
+
+    p_nodes = calloc(UTEST_ARENA_ELEMS, sizeof(*p_nodes));
+    assert(p_nodes);
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: request scoped hash/stack/queue, %u elems",
+                UTEST_ARENA_ELEMS);
+
+        uint64_t      start   = 0;
+        uint64_t      stop    = 0;
+        adts_arena_t *p_arena = NULL;
+
+        start = adts_tstamp();
+        for (int32_t iter = 0; iter < UTEST_ARENA_ITERS; iter++) {
+            memset(p_nodes, 0, UTEST_ARENA_ELEMS * sizeof(*p_nodes));
+            utest_arena_workload(NULL, p_nodes);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("heap:  per request: %llu ns",
+                (stop - start) / UTEST_ARENA_ITERS);
+
+        p_arena = adts_arena_create(0);
+        assert(p_arena);
+
+        start = adts_tstamp();
+        for (int32_t iter = 0; iter < UTEST_ARENA_ITERS; iter++) {
+            memset(p_nodes, 0, UTEST_ARENA_ELEMS * sizeof(*p_nodes));
+            utest_arena_workload(p_arena, p_nodes);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("arena: per request: %llu ns",
+                (stop - start) / UTEST_ARENA_ITERS);
+
+        adts_arena_display(p_arena);
+        adts_arena_destroy(p_arena);
+    }
+
+    free(p_nodes);
+
+    return;
+} /* utest_arena_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_arena_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: alloc alignment");
+
+        char         *p_mem   = NULL;
+        adts_arena_t *p_arena = NULL;
+
+        p_arena = adts_arena_create(4096);
+        assert(p_arena);
+
+        p_mem = adts_arena_alloc(p_arena, 1);
+        assert(0 == ((uintptr_t) p_mem % ADTS_ARENA_ALIGN));
+        p_mem = adts_arena_alloc(p_arena, 3);
+        assert(0 == ((uintptr_t) p_mem % ADTS_ARENA_ALIGN));
+        p_mem = adts_arena_alloc_aligned(p_arena, 8, 256);
+        assert(0 == ((uintptr_t) p_mem % 256));
+        p_mem = adts_arena_alloc_aligned(p_arena, 8, 3);
+        assert(NULL == p_mem);
+
+        adts_arena_destroy(p_arena);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: block chaining, oversized, reset");
+
+        char         *p_mem   = NULL;
+        char         *p_first = NULL;
+        size_t        blocks  = 0;
+        adts_arena_t *p_arena = NULL;
+        arena_t      *p_priv  = NULL;
+
+        p_arena = adts_arena_create(4096);
+        assert(p_arena);
+        p_priv = (arena_t *) p_arena;
+
+        p_first = adts_arena_alloc(p_arena, 64);
+        for (int32_t idx = 0; idx < 256; idx++) {
+            p_mem = adts_arena_alloc(p_arena, 64);
+            assert(p_mem);
+            memset(p_mem, idx, 64);
+        }
+        assert(1 < p_priv->blocks);
+
+        /* oversized request satisfied by a dedicated block */
+        p_mem = adts_arena_zalloc(p_arena, 3 * 4096);
+        assert(p_mem);
+        assert(0 == p_mem[(3 * 4096) - 1]);
+
+        blocks = p_priv->blocks;
+        adts_arena_display(p_arena);
+
+        /* blocks are retained and reused across a reset */
+        adts_arena_reset(p_arena);
+        assert(0 == adts_arena_bytes_used(p_arena));
+        assert(p_first == adts_arena_alloc(p_arena, 64));
+        for (int32_t idx = 0; idx < 256; idx++) {
+            assert(adts_arena_alloc(p_arena, 64));
+        }
+        assert(adts_arena_zalloc(p_arena, 3 * 4096));
+        assert(blocks == p_priv->blocks);
+
+        adts_arena_destroy(p_arena);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: mark -> rewind");
+
+        void              *p_a     = NULL;
+        void              *p_b     = NULL;
+        size_t             used    = 0;
+        adts_arena_t      *p_arena = NULL;
+        adts_arena_mark_t  mark    = {0};
+
+        p_arena = adts_arena_create(1024);
+        assert(p_arena);
+
+        p_a  = adts_arena_alloc(p_arena, 100);
+        used = adts_arena_bytes_used(p_arena);
+        adts_arena_mark(p_arena, &mark);
+
+        p_b = adts_arena_alloc(p_arena, 100);
+        for (int32_t idx = 0; idx < 64; idx++) {
+            assert(adts_arena_alloc(p_arena, 100));
+        }
+
+        adts_arena_rewind(p_arena, &mark);
+        assert(used == adts_arena_bytes_used(p_arena));
+        assert(p_b == adts_arena_alloc(p_arena, 100));
+        assert(p_a != p_b);
+
+        adts_arena_destroy(p_arena);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: arena backed ADTs");
+
+        adts_arena_t       *p_arena = NULL;
+        adts_list_t        *p_list  = NULL;
+        adts_hash_t        *p_hash  = NULL;
+        adts_stack_t       *p_stack = NULL;
+        adts_queue_t       *p_queue = NULL;
+        adts_hash_create_t  op      = {0};
+        adts_list_node_t    node[ 4 ];
+        adts_hash_node_t    hnode[ 64 ];
+
+        p_arena = adts_arena_create(0);
+        assert(p_arena);
+
+        p_stack = adts_stack_create_arena(p_arena);
+        p_queue = adts_queue_create_arena(p_arena);
+        p_list  = adts_list_create_arena(p_arena);
+        assert(p_stack && p_queue && p_list);
+
+        /* force hash resize */
+        op.p_func = utest_arena_hash;
+        p_hash    = adts_hash_create_arena(&op, p_arena);
+        assert(p_hash);
+        memset(hnode, 0, sizeof(hnode));
+        for (uintptr_t idx = 0; idx < 64; idx++) {
+            adts_hash_node_public_t input = {0};
+
+            input.p_key = (void *) idx;
+            assert(0 == adts_hash_insert(p_hash, &(hnode[idx]), &(input)));
+        }
+        assert(0 < p_hash->pub.resize.grow);
+        for (uintptr_t idx = 0; idx < 64; idx++) {
+            assert(adts_hash_find(p_hash, (void *) idx));
+        }
+        adts_hash_destroy(p_hash);
+
+        /* force stack resize, queue slab growth */
+        for (uintptr_t idx = 1; idx <= 512; idx++) {
+            assert(0 == adts_stack_push(p_stack, (void *) idx, 0));
+            assert(0 == adts_queue_enqueue(p_queue, (void *) idx, 0));
+        }
+        for (uintptr_t idx = 512; idx >= 1; idx--) {
+            assert(idx == (uintptr_t) adts_stack_pop(p_stack));
+        }
+        for (uintptr_t idx = 1; idx <= 512; idx++) {
+            assert(idx == (uintptr_t) adts_queue_dequeue(p_queue));
+        }
+
+        memset(node, 0, sizeof(node));
+        for (int32_t idx = 0; idx < 4; idx++) {
+            assert(0 == adts_list_append(p_list, &(node[idx])));
+        }
+        assert(4 == adts_list_entries(p_list));
+
+        adts_list_destroy(p_list);
+        adts_queue_destroy(p_queue);
+        adts_stack_destroy(p_stack);
+        adts_arena_destroy(p_arena);
+    }
+
+    utest_arena_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_arena( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_arena() */
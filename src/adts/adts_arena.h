@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_ARENA_BYTES      (256)
+#define ADTS_ARENA_MARK_BYTES (16)
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_ARENA_BYTES ];
+} adts_arena_t;
+
+typedef struct {
+    const char reserved[ ADTS_ARENA_MARK_BYTES ];
+} adts_arena_mark_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Default block size, requests larger than a block are satisfied by a
+ *   dedicated oversized block.
+ *
+ **************************************************************************
+ */
+#define ADTS_ARENA_BLOCK_BYTES (64 * 1024)
+#define ADTS_ARENA_ALIGN       (16)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Region (bump) allocator for request scoped ADTs.
+ *
+ *   - Memory is carved from a chain of blocks and is never individually
+ *     freed.  The entire arena is released in a single call via
+ *     adts_arena_reset() or adts_arena_rewind().  Blocks are retained
+ *     across a reset such that steady state use performs no allocation.
+ *   - ADTs created via their *_create_arena() variant source all memory
+ *     from the arena.  The corresponding *_destroy() is O(1) regardless of
+ *     the number of elements, memory is reclaimed on reset.
+ *   - The ADT consumer is responsible for serialization.
+ *
+ **************************************************************************
+ */
+size_t
+adts_arena_bytes_used( adts_arena_t *p_adts_arena );
+
+size_t
+adts_arena_bytes_reserved( adts_arena_t *p_adts_arena );
+
+void
+adts_arena_display( adts_arena_t *p_adts_arena );
+
+void
+adts_arena_mem_stats( adts_arena_t     *p_adts_arena,
+                      adts_mem_stats_t *p_stats );
+
+void *
+adts_arena_alloc_aligned( adts_arena_t *p_adts_arena,
+                          size_t        bytes,
+                          size_t        align );
+void *
+adts_arena_alloc( adts_arena_t *p_adts_arena,
+                  size_t        bytes );
+void *
+adts_arena_zalloc( adts_arena_t *p_adts_arena,
+                   size_t        bytes );
+void
+adts_arena_mark( adts_arena_t      *p_adts_arena,
+                 adts_arena_mark_t *p_mark );
+void
+adts_arena_rewind( adts_arena_t            *p_adts_arena,
+                   const adts_arena_mark_t *p_mark );
+void
+adts_arena_reset( adts_arena_t *p_adts_arena );
+
+void
+adts_arena_destroy( adts_arena_t *p_adts_arena );
+
+adts_arena_t *
+adts_arena_create( size_t block_bytes );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_arena( void );
+
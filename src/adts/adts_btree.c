@@ -0,0 +1,1894 @@
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Toolbox */
+#include <adts_rbt.h>
+#include <adts_tree.h>
+#include <adts_time.h>
+#include <adts_btree.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Node, a 16B header followed by keys_max keys then keys_max + 1 slots.
+ *   Slots are p_data within a leaf and children within an internal node.
+ *   Child idx holds keys in [key[idx - 1], key[idx]).
+ *
+ ****************************************************************************
+ */
+typedef struct btree_node_s {
+    uint32_t              count;  /**< keys held */
+    uint32_t              level;  /**< 0 is a leaf */
+    struct btree_node_s  *p_next; /**< leaf chain, ascending */
+    int64_t               key[];
+} btree_node_t;
+
+#define BTREE_NODE_HDR_BYTES  (sizeof(btree_node_t))
+#define BTREE_KEYS( _bytes )  (((_bytes) - BTREE_NODE_HDR_BYTES - 8) / 16)
+#define BTREE_KEYS_MAX        BTREE_KEYS(ADTS_BTREE_NODE_BYTES_MAX)
+
+/*
+ * The minimum fanout is 8 at 256B nodes, thus 32 levels exceeds any tree
+ * addressable in memory.
+ */
+#define BTREE_HEIGHT_MAX      (32)
+#define BTREE_CACHELINE_BYTES (64)
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    size_t            elems;
+    size_t            nodes;
+    size_t            height;     /**< levels, 0 when empty */
+    size_t            node_bytes;
+    size_t            keys_max;
+    size_t            keys_min;   /**< occupancy floor, root excluded */
+    btree_node_t     *p_root;
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;
+} btree_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    btree_t      *p_tree;
+    btree_node_t *p_leaf;  /**< NULL once exhausted */
+    size_t        idx;
+} btree_iter_t;
+
+typedef struct {
+    btree_node_t *p_node;
+    size_t        idx;     /**< child descended */
+} btree_path_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void **
+btree_slot( const btree_t *p_tree,
+            btree_node_t  *p_node )
+{
+    return (void **) &(p_node->key[p_tree->keys_max]);
+} /* btree_slot() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline btree_node_t *
+btree_child( const btree_t *p_tree,
+             btree_node_t  *p_node,
+             size_t         idx )
+{
+    return (btree_node_t *) btree_slot(p_tree, p_node)[idx];
+} /* btree_child() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Branchless lower bound, the first idx where a_key[idx] >= key.  The
+ *   halving compiles to a conditional move, such that the search cost is
+ *   independent of the key distribution.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+btree_search_ge( const int64_t *a_key,
+                 size_t         count,
+                 int64_t        key )
+{
+    const int64_t *p_base = a_key;
+    size_t         half   = 0;
+
+    if (unlikely(0 == count)) {
+        return 0;
+    }
+
+    while (count > 1) {
+        half    = count / 2;
+        p_base  = (p_base[half] < key) ? (p_base + half) : p_base;
+        count  -= half;
+    }
+
+    return (p_base - a_key) + (*p_base < key);
+} /* btree_search_ge() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Branchless upper bound, the first idx where a_key[idx] > key, which
+ *   is the child holding key.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+btree_search_gt( const int64_t *a_key,
+                 size_t         count,
+                 int64_t        key )
+{
+    const int64_t *p_base = a_key;
+    size_t         half   = 0;
+
+    if (unlikely(0 == count)) {
+        return 0;
+    }
+
+    while (count > 1) {
+        half    = count / 2;
+        p_base  = (p_base[half] <= key) ? (p_base + half) : p_base;
+        count  -= half;
+    }
+
+    return (p_base - a_key) + (*p_base <= key);
+} /* btree_search_gt() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static btree_node_t *
+btree_node_alloc( btree_t  *p_tree,
+                  uint32_t  level )
+{
+    btree_node_t *p_node = NULL;
+
+    p_node = adts_mem_zalloc_acct(&(p_tree->mem), p_tree->node_bytes,
+                                  ADTS_MEM_ALIGN_CACHELINE);
+    if (p_node) {
+        p_node->level = level;
+        p_tree->nodes++;
+    }
+
+    return p_node;
+} /* btree_node_alloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+btree_node_free( btree_t      *p_tree,
+                 btree_node_t *p_node )
+{
+    p_tree->nodes--;
+    adts_mem_free_acct(&(p_tree->mem), p_node, p_tree->node_bytes,
+                       ADTS_MEM_ALIGN_CACHELINE);
+
+    return;
+} /* btree_node_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Free a chain of nodes linked through p_next.
+ *
+ ****************************************************************************
+ */
+static void
+btree_chain_free( btree_t      *p_tree,
+                  btree_node_t *p_node )
+{
+    btree_node_t *p_next = NULL;
+
+    for (; p_node; p_node = p_next) {
+        p_next = p_node->p_next;
+        btree_node_free(p_tree, p_node);
+    }
+
+    return;
+} /* btree_chain_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Leaves through the chain, then the internal levels depth first.
+ *
+ ****************************************************************************
+ */
+static void
+btree_free_all( btree_t *p_tree )
+{
+    size_t        depth  = 0;
+    btree_node_t *p_root = p_tree->p_root;
+    btree_node_t *p_node = p_root;
+    btree_path_t  a_path[ BTREE_HEIGHT_MAX ];
+
+    if (NULL == p_root) {
+        goto exception;
+    }
+
+    while (p_node->level) {
+        p_node = btree_child(p_tree, p_node, 0);
+    }
+    if (p_node == p_root) {
+        /* single leaf */
+        btree_chain_free(p_tree, p_node);
+        goto exception;
+    }
+    btree_chain_free(p_tree, p_node);
+
+    a_path[depth].p_node = p_root;
+    a_path[depth].idx    = 0;
+    depth++;
+    while (depth) {
+        btree_path_t *p_top = &(a_path[depth - 1]);
+
+        if ((p_top->p_node->level > 1) &&
+            (p_top->idx <= p_top->p_node->count)) {
+            a_path[depth].p_node = btree_child(p_tree, p_top->p_node,
+                                               p_top->idx);
+            a_path[depth].idx    = 0;
+            p_top->idx++;
+            depth++;
+        } else {
+            /* children released */
+            btree_node_free(p_tree, p_top->p_node);
+            depth--;
+        }
+    }
+
+exception:
+    p_tree->p_root = NULL;
+    p_tree->height = 0;
+    p_tree->elems  = 0;
+    return;
+} /* btree_free_all() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+btree_leaf_insert_at( btree_t      *p_tree,
+                      btree_node_t *p_leaf,
+                      size_t        pos,
+                      int64_t       key,
+                      void         *p_data )
+{
+    void   **a_slot = btree_slot(p_tree, p_leaf);
+    size_t   move   = p_leaf->count - pos;
+
+    memmove(&(p_leaf->key[pos + 1]), &(p_leaf->key[pos]),
+            move * sizeof(p_leaf->key[0]));
+    memmove(&(a_slot[pos + 1]), &(a_slot[pos]), move * sizeof(a_slot[0]));
+    p_leaf->key[pos] = key;
+    a_slot[pos]      = p_data;
+    p_leaf->count++;
+
+    return;
+} /* btree_leaf_insert_at() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Key at pos with the child to its right at pos + 1.
+ *
+ ****************************************************************************
+ */
+static void
+btree_internal_insert_at( btree_t      *p_tree,
+                          btree_node_t *p_node,
+                          size_t        pos,
+                          int64_t       key,
+                          btree_node_t *p_child )
+{
+    void   **a_slot = btree_slot(p_tree, p_node);
+    size_t   move   = p_node->count - pos;
+
+    memmove(&(p_node->key[pos + 1]), &(p_node->key[pos]),
+            move * sizeof(p_node->key[0]));
+    memmove(&(a_slot[pos + 2]), &(a_slot[pos + 1]), move * sizeof(a_slot[0]));
+    p_node->key[pos]  = key;
+    a_slot[pos + 1]   = p_child;
+    p_node->count++;
+
+    return;
+} /* btree_internal_insert_at() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Remove key[pos] and, within an internal node, the child to its right.
+ *
+ ****************************************************************************
+ */
+static void
+btree_erase_at( btree_t      *p_tree,
+                btree_node_t *p_node,
+                size_t        pos )
+{
+    void   **a_slot = btree_slot(p_tree, p_node);
+    size_t   slot   = (p_node->level) ? (pos + 1) : pos;
+    size_t   move   = p_node->count - pos - 1;
+
+    memmove(&(p_node->key[pos]), &(p_node->key[pos + 1]),
+            move * sizeof(p_node->key[0]));
+    memmove(&(a_slot[slot]), &(a_slot[slot + 1]), move * sizeof(a_slot[0]));
+    p_node->count--;
+
+    return;
+} /* btree_erase_at() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Split a full leaf while inserting at pos, both halves retain at least
+ *   keys_max / 2 keys.  Returns the separator, the new right leaf's first
+ *   key.
+ *
+ ****************************************************************************
+ */
+static int64_t
+btree_leaf_split( btree_t      *p_tree,
+                  btree_node_t *p_leaf,
+                  btree_node_t *p_right,
+                  size_t        pos,
+                  int64_t       key,
+                  void         *p_data )
+{
+    const size_t   limit   = p_tree->keys_max;
+    const size_t   mid     = (limit + 1) / 2;
+    const size_t   from    = (pos < mid) ? (mid - 1) : mid;
+    void         **a_left  = btree_slot(p_tree, p_leaf);
+    void         **a_right = btree_slot(p_tree, p_right);
+
+    memcpy(&(p_right->key[0]), &(p_leaf->key[from]),
+           (limit - from) * sizeof(p_leaf->key[0]));
+    memcpy(&(a_right[0]), &(a_left[from]), (limit - from) * sizeof(a_left[0]));
+    p_right->count = limit - from;
+    p_leaf->count  = from;
+
+    if (pos < mid) {
+        btree_leaf_insert_at(p_tree, p_leaf, pos, key, p_data);
+    } else {
+        btree_leaf_insert_at(p_tree, p_right, pos - mid, key, p_data);
+    }
+
+    p_right->p_next = p_leaf->p_next;
+    p_leaf->p_next  = p_right;
+
+    return p_right->key[0];
+} /* btree_leaf_split() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Split a full internal node while inserting key and p_child at pos.
+ *   The middle key is promoted and returned.
+ *
+ ****************************************************************************
+ */
+static int64_t
+btree_internal_split( btree_t      *p_tree,
+                      btree_node_t *p_node,
+                      btree_node_t *p_right,
+                      size_t        pos,
+                      int64_t       key,
+                      btree_node_t *p_child )
+{
+    const size_t   limit   = p_tree->keys_max;
+    const size_t   mid     = (limit + 1) / 2;
+    void         **a_left  = btree_slot(p_tree, p_node);
+    void         **a_right = btree_slot(p_tree, p_right);
+    int64_t        a_key[ BTREE_KEYS_MAX + 1 ];
+    void          *a_kid[ BTREE_KEYS_MAX + 2 ];
+
+    /* merged view, limit + 1 keys and limit + 2 children */
+    memcpy(&(a_key[0]), &(p_node->key[0]), pos * sizeof(a_key[0]));
+    a_key[pos] = key;
+    memcpy(&(a_key[pos + 1]), &(p_node->key[pos]),
+           (limit - pos) * sizeof(a_key[0]));
+
+    memcpy(&(a_kid[0]), &(a_left[0]), (pos + 1) * sizeof(a_kid[0]));
+    a_kid[pos + 1] = p_child;
+    memcpy(&(a_kid[pos + 2]), &(a_left[pos + 1]),
+           (limit - pos) * sizeof(a_kid[0]));
+
+    memcpy(&(p_node->key[0]), &(a_key[0]), mid * sizeof(a_key[0]));
+    memcpy(&(a_left[0]), &(a_kid[0]), (mid + 1) * sizeof(a_kid[0]));
+    p_node->count = mid;
+
+    memcpy(&(p_right->key[0]), &(a_key[mid + 1]),
+           (limit - mid) * sizeof(a_key[0]));
+    memcpy(&(a_right[0]), &(a_kid[mid + 1]),
+           (limit - mid + 1) * sizeof(a_kid[0]));
+    p_right->count = limit - mid;
+
+    return a_key[mid];
+} /* btree_internal_split() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Node at parent child ci is below the floor, its left sibling at ci - 1
+ *   has a key to spare.
+ *
+ ****************************************************************************
+ */
+static void
+btree_borrow_left( btree_t      *p_tree,
+                   btree_node_t *p_parent,
+                   size_t        ci,
+                   btree_node_t *p_left,
+                   btree_node_t *p_node )
+{
+    void **a_left = btree_slot(p_tree, p_left);
+    void **a_node = btree_slot(p_tree, p_node);
+
+    memmove(&(p_node->key[1]), &(p_node->key[0]),
+            p_node->count * sizeof(p_node->key[0]));
+
+    if (0 == p_node->level) {
+        memmove(&(a_node[1]), &(a_node[0]), p_node->count * sizeof(a_node[0]));
+        p_node->key[0] = p_left->key[p_left->count - 1];
+        a_node[0]      = a_left[p_left->count - 1];
+        p_parent->key[ci - 1] = p_node->key[0];
+    } else {
+        memmove(&(a_node[1]), &(a_node[0]),
+                (p_node->count + 1) * sizeof(a_node[0]));
+        p_node->key[0] = p_parent->key[ci - 1];
+        a_node[0]      = a_left[p_left->count];
+        p_parent->key[ci - 1] = p_left->key[p_left->count - 1];
+    }
+
+    p_left->count--;
+    p_node->count++;
+
+    return;
+} /* btree_borrow_left() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+btree_borrow_right( btree_t      *p_tree,
+                    btree_node_t *p_parent,
+                    size_t        ci,
+                    btree_node_t *p_node,
+                    btree_node_t *p_right )
+{
+    void **a_node  = btree_slot(p_tree, p_node);
+    void **a_right = btree_slot(p_tree, p_right);
+
+    if (0 == p_node->level) {
+        p_node->key[p_node->count] = p_right->key[0];
+        a_node[p_node->count]      = a_right[0];
+        p_node->count++;
+        btree_erase_at(p_tree, p_right, 0);
+        p_parent->key[ci] = p_right->key[0];
+    } else {
+        p_node->key[p_node->count]  = p_parent->key[ci];
+        a_node[p_node->count + 1]   = a_right[0];
+        p_node->count++;
+        p_parent->key[ci] = p_right->key[0];
+
+        memmove(&(p_right->key[0]), &(p_right->key[1]),
+                (p_right->count - 1) * sizeof(p_right->key[0]));
+        memmove(&(a_right[0]), &(a_right[1]),
+                p_right->count * sizeof(a_right[0]));
+        p_right->count--;
+    }
+
+    return;
+} /* btree_borrow_right() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Merge p_right, parent child kidx + 1, into p_left, parent child kidx,
+ *   and release it.  An internal merge pulls down the parent separator.
+ *
+ ****************************************************************************
+ */
+static void
+btree_merge( btree_t      *p_tree,
+             btree_node_t *p_parent,
+             size_t        kidx,
+             btree_node_t *p_left,
+             btree_node_t *p_right )
+{
+    void **a_left  = btree_slot(p_tree, p_left);
+    void **a_right = btree_slot(p_tree, p_right);
+
+    if (0 == p_left->level) {
+        memcpy(&(p_left->key[p_left->count]), &(p_right->key[0]),
+               p_right->count * sizeof(p_left->key[0]));
+        memcpy(&(a_left[p_left->count]), &(a_right[0]),
+               p_right->count * sizeof(a_left[0]));
+        p_left->count  += p_right->count;
+        p_left->p_next  = p_right->p_next;
+    } else {
+        p_left->key[p_left->count] = p_parent->key[kidx];
+        memcpy(&(p_left->key[p_left->count + 1]), &(p_right->key[0]),
+               p_right->count * sizeof(p_left->key[0]));
+        memcpy(&(a_left[p_left->count + 1]), &(a_right[0]),
+               (p_right->count + 1) * sizeof(a_left[0]));
+        p_left->count += 1 + p_right->count;
+    }
+
+    btree_erase_at(p_tree, p_parent, kidx);
+    btree_node_free(p_tree, p_right);
+
+    return;
+} /* btree_merge() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static btree_node_t *
+btree_descend( btree_t      *p_tree,
+               int64_t       key,
+               btree_path_t *a_path,
+               size_t       *p_depth )
+{
+    size_t        idx    = 0;
+    size_t        depth  = 0;
+    btree_node_t *p_node = p_tree->p_root;
+
+    while (p_node->level) {
+        idx = btree_search_gt(p_node->key, p_node->count, key);
+        if (a_path) {
+            a_path[depth].p_node = p_node;
+            a_path[depth].idx    = idx;
+        }
+        depth++;
+        p_node = btree_child(p_tree, p_node, idx);
+    }
+
+    if (p_depth) {
+        *p_depth = depth;
+    }
+
+    return p_node;
+} /* btree_descend() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_btree_is_empty( adts_btree_t *p_adts_btree )
+{
+    btree_t *p_tree = (btree_t *) p_adts_btree;
+
+    return (0 == p_tree->elems);
+} /* adts_btree_is_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_btree_entries( adts_btree_t *p_adts_btree )
+{
+    btree_t *p_tree = (btree_t *) p_adts_btree;
+
+    return p_tree->elems;
+} /* adts_btree_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_btree_height( adts_btree_t *p_adts_btree )
+{
+    btree_t *p_tree = (btree_t *) p_adts_btree;
+
+    return p_tree->height;
+} /* adts_btree_height() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_btree_nodes( adts_btree_t *p_adts_btree )
+{
+    btree_t *p_tree = (btree_t *) p_adts_btree;
+
+    return p_tree->nodes;
+} /* adts_btree_nodes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Summary and the leaf chain, one line per leaf.
+ *
+ ****************************************************************************
+ */
+void
+adts_btree_display( adts_btree_t *p_adts_btree )
+{
+    size_t         idx      = 0;
+    btree_t       *p_tree   = (btree_t *) p_adts_btree;
+    btree_node_t  *p_node   = p_tree->p_root;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    printf("\nbtree: %10p  entries: %zu  height: %zu  nodes: %zu"
+           "  keys/node: %zu\n", p_tree, p_tree->elems, p_tree->height,
+           p_tree->nodes, p_tree->keys_max);
+
+    while (p_node && p_node->level) {
+        p_node = btree_child(p_tree, p_node, 0);
+    }
+    for (; p_node; p_node = p_node->p_next) {
+        printf("[%6zu]  leaf: %10p  keys: %3u  [%" PRId64 " .. %" PRId64 "]\n",
+               idx, p_node, p_node->count, p_node->key[0],
+               p_node->key[p_node->count - 1]);
+        idx++;
+    }
+
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_btree_display() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_btree_mem_stats( adts_btree_t     *p_adts_btree,
+                      adts_mem_stats_t *p_stats )
+{
+    btree_t *p_tree = (btree_t *) p_adts_btree;
+
+    *p_stats = p_tree->mem;
+
+    return;
+} /* adts_btree_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_btree_find( adts_btree_t  *p_adts_btree,
+                 int64_t        key,
+                 void         **pp_data )
+{
+    int32_t        rc       = ENOENT;
+    size_t         pos      = 0;
+    btree_t       *p_tree   = (btree_t *) p_adts_btree;
+    btree_node_t  *p_leaf   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(NULL == p_tree->p_root)) {
+        goto exception;
+    }
+
+    p_leaf = btree_descend(p_tree, key, NULL, NULL);
+    pos    = btree_search_ge(p_leaf->key, p_leaf->count, key);
+    if ((pos < p_leaf->count) && (key == p_leaf->key[pos])) {
+        *pp_data = btree_slot(p_tree, p_leaf)[pos];
+        rc       = 0;
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_btree_find() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The nodes a split may require, one per full node from the leaf up,
+ *   plus a new root, are allocated before the tree is modified such that
+ *   ENOMEM leaves it intact.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_btree_insert( adts_btree_t *p_adts_btree,
+                   int64_t       key,
+                   void         *p_data )
+{
+    int32_t        rc       = 0;
+    size_t         pos      = 0;
+    size_t         depth    = 0;
+    size_t         need     = 0;
+    size_t         used     = 0;
+    int64_t        sep      = 0;
+    btree_t       *p_tree   = (btree_t *) p_adts_btree;
+    btree_node_t  *p_leaf   = NULL;
+    btree_node_t  *p_right  = NULL;
+    btree_node_t  *p_root   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+    btree_path_t   a_path[ BTREE_HEIGHT_MAX ];
+    btree_node_t  *a_spare[ BTREE_HEIGHT_MAX + 1 ];
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(NULL == p_tree->p_root)) {
+        p_tree->p_root = btree_node_alloc(p_tree, 0);
+        if (NULL == p_tree->p_root) {
+            rc = ENOMEM;
+            goto exception;
+        }
+        p_tree->height = 1;
+    }
+
+    p_leaf = btree_descend(p_tree, key, a_path, &(depth));
+    pos    = btree_search_ge(p_leaf->key, p_leaf->count, key);
+    if ((pos < p_leaf->count) && (key == p_leaf->key[pos])) {
+        rc = EEXIST;
+        goto exception;
+    }
+
+    if (likely(p_leaf->count < p_tree->keys_max)) {
+        btree_leaf_insert_at(p_tree, p_leaf, pos, key, p_data);
+        goto inserted;
+    }
+
+    /* full leaf, reserve every node the split may cascade into */
+    need = 1;
+    while ((need <= depth) &&
+           (a_path[depth - need].p_node->count == p_tree->keys_max)) {
+        need++;
+    }
+    need += (need > depth) ? 1 : 0;
+    for (used = 0; used < need; used++) {
+        a_spare[used] = btree_node_alloc(p_tree, 0);
+        if (NULL == a_spare[used]) {
+            while (used) {
+                btree_node_free(p_tree, a_spare[--used]);
+            }
+            rc = ENOMEM;
+            goto exception;
+        }
+    }
+    used = 0;
+
+    p_right = a_spare[used++];
+    sep     = btree_leaf_split(p_tree, p_leaf, p_right, pos, key, p_data);
+
+    while (depth) {
+        btree_path_t *p_up   = &(a_path[--depth]);
+        btree_node_t *p_next = NULL;
+
+        if (p_up->p_node->count < p_tree->keys_max) {
+            btree_internal_insert_at(p_tree, p_up->p_node, p_up->idx, sep,
+                                     p_right);
+            goto inserted;
+        }
+
+        p_next        = a_spare[used++];
+        p_next->level = p_up->p_node->level;
+        sep           = btree_internal_split(p_tree, p_up->p_node, p_next,
+                                             p_up->idx, sep, p_right);
+        p_right       = p_next;
+    }
+
+    /* the root split */
+    p_root        = a_spare[used++];
+    p_root->level = p_tree->p_root->level + 1;
+    p_root->count = 1;
+    p_root->key[0]                = sep;
+    btree_slot(p_tree, p_root)[0] = p_tree->p_root;
+    btree_slot(p_tree, p_root)[1] = p_right;
+    p_tree->p_root = p_root;
+    p_tree->height++;
+
+inserted:
+    assert(used == need);
+    p_tree->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_btree_insert() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   An underflowing node borrows from a sibling with a key to spare,
+ *   otherwise merges with one, which may underflow the parent in turn.
+ *   Separators need not be present keys, thus removing a key equal to
+ *   a separator leaves the separator in place.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_btree_remove( adts_btree_t  *p_adts_btree,
+                   int64_t        key,
+                   void         **pp_data )
+{
+    int32_t        rc       = 0;
+    size_t         pos      = 0;
+    size_t         depth    = 0;
+    btree_t       *p_tree   = (btree_t *) p_adts_btree;
+    btree_node_t  *p_node   = NULL;
+    btree_node_t  *p_root   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+    btree_path_t   a_path[ BTREE_HEIGHT_MAX ];
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(NULL == p_tree->p_root)) {
+        rc = ENOENT;
+        goto exception;
+    }
+
+    p_node = btree_descend(p_tree, key, a_path, &(depth));
+    pos    = btree_search_ge(p_node->key, p_node->count, key);
+    if ((pos == p_node->count) || (key != p_node->key[pos])) {
+        rc = ENOENT;
+        goto exception;
+    }
+
+    if (pp_data) {
+        *pp_data = btree_slot(p_tree, p_node)[pos];
+    }
+    btree_erase_at(p_tree, p_node, pos);
+    p_tree->elems--;
+
+    while (depth && (p_node->count < p_tree->keys_min)) {
+        btree_path_t *p_up    = &(a_path[--depth]);
+        btree_node_t *p_par   = p_up->p_node;
+        size_t        ci      = p_up->idx;
+        btree_node_t *p_left  = NULL;
+        btree_node_t *p_right = NULL;
+
+        p_left  = (ci > 0) ? btree_child(p_tree, p_par, ci - 1) : NULL;
+        p_right = (ci < p_par->count) ? btree_child(p_tree, p_par, ci + 1) :
+                                        NULL;
+
+        if (p_left && (p_left->count > p_tree->keys_min)) {
+            btree_borrow_left(p_tree, p_par, ci, p_left, p_node);
+            break;
+        }
+        if (p_right && (p_right->count > p_tree->keys_min)) {
+            btree_borrow_right(p_tree, p_par, ci, p_node, p_right);
+            break;
+        }
+
+        if (p_left) {
+            btree_merge(p_tree, p_par, ci - 1, p_left, p_node);
+        } else {
+            btree_merge(p_tree, p_par, ci, p_node, p_right);
+        }
+        p_node = p_par;
+    }
+
+    p_root = p_tree->p_root;
+    if (0 == p_root->count) {
+        if (p_root->level) {
+            /* collapse a level */
+            p_tree->p_root = btree_child(p_tree, p_root, 0);
+            p_tree->height--;
+        } else {
+            p_tree->p_root = NULL;
+            p_tree->height = 0;
+        }
+        btree_node_free(p_tree, p_root);
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_btree_remove() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int64_t
+btree_min_key( btree_t      *p_tree,
+               btree_node_t *p_node )
+{
+    while (p_node->level) {
+        p_node = btree_child(p_tree, p_node, 0);
+    }
+
+    return p_node->key[0];
+} /* btree_min_key() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Leaves are filled left to right, then each level is built over the
+ *   one below, chained through p_next while under construction.  Items
+ *   are spread evenly across the nodes of a level, such that every node
+ *   holds at least the occupancy floor.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_btree_build_sorted( adts_btree_t  *p_adts_btree,
+                         const int64_t *a_keys,
+                         void * const  *a_data,
+                         size_t         elems )
+{
+    int32_t        rc       = 0;
+    size_t         levels   = 0;
+    size_t         items    = 0;
+    size_t         nodes    = 0;
+    size_t         fanout   = 0;
+    size_t         take     = 0;
+    size_t         src      = 0;
+    btree_t       *p_tree   = (btree_t *) p_adts_btree;
+    btree_node_t  *p_node   = NULL;
+    btree_node_t  *p_tail   = NULL;
+    btree_node_t  *p_child  = NULL;
+    btree_node_t  *p_next   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+    btree_node_t  *a_head[ BTREE_HEIGHT_MAX ];
+
+    adts_sanity_entry(p_sanity);
+
+    if (p_tree->p_root) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    for (size_t idx = 1; idx < elems; idx++) {
+        if (a_keys[idx - 1] >= a_keys[idx]) {
+            /* not strictly ascending */
+            rc = EINVAL;
+            goto exception;
+        }
+    }
+
+    if (0 == elems) {
+        goto exception;
+    }
+
+    /* leaves */
+    fanout = p_tree->keys_max;
+    items  = elems;
+    nodes  = (items + fanout - 1) / fanout;
+    p_tail = NULL;
+    a_head[levels] = NULL;
+    for (size_t ndx = 0; ndx < nodes; ndx++) {
+        p_node = btree_node_alloc(p_tree, 0);
+        if (NULL == p_node) {
+            rc = ENOMEM;
+            goto cleanup;
+        }
+        take = (items / nodes) + ((ndx < (items % nodes)) ? 1 : 0);
+        memcpy(&(p_node->key[0]), &(a_keys[src]), take * sizeof(a_keys[0]));
+        memcpy(btree_slot(p_tree, p_node), &(a_data[src]),
+               take * sizeof(a_data[0]));
+        p_node->count = take;
+        src          += take;
+
+        if (p_tail) {
+            p_tail->p_next = p_node;
+        } else {
+            a_head[levels] = p_node;
+        }
+        p_tail = p_node;
+    }
+    levels++;
+
+    /* internal levels, items are the children of the level below */
+    fanout = p_tree->keys_max + 1;
+    while (nodes > 1) {
+        items   = nodes;
+        nodes   = (items + fanout - 1) / fanout;
+        p_child = a_head[levels - 1];
+        p_tail  = NULL;
+        a_head[levels] = NULL;
+
+        for (size_t ndx = 0; ndx < nodes; ndx++) {
+            void **a_slot = NULL;
+
+            p_node = btree_node_alloc(p_tree, levels);
+            if (NULL == p_node) {
+                rc = ENOMEM;
+                goto cleanup;
+            }
+            a_slot = btree_slot(p_tree, p_node);
+            take   = (items / nodes) + ((ndx < (items % nodes)) ? 1 : 0);
+
+            for (size_t cdx = 0; cdx < take; cdx++) {
+                if (cdx) {
+                    p_node->key[cdx - 1] = btree_min_key(p_tree, p_child);
+                }
+                a_slot[cdx] = p_child;
+                p_child     = p_child->p_next;
+            }
+            p_node->count = take - 1;
+
+            if (p_tail) {
+                p_tail->p_next = p_node;
+            } else {
+                a_head[levels] = p_node;
+            }
+            p_tail = p_node;
+        }
+        levels++;
+    }
+
+    /* internal chains were for construction only */
+    for (size_t ldx = 1; ldx < levels; ldx++) {
+        for (p_node = a_head[ldx]; p_node; p_node = p_next) {
+            p_next         = p_node->p_next;
+            p_node->p_next = NULL;
+        }
+    }
+
+    p_tree->p_root = a_head[levels - 1];
+    p_tree->height = levels;
+    p_tree->elems  = elems;
+    goto exception;
+
+cleanup:
+    /* every level, the one under construction included, is chained */
+    for (size_t ldx = 0; ldx <= levels; ldx++) {
+        btree_chain_free(p_tree, a_head[ldx]);
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_btree_build_sorted() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_btree_iter_seek( adts_btree_t      *p_adts_btree,
+                      adts_btree_iter_t *p_adts_iter,
+                      int64_t            key )
+{
+    btree_t      *p_tree = (btree_t *) p_adts_btree;
+    btree_iter_t *p_iter = (btree_iter_t *) p_adts_iter;
+
+    p_iter->p_tree = p_tree;
+    p_iter->p_leaf = NULL;
+    p_iter->idx    = 0;
+
+    if (p_tree->p_root) {
+        p_iter->p_leaf = btree_descend(p_tree, key, NULL, NULL);
+        p_iter->idx    = btree_search_ge(p_iter->p_leaf->key,
+                                         p_iter->p_leaf->count, key);
+    }
+
+    return;
+} /* adts_btree_iter_seek() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The following leaf is prefetched on entering a leaf.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_btree_iter_next( adts_btree_iter_t  *p_adts_iter,
+                      int64_t            *p_key,
+                      void              **pp_data )
+{
+    btree_iter_t *p_iter = (btree_iter_t *) p_adts_iter;
+    btree_node_t *p_leaf = p_iter->p_leaf;
+
+    while (p_leaf && (p_iter->idx >= p_leaf->count)) {
+        p_leaf      = p_leaf->p_next;
+        p_iter->idx = 0;
+        if (p_leaf && p_leaf->p_next) {
+            __builtin_prefetch(p_leaf->p_next);
+        }
+    }
+    p_iter->p_leaf = p_leaf;
+
+    if (NULL == p_leaf) {
+        return ENOENT;
+    }
+
+    *p_key   = p_leaf->key[p_iter->idx];
+    *pp_data = btree_slot(p_iter->p_tree, p_leaf)[p_iter->idx];
+    p_iter->idx++;
+
+    return 0;
+} /* adts_btree_iter_next() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_btree_destroy( adts_btree_t *p_adts_btree )
+{
+    btree_t          *p_tree   = (btree_t *) p_adts_btree;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    btree_free_all(p_tree);
+
+    /* the record is released along with the handle */
+    mem = p_tree->mem;
+    adts_mem_free_acct(&(mem), p_tree, sizeof(adts_btree_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_btree_destroy() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_btree_t *
+adts_btree_create_ext( const adts_btree_create_t *p_op )
+{
+    size_t            bytes        = 0;
+    btree_t          *p_tree       = NULL;
+    adts_btree_t     *p_adts_btree = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_BTREE);
+
+    if (NULL == p_op) {
+        goto exception;
+    }
+
+    bytes = p_op->node_bytes ? p_op->node_bytes :
+                               ADTS_BTREE_NODE_BYTES_DEFAULT;
+    if ((ADTS_BTREE_NODE_BYTES_MIN > bytes) ||
+        (ADTS_BTREE_NODE_BYTES_MAX < bytes) ||
+        (bytes % BTREE_CACHELINE_BYTES)) {
+        goto exception;
+    }
+
+    p_adts_btree = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_btree),
+                                        ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_btree) {
+        goto exception;
+    }
+
+    p_tree             = (btree_t *) p_adts_btree;
+    p_tree->node_bytes = bytes;
+    p_tree->keys_max   = BTREE_KEYS(bytes);
+    p_tree->keys_min   = p_tree->keys_max / 2;
+    p_tree->mem        = mem;
+
+exception:
+    return p_adts_btree;
+} /* adts_btree_create_ext() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_btree_t *
+adts_btree_create( void )
+{
+    adts_btree_create_t op = {0};
+
+    return adts_btree_create_ext(&(op));
+} /* adts_btree_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_btree_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(btree_t));
+    CDISPLAY("[%u]", sizeof(adts_btree_t));
+
+    _Static_assert(sizeof(btree_t) <= sizeof(adts_btree_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(btree_iter_t));
+    CDISPLAY("[%u]", sizeof(adts_btree_iter_t));
+
+    _Static_assert(sizeof(btree_iter_t) <= sizeof(adts_btree_iter_t),
+        "Mismatch structs detected");
+
+    _Static_assert(16 == sizeof(btree_node_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_btree_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+utest_btree_rand( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return *p_seed;
+} /* utest_btree_rand() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Recursive structural check, bounded by the height: keys within the
+ *   separator bounds and ascending, occupancy, uniform leaf depth, and the
+ *   leaf chain visiting leaves in order.  p_lo is inclusive, p_hi
+ *   exclusive, NULL for unbounded.
+ *
+ ****************************************************************************
+ */
+static size_t
+utest_btree_node_valid( btree_t        *p_tree,
+                        btree_node_t   *p_node,
+                        const int64_t  *p_lo,
+                        const int64_t  *p_hi,
+                        btree_node_t  **pp_leaf )
+{
+    size_t elems = 0;
+
+    assert((p_node == p_tree->p_root) || (p_node->count >= p_tree->keys_min));
+    assert(p_node->count <= p_tree->keys_max);
+
+    for (size_t idx = 0; idx < p_node->count; idx++) {
+        assert((NULL == p_lo) || (p_node->key[idx] >= *p_lo));
+        assert((NULL == p_hi) || (p_node->key[idx] < *p_hi));
+        assert((0 == idx) || (p_node->key[idx - 1] < p_node->key[idx]));
+    }
+
+    if (0 == p_node->level) {
+        /* the chain reaches this leaf next */
+        assert(*pp_leaf == p_node);
+        *pp_leaf = p_node->p_next;
+        return p_node->count;
+    }
+
+    assert(NULL == p_node->p_next);
+    for (size_t idx = 0; idx <= p_node->count; idx++) {
+        btree_node_t  *p_child = btree_child(p_tree, p_node, idx);
+        const int64_t *p_clo   = (idx) ? &(p_node->key[idx - 1]) : p_lo;
+        const int64_t *p_chi   = (idx < p_node->count) ? &(p_node->key[idx]) :
+                                                         p_hi;
+
+        assert(p_child->level == (p_node->level - 1));
+        elems += utest_btree_node_valid(p_tree, p_child, p_clo, p_chi,
+                                        pp_leaf);
+    }
+
+    return elems;
+} /* utest_btree_node_valid() */
+
+static void
+utest_btree_valid( adts_btree_t *p_adts_btree )
+{
+    size_t        height = 0;
+    btree_t      *p_tree = (btree_t *) p_adts_btree;
+    btree_node_t *p_leaf = p_tree->p_root;
+
+    if (NULL == p_tree->p_root) {
+        assert(0 == p_tree->elems);
+        assert(0 == p_tree->height);
+        return;
+    }
+
+    for (height = 1; p_leaf->level; height++) {
+        p_leaf = btree_child(p_tree, p_leaf, 0);
+    }
+    assert(height == p_tree->height);
+    assert(p_tree->p_root->level == (height - 1));
+    assert(p_tree->elems == utest_btree_node_valid(p_tree, p_tree->p_root,
+                                                   NULL, NULL, &(p_leaf)));
+    assert(NULL == p_leaf);
+
+    return;
+} /* utest_btree_valid() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Scan from lo against the reference presence map over [0, limit).
+ *
+ ****************************************************************************
+ */
+static void
+utest_btree_scan_valid( adts_btree_t  *p_adts_btree,
+                        const uint8_t *p_ref,
+                        int64_t        limit,
+                        int64_t        lo )
+{
+    int64_t            key    = 0;
+    int64_t            expect = (lo < 0) ? 0 : lo;
+    void              *p_data = NULL;
+    adts_btree_iter_t  iter   = {0};
+
+    adts_btree_iter_seek(p_adts_btree, &(iter), lo);
+    while (0 == adts_btree_iter_next(&(iter), &(key), &(p_data))) {
+        while ((expect < limit) && (0 == p_ref[expect])) {
+            expect++;
+        }
+        assert(key == expect);
+        assert((uintptr_t) p_data == (uintptr_t) (key * 3));
+        expect++;
+    }
+    while ((expect < limit) && (0 == p_ref[expect])) {
+        expect++;
+    }
+    assert(expect >= limit);
+
+    return;
+} /* utest_btree_scan_valid() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   B+tree vs AVL and red-black trees, random insert and find, then the
+ *   full and windowed range scans against adts_rbt ranges.  The bulk load
+ *   is B+tree only, the binary trees have none over int64_t keys.
+ *
+ ****************************************************************************
+ */
+#define UTEST_BTREE_WINDOWS     (100 * 1000)
+#define UTEST_BTREE_WINDOW_KEYS (100)
+
+static void
+utest_btree_benchmark( void )
+{
+    const size_t sizes[] = { 1000 * 1000, 10 * 1000 * 1000 };
+    uint64_t     seed    = 0x9E3779B97F4A7C15ULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: B+tree vs AVL / red-black tree, random int64_t keys");
+
+    for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+        const size_t        elems   = sizes[sdx];
+        const int64_t       span      = (UTEST_BTREE_WINDOW_KEYS - 1) * 7919;
+        uint64_t            t_ins[3]  = {0};
+        uint64_t            t_find[3] = {0};
+        uint64_t            t_scan[2] = {0};
+        uint64_t            t_win[2]  = {0};
+        uint64_t            t_bulk    = 0;
+        uint64_t            sum       = 0;
+        size_t              found[2]  = {0};
+        int64_t             key       = 0;
+        void               *p_data    = NULL;
+        int64_t            *p_key     = NULL;
+        int64_t            *p_sorted  = NULL;
+        int64_t            *p_lo      = NULL;
+        adts_btree_t       *p_btree   = NULL;
+        adts_tree_t        *p_avl     = NULL;
+        adts_tree_node_t   *p_nodes   = NULL;
+        adts_rbt_t         *p_rbt     = NULL;
+        adts_rbt_node_t    *p_rnodes  = NULL;
+        adts_rbt_node_t    *p_rnode   = NULL;
+        adts_btree_iter_t   iter      = {0};
+        adts_rbt_range_t    range     = {0};
+        adts_mem_stats_t    stats     = {0};
+
+        p_key    = calloc(elems, sizeof(*p_key));
+        p_sorted = calloc(elems, sizeof(*p_sorted));
+        p_lo     = calloc(UTEST_BTREE_WINDOWS, sizeof(*p_lo));
+        p_nodes  = calloc(elems, sizeof(*p_nodes));
+        assert(p_key && p_sorted && p_lo && p_nodes);
+
+        /* distinct keys, a shuffle of a strided sequence */
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_key[idx] = (int64_t) (idx * 7919);
+        }
+        for (size_t idx = elems - 1; idx > 0; idx--) {
+            size_t  jdx = utest_btree_rand(&(seed)) % (idx + 1);
+            int64_t tmp = p_key[idx];
+
+            p_key[idx] = p_key[jdx];
+            p_key[jdx] = tmp;
+        }
+        for (size_t idx = 0; idx < UTEST_BTREE_WINDOWS; idx++) {
+            p_lo[idx] = p_key[utest_btree_rand(&(seed)) % elems];
+        }
+
+        /* B+tree */
+        p_btree = adts_btree_create();
+        assert(p_btree);
+        t_ins[0] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_btree_insert(p_btree, p_key[idx], (void *) idx);
+        }
+        t_ins[0] = adts_tstamp() - t_ins[0];
+        adts_btree_mem_stats(p_btree, &(stats));
+
+        t_find[0] = adts_tstamp();
+        for (size_t idx = elems; idx > 0; idx--) {
+            if (adts_btree_find(p_btree, p_key[idx - 1], &(p_data))) {
+                assert(0);
+            }
+        }
+        t_find[0] = adts_tstamp() - t_find[0];
+
+        t_scan[0] = adts_tstamp();
+        adts_btree_iter_seek(p_btree, &(iter), INT64_MIN);
+        while (0 == adts_btree_iter_next(&(iter), &(key), &(p_data))) {
+            sum += (uintptr_t) p_data;
+        }
+        t_scan[0] = adts_tstamp() - t_scan[0];
+        assert(sum == ((elems * (elems - 1)) / 2));
+
+        t_win[0] = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_BTREE_WINDOWS; idx++) {
+            adts_btree_iter_seek(p_btree, &(iter), p_lo[idx]);
+            while ((0 == adts_btree_iter_next(&(iter), &(key), &(p_data))) &&
+                   (key <= p_lo[idx] + span)) {
+                found[0]++;
+            }
+        }
+        t_win[0] = adts_tstamp() - t_win[0];
+        adts_btree_destroy(p_btree);
+
+        /* AVL tree, 64B nodes */
+        p_avl = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_avl);
+        t_ins[1] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_insert(p_avl, &(p_nodes[idx]),
+                                    (void *) p_key[idx], 0);
+        }
+        t_ins[1] = adts_tstamp() - t_ins[1];
+
+        t_find[1] = adts_tstamp();
+        for (size_t idx = elems; idx > 0; idx--) {
+            if (NULL == adts_tree_find(p_avl, (void *) p_key[idx - 1])) {
+                assert(0);
+            }
+        }
+        t_find[1] = adts_tstamp() - t_find[1];
+        adts_tree_destroy(p_avl);
+        free(p_nodes);
+
+        /* red-black tree, 64B nodes, keys are non negative thus ordered
+         * by the default unsigned comparator */
+        p_rnodes = calloc(elems, sizeof(*p_rnodes));
+        p_rbt    = adts_rbt_create();
+        assert(p_rnodes && p_rbt);
+        t_ins[2] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_rbt_insert(p_rbt, &(p_rnodes[idx]),
+                                   (void *) p_key[idx], (void *) idx);
+        }
+        t_ins[2] = adts_tstamp() - t_ins[2];
+
+        t_find[2] = adts_tstamp();
+        for (size_t idx = elems; idx > 0; idx--) {
+            if (NULL == adts_rbt_find(p_rbt, (void *) p_key[idx - 1])) {
+                assert(0);
+            }
+        }
+        t_find[2] = adts_tstamp() - t_find[2];
+
+        sum       = 0;
+        t_scan[1] = adts_tstamp();
+        for (p_rnode = adts_rbt_range_begin(p_rbt, &(range), (void *) 0,
+                                            (void *) INT64_MAX);
+             p_rnode;
+             p_rnode = adts_rbt_range_next(&(range))) {
+            sum += (uintptr_t) p_rnode->pub.p_data;
+        }
+        t_scan[1] = adts_tstamp() - t_scan[1];
+        assert(sum == ((elems * (elems - 1)) / 2));
+
+        t_win[1] = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_BTREE_WINDOWS; idx++) {
+            for (p_rnode = adts_rbt_range_begin(p_rbt, &(range),
+                                                (void *) p_lo[idx],
+                                                (void *) (p_lo[idx] + span));
+                 p_rnode;
+                 p_rnode = adts_rbt_range_next(&(range))) {
+                found[1]++;
+            }
+        }
+        t_win[1] = adts_tstamp() - t_win[1];
+        assert(found[0] == found[1]);
+        adts_rbt_destroy(p_rbt);
+        free(p_rnodes);
+
+        /* bulk load */
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_sorted[idx] = (int64_t) (idx * 7919);
+        }
+        p_btree = adts_btree_create();
+        assert(p_btree);
+        t_bulk = adts_tstamp();
+        assert(0 == adts_btree_build_sorted(p_btree, p_sorted,
+                                            (void * const *) p_sorted, elems));
+        t_bulk = adts_tstamp() - t_bulk;
+
+        CDISPLAY("%9zu keys  insert %4llu / %4llu / %4llu  find %4llu / %4llu"
+                 " / %4llu ns/op  (btree / avl / rbt)", elems,
+                 t_ins[0] / elems, t_ins[1] / elems, t_ins[2] / elems,
+                 t_find[0] / elems, t_find[1] / elems, t_find[2] / elems);
+        CDISPLAY("%9zu keys  scan %llu / %llu ns/key  %u key windows %llu /"
+                 " %llu ns/window  (btree / rbt)", elems, t_scan[0] / elems,
+                 t_scan[1] / elems, UTEST_BTREE_WINDOW_KEYS,
+                 t_win[0] / UTEST_BTREE_WINDOWS,
+                 t_win[1] / UTEST_BTREE_WINDOWS);
+        CDISPLAY("%9zu keys  btree height %zu  build_sorted %llu ms  bytes %zu"
+                 " / %zu  (btree / avl, rbt)", elems,
+                 adts_btree_height(p_btree), t_bulk / (1000 * 1000),
+                 stats.bytes_curr, elems * sizeof(adts_tree_node_t));
+
+        adts_btree_destroy(p_btree);
+        free(p_lo);
+        free(p_sorted);
+        free(p_key);
+    }
+
+    return;
+} /* utest_btree_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_btree_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> destroy, node sizing, empty tree");
+
+        int64_t              key     = 0;
+        void                *p_data  = NULL;
+        adts_btree_t        *p_btree = NULL;
+        adts_btree_create_t  op      = {0};
+        adts_btree_iter_t    iter    = {0};
+
+        assert(NULL == adts_btree_create_ext(NULL));
+        op.node_bytes = 128;
+        assert(NULL == adts_btree_create_ext(&(op)));
+        op.node_bytes = 320 + 1;
+        assert(NULL == adts_btree_create_ext(&(op)));
+        op.node_bytes = 2 * ADTS_BTREE_NODE_BYTES_MAX;
+        assert(NULL == adts_btree_create_ext(&(op)));
+
+        p_btree = adts_btree_create();
+        assert(p_btree);
+        assert(30 == ((btree_t *) p_btree)->keys_max);
+        assert(adts_btree_is_empty(p_btree));
+        assert(ENOENT == adts_btree_find(p_btree, 0, &(p_data)));
+        assert(ENOENT == adts_btree_remove(p_btree, 0, &(p_data)));
+        adts_btree_iter_seek(p_btree, &(iter), INT64_MIN);
+        assert(ENOENT == adts_btree_iter_next(&(iter), &(key), &(p_data)));
+
+        assert(0 == adts_btree_insert(p_btree, 5, (void *) 15));
+        assert(EEXIST == adts_btree_insert(p_btree, 5, NULL));
+        assert(0 == adts_btree_find(p_btree, 5, &(p_data)));
+        assert(15 == (uintptr_t) p_data);
+        assert(0 == adts_btree_remove(p_btree, 5, NULL));
+        assert(0 == adts_btree_nodes(p_btree));
+        utest_btree_valid(p_btree);
+        adts_btree_destroy(p_btree);
+
+        op.node_bytes = ADTS_BTREE_NODE_BYTES_MAX;
+        p_btree = adts_btree_create_ext(&(op));
+        assert(p_btree);
+        assert(BTREE_KEYS_MAX == ((btree_t *) p_btree)->keys_max);
+        adts_btree_destroy(p_btree);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: random insert / remove / find against a reference");
+
+        const int64_t        limit   = 16 * 1024;
+        const size_t         sizes[] = { 256, 512, 1024 };
+        uint64_t             seed    = 0x9E3779B97F4A7C15ULL;
+        uint8_t             *p_ref   = NULL;
+        adts_btree_t        *p_btree = NULL;
+        adts_btree_create_t  op      = {0};
+        adts_mem_stats_t     before  = {0};
+        adts_mem_stats_t     after   = {0};
+
+        p_ref = calloc(limit, sizeof(*p_ref));
+        assert(p_ref);
+        adts_mem_stats_type(ADTS_MEM_TYPE_BTREE, &(before));
+
+        for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+            size_t elems = 0;
+
+            memset(p_ref, 0, limit * sizeof(*p_ref));
+            op.node_bytes = sizes[sdx];
+            p_btree       = adts_btree_create_ext(&(op));
+            assert(p_btree);
+
+            for (size_t idx = 0; idx < (8 * limit); idx++) {
+                uint64_t  r      = utest_btree_rand(&(seed));
+                int64_t   key    = (r >> 8) % limit;
+                void     *p_data = NULL;
+                int32_t   rc     = 0;
+
+                /* grow for the first half, then shrink */
+                if ((r & 0xff) < ((idx < (4 * limit)) ? 160 : 96)) {
+                    rc = adts_btree_insert(p_btree, key, (void *) (key * 3));
+                    assert(rc == (p_ref[key] ? EEXIST : 0));
+                    elems      += p_ref[key] ? 0 : 1;
+                    p_ref[key]  = 1;
+                } else {
+                    rc = adts_btree_remove(p_btree, key, &(p_data));
+                    assert(rc == (p_ref[key] ? 0 : ENOENT));
+                    if (0 == rc) {
+                        assert((uintptr_t) p_data == (uintptr_t) (key * 3));
+                    }
+                    elems      -= p_ref[key] ? 1 : 0;
+                    p_ref[key]  = 0;
+                }
+
+                rc = adts_btree_find(p_btree, key ^ 1, &(p_data));
+                assert(rc == (p_ref[key ^ 1] ? 0 : ENOENT));
+                assert(elems == adts_btree_entries(p_btree));
+
+                if (0 == (idx % 2048)) {
+                    utest_btree_valid(p_btree);
+                    utest_btree_scan_valid(p_btree, p_ref, limit,
+                                           (int64_t) (r % limit) - 8);
+                }
+            }
+            utest_btree_valid(p_btree);
+            utest_btree_scan_valid(p_btree, p_ref, limit, INT64_MIN);
+
+            /* drain */
+            for (int64_t key = 0; key < limit; key++) {
+                assert((p_ref[key] ? 0 : ENOENT) ==
+                       adts_btree_remove(p_btree, key, NULL));
+            }
+            assert(adts_btree_is_empty(p_btree));
+            assert(0 == adts_btree_nodes(p_btree));
+            utest_btree_valid(p_btree);
+
+            adts_btree_destroy(p_btree);
+        }
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_BTREE, &(after));
+        assert(before.bytes_curr == after.bytes_curr);
+        free(p_ref);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: build sorted");
+
+        const size_t         sizes[] = { 0, 1, 14, 15, 29, 225, 226, 100000 };
+        const size_t         limit   = 100000;
+        int64_t             *p_keys  = NULL;
+        uint8_t             *p_ref   = NULL;
+        adts_btree_t        *p_btree = NULL;
+        adts_btree_create_t  op      = {0};
+
+        p_keys = calloc(limit, sizeof(*p_keys));
+        p_ref  = calloc(2 * limit, sizeof(*p_ref));
+        assert(p_keys && p_ref);
+        for (size_t idx = 0; idx < limit; idx++) {
+            p_keys[idx] = 2 * idx;
+        }
+
+        /* 256B nodes, 14 keys, such that levels stack up quickly */
+        op.node_bytes = ADTS_BTREE_NODE_BYTES_MIN;
+        for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+            const size_t  elems  = sizes[sdx];
+            void        **a_data = calloc(elems + 1, sizeof(*a_data));
+
+            assert(a_data);
+            memset(p_ref, 0, 2 * limit * sizeof(*p_ref));
+            for (size_t idx = 0; idx < elems; idx++) {
+                a_data[idx]       = (void *) (p_keys[idx] * 3);
+                p_ref[2 * idx]    = 1;
+            }
+
+            p_btree = adts_btree_create_ext(&(op));
+            assert(p_btree);
+            assert(0 == adts_btree_build_sorted(p_btree, p_keys, a_data,
+                                                elems));
+            assert(elems == adts_btree_entries(p_btree));
+            utest_btree_valid(p_btree);
+            utest_btree_scan_valid(p_btree, p_ref, 2 * limit, INT64_MIN);
+            utest_btree_scan_valid(p_btree, p_ref, 2 * limit, elems - 1);
+
+            if (elems) {
+                assert(EINVAL == adts_btree_build_sorted(p_btree, p_keys,
+                                                         a_data, elems));
+            }
+
+            /* odd keys interleave, then every third even key leaves */
+            for (size_t idx = 0; idx < elems; idx += 2) {
+                assert(0 == adts_btree_insert(p_btree, p_keys[idx] + 1,
+                                              (void *) ((p_keys[idx] + 1) * 3)));
+                p_ref[p_keys[idx] + 1] = 1;
+            }
+            for (size_t idx = 0; idx < elems; idx += 3) {
+                assert(0 == adts_btree_remove(p_btree, p_keys[idx], NULL));
+                p_ref[p_keys[idx]] = 0;
+            }
+            utest_btree_valid(p_btree);
+            utest_btree_scan_valid(p_btree, p_ref, 2 * limit, INT64_MIN);
+
+            adts_btree_destroy(p_btree);
+            free(a_data);
+        }
+
+        /* out of order or duplicate input is rejected */
+        p_btree = adts_btree_create();
+        assert(p_btree);
+        p_keys[7] = p_keys[6];
+        assert(EINVAL == adts_btree_build_sorted(p_btree, p_keys,
+                                                 (void * const *) p_keys, 64));
+        assert(adts_btree_is_empty(p_btree));
+        assert(0 == adts_btree_nodes(p_btree));
+
+        p_keys[7] = p_keys[8] + 1;
+        assert(EINVAL == adts_btree_build_sorted(p_btree, p_keys,
+                                                 (void * const *) p_keys, 64));
+        assert(0 == adts_btree_nodes(p_btree));
+        adts_btree_destroy(p_btree);
+
+        free(p_ref);
+        free(p_keys);
+    }
+
+    utest_btree_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_btree( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_btree() */
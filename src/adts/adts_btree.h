@@ -0,0 +1,166 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_BTREE_BYTES      (256)
+#define ADTS_BTREE_ITER_BYTES (32)
+
+typedef struct {
+    const char reserved[ ADTS_BTREE_BYTES ];
+} adts_btree_t;
+
+typedef struct {
+    const char reserved[ ADTS_BTREE_ITER_BYTES ];
+} adts_btree_iter_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   B+tree ordered map, unique int64_t keys to p_data.  Nodes are whole
+ *   cachelines, keys are held apart from values and children such that
+ *   a node search touches only the key lines, and is branchless.  All
+ *   entries reside in the leaves, which are chained in key order for
+ *   range scans.
+ *
+ *   A lookup costs about log_B(n) misses for B keys per node, where a
+ *   binary tree costs log_2(n).
+ *
+ *   btree create parameters
+ *     - node_bytes: bytes per node, a multiple of the cacheline within
+ *       [ADTS_BTREE_NODE_BYTES_MIN, ADTS_BTREE_NODE_BYTES_MAX].  0 selects
+ *       ADTS_BTREE_NODE_BYTES_DEFAULT.  A node holds (node_bytes - 24) / 16
+ *       keys, 30 at the default.
+ *
+ **************************************************************************
+ */
+#define ADTS_BTREE_NODE_BYTES_DEFAULT (512)
+#define ADTS_BTREE_NODE_BYTES_MIN     (256)
+#define ADTS_BTREE_NODE_BYTES_MAX     (4096)
+
+typedef struct {
+    size_t node_bytes;
+} adts_btree_create_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+bool
+adts_btree_is_empty( adts_btree_t *p_adts_btree );
+
+size_t
+adts_btree_entries( adts_btree_t *p_adts_btree );
+
+size_t
+adts_btree_height( adts_btree_t *p_adts_btree );
+
+size_t
+adts_btree_nodes( adts_btree_t *p_adts_btree );
+
+void
+adts_btree_display( adts_btree_t *p_adts_btree );
+
+void
+adts_btree_mem_stats( adts_btree_t     *p_adts_btree,
+                      adts_mem_stats_t *p_stats );
+
+/**
+ **************************************************************************
+ * \details
+ *   find:   ENOENT if absent, otherwise p_data is returned via pp_data.
+ *   insert: EEXIST if present, ENOMEM on node allocation failure.
+ *   remove: ENOENT if absent, otherwise p_data is returned via pp_data,
+ *           which may be NULL.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_btree_find( adts_btree_t  *p_adts_btree,
+                 int64_t        key,
+                 void         **pp_data );
+
+int32_t
+adts_btree_insert( adts_btree_t *p_adts_btree,
+                   int64_t       key,
+                   void         *p_data );
+
+int32_t
+adts_btree_remove( adts_btree_t  *p_adts_btree,
+                   int64_t        key,
+                   void         **pp_data );
+
+/**
+ **************************************************************************
+ * \details
+ *   Populate an empty tree, in O(n), from elems strictly ascending keys
+ *   and their a_data.  Nodes are filled and the remainder spread evenly.
+ *   EINVAL if the tree is not empty or the keys are not strictly
+ *   ascending, ENOMEM on allocation failure, in either case the tree is
+ *   left empty.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_btree_build_sorted( adts_btree_t  *p_adts_btree,
+                         const int64_t *a_keys,
+                         void * const  *a_data,
+                         size_t         elems );
+
+/**
+ **************************************************************************
+ * \details
+ *   Ascending iteration from the first key >= key, INT64_MIN for the
+ *   whole tree.  adts_btree_iter_next() returns ENOENT once exhausted.
+ *   Any modification of the tree invalidates the iterator.
+ *
+ *   adts_btree_iter_seek(p_tree, &(iter), lo);
+ *   while ((0 == adts_btree_iter_next(&(iter), &(key), &(p_data))) &&
+ *          (key < hi)) {
+ *       ...
+ *   }
+ *
+ **************************************************************************
+ */
+void
+adts_btree_iter_seek( adts_btree_t      *p_adts_btree,
+                      adts_btree_iter_t *p_iter,
+                      int64_t            key );
+
+int32_t
+adts_btree_iter_next( adts_btree_iter_t  *p_iter,
+                      int64_t            *p_key,
+                      void              **pp_data );
+
+void
+adts_btree_destroy( adts_btree_t *p_adts_btree );
+
+adts_btree_t *
+adts_btree_create_ext( const adts_btree_create_t *p_op );
+
+adts_btree_t *
+adts_btree_create( void );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_btree( void );
@@ -5,11 +5,14 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
+#include <adts_pool.h>
 #include <adts_graph.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -38,7 +41,9 @@ typedef struct {
     size_t         vertices;
     size_t         edges;    /* also known as arcs */
     graph_node_t **adjlist;
-    adts_sanity_t  sanity;
+    adts_pool_t      *p_pool;   /* vertex cache */
+    adts_mem_stats_t  mem;      /* includes the vertex cache */
+    adts_sanity_t     sanity;
 } graph_t;
 
 
@@ -92,18 +97,22 @@ exception:
 void
 adts_graph_destroy( adts_graph_t *p_adts_graph )
 {
-    graph_t       *p_graph  = (graph_t *) p_adts_graph;
-    adts_sanity_t *p_sanity = &(p_graph->sanity);
+    graph_t          *p_graph  = (graph_t *) p_adts_graph;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_graph->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    for (int32_t i = 0; i < p_graph->vertices; i++) {
-        free(p_graph->adjlist[i]);
-        p_graph->adjlist[i] = NULL;
-    }
+    /* vertices are released along with the cache */
+    adts_pool_destroy(p_graph->p_pool);
+    adts_mem_free_acct(&(p_graph->mem), p_graph->adjlist,
+                       sizeof(p_graph->adjlist[0]) * p_graph->vertices,
+                       ADTS_MEM_ALIGN_DEFAULT);
 
-    free(p_graph->adjlist);
-    free(p_graph);
+    /* the record is released along with the handle */
+    mem = p_graph->mem;
+    adts_mem_free_acct(&(mem), p_graph, sizeof(adts_graph_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
 
     /* No adts_sanity_exit() since we've freed the memory */
 
@@ -119,15 +128,17 @@ adts_graph_destroy( adts_graph_t *p_adts_graph )
 adts_graph_t *
 adts_graph_create( size_t vertices )
 {
-    bool               valid_nodes       = false;
     size_t             bytes             = 0;
     int32_t            rc                = 0;
     int32_t            idx               = 0;
     graph_t           *p_graph           = NULL;
     adts_graph_t      *p_adts_graph      = NULL;
     adts_graph_node_t *p_adts_graph_node = NULL;
+    adts_pool_create_t pool_op           = {0};
+    adts_mem_stats_t   mem               = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_GRAPH);
 
-    p_adts_graph  = adts_mem_zalloc(sizeof(*p_adts_graph));
+    p_adts_graph  = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_graph),
+                                         ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_adts_graph) {
         rc = ENOMEM;
         goto exception;
@@ -135,18 +146,30 @@ adts_graph_create( size_t vertices )
 
     p_graph           = (graph_t *) p_adts_graph;
     p_graph->vertices = vertices;
+    p_graph->mem      = mem;
 
-    bytes = sizeof(p_adts_graph_node) * vertices;
-    p_graph->adjlist = calloc(1, bytes);
+    bytes = sizeof(p_graph->adjlist[0]) * vertices;
+    p_graph->adjlist = adts_mem_zalloc_acct(&(p_graph->mem), bytes,
+                                            ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_graph->adjlist) {
         rc = ENOMEM;
         goto exception;
     }
 
+    /* vertices are carved from a single cache rather than per node allocs */
+    pool_op.obj_bytes = sizeof(*p_adts_graph_node);
+    pool_op.options   = ADTS_POOL_OPTS_ZERO;
+    pool_op.p_stats   = &(p_graph->mem);
+    p_graph->p_pool   = adts_pool_create(&pool_op);
+    if (NULL == p_graph->p_pool) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
     for (idx = 0; idx < vertices; idx++) {
         graph_node_t *p_node = NULL;
 
-        p_node = calloc(1, sizeof(*p_adts_graph_node));
+        p_node = adts_pool_alloc(p_graph->p_pool);
         if (NULL == p_node) {
             rc = ENOMEM;
             goto exception;
@@ -156,24 +179,23 @@ adts_graph_create( size_t vertices )
         p_node->list_elems  = 1;
         p_node->list_sorted = 1;
 
-        valid_nodes           = true;
         p_graph->adjlist[idx] = p_node;
     }
 
 exception:
     if (rc) {
-        if (valid_nodes) {
-            for (int32_t i = idx - 1; i >= 0; i--) {
-                free(p_graph->adjlist[i]);
+        if (p_graph) {
+            adts_pool_destroy(p_graph->p_pool);
+
+            if (p_graph->adjlist) {
+                adts_mem_free_acct(&(p_graph->mem), p_graph->adjlist, bytes,
+                                   ADTS_MEM_ALIGN_DEFAULT);
+                p_graph->adjlist = NULL;
             }
-        }
 
-        if (p_graph) {
-        	if (p_graph->adjlist) {
-            	free(p_graph->adjlist);
-				p_graph->adjlist = NULL;
-        	}
-            free(p_graph);
+            mem = p_graph->mem;
+            adts_mem_free_acct(&(mem), p_graph, sizeof(adts_graph_t),
+                               ADTS_MEM_ALIGN_DEFAULT);
             p_graph = NULL;
         }
     }
@@ -10,7 +10,7 @@
  *
  **************************************************************************
  */
-#define ADTS_GRAPH_BYTES      (64)
+#define ADTS_GRAPH_BYTES      (256)
 #define ADTS_GRAPH_NODE_BYTES (64)
 
 
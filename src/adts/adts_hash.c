@@ -4,12 +4,15 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_math.h>
 #include <adts_hash.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_hexdump.h>
@@ -97,7 +100,10 @@ typedef struct hash_s {
     adts_hash_create_t    params;
     volatile bool         resizing;
     hash_node_t         **workspace;
+    adts_arena_t         *p_arena;  /**< optional, owns all memory */
     adts_sanity_t         sanity;
+    adts_mem_stats_t      mem;
+    bool                  embedded; /**< caller owns all memory */
 } hash_t;
 
 
@@ -274,6 +280,28 @@ hash_load_factor( hash_t *p_hash )
 } /* hash_load_factor() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Workspace alignment is derived from the options and size alone such
+ *   that the free path resolves the identical alignment.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+hash_workspace_align( hash_t *p_hash,
+                      size_t  bytes )
+{
+    size_t align = ADTS_MEM_ALIGN_DEFAULT;
+
+    if (ADTS_HASH_OPTS_HUGEPAGE & p_hash->params.options) {
+        align = adts_mem_align_hugepage(bytes);
+    }
+
+    return align;
+} /* hash_workspace_align() */
+
+
 /*
  ****************************************************************************
  *
@@ -393,7 +421,12 @@ hash_resize( hash_t           *p_hash,
     /* p_new used to handle error case and preserve the workspace */
     limit_new = hash_resize_limit(p_hash->pub.elems_limit, op);
     bytes     = limit_new * sizeof(p_hash->workspace[0]);
-    p_new     = adts_mem_zalloc(bytes);
+    if (p_hash->p_arena) {
+        p_new = adts_arena_zalloc(p_hash->p_arena, bytes);
+    }else {
+        p_new = adts_mem_zalloc_acct(&(p_hash->mem), bytes,
+                                     hash_workspace_align(p_hash, bytes));
+    }
     if (NULL == p_new) {
         rc = ENOMEM;
         goto exception;
@@ -413,10 +446,14 @@ hash_resize( hash_t           *p_hash,
      * previous recursive opereraitions. */
     hash_resize_rehash(&new, p_hash);
 
-    /* clear and free the old hashtbl workspace */
-    bytes = p_hash->pub.elems_limit * sizeof(p_hash->workspace[0]);
-    memset(p_hash->workspace, 0, bytes);
-    free(p_hash->workspace);
+    /* free the old hashtbl workspace, scrubbed per the library policy and
+     * arena memory is reclaimed on arena reset.  Charged to the new
+     * properties since those replace the old below. */
+    if (NULL == p_hash->p_arena) {
+        bytes = p_hash->pub.elems_limit * sizeof(p_hash->workspace[0]);
+        adts_mem_free_acct(&(new.mem), p_hash->workspace, bytes,
+                           hash_workspace_align(p_hash, bytes));
+    }
 
     /* all is good, transition new hashtbl into old hashtbl memspace */
     memcpy(p_hash, &(new), sizeof(*p_hash));
@@ -645,7 +682,7 @@ exception:
         p_stats->loadfactor = hash_load_factor(p_hash);
 
         /* resize candidacy only after accounting complete */
-        if (unlikely(empty)) {
+        if (unlikely(empty) && hash_resize_enabled(p_hash)) {
             /* Resize is relevant when empty elements exist, */
             hash_resize_check_shrink(p_hash);
         }
@@ -672,9 +709,16 @@ hash_insert( hash_t                  *p_hash,
     adts_hash_stats_t  *p_stats   = &(p_hash->pub.stats);
     adts_hash_create_t *p_params  = &(p_hash->params);
 
-    /* Clear and populate consumers node structure as read-only mode */
-    memset(p_node, 0, sizeof(*p_node));
-    memcpy(&(p_node->pub), p_input, sizeof(p_node->pub));
+    if (unlikely(p_hash->embedded &&
+                 (p_hash->pub.elems_curr == p_hash->pub.elems_limit))) {
+        /* fixed capacity */
+        rc = ENOSPC;
+        goto exception;
+    }
+
+    /* Populate consumers node structure as read-only mode, linkage is
+     * cleared within the same store */
+    *p_node = (hash_node_t) { .pub = *p_input };
 
     /* Hash and insert node */
     idx = p_params->p_func(p_hash, p_node->pub.p_key);
@@ -725,12 +769,8 @@ hash_create_sanity( const adts_hash_create_t *p_op )
         goto exception;
     }
 
-    switch (opts) {
-        case ADTS_HASH_OPTS_NONE:           /**< fall through */
-        case ADTS_HASH_OPTS_DISABLE_RESIZE:
-            break;
-        default:
-            rc = EINVAL;
+    if (opts & ~(ADTS_HASH_OPTS_DISABLE_RESIZE | ADTS_HASH_OPTS_HUGEPAGE)) {
+        rc = EINVAL;
     }
 
 exception:
@@ -738,6 +778,47 @@ exception:
 } /* hash_create_sanity() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Nodes are consumer owned and not included.  Arena backed and embedded
+ *   tables report nothing, the arena or the caller holds the memory.
+ *
+ ****************************************************************************
+ */
+void
+adts_hash_mem_stats( const adts_hash_t *p_adts_hash,
+                     adts_mem_stats_t  *p_stats )
+{
+    hash_t *p_hash = (hash_t *) p_adts_hash;
+
+    *p_stats = p_hash->mem;
+
+    return;
+} /* adts_hash_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_hash_hugepage_bytes( const adts_hash_t *p_adts_hash )
+{
+    hash_t *p_hash = (hash_t *) p_adts_hash;
+    size_t  bytes  = p_hash->pub.elems_limit * sizeof(p_hash->workspace[0]);
+    size_t  huge   = 0;
+
+    if ((NULL == p_hash->p_arena) && (false == p_hash->embedded) &&
+        (ADTS_MEM_ALIGN_HUGEPAGE == hash_workspace_align(p_hash, bytes))) {
+        huge = adts_mem_hugepage_bytes(p_hash->workspace, bytes);
+    }
+
+    return huge;
+} /* adts_hash_hugepage_bytes() */
+
+
 /*
  ****************************************************************************
  *
@@ -896,24 +977,31 @@ adts_hash_find( adts_hash_t *p_adts_hash,
 void
 adts_hash_destroy( adts_hash_t *p_adts_hash )
 {
-    hash_t        *p_hash   = (hash_t *) p_adts_hash;
-    size_t         bytes    = 0;
-    adts_sanity_t *p_sanity = &(p_hash->sanity);
+    hash_t           *p_hash   = (hash_t *) p_adts_hash;
+    size_t            bytes    = 0;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_hash->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    /* clear the workspace memory, note that this take into accoung a hashtbl
-     * resize since we use the current elem count limit to determine the
-     * bytes of the workspace */
+    if (p_hash->p_arena || p_hash->embedded) {
+        /* O(1), arena memory is reclaimed on arena reset, embedded memory
+         * is caller owned */
+        goto exception;
+    }
+
+    /* the current elem count limit accounts for any resize, scrubbing is
+     * per the library policy, see adts_mem_scrub_set() */
     bytes = p_hash->pub.elems_limit * sizeof(p_hash->workspace[0]);
-    memset(p_hash->workspace, 0, bytes);
-    free(p_hash->workspace);
+    adts_mem_free_acct(&(p_hash->mem), p_hash->workspace, bytes,
+                       hash_workspace_align(p_hash, bytes));
 
-    /* Ensure proper cleanup to avoid false positives on accidental reuse */
+    /* the record is released along with the handle */
+    mem   = p_hash->mem;
     bytes = sizeof(*p_hash);
-    memset(p_hash, 0, bytes);
-    free(p_hash);
+    adts_mem_free_acct(&(mem), p_hash, bytes, ADTS_MEM_ALIGN_DEFAULT);
 
+exception:
     /* No adts_sanity_exit() since we've freed the memory */
 
     return;
@@ -925,14 +1013,17 @@ adts_hash_destroy( adts_hash_t *p_adts_hash )
  *
  ****************************************************************************
  */
-adts_hash_t *
-adts_hash_create( const adts_hash_create_t *p_op )
+static adts_hash_t *
+hash_create( const adts_hash_create_t *p_op,
+             adts_arena_t             *p_arena )
 {
-    hash_t       *p_hash      = NULL;
-    size_t        elems       = 0;
-    int32_t       rc          = 0;
-    hash_node_t  *p_elems     = NULL;
-    adts_hash_t  *p_adts_hash = NULL;
+    hash_t           *p_hash      = NULL;
+    size_t            elems       = 0;
+    size_t            bytes       = 0;
+    int32_t           rc          = 0;
+    hash_node_t      *p_elems     = NULL;
+    adts_hash_t      *p_adts_hash = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_HASH);
 
     assert(p_op);
     if (ADTS_HASH_OPTS_DISABLE_RESIZE & p_op->options) {
@@ -950,39 +1041,154 @@ adts_hash_create( const adts_hash_create_t *p_op )
         goto exception;
     }
 
-    p_adts_hash = adts_mem_zalloc(sizeof(*p_hash));
+    if (p_arena) {
+        p_adts_hash = adts_arena_zalloc(p_arena, sizeof(*p_hash));
+    }else {
+        p_adts_hash = adts_mem_zalloc_acct(&(mem), sizeof(*p_hash),
+                                           ADTS_MEM_ALIGN_DEFAULT);
+    }
     if (NULL == p_adts_hash) {
         rc = ENOMEM;
         goto exception;
     }
 
+    p_hash      = (hash_t *) p_adts_hash;
+    p_hash->mem = mem;
+    memcpy(&(p_hash->params), p_op, sizeof(*p_op));
 
-    p_elems = adts_mem_zalloc(elems * sizeof(p_hash->workspace[0]));
+    bytes = elems * sizeof(p_hash->workspace[0]);
+    if (p_arena) {
+        p_elems = adts_arena_zalloc(p_arena, bytes);
+    }else {
+        p_elems = adts_mem_zalloc_acct(&(p_hash->mem), bytes,
+                                       hash_workspace_align(p_hash, bytes));
+    }
     if (NULL == p_elems) {
         rc = ENOMEM;
         goto exception;
     }
 
-    p_hash = (hash_t *) p_adts_hash;
-    memcpy(&(p_hash->params), p_op, sizeof(*p_op));
-
     p_hash->workspace       = p_elems;
     p_hash->pub.elems_limit = elems;
+    p_hash->p_arena         = p_arena;
 
 exception:
     if (rc) {
-        if (p_elems) {
-            free(p_elems);
-			p_elems = NULL;
-        }
-
-        if (p_adts_hash) {
-            free(p_adts_hash);
-			p_adts_hash = NULL;
+        if (p_adts_hash && (NULL == p_arena)) {
+            /* arena memory is reclaimed on reset */
+            mem = p_hash->mem;
+            adts_mem_free_acct(&(mem), p_adts_hash, sizeof(*p_hash),
+                               ADTS_MEM_ALIGN_DEFAULT);
         }
+        p_hash = NULL;
     }
 
     return (adts_hash_t *) p_hash;
+} /* hash_create() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bytes required for an embedded table of the given number of slots.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_hash_embedded_bytes( size_t elems )
+{
+    return sizeof(adts_hash_t) + (elems * sizeof(hash_node_t *));
+} /* adts_hash_embedded_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The handle and table reside in the caller's memory and the allocator
+ *   is never called.  The slot count is the largest prime the memory
+ *   holds, available via pub.elems_limit to the consumer hash function.
+ *   The table never resizes and holds at most as many nodes as slots,
+ *   an insert once the entries reach the slot count returns ENOSPC such
+ *   that the load factor, thus expected lookup time, remains bounded.
+ *   Resize and huge page options are ignored.
+ *
+ *   p_mem must be 8B aligned and hold at least HASH_DEFAULT_ELEMS slots,
+ *   otherwise NULL.  Nodes remain consumer owned, destroy releases
+ *   nothing.
+ *
+ ****************************************************************************
+ */
+adts_hash_t *
+adts_hash_create_embedded( const adts_hash_create_t *p_op,
+                           void                     *p_mem,
+                           size_t                    bytes )
+{
+    size_t            elems       = 0;
+    hash_t           *p_hash      = NULL;
+    adts_hash_t      *p_adts_hash = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_HASH);
+
+    if ((NULL == p_op) || (NULL == p_mem) || ((uintptr_t) p_mem & 0x7) ||
+        (bytes < adts_hash_embedded_bytes(HASH_DEFAULT_ELEMS)) ||
+        hash_create_sanity(p_op)) {
+        goto exception;
+    }
+
+    /* largest prime slot count, searched downward from the limit */
+    elems = (bytes - sizeof(*p_adts_hash)) / sizeof(hash_node_t *);
+    while (adts_is_not_prime(elems)) {
+        elems--;
+    }
+
+    p_adts_hash = p_mem;
+    memset(p_adts_hash, 0, adts_hash_embedded_bytes(elems));
+
+    p_hash                  = (hash_t *) p_adts_hash;
+    p_hash->mem             = mem;
+    p_hash->embedded        = true;
+    p_hash->workspace       = (hash_node_t **) (p_adts_hash + 1);
+    p_hash->pub.elems_limit = elems;
+    memcpy(&(p_hash->params), p_op, sizeof(*p_op));
+    p_hash->params.options                   = ADTS_HASH_OPTS_DISABLE_RESIZE;
+    p_hash->params.opts.disable_resize.elems = elems;
+
+exception:
+    return p_adts_hash;
+} /* adts_hash_create_embedded() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The table, including any resized workspace, is sourced from the arena.
+ *   Destroy is O(1) and the memory is reclaimed on arena reset.  Nodes
+ *   remain consumer owned.
+ *
+ ****************************************************************************
+ */
+adts_hash_t *
+adts_hash_create_arena( const adts_hash_create_t *p_op,
+                        adts_arena_t             *p_arena )
+{
+    adts_hash_t *p_adts_hash = NULL;
+
+    if (p_arena) {
+        p_adts_hash = hash_create(p_op, p_arena);
+    }
+
+    return p_adts_hash;
+} /* adts_hash_create_arena() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_hash_t *
+adts_hash_create( const adts_hash_create_t *p_op )
+{
+    return hash_create(p_op, NULL);
 } /* adts_hash_create() */
 
 
@@ -1528,6 +1734,56 @@ utest_control( void )
     }
 
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: embedded, fixed capacity, no allocation");
+
+        int32_t                  rc     = 0;
+        size_t                   limit  = 0;
+        adts_hash_t             *p_hash = NULL;
+        adts_hash_create_t       op     = {0};
+        adts_hash_node_t         node[ 128 ];
+        adts_hash_node_public_t  input  = {0};
+        adts_mem_stats_t         before = {0};
+        adts_mem_stats_t         after  = {0};
+        uint64_t                 arr[ 128 ];
+
+        op.p_func = utest_hash_function;
+        assert(NULL == adts_hash_create_embedded(&op, arr, sizeof(adts_hash_t)));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_HASH, &(before));
+        p_hash = adts_hash_create_embedded(&op, arr, sizeof(arr));
+        assert(p_hash);
+
+        /* largest prime slot count which fits */
+        limit = p_hash->pub.elems_limit;
+        assert(adts_is_prime(limit));
+        assert(adts_hash_embedded_bytes(limit) <= sizeof(arr));
+        assert(limit <= (sizeof(node) / sizeof(node[0])));
+
+        /* keys collide once past the first lap */
+        for (uintptr_t idx = 0; idx < limit; idx++) {
+            input.p_key = (void *) (idx * 3);
+            rc = adts_hash_insert(p_hash, &(node[idx]), &(input));
+            assert(0 == rc);
+        }
+        input.p_key = (void *) -1;
+        assert(ENOSPC == adts_hash_insert(p_hash, &(node[0]), &(input)));
+        assert(0 == p_hash->pub.resize.grow);
+
+        for (uintptr_t idx = 0; idx < limit; idx++) {
+            assert(adts_hash_find(p_hash, (void *) (idx * 3)));
+        }
+        assert(0 == adts_hash_remove(p_hash, (void *) 0));
+        input.p_key = (void *) -1;
+        assert(0 == adts_hash_insert(p_hash, &(node[0]), &(input)));
+
+        adts_hash_destroy(p_hash);
+        adts_mem_stats_type(ADTS_MEM_TYPE_HASH, &(after));
+        assert(before.allocs == after.allocs);
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
     //test grow -> find
     //test shrink -> find
 
@@ -3,6 +3,8 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 #include <adts_snapshot.h>
 
 /**
@@ -11,7 +13,7 @@
  *
  *************************************************************************
  */
-#define ADTS_HASH_BYTES      (256)
+#define ADTS_HASH_BYTES      (512)
 #define ADTS_HASH_NODE_BYTES (64)
 
 
@@ -82,11 +84,15 @@ typedef struct {
  **************************************************************************
  * \details
  *   hash create options
+ *     - HUGEPAGE: place the workspace in huge page backed memory once it
+ *       spans a huge page, see adts_mem_align_hugepage().  Ignored for
+ *       arena backed tables.
  *
  **************************************************************************
  */
 #define ADTS_HASH_OPTS_NONE                (0) /**< Default */
 #define ADTS_HASH_OPTS_DISABLE_RESIZE (1 << 1)
+#define ADTS_HASH_OPTS_HUGEPAGE       (1 << 2)
 typedef uint64_t adts_hash_options_t;
 
 
@@ -98,6 +104,7 @@ typedef uint64_t adts_hash_options_t;
  **************************************************************************
  */
 typedef size_t hash_idx_t;
+struct hash_s;
 
 typedef struct {
     adts_hash_options_t  options;  /**< options bitfield */
@@ -169,6 +176,12 @@ typedef union {
  *
  **************************************************************************
  */
+void
+adts_hash_mem_stats( const adts_hash_t *p_adts_hash,
+                     adts_mem_stats_t  *p_stats );
+size_t
+adts_hash_hugepage_bytes( const adts_hash_t *p_adts_hash );
+
 bool
 adts_hash_is_empty( const adts_hash_t *p_adts_hash );
 
@@ -195,6 +208,18 @@ adts_hash_find( adts_hash_t *p_adts_hash,
 void
 adts_hash_destroy( adts_hash_t *p_adts_hash );
 
+size_t
+adts_hash_embedded_bytes( size_t elems );
+
+adts_hash_t *
+adts_hash_create_embedded( const adts_hash_create_t *p_op,
+                           void                     *p_mem,
+                           size_t                    bytes );
+
+adts_hash_t *
+adts_hash_create_arena( const adts_hash_create_t *p_op,
+                        adts_arena_t             *p_arena );
+
 adts_hash_t *
 adts_hash_create( const adts_hash_create_t *p_op );
 
@@ -1,13 +1,17 @@
 
+#include <stdio.h>
 #include <errno.h>
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_heap.h>
+#include <adts_time.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -42,8 +46,24 @@ typedef struct {
     void   *p_data; /**< consumer datapointer */
     size_t  bytes;  /**< data bytes for p_data */
     int64_t key;    /**< Key used to perform min or max heap ordering */
+    size_t  idx;    /**< workspace index, HEAP_IDX_NONE when not queued */
 } heap_node_t;
 
+#define HEAP_IDX_NONE (SIZE_MAX)
+
+/*
+ ****************************************************************************
+ * \details
+ *   d-ary workspace entry.  The key is duplicated from the node such that
+ *   sifting never dereferences consumer memory.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    int64_t      key;
+    heap_node_t *p_node;
+} heap_slot_t;
+
 
 /*
  ****************************************************************************
@@ -62,17 +82,49 @@ typedef struct {
 #define HEAP_DEFAULT_ELEMS (4096 / sizeof(void *))
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Radix heap.  Bucket b > 0 holds keys whose highest bit differing from
+ *   the last popped key is b - 1, bucket 0 holds keys equal to it.  Keys
+ *   are held inline, as the d-ary slots, such that redistribution never
+ *   reads consumer nodes.  Bucket capacity is retained until destroy.
+ *
+ ****************************************************************************
+ */
+#define HEAP_RADIX_BUCKETS    (65)
+#define HEAP_RADIX_MIN_ELEMS  (64)
+
+typedef struct {
+    heap_slot_t *p_slots;
+    size_t       elems;
+    size_t       limit;
+} heap_bucket_t;
+
+typedef struct {
+    uint64_t      last;  /**< last popped key, unsigned order */
+    uint64_t      mask;  /**< bit b - 1 set while bucket b is occupied */
+    heap_bucket_t bucket[ HEAP_RADIX_BUCKETS ];
+} heap_radix_t;
+
+
 /*
  ****************************************************************************
  *
  ****************************************************************************
  */
 typedef struct {
-    size_t            elems_curr;
-    size_t            elems_limit;
-    heap_node_t     **workspace;
-    adts_sanity_t     sanity;
-    adts_heap_type_t  type;
+    size_t               elems_curr;
+    size_t               elems_limit;
+    heap_node_t        **workspace; /**< allocation, binary layout */
+    heap_slot_t         *p_slots;   /**< d-ary layout, see heap_slots_set() */
+    size_t               arity;     /**< 0 for the binary layout */
+    heap_radix_t        *p_radix;   /**< ADTS_HEAP_RADIX only */
+    adts_sanity_t        sanity;
+    adts_heap_type_t     type;
+    adts_heap_options_t  options;
+    adts_mem_stats_t     mem;
+    bool                 embedded; /**< caller owns all memory */
 } heap_t;
 
 
@@ -89,6 +141,136 @@ typedef struct {
  * #        #####  #     #  #####     #      ###   ####### #     #  #####
 ******************************************************************************/
 
+/*
+ ****************************************************************************
+ * \details
+ *   Workspace alignment is derived from the options and size alone such
+ *   that the free path resolves the identical alignment.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+heap_workspace_align( heap_t *p_heap,
+                      size_t  bytes )
+{
+    size_t align = ADTS_MEM_ALIGN_DEFAULT;
+
+    if (ADTS_HEAP_OPTS_HUGEPAGE & p_heap->options) {
+        align = adts_mem_align_hugepage(bytes);
+    }
+
+    return align;
+} /* heap_workspace_align() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The d-ary workspace carries arity - 1 leading pad slots, see
+ *   heap_slots_set().
+ *
+ ****************************************************************************
+ */
+static inline size_t
+heap_workspace_bytes( heap_t *p_heap,
+                      size_t  elems )
+{
+    size_t bytes = elems * sizeof(p_heap->workspace[0]);
+
+    if (p_heap->arity) {
+        bytes = (elems + p_heap->arity - 1) * sizeof(heap_slot_t);
+    }
+
+    return bytes;
+} /* heap_workspace_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The children of slot i are d*i+1 .. d*i+d.  Offsetting the slot base by
+ *   arity - 1 places each sibling group on a multiple of arity, such that
+ *   with a cacheline aligned workspace the 4 children of a 4-ary parent
+ *   occupy exactly one cacheline.
+ *
+ ****************************************************************************
+ */
+static inline void
+heap_slots_set( heap_t *p_heap )
+{
+    if (p_heap->arity) {
+        p_heap->p_slots = (heap_slot_t *) p_heap->workspace;
+        p_heap->p_slots = p_heap->p_slots + (p_heap->arity - 1);
+    }
+
+    return;
+} /* heap_slots_set() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+heap_workspace_free( heap_t *p_heap )
+{
+    size_t bytes = heap_workspace_bytes(p_heap, p_heap->elems_limit);
+
+    adts_mem_free_acct(&(p_heap->mem), p_heap->workspace, bytes,
+                       heap_workspace_align(p_heap, bytes));
+
+    return;
+} /* heap_workspace_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Reallocate the workspace to limit_new elements, preserving the current
+ *   elements.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_resize_limit( heap_t *p_heap,
+                   size_t  limit_new )
+{
+    size_t         bytes     = 0;
+    int32_t        rc        = 0;
+    heap_node_t  **p_tmp     = NULL;
+
+    /* p_tmp used to handle error case and preserve the workspace */
+    bytes = heap_workspace_bytes(p_heap, limit_new);
+    p_tmp = adts_mem_zalloc_acct(&(p_heap->mem), bytes,
+                                 heap_workspace_align(p_heap, bytes));
+    if (NULL == p_tmp) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    /* copy _current_ elements into new workspace */
+    if (p_heap->arity) {
+        heap_slot_t *p_dst = ((heap_slot_t *) p_tmp) + (p_heap->arity - 1);
+
+        memcpy(p_dst, p_heap->p_slots,
+               p_heap->elems_curr * sizeof(p_heap->p_slots[0]));
+    } else {
+        memcpy(p_tmp, p_heap->workspace,
+               p_heap->elems_curr * sizeof(p_heap->workspace[0]));
+    }
+    heap_workspace_free(p_heap);
+
+    /* Set the new heap properties */
+    p_heap->workspace   = p_tmp;
+    p_heap->elems_limit = limit_new;
+    heap_slots_set(p_heap);
+
+exception:
+    return rc;
+} /* heap_resize_limit() */
+
+
 /*
  ****************************************************************************
  * \details
@@ -101,10 +283,7 @@ static int32_t
 heap_resize( heap_t           *p_heap,
              heap_resize_op_t  op )
 {
-    size_t        limit_new = p_heap->elems_limit;
-    size_t        bytes     = 0;
-    int32_t       rc        = 0;
-    heap_node_t *p_tmp      = NULL;
+    size_t limit_new = p_heap->elems_limit;
 
     switch (op) {
         case HEAP_GROW:
@@ -118,21 +297,50 @@ heap_resize( heap_t           *p_heap,
             assert(0);
     }
 
-    /* p_tmp used to handle error case and preserve the workspace */
-    bytes = limit_new * sizeof(p_heap->workspace[0]);
-    p_tmp = realloc(p_heap->workspace, bytes);
-    if (NULL == p_tmp) {
-        rc = ENOMEM;
+    return heap_resize_limit(p_heap, limit_new);
+} /* heap_resize() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Grow the workspace, in a single reallocation, to hold elems in total.
+ *   The limit stays on the doubling series of the default, consistent
+ *   with grow and shrink.  An embedded heap that cannot hold elems returns
+ *   ENOSPC.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_reserve( heap_t *p_heap,
+              size_t  elems )
+{
+    size_t  limit_new = p_heap->elems_limit;
+    int32_t rc        = 0;
+
+    if (elems <= p_heap->elems_limit) {
         goto exception;
     }
 
-    /* Set the new heap properties */
-    p_heap->workspace   = p_tmp;
-    p_heap->elems_limit = limit_new;
+    if (p_heap->embedded) {
+        /* fixed capacity */
+        rc = ENOSPC;
+        goto exception;
+    }
+
+    while (limit_new < elems) {
+        if (limit_new > (SIZE_MAX / 2)) {
+            rc = ENOMEM;
+            goto exception;
+        }
+        limit_new *= 2;
+    }
+
+    rc = heap_resize_limit(p_heap, limit_new);
 
 exception:
     return rc;
-} /* heap_resize() */
+} /* heap_reserve() */
 
 
 /*
@@ -148,7 +356,8 @@ heap_resize_shrink_candidate( heap_t *p_heap )
     bool   rc      = false;
     size_t trigger = 0;
 
-    if (HEAP_DEFAULT_ELEMS < p_heap->elems_limit) {
+    if ((false == p_heap->embedded) &&
+        (HEAP_DEFAULT_ELEMS < p_heap->elems_limit)) {
         /* - growth beyond the default,
          * - to avoid resize thrashing, only make resize candidacy when
          *   the utilization is 25% of current, such that after resizing
@@ -195,54 +404,253 @@ heap_node_swap_candidate( heap_t      *p_heap,
 
 /*
  ****************************************************************************
+ * \details
+ *   Every workspace store goes through a set or swap such that the node
+ *   tracks its index, see adts_heap_update_key().
+ *
+ ****************************************************************************
+ */
+static inline void
+heap_node_set( heap_t      *p_heap,
+               size_t       idx,
+               heap_node_t *p_node )
+{
+    p_heap->workspace[idx] = p_node;
+    p_node->idx            = idx;
+
+    return;
+} /* heap_node_set() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void
+heap_node_swap( heap_t *p_heap,
+                size_t  idxa,
+                size_t  idxb )
+{
+    heap_node_t *p_tmp = p_heap->workspace[idxa];
+
+    heap_node_set(p_heap, idxa, p_heap->workspace[idxb]);
+    heap_node_set(p_heap, idxb, p_tmp);
+
+    return;
+} /* heap_node_swap() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Min-max levels, the root level 0 is a min level and the levels
+ *   alternate from there.  A node on a min level is at or below every
+ *   descendant, on a max level at or above.
+ *
+ ****************************************************************************
+ */
+static inline bool
+heap_minmax_level_min( size_t idx )
+{
+    return (0 == ((63 - __builtin_clzll(idx + 1)) & 1));
+} /* heap_minmax_level_min() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   True when key a belongs above key b on the level of idx.
  *
+ ****************************************************************************
+ */
+static inline bool
+heap_minmax_above( size_t  idx,
+                   int64_t a,
+                   int64_t b )
+{
+    return heap_minmax_level_min(idx) ? (a < b) : (a > b);
+} /* heap_minmax_above() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sift the node at idx up through the grandparents of its own level
+ *   order.  The parent is checked once, as it orders the opposite way.
  *
  ****************************************************************************
  */
 static void
-heap_adjust_up( heap_t *p_heap )
+heap_minmax_adjust_up( heap_t *p_heap,
+                       size_t  idx )
 {
-    size_t       elems    = p_heap->elems_curr;
-    size_t       idx      = elems - 1;
-    heap_node_t *p_child  = NULL;
-    heap_node_t *p_parent = NULL;
+    size_t        parent    = 0;
+    size_t        gp        = 0;
+    heap_node_t **workspace = p_heap->workspace;
 
-    if (unlikely(1 >= elems)) {
-        /* Nothing to do here */
+    if (0 == idx) {
+        /* nothing to do here */
         goto exception;
     }
 
-    p_child  = p_heap->workspace[idx];
-    p_parent = p_heap->workspace[idx/2];
-    while ((1 <= idx) && heap_node_swap_candidate(p_heap, p_parent, p_child)) {
-        heap_node_t *p_tmp = NULL;
+    parent = (idx - 1) / 2;
+    if (heap_minmax_above(parent, workspace[idx]->key,
+                          workspace[parent]->key)) {
+        /* belongs to the parent level order */
+        heap_node_swap(p_heap, idx, parent);
+        idx = parent;
+    }
+
+    while (3 <= idx) {
+        gp = (((idx - 1) / 2) - 1) / 2;
+        if (!heap_minmax_above(idx, workspace[idx]->key, workspace[gp]->key)) {
+            break;
+        }
+
+        heap_node_swap(p_heap, idx, gp);
+        idx = gp;
+    }
+
+exception:
+    return;
+} /* heap_minmax_adjust_up() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sift the node at idx down.  The best of up to 2 children and 4
+ *   grandchildren, by the level order of idx, is moved up.  A node moved
+ *   down to a grandchild may then belong above its new parent.
+ *
+ ****************************************************************************
+ */
+static void
+heap_minmax_adjust_down( heap_t *p_heap,
+                         size_t  idx )
+{
+    size_t        best      = 0;
+    size_t        parent    = 0;
+    const size_t  elems     = p_heap->elems_curr;
+    heap_node_t **workspace = p_heap->workspace;
+
+    for (;;) {
+        const size_t child = (idx * 2) + 1;
+        const size_t grand = (child * 2) + 1;
+
+        if (child >= elems) {
+            break;
+        }
+
+        best = child;
+        if ((child + 1 < elems) &&
+            heap_minmax_above(idx, workspace[child + 1]->key,
+                              workspace[best]->key)) {
+            best = child + 1;
+        }
+        for (size_t g = grand; (g < grand + 4) && (g < elems); g++) {
+            if (heap_minmax_above(idx, workspace[g]->key,
+                                  workspace[best]->key)) {
+                best = g;
+            }
+        }
+
+        if (!heap_minmax_above(idx, workspace[best]->key,
+                               workspace[idx]->key)) {
+            /* heap property restored */
+            break;
+        }
+
+        heap_node_swap(p_heap, idx, best);
+        if (best < grand) {
+            /* child, the bottom of this subtree */
+            break;
+        }
+
+        parent = (best - 1) / 2;
+        if (heap_minmax_above(parent, workspace[best]->key,
+                              workspace[parent]->key)) {
+            heap_node_swap(p_heap, best, parent);
+        }
+        idx = best;
+    }
+
+    return;
+} /* heap_minmax_adjust_down() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Index of the max, one of the two max level children of the root.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+heap_minmax_max_idx( heap_t *p_heap )
+{
+    size_t        idx       = 0;
+    heap_node_t **workspace = p_heap->workspace;
+
+    if (2 == p_heap->elems_curr) {
+        idx = 1;
+    } else if (2 < p_heap->elems_curr) {
+        idx = (workspace[1]->key >= workspace[2]->key) ? 1 : 2;
+    }
+
+    return idx;
+} /* heap_minmax_max_idx() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sift the node at idx up, idx is the last element for a push.
+ *
+ ****************************************************************************
+ */
+static void
+heap_adjust_up( heap_t *p_heap,
+                size_t  idx )
+{
+    size_t parent = 0;
+
+    if (ADTS_HEAP_MINMAX == p_heap->type) {
+        heap_minmax_adjust_up(p_heap, idx);
+        return;
+    }
+
+    while (1 <= idx) {
+        parent = (idx - 1) / 2;
+        if (!heap_node_swap_candidate(p_heap, p_heap->workspace[parent],
+                                      p_heap->workspace[idx])) {
+            break;
+        }
 
         /* swap parent and child array entries */
-        p_tmp                    = p_heap->workspace[idx];
-        p_heap->workspace[idx]   = p_heap->workspace[idx/2];
-        p_heap->workspace[idx/2] = p_tmp;
+        heap_node_swap(p_heap, idx, parent);
 
         /* Get index of next parent and child to compare */
-        idx     /= 2;
-        p_child  = p_heap->workspace[idx];
-        p_parent = p_heap->workspace[idx/2];
+        idx = parent;
     }
 
-exception:
     return;
 } /* heap_adjust_up() */
 
 
 /*
  ****************************************************************************
- *
+ * \details
+ *   Sift the node at idx down, idx is 0 for a pop and each internal node
+ *   for a bottom-up heapify.
  *
  ****************************************************************************
  */
 static void
-heap_adjust_down( heap_t *p_heap )
+heap_adjust_down( heap_t *p_heap,
+                  size_t  idx )
 {
-    size_t           idx   = 0;
     int32_t          rc    = 0;
     const size_t     elems = p_heap->elems_curr;
     adts_heap_type_t op    = p_heap->type;
@@ -252,9 +660,13 @@ heap_adjust_down( heap_t *p_heap )
         goto exception;
     }
 
+    if (ADTS_HEAP_MINMAX == op) {
+        heap_minmax_adjust_down(p_heap, idx);
+        goto exception;
+    }
+
     for (;;) {
         size_t        idxc     = 0;      /* child index */
-        heap_node_t  *p_tmp    = NULL;
         heap_node_t  *p_left   = NULL;
         heap_node_t  *p_right  = NULL;
         const size_t  left     = (idx * 2) + 1;
@@ -279,10 +691,14 @@ heap_adjust_down( heap_t *p_heap )
             goto exception;
         }
 
+        if (!heap_node_swap_candidate(p_heap, p_heap->workspace[idx],
+                                      p_heap->workspace[idxc])) {
+            /* heap property restored */
+            goto exception;
+        }
+
         /* swap parent and child array entries */
-        p_tmp                   = p_heap->workspace[idx];
-        p_heap->workspace[idx]  = p_heap->workspace[idxc];
-        p_heap->workspace[idxc] = p_tmp;
+        heap_node_swap(p_heap, idx, idxc);
 
         idx = idxc;
     }
@@ -294,28 +710,1201 @@ exception:
 
 /*
  ****************************************************************************
+ * \details
+ *   True when key a belongs above key b.
  *
  ****************************************************************************
  */
-bool
-adts_heap_is_empty( adts_heap_t *p_adts_heap )
+static inline bool
+heap_slot_above( const heap_t *p_heap,
+                 int64_t       a,
+                 int64_t       b )
 {
-    heap_t *p_heap = (heap_t *) p_adts_heap;
-
-    return (0 >= p_heap->elems_curr);
-} /* adts_heap_is_empty() */
+    return (ADTS_HEAP_MAX == p_heap->type) ? (a > b) : (a < b);
+} /* heap_slot_above() */
 
 
 /*
  ****************************************************************************
+ * \details
+ *   The index store is a write to the node, comparisons still never read
+ *   consumer memory.
  *
  ****************************************************************************
  */
-bool
-adts_heap_is_not_empty( adts_heap_t *p_adts_heap )
+static inline void
+heap_slot_set( heap_t      *p_heap,
+               size_t       idx,
+               heap_slot_t  slot )
 {
-    return !(adts_heap_is_empty(p_adts_heap));
-} /* adts_heap_is_not_empty() */
+    p_heap->p_slots[idx] = slot;
+    slot.p_node->idx     = idx;
+
+    return;
+} /* heap_slot_set() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Hole based sift up, parents are moved down into the hole and the slot
+ *   is written once at its final position.
+ *
+ ****************************************************************************
+ */
+static void
+heap_slot_sift_up( heap_t      *p_heap,
+                   size_t       idx,
+                   heap_slot_t  slot )
+{
+    size_t       parent  = 0;
+    const size_t arity   = p_heap->arity;
+    heap_slot_t *p_slots = p_heap->p_slots;
+
+    while (0 < idx) {
+        parent = (idx - 1) / arity;
+        if (!heap_slot_above(p_heap, slot.key, p_slots[parent].key)) {
+            break;
+        }
+
+        heap_slot_set(p_heap, idx, p_slots[parent]);
+        idx = parent;
+    }
+    heap_slot_set(p_heap, idx, slot);
+
+    return;
+} /* heap_slot_sift_up() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Hole based sift down, the best of up to arity children is moved up
+ *   into the hole.  The sibling keys are contiguous, a single cacheline
+ *   for the default arity.
+ *
+ ****************************************************************************
+ */
+static void
+heap_slot_sift_down( heap_t      *p_heap,
+                     size_t       idx,
+                     heap_slot_t  slot )
+{
+    size_t       first   = 0;
+    size_t       last    = 0;
+    size_t       best    = 0;
+    const size_t arity   = p_heap->arity;
+    const size_t elems   = p_heap->elems_curr;
+    heap_slot_t *p_slots = p_heap->p_slots;
+
+    for (;;) {
+        first = (idx * arity) + 1;
+        if (first >= elems) {
+            break;
+        }
+
+        last = first + arity;
+        last = (last < elems) ? last : elems;
+        best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (heap_slot_above(p_heap, p_slots[c].key, p_slots[best].key)) {
+                best = c;
+            }
+        }
+
+        if (!heap_slot_above(p_heap, p_slots[best].key, slot.key)) {
+            break;
+        }
+
+        heap_slot_set(p_heap, idx, p_slots[best]);
+        idx = best;
+    }
+    heap_slot_set(p_heap, idx, slot);
+
+    return;
+} /* heap_slot_sift_down() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bottom-up heapify, O(n).  Each parent is sifted down, starting from
+ *   the parent of the last element.
+ *
+ ****************************************************************************
+ */
+static void
+heap_heapify( heap_t *p_heap )
+{
+    size_t       idx   = 0;
+    const size_t elems = p_heap->elems_curr;
+
+    if (2 > elems) {
+        /* nothing to do here */
+        goto exception;
+    }
+
+    if (p_heap->arity) {
+        idx = ((elems - 2) / p_heap->arity) + 1;
+        while (idx--) {
+            heap_slot_sift_down(p_heap, idx, p_heap->p_slots[idx]);
+        }
+    } else {
+        idx = elems / 2;
+        while (idx--) {
+            heap_adjust_down(p_heap, idx);
+        }
+    }
+
+exception:
+    return;
+} /* heap_heapify() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Restore order once the entry at idx replaced key old, toward the root
+ *   when it now belongs above old and toward the leaves otherwise.
+ *
+ ****************************************************************************
+ */
+static void
+heap_reposition( heap_t  *p_heap,
+                 size_t   idx,
+                 int64_t  old )
+{
+    if (p_heap->arity) {
+        heap_slot_t slot = p_heap->p_slots[idx];
+
+        if (heap_slot_above(p_heap, slot.key, old)) {
+            heap_slot_sift_up(p_heap, idx, slot);
+        } else {
+            heap_slot_sift_down(p_heap, idx, slot);
+        }
+    } else if (ADTS_HEAP_MINMAX == p_heap->type) {
+        /* either level order may be violated, down settles the subtree
+         * and up the ancestors from wherever the node lands */
+        heap_node_t *p_node = p_heap->workspace[idx];
+
+        heap_adjust_down(p_heap, idx);
+        heap_adjust_up(p_heap, p_node->idx);
+    } else {
+        if (heap_slot_above(p_heap, p_heap->workspace[idx]->key, old)) {
+            heap_adjust_up(p_heap, idx);
+        } else {
+            heap_adjust_down(p_heap, idx);
+        }
+    }
+
+    return;
+} /* heap_reposition() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The node index is only trusted once the workspace confirms it, a
+ *   popped, removed or foreign node fails.
+ *
+ ****************************************************************************
+ */
+static inline bool
+heap_node_queued( heap_t      *p_heap,
+                  heap_node_t *p_node )
+{
+    size_t       idx     = p_node->idx;
+    heap_node_t *p_entry = NULL;
+
+    if ((p_heap->p_radix) || (idx >= p_heap->elems_curr)) {
+        /* radix heap nodes are never indexed */
+        return false;
+    }
+
+    p_entry = p_heap->arity ? p_heap->p_slots[idx].p_node :
+                              p_heap->workspace[idx];
+
+    return (p_entry == p_node);
+} /* heap_node_queued() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Keys are signed, the radix heap orders them as unsigned with the sign
+ *   bit flipped.
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+heap_radix_key( int64_t key )
+{
+    return ((uint64_t) key) ^ (1ULL << 63);
+} /* heap_radix_key() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline size_t
+heap_radix_bucket( const heap_radix_t *p_radix,
+                   uint64_t            key )
+{
+    uint64_t diff = key ^ p_radix->last;
+
+    return diff ? (size_t) (64 - __builtin_clzll(diff)) : 0;
+} /* heap_radix_bucket() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Grow a bucket, by doubling, to hold elems in total.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_bucket_grow( heap_t        *p_heap,
+                  heap_bucket_t *p_bucket,
+                  size_t         elems )
+{
+    int32_t      rc    = 0;
+    size_t       limit = 0;
+    heap_slot_t *p_tmp = NULL;
+
+    if (elems <= p_bucket->limit) {
+        goto exception;
+    }
+
+    limit = p_bucket->limit ? p_bucket->limit : HEAP_RADIX_MIN_ELEMS;
+    while (limit < elems) {
+        limit *= 2;
+    }
+
+    p_tmp = adts_mem_zalloc_acct(&(p_heap->mem), limit * sizeof(*p_tmp),
+                                 ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_tmp) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    if (p_bucket->p_slots) {
+        memcpy(p_tmp, p_bucket->p_slots, p_bucket->elems * sizeof(*p_tmp));
+        adts_mem_free_acct(&(p_heap->mem), p_bucket->p_slots,
+                           p_bucket->limit * sizeof(*p_tmp),
+                           ADTS_MEM_ALIGN_DEFAULT);
+    }
+    p_bucket->p_slots = p_tmp;
+    p_bucket->limit   = limit;
+
+exception:
+    return rc;
+} /* heap_bucket_grow() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Grow every bucket to hold counts[b] additional slots, such that the
+ *   appends which follow cannot fail.  Growth already made is harmless
+ *   when a later bucket fails.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_radix_reserve( heap_t       *p_heap,
+                    const size_t  counts[] )
+{
+    int32_t        rc       = 0;
+    heap_bucket_t *p_bucket = NULL;
+
+    for (size_t b = 0; b < HEAP_RADIX_BUCKETS; b++) {
+        p_bucket = &(p_heap->p_radix->bucket[b]);
+        rc       = heap_bucket_grow(p_heap, p_bucket,
+                                    p_bucket->elems + counts[b]);
+        if (rc) {
+            goto exception;
+        }
+    }
+
+exception:
+    return rc;
+} /* heap_radix_reserve() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Capacity is reserved by the caller.
+ *
+ ****************************************************************************
+ */
+static inline void
+heap_radix_append( heap_radix_t *p_radix,
+                   size_t        b,
+                   heap_slot_t   slot )
+{
+    heap_bucket_t *p_bucket = &(p_radix->bucket[b]);
+
+    p_bucket->p_slots[p_bucket->elems++] = slot;
+    if (b) {
+        p_radix->mask |= (1ULL << (b - 1));
+    }
+
+    return;
+} /* heap_radix_append() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Once bucket 0 drains, the lowest occupied bucket is redistributed
+ *   relative to its minimum, which becomes the last key.  Every slot lands
+ *   in a lower bucket, the minimum in bucket 0.  Each key moves at most 64
+ *   times over its lifetime, hence O(1) amortized per operation.  ENOMEM
+ *   leaves the heap unchanged.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_radix_settle( heap_t *p_heap )
+{
+    size_t         b              = 0;
+    int32_t        rc             = 0;
+    uint64_t       min            = UINT64_MAX;
+    uint64_t       last           = 0;
+    heap_radix_t  *p_radix        = p_heap->p_radix;
+    heap_bucket_t *p_bucket       = NULL;
+    size_t         counts[ HEAP_RADIX_BUCKETS ] = {0};
+
+    if ((p_radix->bucket[0].elems) || (0 == p_heap->elems_curr)) {
+        goto exception;
+    }
+
+    b        = (size_t) __builtin_ctzll(p_radix->mask) + 1;
+    p_bucket = &(p_radix->bucket[b]);
+    for (size_t i = 0; i < p_bucket->elems; i++) {
+        uint64_t key = heap_radix_key(p_bucket->p_slots[i].key);
+
+        min = (key < min) ? key : min;
+    }
+
+    /* count against the new last, commit only once reserved */
+    last          = p_radix->last;
+    p_radix->last = min;
+    for (size_t i = 0; i < p_bucket->elems; i++) {
+        uint64_t key = heap_radix_key(p_bucket->p_slots[i].key);
+
+        counts[heap_radix_bucket(p_radix, key)]++;
+    }
+    rc = heap_radix_reserve(p_heap, counts);
+    if (rc) {
+        p_radix->last = last;
+        goto exception;
+    }
+
+    for (size_t i = 0; i < p_bucket->elems; i++) {
+        heap_slot_t slot = p_bucket->p_slots[i];
+
+        heap_radix_append(p_radix,
+                          heap_radix_bucket(p_radix, heap_radix_key(slot.key)),
+                          slot);
+    }
+    p_bucket->elems = 0;
+    p_radix->mask  &= ~(1ULL << (b - 1));
+
+exception:
+    return rc;
+} /* heap_radix_settle() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   A key below the last popped key returns EINVAL, as does any key of a
+ *   batch.  Nothing is inserted on error.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_radix_insert_n( heap_t        *p_heap,
+                     heap_node_t   *p_nodes[],
+                     const int64_t  keys[],
+                     size_t         elems )
+{
+    int32_t       rc      = 0;
+    uint64_t      key     = 0;
+    heap_radix_t *p_radix = p_heap->p_radix;
+    size_t        counts[ HEAP_RADIX_BUCKETS ] = {0};
+
+    for (size_t i = 0; i < elems; i++) {
+        key = heap_radix_key(keys[i]);
+        if (key < p_radix->last) {
+            rc = EINVAL;
+            goto exception;
+        }
+        counts[heap_radix_bucket(p_radix, key)]++;
+    }
+
+    rc = heap_radix_reserve(p_heap, counts);
+    if (rc) {
+        goto exception;
+    }
+
+    for (size_t i = 0; i < elems; i++) {
+        heap_slot_t slot = { .key = keys[i], .p_node = p_nodes[i] };
+
+        assert(p_nodes[i]);
+        p_nodes[i]->p_data = NULL;
+        p_nodes[i]->bytes  = 0;
+        p_nodes[i]->key    = keys[i];
+        p_nodes[i]->idx    = HEAP_IDX_NONE;
+        heap_radix_append(p_radix,
+                          heap_radix_bucket(p_radix, heap_radix_key(keys[i])),
+                          slot);
+    }
+    p_heap->elems_curr += elems;
+
+exception:
+    return rc;
+} /* heap_radix_insert_n() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_radix_push( heap_t      *p_heap,
+                 heap_node_t *p_node,
+                 int64_t      key )
+{
+    size_t        b       = 0;
+    int32_t       rc      = 0;
+    heap_slot_t   slot    = { .key = key, .p_node = p_node };
+    heap_radix_t *p_radix = p_heap->p_radix;
+
+    if (heap_radix_key(key) < p_radix->last) {
+        /* not monotone */
+        rc = EINVAL;
+        goto exception;
+    }
+
+    b  = heap_radix_bucket(p_radix, heap_radix_key(key));
+    rc = heap_bucket_grow(p_heap, &(p_radix->bucket[b]),
+                          p_radix->bucket[b].elems + 1);
+    if (rc) {
+        goto exception;
+    }
+
+    p_node->key = key;
+    p_node->idx = HEAP_IDX_NONE;
+    heap_radix_append(p_radix, b, slot);
+    p_heap->elems_curr++;
+
+exception:
+    return rc;
+} /* heap_radix_push() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   ENOMEM while settling is reported as empty, the next pop retries.
+ *
+ ****************************************************************************
+ */
+static heap_node_t *
+heap_radix_pop( heap_t *p_heap,
+                bool    remove )
+{
+    heap_node_t   *p_node   = NULL;
+    heap_bucket_t *p_bucket = &(p_heap->p_radix->bucket[0]);
+
+    if ((0 == p_heap->elems_curr) || heap_radix_settle(p_heap)) {
+        goto exception;
+    }
+
+    p_node = p_bucket->p_slots[p_bucket->elems - 1].p_node;
+    if (remove) {
+        p_bucket->elems--;
+        p_heap->elems_curr--;
+    }
+
+exception:
+    return p_node;
+} /* heap_radix_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+heap_radix_free( heap_t *p_heap )
+{
+    heap_bucket_t *p_bucket = NULL;
+
+    for (size_t b = 0; b < HEAP_RADIX_BUCKETS; b++) {
+        p_bucket = &(p_heap->p_radix->bucket[b]);
+        if (p_bucket->p_slots) {
+            adts_mem_free_acct(&(p_heap->mem), p_bucket->p_slots,
+                               p_bucket->limit * sizeof(heap_slot_t),
+                               ADTS_MEM_ALIGN_DEFAULT);
+        }
+    }
+    adts_mem_free_acct(&(p_heap->mem), p_heap->p_radix,
+                       sizeof(*(p_heap->p_radix)), ADTS_MEM_ALIGN_DEFAULT);
+    p_heap->p_radix = NULL;
+
+    return;
+} /* heap_radix_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Remove the entry at idx of a binary or d-ary workspace.  The last
+ *   entry fills the vacated index and is sifted from there.
+ *
+ ****************************************************************************
+ */
+static heap_node_t *
+heap_remove_idx( heap_t *p_heap,
+                 size_t  idx )
+{
+    size_t       last   = 0;
+    heap_node_t *p_node = NULL;
+
+    if (heap_resize_shrink_candidate(p_heap)) {
+        /* Do not error out.  Try again on next removal */
+        (void) heap_resize(p_heap, HEAP_SHRINK);
+    }
+
+    p_node = p_heap->arity ? p_heap->p_slots[idx].p_node :
+                             p_heap->workspace[idx];
+    last   = p_heap->elems_curr - 1;
+    p_heap->elems_curr--;
+
+    if (idx != last) {
+        if (p_heap->arity) {
+            heap_slot_set(p_heap, idx, p_heap->p_slots[last]);
+        } else {
+            heap_node_set(p_heap, idx, p_heap->workspace[last]);
+        }
+        heap_reposition(p_heap, idx, p_node->key);
+    }
+    p_node->idx = HEAP_IDX_NONE;
+
+    return p_node;
+} /* heap_remove_idx() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Append elems nodes after a single workspace reservation.  A heapify
+ *   costs O(curr + elems) against O(elems log(curr + elems)) for per node
+ *   sift ups, thus the heap is rebuilt once the batch is at least as
+ *   large as the heap it joins.  Nothing is inserted on error.
+ *
+ ****************************************************************************
+ */
+static int32_t
+heap_insert_n( heap_t            *p_heap,
+               adts_heap_node_t  *p_nodes[],
+               const int64_t      keys[],
+               size_t             elems )
+{
+    size_t       idx    = 0;
+    int32_t      rc     = 0;
+    bool         bulk   = false;
+    heap_node_t *p_node = NULL;
+
+    if (elems > (SIZE_MAX - p_heap->elems_curr)) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    if (p_heap->p_radix) {
+        rc = heap_radix_insert_n(p_heap, (heap_node_t **) p_nodes, keys,
+                                 elems);
+        goto exception;
+    }
+
+    rc = heap_reserve(p_heap, p_heap->elems_curr + elems);
+    if (rc) {
+        goto exception;
+    }
+
+    bulk = (elems >= p_heap->elems_curr);
+    for (size_t i = 0; i < elems; i++) {
+        p_node = (heap_node_t *) p_nodes[i];
+        assert(p_node);
+
+        p_node->p_data = NULL;
+        p_node->bytes  = 0;
+        p_node->key    = keys[i];
+
+        idx = p_heap->elems_curr++;
+        if (p_heap->arity) {
+            heap_slot_t slot = { .key = keys[i], .p_node = p_node };
+
+            if (bulk) {
+                heap_slot_set(p_heap, idx, slot);
+            } else {
+                heap_slot_sift_up(p_heap, idx, slot);
+            }
+        } else {
+            heap_node_set(p_heap, idx, p_node);
+            if (false == bulk) {
+                heap_adjust_up(p_heap, idx);
+            }
+        }
+    }
+
+    if (bulk) {
+        heap_heapify(p_heap);
+    }
+
+exception:
+    return rc;
+} /* heap_insert_n() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_heap_is_empty( adts_heap_t *p_adts_heap )
+{
+    heap_t *p_heap = (heap_t *) p_adts_heap;
+
+    return (0 >= p_heap->elems_curr);
+} /* adts_heap_is_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_heap_is_not_empty( adts_heap_t *p_adts_heap )
+{
+    return !(adts_heap_is_empty(p_adts_heap));
+} /* adts_heap_is_not_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_heap_entries( adts_heap_t *p_adts_heap )
+{
+    heap_t *p_heap = (heap_t *) p_adts_heap;
+
+    return p_heap->elems_curr;
+} /* adts_heap_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_heap_display( adts_heap_t *p_adts_heap )
+{
+    size_t         elems    = 0;
+    size_t         digits   = 0;
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* display the entire heap with dynamic width formatting */
+    elems  = p_heap->elems_curr;
+    digits = adts_digits_decimal(elems);
+
+    if (p_heap->p_radix) {
+        heap_bucket_t *p_bucket = NULL;
+
+        printf("last: 0x%016llx\n", p_heap->p_radix->last);
+        for (size_t b = 0; b < HEAP_RADIX_BUCKETS; b++) {
+            p_bucket = &(p_heap->p_radix->bucket[b]);
+            for (size_t idx = 0; idx < p_bucket->elems; idx++) {
+                heap_node_t *p_node = p_bucket->p_slots[idx].p_node;
+
+                printf("[%2zu:%*zu]  node: %p  key: 0x%016llx %-lld \n",
+                        b, digits, idx, p_node, p_node->key, p_node->key);
+            }
+        }
+        goto exception;
+    }
+
+    /* The heap implementation uses an array representation of a binary tree
+     * therefore we simply perform a display / decode of each entry as array
+     * format.  Alternately we can perform a BFS display as future extension */
+    for (size_t idx = 0; idx < elems; idx++) {
+        heap_node_t *p_node = NULL;
+
+        p_node = p_heap->arity ? p_heap->p_slots[idx].p_node :
+                                 p_heap->workspace[idx];
+        printf("[%*d]  node: %p  vaddr: %p  bytes: %d  key: 0x%016llx %-lld \n",
+                digits,
+                idx,
+                p_node,
+                p_node->p_data,
+                p_node->bytes,
+                p_node->key,
+                p_node->key );
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_heap_display() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_peek( adts_heap_t *p_adts_heap )
+{
+    heap_t      *p_heap = (heap_t *) p_adts_heap;
+    heap_node_t *p_node = NULL;
+
+    if (unlikely(0 >= p_heap->elems_curr)) {
+        /* empty heap */
+        goto exception;
+    }
+
+    if (p_heap->p_radix) {
+        /* settles bucket 0, order is unchanged */
+        p_node = heap_radix_pop(p_heap, false);
+        goto exception;
+    }
+
+    p_node = p_heap->arity ? p_heap->p_slots[0].p_node : p_heap->workspace[0];
+
+exception:
+    return (adts_heap_node_t *) p_node;
+} /* adts_heap_peek() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Key of a queued or popped node.
+ *
+ ****************************************************************************
+ */
+int64_t
+adts_heap_node_key( const adts_heap_node_t *p_adts_node_heap )
+{
+    const heap_node_t *p_node = (const heap_node_t *) p_adts_node_heap;
+
+    return p_node->key;
+} /* adts_heap_node_key() */
+
+
+/*
+ ****************************************************************************
+ *
+ *  FIXME: Add resize shrink capability
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_pop( adts_heap_t *p_adts_heap )
+{
+    size_t         idx      = 0;
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    heap_node_t   *p_node   = NULL;
+    const size_t   elems    = p_heap->elems_curr;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(0 >= elems)) {
+        /* empty heap */
+        goto exception;
+    }
+
+    if (p_heap->p_radix) {
+        p_node = heap_radix_pop(p_heap, true);
+        goto exception;
+    }
+
+    if (heap_resize_shrink_candidate(p_heap)) {
+        /* Do not error out.  Try again on next pop operation */
+        (void) heap_resize(p_heap, HEAP_SHRINK);
+    }
+
+    idx = elems - 1;
+    if (p_heap->arity) {
+        /* Pop root, and sift the last slot down from the root hole */
+        p_node = p_heap->p_slots[0].p_node;
+        p_heap->elems_curr--;
+        if (idx) {
+            heap_slot_sift_down(p_heap, 0, p_heap->p_slots[idx]);
+        }
+        p_node->idx = HEAP_IDX_NONE;
+        goto exception;
+    }
+
+    /* Pop root from tree, and overwrite root with last node in tree */
+    p_node = p_heap->workspace[0];
+    heap_node_set(p_heap, 0, p_heap->workspace[idx]);
+
+    p_heap->elems_curr--;
+
+    heap_adjust_down(p_heap, 0);
+    p_node->idx = HEAP_IDX_NONE;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return p_node;
+} /* adts_heap_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_heap_push( adts_heap_t       *p_adts_heap,
+                adts_heap_node_t  *p_adts_node_heap,
+                void              *p_data,
+                size_t             bytes,
+                int64_t            key )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    size_t         idx      = 0;
+    int32_t        rc       = 0;
+    heap_node_t   *p_node   = (heap_node_t *) p_adts_node_heap;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* Key not validated. Duplicates and 0 value allowed */
+    assert(p_node);
+    assert(p_data);
+    assert(bytes);
+
+    if (p_heap->p_radix) {
+        rc = heap_radix_push(p_heap, p_node, key);
+        if (0 == rc) {
+            p_node->p_data = p_data;
+            p_node->bytes  = bytes;
+        }
+        goto exception;
+    }
+
+    if (unlikely(p_heap->elems_curr == p_heap->elems_limit)) {
+        if (p_heap->embedded) {
+            /* fixed capacity */
+            rc = ENOSPC;
+            goto exception;
+        }
+
+        /* Full, perform dynamic resize operation */
+        rc = heap_resize(p_heap, HEAP_GROW);
+        if (rc) {
+            goto exception;
+        }
+    }
+
+    /* Populate the consumers node structure */
+    p_node->p_data = p_data;
+    p_node->bytes  = bytes;
+    p_node->key    = key;
+
+    idx = p_heap->elems_curr;
+    if (p_heap->arity) {
+        heap_slot_t slot = { .key = key, .p_node = p_node };
+
+        /* Sift up from a hole at the end of array */
+        p_heap->elems_curr++;
+        heap_slot_sift_up(p_heap, idx, slot);
+        goto exception;
+    }
+
+    /* Insert this node at end of array */
+    heap_node_set(p_heap, idx, p_node);
+
+    p_heap->elems_curr++;
+
+    heap_adjust_up(p_heap, idx);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_heap_push() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_peek_min( adts_heap_t *p_adts_heap )
+{
+    heap_t *p_heap = (heap_t *) p_adts_heap;
+
+    if (ADTS_HEAP_MAX == p_heap->type) {
+        /* single-ended, opposite end */
+        return NULL;
+    }
+
+    return adts_heap_peek(p_adts_heap);
+} /* adts_heap_peek_min() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_peek_max( adts_heap_t *p_adts_heap )
+{
+    heap_t      *p_heap = (heap_t *) p_adts_heap;
+    heap_node_t *p_node = NULL;
+
+    if (ADTS_HEAP_MAX == p_heap->type) {
+        p_node = (heap_node_t *) adts_heap_peek(p_adts_heap);
+        goto exception;
+    }
+
+    if ((ADTS_HEAP_MINMAX != p_heap->type) ||
+        unlikely(0 >= p_heap->elems_curr)) {
+        /* single-ended opposite end, or empty heap */
+        goto exception;
+    }
+
+    p_node = p_heap->workspace[heap_minmax_max_idx(p_heap)];
+
+exception:
+    return (adts_heap_node_t *) p_node;
+} /* adts_heap_peek_max() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_pop_min( adts_heap_t *p_adts_heap )
+{
+    heap_t *p_heap = (heap_t *) p_adts_heap;
+
+    if (ADTS_HEAP_MAX == p_heap->type) {
+        /* single-ended, opposite end */
+        return NULL;
+    }
+
+    return adts_heap_pop(p_adts_heap);
+} /* adts_heap_pop_min() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The max is one of the two children of the root and is removed as any
+ *   other indexed entry.
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_pop_max( adts_heap_t *p_adts_heap )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    heap_node_t   *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    if (ADTS_HEAP_MAX == p_heap->type) {
+        return adts_heap_pop(p_adts_heap);
+    }
+
+    adts_sanity_entry(p_sanity);
+
+    if ((ADTS_HEAP_MINMAX != p_heap->type) ||
+        unlikely(0 >= p_heap->elems_curr)) {
+        /* single-ended opposite end, or empty heap */
+        goto exception;
+    }
+
+    p_node = heap_remove_idx(p_heap, heap_minmax_max_idx(p_heap));
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return (adts_heap_node_t *) p_node;
+} /* adts_heap_pop_max() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_heap_update_key( adts_heap_t      *p_adts_heap,
+                      adts_heap_node_t *p_adts_node_heap,
+                      int64_t           key )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    int64_t        old      = 0;
+    int32_t        rc       = 0;
+    heap_node_t   *p_node   = (heap_node_t *) p_adts_node_heap;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((NULL == p_node) || (false == heap_node_queued(p_heap, p_node))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    old         = p_node->key;
+    p_node->key = key;
+    if (p_heap->arity) {
+        p_heap->p_slots[p_node->idx].key = key;
+    }
+
+    heap_reposition(p_heap, p_node->idx, old);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_heap_update_key() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_heap_remove_node( adts_heap_t      *p_adts_heap,
+                       adts_heap_node_t *p_adts_node_heap )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    int32_t        rc       = 0;
+    heap_node_t   *p_node   = (heap_node_t *) p_adts_node_heap;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((NULL == p_node) || (false == heap_node_queued(p_heap, p_node))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    (void) heap_remove_idx(p_heap, p_node->idx);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_heap_remove_node() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_heap_push_n( adts_heap_t      *p_adts_heap,
+                  adts_heap_node_t *p_nodes[],
+                  const int64_t     keys[],
+                  size_t            elems )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    int32_t        rc       = 0;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (elems && ((NULL == p_nodes) || (NULL == keys))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    rc = heap_insert_n(p_heap, p_nodes, keys, elems);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_heap_push_n() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_heap_build( adts_heap_t      *p_adts_heap,
+                 adts_heap_node_t *p_nodes[],
+                 const int64_t     keys[],
+                 size_t            elems )
+{
+    heap_t        *p_heap   = (heap_t *) p_adts_heap;
+    int32_t        rc       = 0;
+    adts_sanity_t *p_sanity = &(p_heap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((p_heap->elems_curr) ||
+        (elems && ((NULL == p_nodes) || (NULL == keys)))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    rc = heap_insert_n(p_heap, p_nodes, keys, elems);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_heap_build() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Nodes are consumer owned and not included.  Embedded heaps report
+ *   nothing, the caller holds the memory.
+ *
+ ****************************************************************************
+ */
+void
+adts_heap_mem_stats( adts_heap_t      *p_adts_heap,
+                     adts_mem_stats_t *p_stats )
+{
+    heap_t *p_heap = (heap_t *) p_adts_heap;
+
+    *p_stats = p_heap->mem;
+
+    return;
+} /* adts_heap_mem_stats() */
 
 
 /*
@@ -324,281 +1913,856 @@ adts_heap_is_not_empty( adts_heap_t *p_adts_heap )
  ****************************************************************************
  */
 size_t
-adts_heap_entries( adts_heap_t *p_adts_heap )
+adts_heap_hugepage_bytes( adts_heap_t *p_adts_heap )
 {
     heap_t *p_heap = (heap_t *) p_adts_heap;
+    size_t  bytes  = heap_workspace_bytes(p_heap, p_heap->elems_limit);
+    size_t  huge   = 0;
 
-    return p_heap->elems_curr;
-} /* adts_heap_entries() */
+    if ((false == p_heap->embedded) &&
+        (ADTS_MEM_ALIGN_HUGEPAGE == heap_workspace_align(p_heap, bytes))) {
+        huge = adts_mem_hugepage_bytes(p_heap->workspace, bytes);
+    }
+
+    return huge;
+} /* adts_heap_hugepage_bytes() */
 
 
 /*
  ****************************************************************************
  *
+ *
  ****************************************************************************
  */
 void
-adts_heap_display( adts_heap_t *p_adts_heap )
+adts_heap_destroy( adts_heap_t *p_adts_heap )
 {
-    size_t         elems    = 0;
-    size_t         digits   = 0;
-    heap_t        *p_heap   = (heap_t *) p_adts_heap;
-    adts_sanity_t *p_sanity = &(p_heap->sanity);
+    heap_t           *p_heap   = (heap_t *) p_adts_heap;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_heap->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    /* display the entire heap with dynamic width formatting */
-    elems  = p_heap->elems_curr;
-    digits = adts_digits_decimal(elems);
+    if (p_heap->embedded) {
+        /* caller owned */
+        goto exception;
+    }
 
-    /* The heap implementation uses an array representation of a binary tree
-     * therefore we simply perform a display / decode of each entry as array
-     * format.  Alternately we can perform a BFS display as future extension */
+    if (p_heap->p_radix) {
+        heap_radix_free(p_heap);
+    } else {
+        heap_workspace_free(p_heap);
+    }
+
+    /* the record is released along with the handle */
+    mem = p_heap->mem;
+    adts_mem_free_acct(&(mem), p_heap, sizeof(adts_heap_t), ADTS_MEM_ALIGN_DEFAULT);
+
+exception:
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_heap_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bytes required for an embedded heap of the given capacity.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_heap_embedded_bytes( size_t elems )
+{
+    return sizeof(adts_heap_t) + (elems * sizeof(heap_node_t *));
+} /* adts_heap_embedded_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The handle and workspace reside in the caller's memory and the
+ *   allocator is never called.  Capacity is derived from bytes, a push to
+ *   a full heap returns ENOSPC.  p_mem must be 8B aligned and hold at
+ *   least one element, otherwise NULL.  Nodes remain consumer owned,
+ *   destroy releases nothing.
+ *
+ ****************************************************************************
+ */
+adts_heap_t *
+adts_heap_create_embedded( adts_heap_type_t  type,
+                           void             *p_mem,
+                           size_t            bytes )
+{
+    heap_t           *p_heap      = NULL;
+    adts_heap_t      *p_adts_heap = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_HEAP);
+
+    if ((NULL == p_mem) || ((uintptr_t) p_mem & 0x7) ||
+        ((ADTS_HEAP_MIN != type) && (ADTS_HEAP_MAX != type) &&
+         (ADTS_HEAP_MINMAX != type)) ||
+        (bytes < adts_heap_embedded_bytes(1))) {
+        goto exception;
+    }
+
+    p_adts_heap = p_mem;
+    memset(p_adts_heap, 0, sizeof(*p_adts_heap));
+
+    p_heap              = (heap_t *) p_adts_heap;
+    p_heap->type        = type;
+    p_heap->embedded    = true;
+    p_heap->mem         = mem;
+    p_heap->workspace   = (heap_node_t **) (p_adts_heap + 1);
+    p_heap->elems_limit = bytes - sizeof(*p_adts_heap);
+    p_heap->elems_limit = p_heap->elems_limit / sizeof(heap_node_t *);
+
+exception:
+    return p_adts_heap;
+} /* adts_heap_create_embedded() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Huge page placement applies once the workspace grows to span a huge
+ *   page, see adts_mem_align_hugepage().  The d-ary layout accepts an
+ *   arity of 2, 4 or 8, such that a sibling group never straddles a
+ *   cacheline.
+ *
+ ****************************************************************************
+ */
+adts_heap_t *
+adts_heap_create_ext( const adts_heap_create_t *p_op )
+{
+    size_t            elems       = HEAP_DEFAULT_ELEMS;
+    size_t            bytes       = 0;
+    size_t            arity       = 0;
+    int32_t           rc          = 0;
+    heap_t           *p_heap      = NULL;
+    adts_heap_t      *p_adts_heap = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_HEAP);
+
+    if ((NULL == p_op) ||
+        ((ADTS_HEAP_MIN != p_op->type) && (ADTS_HEAP_MAX != p_op->type) &&
+         (ADTS_HEAP_RADIX != p_op->type) && (ADTS_HEAP_MINMAX != p_op->type)) ||
+        (~(ADTS_HEAP_OPTS_HUGEPAGE | ADTS_HEAP_OPTS_DARY) & p_op->options) ||
+        ((ADTS_HEAP_RADIX == p_op->type) && p_op->options) ||
+        ((ADTS_HEAP_MINMAX == p_op->type) &&
+         (ADTS_HEAP_OPTS_DARY & p_op->options))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    if (ADTS_HEAP_OPTS_DARY & p_op->options) {
+        arity = p_op->arity ? p_op->arity : ADTS_HEAP_ARITY_DEFAULT;
+        if ((2 > arity) || (ADTS_HEAP_ARITY_MAX < arity) ||
+            (arity & (arity - 1))) {
+            rc = EINVAL;
+            goto exception;
+        }
+    }
+
+    p_adts_heap = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_heap),
+                                       ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_heap) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_heap          = (heap_t *) p_adts_heap;
+    p_heap->type    = p_op->type;
+    p_heap->options = p_op->options;
+    p_heap->arity   = arity;
+    p_heap->mem     = mem;
+
+    if (ADTS_HEAP_RADIX == p_heap->type) {
+        /* buckets are allocated on demand */
+        p_heap->p_radix = adts_mem_zalloc_acct(&(p_heap->mem),
+                                               sizeof(*(p_heap->p_radix)),
+                                               ADTS_MEM_ALIGN_DEFAULT);
+        rc = p_heap->p_radix ? 0 : ENOMEM;
+        goto exception;
+    }
+
+    /* Array of pointers to heap_adts_node_t, or of d-ary slots */
+    bytes             = heap_workspace_bytes(p_heap, elems);
+    p_heap->workspace = adts_mem_zalloc_acct(&(p_heap->mem), bytes,
+                                             heap_workspace_align(p_heap, bytes));
+    if (NULL == p_heap->workspace) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_heap->elems_limit = elems;
+    heap_slots_set(p_heap);
+
+exception:
+    if (rc) {
+        if (p_adts_heap) {
+            mem = p_heap->mem;
+            adts_mem_free_acct(&(mem), p_adts_heap, sizeof(*p_adts_heap),
+                               ADTS_MEM_ALIGN_DEFAULT);
+            p_adts_heap = NULL;
+        }
+    }
+
+    return p_adts_heap;
+} /* adts_heap_create_ext() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+adts_heap_t *
+adts_heap_create( adts_heap_type_t type )
+{
+    adts_heap_create_t op = {0};
+
+    op.type = type;
+
+    return adts_heap_create_ext(&(op));
+} /* adts_heap_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_heap_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(heap_t));
+    CDISPLAY("[%u]", sizeof(adts_heap_t));
+
+    _Static_assert(sizeof(heap_t) <= sizeof(adts_heap_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(heap_node_t));
+    CDISPLAY("[%u]", sizeof(adts_heap_node_t));
+
+    _Static_assert(sizeof(heap_node_t) <= sizeof(adts_heap_node_t),
+        "Mismatch structs detected");
+
+    _Static_assert(_Alignof(heap_node_t) <= _Alignof(adts_heap_node_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_heap_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Benchmark sizes.  100M entries require ~5GB of nodes and workspace,
+ *   beyond the default test host, thus capped at 10M.
+ *
+ ****************************************************************************
+ */
+static const size_t utest_heap_bench_elems[] = {
+    1000, 100 * 1000, 1000 * 1000, 10 * 1000 * 1000,
+};
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Pop elems, verifying order on the way out, and return the pop ns/op.
+ *
+ ****************************************************************************
+ */
+static uint64_t
+utest_heap_drain( adts_heap_t *p_heap,
+                  size_t       elems )
+{
+    uint64_t     start = 0;
+    int64_t      prev  = 0;
+    bool         max   = false;
+    heap_t      *p_h   = (heap_t *) p_heap;
+    heap_node_t *p_n   = NULL;
+
+    max   = (ADTS_HEAP_MAX == p_h->type);
+    prev  = max ? INT64_MAX : INT64_MIN;
+    start = adts_tstamp();
     for (size_t idx = 0; idx < elems; idx++) {
-        heap_node_t *p_node = p_heap->workspace[idx];
-        printf("[%*d]  node: %p  vaddr: %p  bytes: %d  key: 0x%016llx %-lld \n",
-                digits,
-                idx,
-                p_node,
-                p_node->p_data,
-                p_node->bytes,
-                p_node->key,
-                p_node->key );
+        p_n = (heap_node_t *) adts_heap_pop(p_heap);
+        assert(p_n);
+        assert(max ? (p_n->key <= prev) : (p_n->key >= prev));
+        prev = p_n->key;
     }
+    start = adts_tstamp() - start;
+    assert(adts_heap_is_empty(p_heap));
+
+    return elems ? (start / elems) : 0;
+} /* utest_heap_drain() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   xorshift keys, non-negative such that INT64_MIN / MAX bound the drain.
+ *
+ ****************************************************************************
+ */
+static inline int64_t
+utest_heap_key( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return (int64_t) (*p_seed >> 1);
+} /* utest_heap_key() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Push n random keys then pop n, verifying order on the way out.
+ *   Returns the respective push and pop ns/op.
+ *
+ ****************************************************************************
+ */
+static void
+utest_heap_ordered( adts_heap_t      *p_heap,
+                    adts_heap_node_t *p_nodes,
+                    size_t            elems,
+                    uint64_t         *p_push_ns,
+                    uint64_t         *p_pop_ns )
+{
+    uint64_t start = 0;
+    uint64_t seed  = 0x9E3779B97F4A7C15ULL;
+
+    start = adts_tstamp();
+    for (size_t idx = 0; idx < elems; idx++) {
+        int32_t rc = 0;
 
-    adts_sanity_exit(p_sanity);
+        rc = adts_heap_push(p_heap, &(p_nodes[idx]), &(p_nodes[idx]), 1,
+                            utest_heap_key(&(seed)));
+        assert(0 == rc);
+    }
+    *p_push_ns = (adts_tstamp() - start) / elems;
+    *p_pop_ns  = utest_heap_drain(p_heap, elems);
 
     return;
-} /* adts_heap_display() */
+} /* utest_heap_ordered() */
 
 
 /*
  ****************************************************************************
+ * \details
+ *   Binary pointer layout vs 4-ary inline key layout.
  *
  ****************************************************************************
  */
-adts_heap_node_t *
-adts_heap_peek( adts_heap_t *p_adts_heap )
+static void
+utest_heap_benchmark( void )
 {
-    heap_t      *p_heap = (heap_t *) p_adts_heap;
-    heap_node_t *p_node = p_heap->workspace[0];
+    const size_t      count   = sizeof(utest_heap_bench_elems) /
+                                sizeof(utest_heap_bench_elems[0]);
+    const size_t      elems   = utest_heap_bench_elems[count - 1];
+    adts_heap_node_t *p_nodes = NULL;
 
-    return (adts_heap_node_t *) p_node;
-} /* adts_heap_peek() */
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: binary vs 4-ary heap, random keys");
+
+    p_nodes = calloc(elems, sizeof(*p_nodes));
+    assert(p_nodes);
+
+    for (size_t idx = 0; idx < count; idx++) {
+        uint64_t           push[2] = {0};
+        uint64_t           pop[2]  = {0};
+        adts_heap_t       *p_heap  = NULL;
+        adts_heap_create_t op      = {0};
+
+        op.type = ADTS_HEAP_MIN;
+        p_heap  = adts_heap_create_ext(&(op));
+        assert(p_heap);
+        utest_heap_ordered(p_heap, p_nodes, utest_heap_bench_elems[idx],
+                           &(push[0]), &(pop[0]));
+        adts_heap_destroy(p_heap);
+
+        op.options = ADTS_HEAP_OPTS_DARY;
+        p_heap     = adts_heap_create_ext(&(op));
+        assert(p_heap);
+        utest_heap_ordered(p_heap, p_nodes, utest_heap_bench_elems[idx],
+                           &(push[1]), &(pop[1]));
+        adts_heap_destroy(p_heap);
+
+        CDISPLAY("%10zu elems  push: %4llu / %4llu ns  pop: %5llu / %5llu ns"
+                 "  (binary / 4-ary)",
+                 utest_heap_bench_elems[idx], push[0], push[1], pop[0],
+                 pop[1]);
+    }
+
+    free(p_nodes);
+
+    return;
+} /* utest_heap_benchmark() */
 
 
 /*
  ****************************************************************************
- *
- *  FIXME: Add resize shrink capability
+ * \details
+ *   Per node push vs bulk build, total time to construct the heap.
  *
  ****************************************************************************
  */
-adts_heap_node_t *
-adts_heap_pop( adts_heap_t *p_adts_heap )
+static void
+utest_heap_benchmark_build( void )
 {
-    size_t         idx      = 0;
-    heap_t        *p_heap   = (heap_t *) p_adts_heap;
-    heap_node_t   *p_node   = NULL;
-    const size_t   elems    = p_heap->elems_curr;
-    adts_sanity_t *p_sanity = &(p_heap->sanity);
+    const size_t        count   = sizeof(utest_heap_bench_elems) /
+                                  sizeof(utest_heap_bench_elems[0]);
+    const size_t        elems   = utest_heap_bench_elems[count - 1];
+    const size_t        arity[] = { 0, ADTS_HEAP_ARITY_DEFAULT };
+    uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+    int64_t            *p_keys  = NULL;
+    adts_heap_node_t   *p_nodes = NULL;
+    adts_heap_node_t  **pp_node = NULL;
 
-    adts_sanity_entry(p_sanity);
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: N x push vs build, random keys");
 
-    if (unlikely(0 >= elems)) {
-        /* empty heap */
-        goto exception;
+    p_nodes = calloc(elems, sizeof(*p_nodes));
+    pp_node = calloc(elems, sizeof(*pp_node));
+    p_keys  = calloc(elems, sizeof(*p_keys));
+    assert(p_nodes && pp_node && p_keys);
+    for (size_t idx = 0; idx < elems; idx++) {
+        pp_node[idx] = &(p_nodes[idx]);
+        p_keys[idx]  = utest_heap_key(&(seed));
     }
 
-    if (heap_resize_shrink_candidate(p_heap)) {
-        /* Do not error out.  Try again on next pop operation */
-        (void) heap_resize(p_heap, HEAP_SHRINK);
+    for (size_t idx = 0; idx < count; idx++) {
+        for (size_t adx = 0; adx < sizeof(arity) / sizeof(arity[0]); adx++) {
+            uint64_t            push   = 0;
+            uint64_t            build  = 0;
+            const size_t        n      = utest_heap_bench_elems[idx];
+            adts_heap_t        *p_heap = NULL;
+            adts_heap_create_t  op     = {0};
+
+            op.type    = ADTS_HEAP_MIN;
+            op.options = arity[adx] ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+            op.arity   = arity[adx];
+
+            p_heap = adts_heap_create_ext(&(op));
+            assert(p_heap);
+            push = adts_tstamp();
+            for (size_t i = 0; i < n; i++) {
+                assert(0 == adts_heap_push(p_heap, pp_node[i], pp_node[i], 1,
+                                           p_keys[i]));
+            }
+            push = adts_tstamp() - push;
+            adts_heap_destroy(p_heap);
+
+            p_heap = adts_heap_create_ext(&(op));
+            assert(p_heap);
+            build = adts_tstamp();
+            assert(0 == adts_heap_build(p_heap, pp_node, p_keys, n));
+            build = adts_tstamp() - build;
+            (void) utest_heap_drain(p_heap, n);
+            adts_heap_destroy(p_heap);
+
+            CDISPLAY("%10zu elems  %s  push: %8llu us  build: %8llu us",
+                     n, arity[adx] ? "4-ary " : "binary",
+                     push / 1000, build / 1000);
+        }
     }
 
-    /* Pop root from tree, and overwrite root with last node in tree */
-    p_node               = p_heap->workspace[0];
-    idx                  = elems - 1;
-    p_heap->workspace[0] = p_heap->workspace[idx];
-
-    p_heap->elems_curr--;
-
-    heap_adjust_down(p_heap);
+    free(p_keys);
+    free(pp_node);
+    free(p_nodes);
 
-exception:
-    adts_sanity_exit(p_sanity);
-    return p_node;
-} /* adts_heap_pop() */
+    return;
+} /* utest_heap_benchmark_build() */
 
 
 /*
  ****************************************************************************
- *
+ * \details
+ *   Timer reschedule, N live timers each rescheduled R/N times on average.
+ *   Tombstones cancel the queued node and push a replacement, the indexed
+ *   heap updates the key in place.  Both drain the heap at the end.
  *
  ****************************************************************************
  */
-int32_t
-adts_heap_push( adts_heap_t       *p_adts_heap,
-                adts_heap_node_t  *p_adts_node_heap,
-                void              *p_data,
-                size_t             bytes,
-                int64_t            key )
-{
-    heap_t        *p_heap   = (heap_t *) p_adts_heap;
-    size_t         idx      = 0;
-    int32_t        rc       = 0;
-    heap_node_t   *p_node   = (heap_node_t *) p_adts_node_heap;
-    adts_sanity_t *p_sanity = &(p_heap->sanity);
+#define UTEST_HEAP_TIMERS     (1000 * 1000)
+#define UTEST_HEAP_RESCHEDULE (4 * 1000 * 1000)
 
-    adts_sanity_entry(p_sanity);
+typedef struct {
+    adts_heap_node_t node; /**< first, popped node is the timer */
+    bool             cancelled;
+} utest_heap_timer_t;
 
-    /* Key not validated. Duplicates and 0 value allowed */
-    assert(p_node);
-    assert(p_data);
-    assert(bytes);
+static void
+utest_heap_benchmark_tombstone( void )
+{
+    const size_t         arity[]  = { 0, ADTS_HEAP_ARITY_DEFAULT };
+    const size_t         timers   = UTEST_HEAP_TIMERS;
+    const size_t         resched  = UTEST_HEAP_RESCHEDULE;
+    utest_heap_timer_t  *p_timers = NULL;
+    utest_heap_timer_t **pp_live  = NULL;
 
-    if (unlikely(p_heap->elems_curr == p_heap->elems_limit)) {
-        /* Full, perform dynamic resize operation */
-        rc = heap_resize(p_heap, HEAP_GROW);
-        if (rc) {
-            goto exception;
-        }
-    }
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: %zu timers, %zu reschedules, tombstone vs indexed",
+             timers, resched);
+
+    p_timers = calloc(timers + resched, sizeof(*p_timers));
+    pp_live  = calloc(timers, sizeof(*pp_live));
+    assert(p_timers && pp_live);
+
+    for (size_t adx = 0; adx < sizeof(arity) / sizeof(arity[0]); adx++) {
+        for (size_t indexed = 0; indexed < 2; indexed++) {
+            uint64_t            start  = 0;
+            uint64_t            seed   = 0x9E3779B97F4A7C15ULL;
+            size_t              next   = 0;
+            size_t              peak   = 0;
+            size_t              popped = 0;
+            adts_heap_t        *p_heap = NULL;
+            heap_node_t        *p_n    = NULL;
+            adts_heap_create_t  op     = {0};
+
+            op.type    = ADTS_HEAP_MIN;
+            op.options = arity[adx] ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+            op.arity   = arity[adx];
+            p_heap     = adts_heap_create_ext(&(op));
+            assert(p_heap);
+
+            memset(p_timers, 0, (timers + resched) * sizeof(*p_timers));
+            start = adts_tstamp();
+            for (next = 0; next < timers; next++) {
+                pp_live[next] = &(p_timers[next]);
+                assert(0 == adts_heap_push(p_heap, &(pp_live[next]->node),
+                                           pp_live[next], 1,
+                                           utest_heap_key(&(seed))));
+            }
 
-    /* Populate the consumers node structure */
-    p_node->p_data = p_data;
-    p_node->bytes  = bytes;
-    p_node->key    = key;
+            for (size_t i = 0; i < resched; i++) {
+                int64_t             key     = utest_heap_key(&(seed));
+                utest_heap_timer_t *p_timer = pp_live[key % timers];
+
+                if (indexed) {
+                    assert(0 == adts_heap_update_key(p_heap, &(p_timer->node),
+                                                     key));
+                    continue;
+                }
+
+                /* cancel, and queue a replacement */
+                p_timer->cancelled = true;
+                p_timer            = &(p_timers[next++]);
+                pp_live[key % timers] = p_timer;
+                assert(0 == adts_heap_push(p_heap, &(p_timer->node), p_timer,
+                                           1, key));
+            }
+            peak = adts_heap_entries(p_heap);
 
-    /* Insert this node at end of array */
-    idx                    = p_heap->elems_curr;
-    p_heap->workspace[idx] = p_node;
+            while ((p_n = (heap_node_t *) adts_heap_pop(p_heap))) {
+                popped += !((utest_heap_timer_t *) p_n)->cancelled;
+            }
+            assert(timers == popped);
 
-    p_heap->elems_curr++;
+            CDISPLAY("%s %-9s %6llu ms  peak entries: %zu",
+                     arity[adx] ? "4-ary " : "binary",
+                     indexed ? "indexed" : "tombstone",
+                     (adts_tstamp() - start) / (1000 * 1000), peak);
+
+            adts_heap_destroy(p_heap);
+        }
+    }
 
-    heap_adjust_up(p_heap);
+    free(pp_live);
+    free(p_timers);
 
-exception:
-    adts_sanity_exit(p_sanity);
-    return rc;
-} /* adts_heap_push() */
+    return;
+} /* utest_heap_benchmark_tombstone() */
 
 
 /*
  ****************************************************************************
- *
+ * \details
+ *   Lazy deletion Dijkstra over a random graph, V vertices of out degree
+ *   D with weights in [1, 1024).  Identical for every heap type, the
+ *   distance checksum must agree.
  *
  ****************************************************************************
  */
-void
-adts_heap_destroy( adts_heap_t *p_adts_heap )
+#define UTEST_HEAP_SP_VERTS  (1000 * 1000)
+#define UTEST_HEAP_SP_DEGREE (4)
+
+static void
+utest_heap_benchmark_sp( void )
 {
-    heap_t        *p_heap   = (heap_t *) p_adts_heap;
-    adts_sanity_t *p_sanity = &(p_heap->sanity);
+    const size_t       verts   = UTEST_HEAP_SP_VERTS;
+    const size_t       edges   = verts * UTEST_HEAP_SP_DEGREE;
+    const char        *name[]  = { "binary", "4-ary", "radix" };
+    uint64_t           seed    = 0x9E3779B97F4A7C15ULL;
+    uint64_t           check   = 0;
+    uint32_t          *p_dst   = NULL;
+    uint32_t          *p_wgt   = NULL;
+    uint32_t          *p_vtx   = NULL;
+    int64_t           *p_dist  = NULL;
+    adts_heap_node_t  *p_nodes = NULL;
 
-    adts_sanity_entry(p_sanity);
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: dijkstra, %zu vertices, %zu edges", verts, edges);
+
+    p_dst   = calloc(edges, sizeof(*p_dst));
+    p_wgt   = calloc(edges, sizeof(*p_wgt));
+    p_vtx   = calloc(edges + 1, sizeof(*p_vtx));
+    p_dist  = calloc(verts, sizeof(*p_dist));
+    p_nodes = calloc(edges + 1, sizeof(*p_nodes));
+    assert(p_dst && p_wgt && p_vtx && p_dist && p_nodes);
+    for (size_t e = 0; e < edges; e++) {
+        p_dst[e] = (uint32_t) (utest_heap_key(&(seed)) % verts);
+        p_wgt[e] = (uint32_t) (utest_heap_key(&(seed)) % 1023) + 1;
+    }
 
-    free(p_heap->workspace);
-    free(p_heap);
+    for (size_t t = 0; t < sizeof(name) / sizeof(name[0]); t++) {
+        uint64_t            start  = 0;
+        uint64_t            sum    = 0;
+        size_t              next   = 0;
+        size_t              peak   = 0;
+        adts_heap_t        *p_heap = NULL;
+        heap_node_t        *p_n    = NULL;
+        adts_heap_create_t  op     = {0};
+
+        op.type    = (2 == t) ? ADTS_HEAP_RADIX : ADTS_HEAP_MIN;
+        op.options = (1 == t) ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+        p_heap     = adts_heap_create_ext(&(op));
+        assert(p_heap);
+
+        for (size_t v = 0; v < verts; v++) {
+            p_dist[v] = INT64_MAX;
+        }
 
-    /* No adts_sanity_exit() since we've freed the memory */
+        start     = adts_tstamp();
+        p_dist[0] = 0;
+        p_vtx[0]  = 0;
+        assert(0 == adts_heap_push(p_heap, &(p_nodes[next]), p_heap, 1, 0));
+        next++;
+        while ((p_n = (heap_node_t *) adts_heap_pop(p_heap))) {
+            uint32_t v = p_vtx[(adts_heap_node_t *) p_n - p_nodes];
+
+            if (p_n->key > p_dist[v]) {
+                /* stale */
+                continue;
+            }
+
+            for (size_t e = v * UTEST_HEAP_SP_DEGREE;
+                 e < (v + 1) * UTEST_HEAP_SP_DEGREE; e++) {
+                int64_t d = p_n->key + p_wgt[e];
+
+                if (d < p_dist[p_dst[e]]) {
+                    p_dist[p_dst[e]] = d;
+                    p_vtx[next]      = p_dst[e];
+                    assert(0 == adts_heap_push(p_heap, &(p_nodes[next]),
+                                               p_heap, 1, d));
+                    next++;
+                }
+            }
+            peak = (adts_heap_entries(p_heap) > peak) ?
+                   adts_heap_entries(p_heap) : peak;
+        }
+        start = adts_tstamp() - start;
+
+        for (size_t v = 0; v < verts; v++) {
+            sum += (INT64_MAX == p_dist[v]) ? 0 : (uint64_t) p_dist[v];
+        }
+        assert((0 == t) || (sum == check));
+        check = sum;
+
+        CDISPLAY("%-6s %6llu ms  pushes: %zu  peak entries: %zu  (%llu)",
+                 name[t], start / (1000 * 1000), next, peak, sum);
+
+        adts_heap_destroy(p_heap);
+    }
+
+    free(p_nodes);
+    free(p_dist);
+    free(p_vtx);
+    free(p_wgt);
+    free(p_dst);
 
     return;
-} /* adts_heap_destroy() */
+} /* utest_heap_benchmark_sp() */
 
 
 /*
  ****************************************************************************
- *
+ * \details
+ *   Double-ended window, W live keys.  Each op pushes a random key and
+ *   alternately evicts the min or the max.  The two heap approach keeps a
+ *   MIN and a MAX heap in lockstep, each element carries a node per heap
+ *   and an eviction removes its twin by index.
  *
  ****************************************************************************
  */
-adts_heap_t *
-adts_heap_create( adts_heap_type_t type )
-{
-    size_t       elems       = HEAP_DEFAULT_ELEMS;
-    int32_t      rc          = 0;
-    heap_t      *p_heap      = NULL;
-    heap_node_t *p_elems     = NULL;
-    adts_heap_t *p_adts_heap = NULL;
+#define UTEST_HEAP_WINDOW_OPS (4 * 1000 * 1000)
 
-    p_adts_heap = adts_mem_zalloc(sizeof(*p_adts_heap));
-    if (NULL == p_adts_heap) {
-        rc = ENOMEM;
-        goto exception;
-    }
+typedef struct {
+    adts_heap_node_t lo;
+    adts_heap_node_t hi;
+} utest_heap_dual_t;
 
-    /* Array of pointers to heap_adts_node_t */
-    p_elems = calloc(elems, sizeof(*p_elems));
-    if (NULL == p_elems) {
-        rc = ENOMEM;
-        goto exception;
-    }
+static void
+utest_heap_benchmark_minmax( void )
+{
+    const size_t       windows[] = { 1000, 1000 * 1000 };
+    const size_t       ops       = UTEST_HEAP_WINDOW_OPS;
+    utest_heap_dual_t *p_dual    = NULL;
 
-    p_heap              = (heap_t *) p_adts_heap;
-    p_heap->type        = type;
-    p_heap->workspace   = p_elems;
-    p_heap->elems_limit = elems;
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: %zu window ops, two heaps vs min-max heap", ops);
+
+    p_dual = calloc(windows[1], sizeof(*p_dual));
+    assert(p_dual);
+
+    for (size_t wdx = 0; wdx < sizeof(windows) / sizeof(windows[0]); wdx++) {
+        const size_t       window = windows[wdx];
+        uint64_t           ns[2]  = {0};
+        size_t             mem[2] = {0};
+        adts_heap_t       *p_lo   = NULL;
+        adts_heap_t       *p_hi   = NULL;
+        adts_heap_t       *p_mm   = NULL;
+        adts_mem_stats_t   stats  = {0};
+
+        /* two heaps in lockstep */
+        {
+            uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+            p_lo = adts_heap_create(ADTS_HEAP_MIN);
+            p_hi = adts_heap_create(ADTS_HEAP_MAX);
+            assert(p_lo && p_hi);
+            for (size_t idx = 0; idx < window; idx++) {
+                int64_t key = utest_heap_key(&(seed));
+
+                assert(0 == adts_heap_push(p_lo, &(p_dual[idx].lo),
+                                           &(p_dual[idx]), 1, key));
+                assert(0 == adts_heap_push(p_hi, &(p_dual[idx].hi),
+                                           &(p_dual[idx]), 1, key));
+            }
 
-exception:
-    if (rc) {
-        if (p_elems) {
-            free(p_elems);
-			p_elems = NULL;
+            ns[0] = adts_tstamp();
+            for (size_t idx = 0; idx < ops; idx++) {
+                heap_node_t       *p_n = NULL;
+                utest_heap_dual_t *p_e = NULL;
+                int64_t            key = utest_heap_key(&(seed));
+
+                p_n = (heap_node_t *) ((idx & 1) ? adts_heap_pop(p_hi) :
+                                                   adts_heap_pop(p_lo));
+                p_e = p_n->p_data;
+                assert(0 == adts_heap_remove_node((idx & 1) ? p_lo : p_hi,
+                                                  (idx & 1) ? &(p_e->lo) :
+                                                              &(p_e->hi)));
+                assert(0 == adts_heap_push(p_lo, &(p_e->lo), p_e, 1, key));
+                assert(0 == adts_heap_push(p_hi, &(p_e->hi), p_e, 1, key));
+            }
+            ns[0] = adts_tstamp() - ns[0];
+
+            adts_heap_mem_stats(p_lo, &(stats));
+            mem[0] = stats.bytes_curr;
+            adts_heap_mem_stats(p_hi, &(stats));
+            mem[0] += stats.bytes_curr + (window * 2 * sizeof(adts_heap_node_t));
+            adts_heap_destroy(p_hi);
+            adts_heap_destroy(p_lo);
         }
 
-        if (p_adts_heap) {
-            free(p_adts_heap);
-			p_adts_heap = NULL;
-        }
-    }
+        /* single min-max heap */
+        {
+            uint64_t seed = 0x9E3779B97F4A7C15ULL;
 
-    return p_adts_heap;
-} /* adts_heap_create() */
+            p_mm = adts_heap_create(ADTS_HEAP_MINMAX);
+            assert(p_mm);
+            for (size_t idx = 0; idx < window; idx++) {
+                assert(0 == adts_heap_push(p_mm, &(p_dual[idx].lo),
+                                           &(p_dual[idx]), 1,
+                                           utest_heap_key(&(seed))));
+            }
 
+            ns[1] = adts_tstamp();
+            for (size_t idx = 0; idx < ops; idx++) {
+                adts_heap_node_t *p_n = NULL;
+                int64_t           key = utest_heap_key(&(seed));
 
+                p_n = (idx & 1) ? adts_heap_pop_max(p_mm) :
+                                  adts_heap_pop_min(p_mm);
+                assert(p_n);
+                assert(0 == adts_heap_push(p_mm, p_n, p_n, 1, key));
+            }
+            ns[1] = adts_tstamp() - ns[1];
 
+            adts_heap_mem_stats(p_mm, &(stats));
+            mem[1] = stats.bytes_curr + (window * sizeof(adts_heap_node_t));
+            adts_heap_destroy(p_mm);
+        }
 
+        CDISPLAY("%8zu window  %4llu / %4llu ns/op  %9zu / %9zu bytes"
+                 "  (two heaps / min-max)",
+                 window, ns[0] / ops, ns[1] / ops, mem[0], mem[1]);
+    }
 
-/******************************************************************************
- * #     # #     #   ###   ####### ####### #######  #####  #######  #####
- * #     # ##    #    #       #       #    #       #     #    #    #     #
- * #     # # #   #    #       #       #    #       #          #    #
- * #     # #  #  #    #       #       #    #####    #####     #     #####
- * #     # #   # #    #       #       #    #             #    #          #
- * #     # #    ##    #       #       #    #       #     #    #    #     #
- *  #####  #     #   ###      #       #    #######  #####     #     #####
-******************************************************************************/
+    free(p_dual);
 
+    return;
+} /* utest_heap_benchmark_minmax() */
 
-/**
- **************************************************************************
- * \brief
- *   Compile time structure sanity
- *
+
+/*
+ ****************************************************************************
  * \details
- *   Sanitize the abstract data type interface.  Enforced in header file so
- *   as to catch improper usage/include by unauthorized callers.
+ *   Full min-max invariant, every entry ordered against its children and
+ *   grandchildren by its level, and every node tracking its index.
  *
- **************************************************************************
+ ****************************************************************************
  */
 static void
-utest_heap_bytes( void )
+utest_heap_minmax_valid( adts_heap_t *p_adts_heap )
 {
+    heap_t       *p_heap    = (heap_t *) p_adts_heap;
+    heap_node_t **workspace = p_heap->workspace;
+    const size_t  elems     = p_heap->elems_curr;
 
-    CDISPLAY("[%u]", sizeof(heap_t));
-    CDISPLAY("[%u]", sizeof(adts_heap_t));
-
-    _Static_assert(sizeof(heap_t) <= sizeof(adts_heap_t),
-        "Mismatch structs detected");
-
-    CDISPLAY("[%u]", sizeof(heap_node_t));
-    CDISPLAY("[%u]", sizeof(adts_heap_node_t));
+    for (size_t idx = 0; idx < elems; idx++) {
+        const size_t child = (idx * 2) + 1;
+        const size_t grand = (child * 2) + 1;
 
-    _Static_assert(sizeof(heap_node_t) <= sizeof(adts_heap_node_t),
-        "Mismatch structs detected");
+        assert(idx == workspace[idx]->idx);
+        for (size_t c = child; (c < child + 2) && (c < elems); c++) {
+            assert(!heap_minmax_above(idx, workspace[c]->key,
+                                      workspace[idx]->key));
+        }
+        for (size_t g = grand; (g < grand + 4) && (g < elems); g++) {
+            assert(!heap_minmax_above(idx, workspace[g]->key,
+                                      workspace[idx]->key));
+        }
+    }
 
     return;
-} /* utest_heap_bytes() */
+} /* utest_heap_minmax_valid() */
 
 
 /*
@@ -742,6 +2906,497 @@ utest_control( void )
         (void) adts_heap_destroy(p_heap);
     }
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: embedded, fixed capacity, no allocation");
+
+        uint64_t           arr[ 64 ];
+        size_t             limit  = 0;
+        adts_heap_t       *p_heap = NULL;
+        heap_node_t       *p_node = NULL;
+        adts_heap_node_t   hnode[ 64 ];
+        adts_mem_stats_t   before = {0};
+        adts_mem_stats_t   after  = {0};
+
+        assert(NULL == adts_heap_create_embedded(ADTS_HEAP_MIN, arr,
+                                                 sizeof(adts_heap_t)));
+        assert(NULL == adts_heap_create_embedded(0, arr, sizeof(arr)));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_HEAP, &(before));
+        p_heap = adts_heap_create_embedded(ADTS_HEAP_MIN, arr, sizeof(arr));
+        assert(p_heap);
+
+        limit = (sizeof(arr) - sizeof(adts_heap_t)) / sizeof(heap_node_t *);
+        assert(adts_heap_embedded_bytes(limit) <= sizeof(arr));
+        assert(limit <= (sizeof(hnode) / sizeof(hnode[0])));
+        for (size_t idx = 0; idx < limit; idx++) {
+            int64_t k = (int64_t) ((idx * 7) % limit);
+
+            assert(0 == adts_heap_push(p_heap, &(hnode[idx]), &(hnode[idx]),
+                                       1, k));
+        }
+        assert(ENOSPC == adts_heap_push(p_heap, &(hnode[0]), &(hnode[0]),
+                                        1, 0));
+
+        for (size_t idx = 0; idx < limit; idx++) {
+            p_node = (heap_node_t *) adts_heap_pop(p_heap);
+            assert(p_node);
+        }
+        assert(adts_heap_is_empty(p_heap));
+        assert(NULL == adts_heap_pop(p_heap));
+        assert(0 == adts_heap_push(p_heap, &(hnode[0]), &(hnode[0]), 1, 0));
+
+        adts_heap_destroy(p_heap);
+        adts_mem_stats_type(ADTS_MEM_TYPE_HEAP, &(after));
+        assert(before.allocs == after.allocs);
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: pop order, binary and d-ary, through resize");
+
+        const size_t        arity[] = { 0, 2, 4, 8 };
+        const size_t        limit   = HEAP_DEFAULT_ELEMS * 16;
+        uint64_t            push    = 0;
+        uint64_t            pop     = 0;
+        adts_heap_t        *p_heap  = NULL;
+        adts_heap_node_t   *p_nodes = NULL;
+        adts_heap_create_t  op      = {0};
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        op.type    = ADTS_HEAP_MIN;
+        op.options = ADTS_HEAP_OPTS_DARY;
+        op.arity   = 3;
+        assert(NULL == adts_heap_create_ext(&(op)));
+        op.arity   = 16;
+        assert(NULL == adts_heap_create_ext(&(op)));
+
+        for (size_t idx = 0; idx < sizeof(arity) / sizeof(arity[0]); idx++) {
+            op.options = arity[idx] ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+            op.arity   = arity[idx];
+
+            op.type = ADTS_HEAP_MIN;
+            p_heap  = adts_heap_create_ext(&(op));
+            assert(p_heap);
+            assert(NULL == adts_heap_peek(p_heap));
+            utest_heap_ordered(p_heap, p_nodes, limit, &(push), &(pop));
+            utest_heap_ordered(p_heap, p_nodes, 1, &(push), &(pop));
+            adts_heap_destroy(p_heap);
+
+            op.type = ADTS_HEAP_MAX;
+            p_heap  = adts_heap_create_ext(&(op));
+            assert(p_heap);
+            utest_heap_ordered(p_heap, p_nodes, limit, &(push), &(pop));
+            assert(0 == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]),
+                                       1, -7));
+            assert(&(p_nodes[0]) == adts_heap_peek(p_heap));
+            adts_heap_destroy(p_heap);
+        }
+
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: build and push_n, binary and d-ary");
+
+        const size_t         arity[] = { 0, 2, 4, 8 };
+        const size_t         limit   = HEAP_DEFAULT_ELEMS * 16;
+        uint64_t             seed    = 0x9E3779B97F4A7C15ULL;
+        uint64_t             arr[ 64 ];
+        int64_t             *p_keys  = NULL;
+        adts_heap_t         *p_heap  = NULL;
+        adts_heap_node_t    *p_nodes = NULL;
+        adts_heap_node_t   **pp_node = NULL;
+        adts_heap_create_t   op      = {0};
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        pp_node = calloc(limit, sizeof(*pp_node));
+        p_keys  = calloc(limit, sizeof(*p_keys));
+        assert(p_nodes && pp_node && p_keys);
+        for (size_t idx = 0; idx < limit; idx++) {
+            pp_node[idx] = &(p_nodes[idx]);
+            p_keys[idx]  = utest_heap_key(&(seed));
+        }
+
+        for (size_t idx = 0; idx < sizeof(arity) / sizeof(arity[0]); idx++) {
+            op.options = arity[idx] ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+            op.arity   = arity[idx];
+
+            for (size_t tdx = 0; tdx < 2; tdx++) {
+                size_t small = limit / 64;
+
+                op.type = tdx ? ADTS_HEAP_MAX : ADTS_HEAP_MIN;
+                p_heap  = adts_heap_create_ext(&(op));
+                assert(p_heap);
+
+                /* bulk build, one reservation */
+                assert(0 == adts_heap_build(p_heap, pp_node, p_keys, limit));
+                assert(limit == adts_heap_entries(p_heap));
+                assert(EINVAL == adts_heap_build(p_heap, pp_node, p_keys, 1));
+                (void) utest_heap_drain(p_heap, limit);
+
+                /* small batch into a large heap, sifted per node */
+                assert(0 == adts_heap_build(p_heap, pp_node, p_keys,
+                                            limit - small));
+                assert(0 == adts_heap_push_n(p_heap, &(pp_node[limit - small]),
+                                             &(p_keys[limit - small]), small));
+                (void) utest_heap_drain(p_heap, limit);
+
+                /* large batch into a small heap, rebuilt */
+                assert(0 == adts_heap_push_n(p_heap, pp_node, p_keys, small));
+                assert(0 == adts_heap_push_n(p_heap, &(pp_node[small]),
+                                             &(p_keys[small]), limit - small));
+                assert(0 == adts_heap_push_n(p_heap, NULL, NULL, 0));
+                (void) utest_heap_drain(p_heap, limit);
+
+                adts_heap_destroy(p_heap);
+            }
+        }
+
+        /* embedded, all or nothing */
+        p_heap = adts_heap_create_embedded(ADTS_HEAP_MIN, arr, sizeof(arr));
+        assert(p_heap);
+        assert(ENOSPC == adts_heap_build(p_heap, pp_node, p_keys, limit));
+        assert(adts_heap_is_empty(p_heap));
+        assert(0 == adts_heap_build(p_heap, pp_node, p_keys, 4));
+        assert(0 == adts_heap_push_n(p_heap, &(pp_node[4]), &(p_keys[4]), 2));
+        (void) utest_heap_drain(p_heap, 6);
+        adts_heap_destroy(p_heap);
+
+        free(p_keys);
+        free(pp_node);
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: update_key and remove_node, binary and d-ary");
+
+        const size_t        arity[] = { 0, 2, 4, 8 };
+        const size_t        limit   = HEAP_DEFAULT_ELEMS * 16;
+        uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+        size_t              removed = 0;
+        adts_heap_t        *p_heap  = NULL;
+        heap_node_t        *p_n     = NULL;
+        adts_heap_node_t   *p_nodes = NULL;
+        adts_heap_create_t  op      = {0};
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        for (size_t idx = 0; idx < sizeof(arity) / sizeof(arity[0]); idx++) {
+            op.options = arity[idx] ? ADTS_HEAP_OPTS_DARY : ADTS_HEAP_OPTS_NONE;
+            op.arity   = arity[idx];
+
+            for (size_t tdx = 0; tdx < 2; tdx++) {
+                op.type = tdx ? ADTS_HEAP_MAX : ADTS_HEAP_MIN;
+                p_heap  = adts_heap_create_ext(&(op));
+                assert(p_heap);
+
+                for (size_t i = 0; i < limit; i++) {
+                    assert(0 == adts_heap_push(p_heap, &(p_nodes[i]),
+                                               &(p_nodes[i]), 1,
+                                               utest_heap_key(&(seed))));
+                }
+
+                /* move keys both toward the root and the leaves */
+                for (size_t i = 0; i < limit; i += 2) {
+                    int64_t key = utest_heap_key(&(seed));
+
+                    assert(0 == adts_heap_update_key(p_heap, &(p_nodes[i]),
+                                                     key));
+                }
+                assert(0 == adts_heap_update_key(p_heap, &(p_nodes[1]),
+                                                 tdx ? INT64_MAX : -1));
+                assert(&(p_nodes[1]) == adts_heap_peek(p_heap));
+
+                /* remove a third, and the root */
+                removed = 0;
+                for (size_t i = 0; i < limit; i += 3) {
+                    assert(0 == adts_heap_remove_node(p_heap, &(p_nodes[i])));
+                    assert(EINVAL == adts_heap_remove_node(p_heap,
+                                                           &(p_nodes[i])));
+                    removed++;
+                }
+                p_n = (heap_node_t *) adts_heap_peek(p_heap);
+                assert(0 == adts_heap_remove_node(p_heap,
+                                                  (adts_heap_node_t *) p_n));
+                removed++;
+                (void) utest_heap_drain(p_heap, limit - removed);
+
+                /* popped nodes are no longer queued */
+                assert(EINVAL == adts_heap_update_key(p_heap, &(p_nodes[1]),
+                                                      0));
+                assert(0 == adts_heap_push(p_heap, &(p_nodes[0]),
+                                           &(p_nodes[0]), 1, 1));
+                assert(0 == adts_heap_remove_node(p_heap, &(p_nodes[0])));
+                assert(adts_heap_is_empty(p_heap));
+
+                adts_heap_destroy(p_heap);
+            }
+        }
+
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: radix heap, monotone keys");
+
+        const size_t        limit   = HEAP_DEFAULT_ELEMS * 16;
+        uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+        int64_t             last    = INT64_MIN;
+        int64_t             key     = 0;
+        adts_heap_t        *p_heap  = NULL;
+        heap_node_t        *p_n     = NULL;
+        adts_heap_node_t   *p_nodes = NULL;
+        adts_heap_node_t  **pp_node = NULL;
+        adts_heap_create_t  op      = {0};
+        adts_mem_stats_t    before  = {0};
+        adts_mem_stats_t    after   = {0};
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        pp_node = calloc(limit, sizeof(*pp_node));
+        assert(p_nodes && pp_node);
+        for (size_t idx = 0; idx < limit; idx++) {
+            pp_node[idx] = &(p_nodes[idx]);
+        }
+
+        op.type    = ADTS_HEAP_RADIX;
+        op.options = ADTS_HEAP_OPTS_DARY;
+        assert(NULL == adts_heap_create_ext(&(op)));
+        assert(NULL == adts_heap_create_embedded(ADTS_HEAP_RADIX, p_nodes,
+                                                 limit));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_HEAP, &(before));
+        op.options = ADTS_HEAP_OPTS_NONE;
+        p_heap     = adts_heap_create_ext(&(op));
+        assert(p_heap);
+        assert(NULL == adts_heap_peek(p_heap));
+        assert(NULL == adts_heap_pop(p_heap));
+
+        /* any signed key prior to the first pop, drained in order */
+        for (size_t idx = 0; idx < limit; idx++) {
+            key = utest_heap_key(&(seed)) - (INT64_MAX / 2);
+            assert(0 == adts_heap_push(p_heap, &(p_nodes[idx]),
+                                       &(p_nodes[idx]), 1, key));
+        }
+        assert(EINVAL == adts_heap_update_key(p_heap, &(p_nodes[0]), 0));
+        assert(EINVAL == adts_heap_remove_node(p_heap, &(p_nodes[0])));
+        (void) utest_heap_drain(p_heap, limit);
+
+        /* event simulation, every push at or above the last pop.  The
+         * drain above popped keys below INT64_MAX / 2 */
+        assert(EINVAL == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]),
+                                        1, INT64_MIN));
+        assert(0 == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]), 1,
+                                   INT64_MAX / 2));
+        for (size_t idx = 1; idx < limit; idx++) {
+            p_n = (heap_node_t *) adts_heap_peek(p_heap);
+            assert(p_n == (heap_node_t *) adts_heap_pop(p_heap));
+            assert(p_n->key >= last);
+            last = p_n->key;
+
+            key = last + (int64_t) (utest_heap_key(&(seed)) % 64);
+            assert(0 == adts_heap_push(p_heap, &(p_nodes[idx]),
+                                       &(p_nodes[idx]), 1, key));
+            if (idx & 1) {
+                assert(0 == adts_heap_push(p_heap, (adts_heap_node_t *) p_n,
+                                           p_n, 1, key + 1));
+            }
+        }
+        assert(EINVAL == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]),
+                                        1, last - 1));
+
+        /* bulk, all or nothing */
+        (void) utest_heap_drain(p_heap, adts_heap_entries(p_heap));
+        {
+            int64_t *p_keys = calloc(limit, sizeof(*p_keys));
+
+            assert(p_keys);
+            for (size_t idx = 0; idx < limit; idx++) {
+                p_keys[idx] = INT64_MAX - (int64_t) idx;
+            }
+            p_keys[limit - 1] = INT64_MIN;
+            assert(EINVAL == adts_heap_push_n(p_heap, pp_node, p_keys, limit));
+            assert(adts_heap_is_empty(p_heap));
+            assert(0 == adts_heap_build(p_heap, pp_node, p_keys, limit - 1));
+            (void) utest_heap_drain(p_heap, limit - 1);
+            free(p_keys);
+        }
+
+        adts_heap_destroy(p_heap);
+        adts_mem_stats_type(ADTS_MEM_TYPE_HEAP, &(after));
+        assert(before.bytes_curr == after.bytes_curr);
+
+        free(pp_node);
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: min-max heap, both ends against a reference");
+
+        #define UTEST_HEAP_KEYS (256)
+        const size_t        limit   = HEAP_DEFAULT_ELEMS * 16;
+        uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+        size_t              count[ UTEST_HEAP_KEYS ] = {0};
+        size_t              lo      = 0;
+        size_t              hi      = 0;
+        uint64_t            arr[ 64 ];
+        adts_heap_t        *p_heap  = NULL;
+        heap_node_t        *p_n     = NULL;
+        adts_heap_node_t   *p_nodes = NULL;
+        adts_heap_node_t  **pp_node = NULL;
+        int64_t            *p_keys  = NULL;
+        adts_heap_create_t  op      = {0};
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        pp_node = calloc(limit, sizeof(*pp_node));
+        p_keys  = calloc(limit, sizeof(*p_keys));
+        assert(p_nodes && pp_node && p_keys);
+
+        op.type    = ADTS_HEAP_MINMAX;
+        op.options = ADTS_HEAP_OPTS_DARY;
+        assert(NULL == adts_heap_create_ext(&(op)));
+
+        /* single-ended heaps serve their own end only */
+        p_heap = adts_heap_create(ADTS_HEAP_MAX);
+        assert(p_heap);
+        assert(0 == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]), 1, 1));
+        assert(NULL == adts_heap_peek_min(p_heap));
+        assert(NULL == adts_heap_pop_min(p_heap));
+        assert(&(p_nodes[0]) == adts_heap_peek_max(p_heap));
+        assert(&(p_nodes[0]) == adts_heap_pop_max(p_heap));
+        adts_heap_destroy(p_heap);
+        p_heap = adts_heap_create(ADTS_HEAP_MIN);
+        assert(p_heap);
+        assert(0 == adts_heap_push(p_heap, &(p_nodes[0]), &(p_nodes[0]), 1, 1));
+        assert(NULL == adts_heap_peek_max(p_heap));
+        assert(NULL == adts_heap_pop_max(p_heap));
+        assert(&(p_nodes[0]) == adts_heap_pop_min(p_heap));
+        adts_heap_destroy(p_heap);
+
+        op.options = ADTS_HEAP_OPTS_NONE;
+        p_heap     = adts_heap_create_ext(&(op));
+        assert(p_heap);
+        assert(NULL == adts_heap_peek_max(p_heap));
+        assert(NULL == adts_heap_pop_max(p_heap));
+
+        /* random push, pop at either end, update and remove, duplicate
+         * keys from a small range tracked by count */
+        for (size_t idx = 0; idx < limit; idx++) {
+            int64_t key = utest_heap_key(&(seed)) % UTEST_HEAP_KEYS;
+
+            assert(0 == adts_heap_push(p_heap, &(p_nodes[idx]),
+                                       &(p_nodes[idx]), 1, key));
+            count[key]++;
+        }
+        utest_heap_minmax_valid(p_heap);
+
+        for (size_t idx = 0; idx < (limit * 4); idx++) {
+            uint64_t r = utest_heap_key(&(seed));
+
+            p_n = (heap_node_t *) &(p_nodes[(r >> 8) % limit]);
+            for (lo = 0; (lo < UTEST_HEAP_KEYS) && (0 == count[lo]); lo++);
+            for (hi = UTEST_HEAP_KEYS; (hi > 0) && (0 == count[hi - 1]); hi--);
+
+            switch (r % 5) {
+                case 0:
+                    p_n = (heap_node_t *) adts_heap_pop_min(p_heap);
+                    assert(p_n ? (lo == (size_t) p_n->key) : (0 == hi));
+                    count[p_n ? p_n->key : 0] -= !!p_n;
+                    break;
+                case 1:
+                    p_n = (heap_node_t *) adts_heap_pop_max(p_heap);
+                    assert(p_n ? ((hi - 1) == (size_t) p_n->key) : (0 == hi));
+                    count[p_n ? p_n->key : 0] -= !!p_n;
+                    break;
+                case 2:
+                    if (HEAP_IDX_NONE != p_n->idx) {
+                        count[p_n->key]--;
+                        assert(0 == adts_heap_update_key(p_heap,
+                                   (adts_heap_node_t *) p_n, r % UTEST_HEAP_KEYS));
+                        count[p_n->key]++;
+                    }
+                    break;
+                case 3:
+                    if (HEAP_IDX_NONE != p_n->idx) {
+                        assert(0 == adts_heap_remove_node(p_heap,
+                                   (adts_heap_node_t *) p_n));
+                        count[p_n->key]--;
+                    }
+                    break;
+                default:
+                    if (HEAP_IDX_NONE == p_n->idx) {
+                        assert(0 == adts_heap_push(p_heap,
+                                   (adts_heap_node_t *) p_n, p_n, 1,
+                                   r % UTEST_HEAP_KEYS));
+                        count[p_n->key]++;
+                    }
+            }
+
+            if (0 == (idx % 256)) {
+                utest_heap_minmax_valid(p_heap);
+            }
+        }
+        utest_heap_minmax_valid(p_heap);
+
+        /* alternate drain, both ends converge */
+        while (adts_heap_is_not_empty(p_heap)) {
+            heap_node_t *p_min = NULL;
+            heap_node_t *p_max = NULL;
+
+            p_min = (heap_node_t *) adts_heap_peek_min(p_heap);
+            p_max = (heap_node_t *) adts_heap_peek_max(p_heap);
+            assert(p_min->key <= p_max->key);
+            assert(p_min == (heap_node_t *) adts_heap_pop_min(p_heap));
+            if (adts_heap_is_not_empty(p_heap)) {
+                assert(p_max == (heap_node_t *) adts_heap_pop_max(p_heap));
+            }
+        }
+        assert(NULL == adts_heap_pop_max(p_heap));
+
+        /* bulk build, then the single-ended pop drains the min end */
+        for (size_t idx = 0; idx < limit; idx++) {
+            pp_node[idx] = &(p_nodes[idx]);
+            p_keys[idx]  = utest_heap_key(&(seed));
+        }
+        assert(0 == adts_heap_build(p_heap, pp_node, p_keys, limit - 64));
+        utest_heap_minmax_valid(p_heap);
+        assert(0 == adts_heap_push_n(p_heap, &(pp_node[limit - 64]),
+                                     &(p_keys[limit - 64]), 64));
+        utest_heap_minmax_valid(p_heap);
+        (void) utest_heap_drain(p_heap, limit);
+        adts_heap_destroy(p_heap);
+
+        /* embedded */
+        p_heap = adts_heap_create_embedded(ADTS_HEAP_MINMAX, arr, sizeof(arr));
+        assert(p_heap);
+        for (size_t idx = 0; idx < 8; idx++) {
+            assert(0 == adts_heap_push(p_heap, &(p_nodes[idx]),
+                                       &(p_nodes[idx]), 1, (int64_t) idx));
+        }
+        assert(7 == adts_heap_node_key(adts_heap_pop_max(p_heap)));
+        assert(0 == adts_heap_node_key(adts_heap_pop_min(p_heap)));
+        assert(6 == adts_heap_node_key(adts_heap_peek_max(p_heap)));
+        adts_heap_destroy(p_heap);
+
+        free(p_keys);
+        free(pp_node);
+        free(p_nodes);
+    }
+
+    utest_heap_benchmark();
+    utest_heap_benchmark_build();
+    utest_heap_benchmark_tombstone();
+    utest_heap_benchmark_sp();
+    utest_heap_benchmark_minmax();
+
     return;
 } /* utest_control() */
 
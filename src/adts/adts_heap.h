@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_memory.h>
 
 
 /**
@@ -11,23 +12,42 @@
  *
  **************************************************************************
  */
-#define ADTS_HEAP_BYTES      (64)
+#define ADTS_HEAP_BYTES      (256)
 #define ADTS_HEAP_NODE_BYTES (32)
 
 
 /**
  **************************************************************************
  * \details
+ *   heap types
+ *     - RADIX: min heap over monotone keys, e.g. Dijkstra or event
+ *       simulation, where no key pushed is below the last key popped.  A
+ *       push below it returns EINVAL.  O(1) amortized push and pop,
+ *       accepts no create options, and update_key / remove_node return
+ *       EINVAL.
+ *     - MINMAX: double-ended heap on a single binary workspace, levels
+ *       alternate between min and max order.  Both ends are reachable in
+ *       O(1) and removable in O(log n), see adts_heap_pop_max().  The
+ *       single-ended interfaces, e.g. adts_heap_pop(), address the min.
+ *       Accepts the HUGEPAGE option only.
  *
  **************************************************************************
  */
 typedef enum {
-    ADTS_HEAP_MIN = 0x11111111,
-    ADTS_HEAP_MAX = 0x22222222,
+    ADTS_HEAP_MIN    = 0x11111111,
+    ADTS_HEAP_MAX    = 0x22222222,
+    ADTS_HEAP_RADIX  = 0x33333333,
+    ADTS_HEAP_MINMAX = 0x44444444,
 } adts_heap_type_t;
 
 typedef struct {
-    const char reserved[ ADTS_HEAP_NODE_BYTES ];
+    void   *p_data;
+    size_t  bytes;
+} adts_heap_node_public_t;
+
+typedef union {
+    const char                    reserved[ ADTS_HEAP_NODE_BYTES ];
+    const adts_heap_node_public_t pub; /**< read only */
 } adts_heap_node_t;
 
 typedef struct {
@@ -38,9 +58,44 @@ typedef struct {
 /**
  **************************************************************************
  * \details
+ *   heap create options
+ *     - HUGEPAGE: place the workspace in huge page backed memory once it
+ *       spans a huge page, see adts_mem_align_hugepage().
+ *     - DARY:     d-ary layout.  The workspace holds (key, node) pairs
+ *       such that a sift compares keys without touching consumer nodes,
+ *       and the children of a parent share a cacheline.  Arity selects
+ *       the fan-out, 0 selects ADTS_HEAP_ARITY_DEFAULT.  Otherwise the
+ *       workspace holds node pointers in a binary layout.
  *
  **************************************************************************
  */
+#define ADTS_HEAP_OPTS_NONE          (0) /**< Default */
+#define ADTS_HEAP_OPTS_HUGEPAGE (1 << 1)
+#define ADTS_HEAP_OPTS_DARY     (1 << 2)
+typedef uint64_t adts_heap_options_t;
+
+#define ADTS_HEAP_ARITY_DEFAULT (4)
+#define ADTS_HEAP_ARITY_MAX     (8)
+
+typedef struct {
+    adts_heap_type_t     type;
+    adts_heap_options_t  options; /**< options bitfield */
+    size_t               arity;   /**< DARY only, 2, 4 or 8 */
+} adts_heap_create_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+void
+adts_heap_mem_stats( adts_heap_t      *p_adts_heap,
+                     adts_mem_stats_t *p_stats );
+size_t
+adts_heap_hugepage_bytes( adts_heap_t *p_adts_heap );
+
 bool
 adts_heap_is_empty( adts_heap_t *p_adts_heap );
 
@@ -56,6 +111,9 @@ adts_heap_display( adts_heap_t *p_adts_heap );
 adts_heap_node_t *
 adts_heap_peek( adts_heap_t *p_adts_heap );
 
+int64_t
+adts_heap_node_key( const adts_heap_node_t *p_adts_node_heap );
+
 adts_heap_node_t *
 adts_heap_pop( adts_heap_t *p_adts_heap );
 
@@ -65,9 +123,86 @@ adts_heap_push( adts_heap_t       *p_adts_heap,
                 void              *p_data,
                 size_t             bytes,
                 int64_t            key );
+
+/**
+ **************************************************************************
+ * \details
+ *   Double-ended access.  A MINMAX heap serves both ends.  A single-ended
+ *   heap serves its own end, equivalent to adts_heap_peek() and
+ *   adts_heap_pop(), and returns NULL for the opposite end.
+ *
+ **************************************************************************
+ */
+adts_heap_node_t *
+adts_heap_peek_min( adts_heap_t *p_adts_heap );
+
+adts_heap_node_t *
+adts_heap_peek_max( adts_heap_t *p_adts_heap );
+
+adts_heap_node_t *
+adts_heap_pop_min( adts_heap_t *p_adts_heap );
+
+adts_heap_node_t *
+adts_heap_pop_max( adts_heap_t *p_adts_heap );
+
+/**
+ **************************************************************************
+ * \details
+ *   Reorder or cancel a queued node in O(log n).  Each node tracks its
+ *   workspace index within its reserved bytes, thus a node must not be
+ *   copied or moved while queued.  A node that is not queued in this heap,
+ *   e.g. already popped or removed, returns EINVAL.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_heap_update_key( adts_heap_t      *p_adts_heap,
+                      adts_heap_node_t *p_adts_node_heap,
+                      int64_t           key );
+int32_t
+adts_heap_remove_node( adts_heap_t      *p_adts_heap,
+                       adts_heap_node_t *p_adts_node_heap );
+
+/**
+ **************************************************************************
+ * \details
+ *   Bulk insert of elems nodes keyed by the parallel keys array.  The
+ *   workspace is sized once and the heap is heapified bottom-up in O(n)
+ *   rather than sifted per node.  Bulk inserted nodes carry no data, the
+ *   node itself is the consumer reference.
+ *
+ *   - adts_heap_build():  heap must be empty, otherwise EINVAL.
+ *   - adts_heap_push_n(): merges into a populated heap.
+ *
+ *   ENOMEM / ENOSPC leave the heap unchanged.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_heap_push_n( adts_heap_t      *p_adts_heap,
+                  adts_heap_node_t *p_nodes[],
+                  const int64_t     keys[],
+                  size_t            elems );
+int32_t
+adts_heap_build( adts_heap_t      *p_adts_heap,
+                 adts_heap_node_t *p_nodes[],
+                 const int64_t     keys[],
+                 size_t            elems );
+
 void
 adts_heap_destroy( adts_heap_t *p_adts_heap );
 
+size_t
+adts_heap_embedded_bytes( size_t elems );
+
+adts_heap_t *
+adts_heap_create_embedded( adts_heap_type_t  type,
+                           void             *p_mem,
+                           size_t            bytes );
+
+adts_heap_t *
+adts_heap_create_ext( const adts_heap_create_t *p_op );
+
 adts_heap_t *
 adts_heap_create( adts_heap_type_t type );
 
@@ -4,11 +4,15 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_list.h>
+#include <adts_time.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -46,11 +50,13 @@ typedef struct list_node_s {
  ****************************************************************************
  */
 typedef struct list_s {
-    size_t        elems_curr;
-    size_t        elems_max;
-    list_node_t  *p_head;
-    list_node_t  *p_tail;
-    adts_sanity_t sanity;
+    size_t            elems_curr;
+    size_t            elems_max;
+    list_node_t      *p_head;
+    list_node_t      *p_tail;
+    adts_arena_t     *p_arena;  /**< optional, owns the handle */
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;
 } list_t;
 
 typedef enum {
@@ -75,8 +81,6 @@ typedef enum {
  * #        #####  #     #  #####     #      ###   ####### #     #  #####
 ******************************************************************************/
 
-// adts_list_node_peek_next
-// adts_list_node_peek_prev
 // adts_list_node_append
 // adts_list_node_prepend
 
@@ -285,7 +289,8 @@ adts_list_is_invalid( adts_list_t *p_adts_list )
     adts_sanity_entry(p_sanity);
 
     elems  = p_list->elems_curr;
-    a_comp = calloc(elems, sizeof(int64_t));
+    a_comp = adts_mem_zalloc_acct(&(p_list->mem), elems * sizeof(int64_t),
+                                  ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == a_comp) {
         goto exception;
     }
@@ -310,9 +315,8 @@ adts_list_is_invalid( adts_list_t *p_adts_list )
     }
 
 exception:
-    if (a_comp) {
-        free(a_comp);
-    }
+    adts_mem_free_acct(&(p_list->mem), a_comp, elems * sizeof(int64_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
     adts_sanity_exit(p_sanity);
     return rc;
 } /* adts_list_is_invalid() */
@@ -464,6 +468,34 @@ adts_list_peek_tail( adts_list_t *p_adts_list )
 } /* adts_list_peek_tail() */
 
 
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_list_node_t *
+adts_list_node_peek_next( adts_list_node_t *p_adts_list_node )
+{
+    list_node_t *p_node = (list_node_t *) p_adts_list_node;
+
+    return (adts_list_node_t *) p_node->p_next;
+} /* adts_list_node_peek_next() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_list_node_t *
+adts_list_node_peek_prev( adts_list_node_t *p_adts_list_node )
+{
+    list_node_t *p_node = (list_node_t *) p_adts_list_node;
+
+    return (adts_list_node_t *) p_node->p_prev;
+} /* adts_list_node_peek_prev() */
+
+
 /*
  ****************************************************************************
  *
@@ -516,16 +548,268 @@ adts_list_remove_tail( adts_list_t *p_adts_list )
 
 /*
  ****************************************************************************
+ * \details
+ *   Link the chain first .. last, of elems nodes, at the tail of the list.
+ *
+ ****************************************************************************
+ */
+static void
+list_chain_append( list_t      *p_list,
+                   list_node_t *p_first,
+                   list_node_t *p_last,
+                   size_t       elems )
+{
+    if (NULL == p_first) {
+        /* empty chain */
+        return;
+    }
+
+    p_first->p_prev = p_list->p_tail;
+    p_last->p_next  = NULL;
+    if (p_list->p_tail) {
+        p_list->p_tail->p_next = p_first;
+    } else {
+        p_list->p_head = p_first;
+    }
+    p_list->p_tail      = p_last;
+    p_list->elems_curr += elems;
+
+    return;
+} /* list_chain_append() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_list_splice( adts_list_t *p_adts_list_dst,
+                  adts_list_t *p_adts_list_src )
+{
+    int32_t  rc    = 0;
+    list_t  *p_dst = (list_t *) p_adts_list_dst;
+    list_t  *p_src = (list_t *) p_adts_list_src;
+
+    if (unlikely(p_dst == p_src)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    adts_sanity_entry(&(p_dst->sanity));
+    adts_sanity_entry(&(p_src->sanity));
+
+    list_chain_append(p_dst, p_src->p_head, p_src->p_tail, p_src->elems_curr);
+
+    p_src->p_head     = NULL;
+    p_src->p_tail     = NULL;
+    p_src->elems_curr = 0;
+
+    adts_sanity_exit(&(p_src->sanity));
+    adts_sanity_exit(&(p_dst->sanity));
+
+exception:
+    return rc;
+} /* adts_list_splice() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The split point is located from the nearer end of the list.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_list_split( adts_list_t *p_adts_list_src,
+                 size_t       entries,
+                 adts_list_t *p_adts_list_dst )
+{
+    int32_t      rc      = 0;
+    size_t       moved   = 0;
+    list_t      *p_src   = (list_t *) p_adts_list_src;
+    list_t      *p_dst   = (list_t *) p_adts_list_dst;
+    list_node_t *p_first = NULL;
+    list_node_t *p_last  = NULL;
+
+    if (unlikely((p_dst == p_src) || (entries > p_src->elems_curr))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    adts_sanity_entry(&(p_dst->sanity));
+    adts_sanity_entry(&(p_src->sanity));
+
+    moved = p_src->elems_curr - entries;
+    if (moved) {
+        if (entries <= moved) {
+            p_first = p_src->p_head;
+            for (size_t idx = 0; idx < entries; idx++) {
+                p_first = p_first->p_next;
+            }
+        } else {
+            p_first = p_src->p_tail;
+            for (size_t idx = 1; idx < moved; idx++) {
+                p_first = p_first->p_prev;
+            }
+        }
+        p_last = p_src->p_tail;
+
+        /* detach first .. last from src */
+        p_src->p_tail = p_first->p_prev;
+        if (p_src->p_tail) {
+            p_src->p_tail->p_next = NULL;
+        } else {
+            p_src->p_head = NULL;
+        }
+        p_src->elems_curr = entries;
+
+        list_chain_append(p_dst, p_first, p_last, moved);
+    }
+
+    adts_sanity_exit(&(p_src->sanity));
+    adts_sanity_exit(&(p_dst->sanity));
+
+exception:
+    return rc;
+} /* adts_list_split() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Merge two next linked, NULL terminated, sorted runs.  Ties are taken
+ *   from p_a, the earlier run, thus the merge is stable.
  *
+ ****************************************************************************
+ */
+static list_node_t *
+list_sort_merge( adts_list_cmp_t  cmp,
+                 list_node_t     *p_a,
+                 list_node_t     *p_b )
+{
+    list_node_t  *p_head  = NULL;
+    list_node_t **pp_tail = &(p_head);
+
+    while (p_a && p_b) {
+        if (cmp(&(p_a->pub), &(p_b->pub)) <= 0) {
+            *pp_tail = p_a;
+            p_a      = p_a->p_next;
+        } else {
+            *pp_tail = p_b;
+            p_b      = p_b->p_next;
+        }
+        pp_tail = &((*pp_tail)->p_next);
+    }
+    *pp_tail = p_a ? p_a : p_b;
+
+    return p_head;
+} /* list_sort_merge() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bottom-up merge sort, counting in binary.  pending[i] holds a sorted
+ *   run of 2^i nodes, each node taken from the list is carried upward
+ *   merging equal sized runs.  Merges thus operate on recently touched
+ *   nodes, rather than log(n) full passes over a list scattered in
+ *   memory.  The runs are next linked only, prev is restored in a final
+ *   pass.
  *
  ****************************************************************************
  */
 void
-adts_list_destroy( adts_list_t *p_adts_list )
+adts_list_sort( adts_list_t     *p_adts_list,
+                adts_list_cmp_t  cmp )
 {
-    list_t  *p_list = (list_t *) p_adts_list;
+    size_t         idx      = 0;
+    list_t        *p_list   = (list_t *) p_adts_list;
+    list_node_t   *p_next   = NULL;
+    list_node_t   *p_run    = NULL;
+    list_node_t   *p_prev   = NULL;
+    list_node_t   *pending[ 64 ];
+    adts_sanity_t *p_sanity = &(p_list->sanity);
 
-    free(p_list);
+    adts_sanity_entry(p_sanity);
+
+    if (p_list->elems_curr < 2) {
+        /* sorted */
+        goto exception;
+    }
+
+    memset(pending, 0, sizeof(pending));
+    for (list_node_t *p_node = p_list->p_head; p_node; p_node = p_next) {
+        p_next         = p_node->p_next;
+        p_node->p_next = NULL;
+        p_run          = p_node;
+
+        for (idx = 0; pending[idx]; idx++) {
+            p_run        = list_sort_merge(cmp, pending[idx], p_run);
+            pending[idx] = NULL;
+        }
+        pending[idx] = p_run;
+    }
+
+    /* fold the remaining runs, lower bins hold the later nodes */
+    p_run = NULL;
+    for (idx = 0; idx < (sizeof(pending) / sizeof(pending[0])); idx++) {
+        if (pending[idx]) {
+            p_run = list_sort_merge(cmp, pending[idx], p_run);
+        }
+    }
+
+    /* restore prev linkage */
+    p_list->p_head = p_run;
+    for (p_prev = NULL; p_run; p_run = p_run->p_next) {
+        p_run->p_prev = p_prev;
+        p_prev        = p_run;
+    }
+    p_list->p_tail = p_prev;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_list_sort() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Nodes are consumer owned and not included.
+ *
+ ****************************************************************************
+ */
+void
+adts_list_mem_stats( adts_list_t      *p_adts_list,
+                     adts_mem_stats_t *p_stats )
+{
+    list_t *p_list = (list_t *) p_adts_list;
+
+    *p_stats = p_list->mem;
+
+    return;
+} /* adts_list_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+void
+adts_list_destroy( adts_list_t *p_adts_list )
+{
+    list_t           *p_list = (list_t *) p_adts_list;
+    adts_mem_stats_t  mem    = {0};
+
+    if (NULL == p_list->p_arena) {
+        /* the record is released along with the handle */
+        mem = p_list->mem;
+        adts_mem_free_acct(&(mem), p_list, sizeof(adts_list_t),
+                           ADTS_MEM_ALIGN_DEFAULT);
+    }
 
     return;
 } /* adts_list_destroy() */
@@ -540,10 +824,50 @@ adts_list_destroy( adts_list_t *p_adts_list )
 adts_list_t *
 adts_list_create( void )
 {
-    return adts_mem_zalloc(sizeof(adts_list_t));
+    list_t           *p_list      = NULL;
+    adts_list_t      *p_adts_list = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_LIST);
+
+    p_adts_list = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_list),
+                                       ADTS_MEM_ALIGN_DEFAULT);
+    if (p_adts_list) {
+        p_list      = (list_t *) p_adts_list;
+        p_list->mem = mem;
+    }
+
+    return p_adts_list;
 } /* adts_list_create() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Nodes are consumer owned, only the handle is sourced from the arena.
+ *
+ ****************************************************************************
+ */
+adts_list_t *
+adts_list_create_arena( adts_arena_t *p_arena )
+{
+    list_t      *p_list      = NULL;
+    adts_list_t *p_adts_list = NULL;
+
+    if (NULL == p_arena) {
+        goto exception;
+    }
+
+    p_adts_list = adts_arena_zalloc(p_arena, sizeof(*p_adts_list));
+    if (p_adts_list) {
+        p_list           = (list_t *) p_adts_list;
+        p_list->p_arena  = p_arena;
+        p_list->mem.type = ADTS_MEM_TYPE_LIST;
+    }
+
+exception:
+    return p_adts_list;
+} /* adts_list_create_arena() */
+
+
 /******************************************************************************
  * #     # #     #   ###   ####### ####### #######  #####  #######  #####
  * #     # ##    #    #       #       #    #       #     #    #    #     #
@@ -679,6 +1003,222 @@ utest_list_bytes( void )
 } /* utest_list_bytes() */
 
 
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+utest_list_rand( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return *p_seed;
+} /* utest_list_rand() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Orders by p_data as an integer key.
+ *
+ ****************************************************************************
+ */
+static int32_t
+utest_list_cmp( const adts_list_node_public_t *p_a,
+                const adts_list_node_public_t *p_b )
+{
+    uintptr_t a = (uintptr_t) p_a->p_data;
+    uintptr_t b = (uintptr_t) p_b->p_data;
+
+    return (a > b) - (a < b);
+} /* utest_list_cmp() */
+
+
+static int
+utest_list_qsort_cmp( const void *p_a,
+                      const void *p_b )
+{
+    const adts_list_node_t *p_node_a = *(adts_list_node_t * const *) p_a;
+    const adts_list_node_t *p_node_b = *(adts_list_node_t * const *) p_b;
+
+    return utest_list_cmp(&(p_node_a->pub), &(p_node_b->pub));
+} /* utest_list_qsort_cmp() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Populate nodes[0 .. elems) with p_data = key % modulo and bytes = idx,
+ *   such that sort stability may be verified through bytes.
+ *
+ ****************************************************************************
+ */
+static void
+utest_list_nodes_init( adts_list_node_t *p_nodes,
+                       size_t            elems,
+                       uint64_t          modulo,
+                       uint64_t         *p_seed )
+{
+    for (size_t idx = 0; idx < elems; idx++) {
+        adts_list_node_public_t *p_pub =
+            (adts_list_node_public_t *) &(p_nodes[idx].pub);
+
+        memset(&(p_nodes[idx]), 0, sizeof(p_nodes[idx]));
+        p_pub->p_data = (void *) (uintptr_t) (utest_list_rand(p_seed) % modulo);
+        p_pub->bytes  = idx;
+    }
+
+    return;
+} /* utest_list_nodes_init() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Head to tail, verify prev linkage, count and, when sorted, key order
+ *   with ties in insertion order.
+ *
+ ****************************************************************************
+ */
+static void
+utest_list_walk_valid( adts_list_t *p_adts_list,
+                       bool         sorted )
+{
+    size_t                  count  = 0;
+    adts_list_node_t       *p_node = NULL;
+    const adts_list_node_t *p_prev = NULL;
+
+    for (p_node = adts_list_peek_head(p_adts_list);
+         p_node;
+         p_node = adts_list_node_peek_next(p_node)) {
+        assert(adts_list_node_peek_prev(p_node) == p_prev);
+        if (sorted && p_prev) {
+            int32_t cmp = utest_list_cmp(&(p_prev->pub), &(p_node->pub));
+
+            assert(cmp <= 0);
+            assert(cmp || (p_prev->pub.bytes < p_node->pub.bytes));
+        }
+        p_prev = p_node;
+        count++;
+    }
+    assert(adts_list_peek_tail(p_adts_list) == p_prev);
+    assert(adts_list_entries(p_adts_list) == count);
+
+    return;
+} /* utest_list_walk_valid() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Per element concatenation vs splice, and merge sort vs sorting an
+ *   array of node pointers then relinking.
+ *
+ ****************************************************************************
+ */
+static void
+utest_list_benchmark( void )
+{
+    const size_t       elems    = 1000 * 1000;
+    const size_t       lists    = 8;
+    uint64_t           seed     = 0x9E3779B97F4A7C15ULL;
+    uint64_t           t_loop   = 0;
+    uint64_t           t_splice = 0;
+    uint64_t           t_qsort  = 0;
+    uint64_t           t_sort   = 0;
+    uint64_t           t_sorted = 0;
+    adts_list_t       *p_dst    = NULL;
+    adts_list_t       *p_src[8] = {0};
+    adts_list_node_t  *p_nodes  = NULL;
+    adts_list_node_t  *p_node   = NULL;
+    adts_list_node_t **pp_array = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: adts_list splice and sort, %zu elems", elems);
+
+    p_nodes  = calloc(elems, sizeof(*p_nodes));
+    pp_array = calloc(elems, sizeof(*pp_array));
+    p_dst    = adts_list_create();
+    assert(p_nodes && pp_array && p_dst);
+
+    for (size_t ldx = 0; ldx < lists; ldx++) {
+        p_src[ldx] = adts_list_create();
+        assert(p_src[ldx]);
+    }
+
+    /* concatenate per thread lists, element at a time */
+    utest_list_nodes_init(p_nodes, elems, UINT32_MAX, &(seed));
+    for (size_t idx = 0; idx < elems; idx++) {
+        assert(0 == adts_list_append(p_src[idx % lists], &(p_nodes[idx])));
+    }
+    t_loop = adts_tstamp();
+    for (size_t ldx = 0; ldx < lists; ldx++) {
+        while ((p_node = adts_list_remove_head(p_src[ldx]))) {
+            assert(0 == adts_list_append(p_dst, p_node));
+        }
+    }
+    t_loop = adts_tstamp() - t_loop;
+
+    /* back out to the per thread lists, then splice */
+    assert(0 == adts_list_split(p_dst, 0, p_src[0]));
+    for (size_t ldx = 1; ldx < lists; ldx++) {
+        assert(0 == adts_list_split(p_src[0], elems - (elems / lists) * ldx,
+                                    p_src[ldx]));
+    }
+    t_splice = adts_tstamp();
+    for (size_t ldx = 0; ldx < lists; ldx++) {
+        assert(0 == adts_list_splice(p_dst, p_src[ldx]));
+    }
+    t_splice = adts_tstamp() - t_splice;
+    assert(elems == adts_list_entries(p_dst));
+
+    /* sort via an array of node pointers, then relink */
+    for (size_t idx = 0; idx < elems; idx++) {
+        pp_array[idx] = adts_list_remove_head(p_dst);
+    }
+    t_qsort = adts_tstamp();
+    qsort(pp_array, elems, sizeof(*pp_array), utest_list_qsort_cmp);
+    for (size_t idx = 0; idx < elems; idx++) {
+        assert(0 == adts_list_append(p_dst, pp_array[idx]));
+    }
+    t_qsort = adts_tstamp() - t_qsort;
+
+    /* in place merge sort, random then presorted order */
+    while (adts_list_remove_head(p_dst));
+    utest_list_nodes_init(p_nodes, elems, UINT32_MAX, &(seed));
+    for (size_t idx = 0; idx < elems; idx++) {
+        assert(0 == adts_list_append(p_dst, &(p_nodes[idx])));
+    }
+    t_sort = adts_tstamp();
+    adts_list_sort(p_dst, utest_list_cmp);
+    t_sort = adts_tstamp() - t_sort;
+    utest_list_walk_valid(p_dst, false);
+
+    t_sorted = adts_tstamp();
+    adts_list_sort(p_dst, utest_list_cmp);
+    t_sorted = adts_tstamp() - t_sorted;
+
+    CDISPLAY("concat %zu lists, total:  element at a time %llu ms  splice"
+             " %llu ns", lists, t_loop / (1000 * 1000), t_splice);
+    CDISPLAY("sort:  qsort + relink %llu ms  merge sort %llu ms  presorted"
+             " %llu ms", t_qsort / (1000 * 1000), t_sort / (1000 * 1000),
+             t_sorted / (1000 * 1000));
+
+    while (adts_list_remove_head(p_dst));
+    for (size_t ldx = 0; ldx < lists; ldx++) {
+        adts_list_destroy(p_src[ldx]);
+    }
+    adts_list_destroy(p_dst);
+    free(pp_array);
+    free(p_nodes);
+
+    return;
+} /* utest_list_benchmark() */
+
+
 /*
  ****************************************************************************
  * test control
@@ -796,6 +1336,26 @@ utest_control( void )
             adts_list_display(p_list);
         }
 
+        /* walk both directions */
+        {
+            adts_list_node_t *p_walk = NULL;
+
+            p_walk = adts_list_peek_head((adts_list_t *) p_list);
+
+            for (size_t i = 0; i < elems; i++) {
+                assert(p_walk == (adts_list_node_t *) &(nodes[i]));
+                p_walk = adts_list_node_peek_next(p_walk);
+            }
+            assert(NULL == p_walk);
+
+            p_walk = adts_list_peek_tail((adts_list_t *) p_list);
+            for (size_t i = elems; i > 0; i--) {
+                assert(p_walk == (adts_list_node_t *) &(nodes[i - 1]));
+                p_walk = adts_list_node_peek_prev(p_walk);
+            }
+            assert(NULL == p_walk);
+        }
+
         for (idx = idx - 1; idx >= 0; idx--) {
             (void) adts_list_remove_head(p_list);
             list_sanity(p_list);
@@ -840,6 +1400,77 @@ utest_control( void )
         adts_list_destroy(p_list);
     }
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: list splice -> split -> sort ");
+
+        const size_t       elems   = 1000;
+        uint64_t           seed    = 0x9E3779B97F4A7C15ULL;
+        adts_list_t       *p_a     = NULL;
+        adts_list_t       *p_b     = NULL;
+        adts_list_node_t  *p_nodes = NULL;
+        adts_list_node_t  *p_node  = NULL;
+        const size_t       at[]    = { 0, 1, 250, 999, 1000 };
+
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        p_a     = adts_list_create();
+        p_b     = adts_list_create();
+        assert(p_nodes && p_a && p_b);
+        utest_list_nodes_init(p_nodes, elems, 64, &(seed));
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_list_append((idx < 600) ? p_a : p_b,
+                                         &(p_nodes[idx])));
+        }
+        assert(EINVAL == adts_list_splice(p_a, p_a));
+        assert(0 == adts_list_splice(p_a, p_b));
+        assert(0 == adts_list_splice(p_a, p_b));
+        assert(adts_list_is_empty(p_b));
+        assert(NULL == adts_list_peek_head(p_b));
+        utest_list_walk_valid(p_a, false);
+        p_node = adts_list_peek_head(p_a);
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(p_node == &(p_nodes[idx]));
+            p_node = adts_list_node_peek_next(p_node);
+        }
+
+        /* split from either end, then rejoin */
+        assert(EINVAL == adts_list_split(p_a, elems + 1, p_b));
+        assert(EINVAL == adts_list_split(p_a, 0, p_a));
+        for (size_t sdx = 0; sdx < sizeof(at) / sizeof(at[0]); sdx++) {
+            assert(0 == adts_list_split(p_a, at[sdx], p_b));
+            assert(at[sdx] == adts_list_entries(p_a));
+            assert((elems - at[sdx]) == adts_list_entries(p_b));
+            utest_list_walk_valid(p_a, false);
+            utest_list_walk_valid(p_b, false);
+            if (at[sdx] < elems) {
+                assert(adts_list_peek_head(p_b) == &(p_nodes[at[sdx]]));
+            }
+
+            assert(0 == adts_list_splice(p_a, p_b));
+            assert(adts_list_is_valid(p_a));
+        }
+
+        /* stable: 64 keys over 1000 nodes, ties ordered by bytes */
+        adts_list_sort(p_a, utest_list_cmp);
+        utest_list_walk_valid(p_a, true);
+        adts_list_sort(p_a, utest_list_cmp);
+        utest_list_walk_valid(p_a, true);
+
+        while (adts_list_remove_head(p_a));
+        assert(0 == adts_list_append(p_a, &(p_nodes[0])));
+        adts_list_sort(p_a, utest_list_cmp);
+        utest_list_walk_valid(p_a, true);
+        (void) adts_list_remove_head(p_a);
+        adts_list_sort(p_a, utest_list_cmp);
+        assert(adts_list_is_empty(p_a));
+
+        adts_list_destroy(p_b);
+        adts_list_destroy(p_a);
+        free(p_nodes);
+    }
+
+    utest_list_benchmark();
 
     return;
 } /* utest_control() */
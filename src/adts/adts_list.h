@@ -3,6 +3,8 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 
 /**
  **************************************************************************
@@ -10,7 +12,7 @@
  *
  **************************************************************************
  */
-#define ADTS_LIST_BYTES      (64)
+#define ADTS_LIST_BYTES      (256)
 #define ADTS_LIST_ELEM_BYTES (64)
 
 typedef struct {
@@ -41,6 +43,93 @@ adts_list_is_empty( adts_list_t *p_adts_list );
 bool
 adts_list_is_not_empty( adts_list_t *p_adts_list );
 
+bool
+adts_list_is_invalid( adts_list_t *p_adts_list );
+
+bool
+adts_list_is_valid( adts_list_t *p_adts_list );
+
+size_t
+adts_list_entries( adts_list_t *p_adts_list );
+
+size_t
+adts_list_entries_max( adts_list_t *p_adts_list );
+
+void
+adts_list_reverse( adts_list_t *p_adts_list );
+
+adts_list_node_t *
+adts_list_peek_head( adts_list_t *p_adts_list );
+
+adts_list_node_t *
+adts_list_peek_tail( adts_list_t *p_adts_list );
+
+adts_list_node_t *
+adts_list_node_peek_next( adts_list_node_t *p_adts_list_node );
+
+adts_list_node_t *
+adts_list_node_peek_prev( adts_list_node_t *p_adts_list_node );
+
+int32_t
+adts_list_append( adts_list_t      *p_adts_list,
+                  adts_list_node_t *p_adts_list_node );
+int32_t
+adts_list_prepend( adts_list_t      *p_adts_list,
+                   adts_list_node_t *p_adts_list_node );
+adts_list_node_t *
+adts_list_remove_head( adts_list_t *p_adts_list );
+
+adts_list_node_t *
+adts_list_remove_tail( adts_list_t *p_adts_list );
+
+/**
+ **************************************************************************
+ * \details
+ *   Bulk operations, no allocation.
+ *
+ *   - splice: move every node of src to the tail of dst, O(1).  src is
+ *     left empty.  EINVAL if src and dst are the same list.
+ *   - split:  src retains its first entries nodes, the remainder is moved
+ *     to the tail of dst.  O(min(entries, n - entries)) to locate the
+ *     split point.  EINVAL if entries exceeds src, or src is dst.
+ *   - sort:   stable bottom-up merge sort, O(n log n) compares and O(1)
+ *     space.  cmp returns <0, 0, >0 as a orders before, equal to, or
+ *     after b.
+ *
+ *   A moved node's list reference is not rewritten, it serves only to
+ *   flag the node as linked, thus a node is owned by whichever list it
+ *   was last spliced or split into.
+ *
+ **************************************************************************
+ */
+typedef int32_t (*adts_list_cmp_t)( const adts_list_node_public_t *p_a,
+                                    const adts_list_node_public_t *p_b );
+
+int32_t
+adts_list_splice( adts_list_t *p_adts_list_dst,
+                  adts_list_t *p_adts_list_src );
+
+int32_t
+adts_list_split( adts_list_t *p_adts_list_src,
+                 size_t       entries,
+                 adts_list_t *p_adts_list_dst );
+
+void
+adts_list_sort( adts_list_t     *p_adts_list,
+                adts_list_cmp_t  cmp );
+
+void
+adts_list_mem_stats( adts_list_t      *p_adts_list,
+                     adts_mem_stats_t *p_stats );
+void
+adts_list_destroy( adts_list_t *p_adts_list );
+
+adts_list_t *
+adts_list_create_arena( adts_arena_t *p_arena );
+
+adts_list_t *
+adts_list_create( void );
+
 
 /**
  **************************************************************************
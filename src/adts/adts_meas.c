@@ -9,6 +9,7 @@
 
 /* Toolbox */
 #include <adts_meas.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -229,9 +230,11 @@ exception:
 int32_t
 adts_meas_destroy( void *p_handle )
 {
-    int32_t        rc       = 0;
-    meas_t        *p_meas   = (meas_t *) p_handle;
-    adts_sanity_t *p_sanity = NULL;
+    int32_t           rc       = 0;
+    size_t            bytes    = 0;
+    meas_t           *p_meas   = (meas_t *) p_handle;
+    adts_mem_stats_t  mem      = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_MEAS);
+    adts_sanity_t    *p_sanity = NULL;
 
     rc = meas_input_sanity(p_meas);
     if (rc) {
@@ -243,7 +246,13 @@ adts_meas_destroy( void *p_handle )
 
     p_meas->state = MEAS_FREE;
 
-    free(p_meas);
+    /*
+     * meas_t is sized by embedded consumers thus carries no instance
+     * record, only the per type totals are accounted.
+     */
+    bytes          = sizeof(meas_t) + (p_meas->entries * sizeof(meas_entry_t));
+    mem.bytes_curr = bytes;
+    adts_mem_free_acct(&(mem), p_meas, bytes, ADTS_MEM_ALIGN_DEFAULT);
 
 exception:
     /* No adts_sanity_exit() since we've freed the memory */
@@ -256,9 +265,10 @@ exception:
 void *
 adts_meas_create( uint32_t elems )
 {
-    uint32_t  bytes    = 0;
-    meas_t   *p_meas   = NULL;
-    void     *p_handle = NULL;
+    uint32_t          bytes    = 0;
+    meas_t           *p_meas   = NULL;
+    void             *p_handle = NULL;
+    adts_mem_stats_t  mem      = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_MEAS);
 
     if (elems < ADTS_MEAS_MIN_ENTRIES) {
         goto exception;
@@ -267,7 +277,7 @@ adts_meas_create( uint32_t elems )
     bytes  = sizeof(meas_t);
     bytes += (elems * sizeof(meas_entry_t));
 
-    p_meas = adts_mem_zalloc(bytes);
+    p_meas = adts_mem_zalloc_acct(&(mem), bytes, ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_meas) {
         goto exception;
     }
@@ -1,5 +1,447 @@
 
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+
+/* Toolbox */
+#include <adts_list.h>
+#include <adts_hash.h>
+#include <adts_heap.h>
+#include <adts_pool.h>
+#include <adts_ring.h>
+#include <adts_time.h>
+#include <adts_arena.h>
+#include <adts_queue.h>
+#include <adts_stack.h>
 #include <adts_memory.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - return idle size class chunks to the system
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Size classes are powers of 2 from ADTS_MEM_CLASS_BYTES_MIN through
+ *   ADTS_MEM_CLASS_BYTES_MAX.  Objects are carved from page aligned chunks,
+ *   thus every object is naturally aligned to its class size.
+ *
+ ****************************************************************************
+ */
+#define MEM_CLASS_SHIFT_MIN (6)   /**< log2(ADTS_MEM_CLASS_BYTES_MIN) */
+#define MEM_CLASS_SHIFT_MAX (11)  /**< log2(ADTS_MEM_CLASS_BYTES_MAX) */
+#define MEM_CLASSES         (MEM_CLASS_SHIFT_MAX - MEM_CLASS_SHIFT_MIN + 1)
+#define MEM_CHUNK_BYTES     (64 * 1024)
+
+#define MEM_ROUNDUP( _val, _align ) \
+    ((((_val) + (_align) - 1) / (_align)) * (_align))
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Free objects are chained through their first word.
+ *
+ ****************************************************************************
+ */
+typedef struct mem_obj_s {
+    struct mem_obj_s *p_next;
+} mem_obj_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    pthread_mutex_t  lock;
+    mem_obj_t       *p_free;   /**< recycled objects, not zeroed */
+    char            *p_carve;  /**< next uncarved object, zeroed */
+    char            *p_limit;
+    size_t           chunks;
+} mem_class_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef enum {
+    MEM_ROUTE_CLASS,
+    MEM_ROUTE_HEAP,
+    MEM_ROUTE_MMAP,
+    MEM_ROUTE_HUGE,
+} mem_route_t;
+
+
+static mem_class_t mem_classes[ MEM_CLASSES ] = {
+    [0 ... (MEM_CLASSES - 1)] = { .lock = PTHREAD_MUTEX_INITIALIZER },
+};
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Per type totals, updated atomically since instances of a type are
+ *   serialized independently of one another.
+ *
+ ****************************************************************************
+ */
+static adts_mem_stats_t mem_type_stats[ ADTS_MEM_TYPES ];
+
+static adts_mem_scrub_t mem_scrub = ADTS_MEM_SCRUB_DEFAULT;
+
+static const char *mem_type_names[ ADTS_MEM_TYPES ] = {
+    [ADTS_MEM_TYPE_OTHER]  = "other",
+    [ADTS_MEM_TYPE_ARENA]  = "arena",
+    [ADTS_MEM_TYPE_BTREE]  = "btree",
+    [ADTS_MEM_TYPE_GRAPH]  = "graph",
+    [ADTS_MEM_TYPE_HASH]   = "hash",
+    [ADTS_MEM_TYPE_HEAP]   = "heap",
+    [ADTS_MEM_TYPE_LIST]   = "list",
+    [ADTS_MEM_TYPE_MEAS]   = "meas",
+    [ADTS_MEM_TYPE_MULTIQ] = "multiq",
+    [ADTS_MEM_TYPE_PHEAP]  = "pheap",
+    [ADTS_MEM_TYPE_POOL]   = "pool",
+    [ADTS_MEM_TYPE_QUEUE]  = "queue",
+    [ADTS_MEM_TYPE_RBT]    = "rbt",
+    [ADTS_MEM_TYPE_REGION] = "region",
+    [ADTS_MEM_TYPE_RING]   = "ring",
+    [ADTS_MEM_TYPE_SORT]   = "sort",
+    [ADTS_MEM_TYPE_STACK]  = "stack",
+    [ADTS_MEM_TYPE_TIME]   = "time",
+    [ADTS_MEM_TYPE_TREE]   = "tree",
+};
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Deterministic routing such that the free path resolves the identical
+ *   origin given the identical inputs.
+ *
+ ****************************************************************************
+ */
+static inline mem_route_t
+mem_route( size_t  bytes,
+           size_t  align,
+           size_t *p_class )
+{
+    mem_route_t route = MEM_ROUTE_HEAP;
+    size_t      span  = MAX(MAX(bytes, align), ADTS_MEM_CLASS_BYTES_MIN);
+
+    if (ADTS_MEM_ALIGN_HUGEPAGE == align) {
+        route = MEM_ROUTE_HUGE;
+    }else if (span <= ADTS_MEM_CLASS_BYTES_MAX) {
+        /* ceil(log2(span)) via leading zero count */
+        *p_class = (64 - __builtin_clzll(span - 1)) - MEM_CLASS_SHIFT_MIN;
+        route    = MEM_ROUTE_CLASS;
+    }else if (bytes >= ADTS_MEM_MMAP_BYTES) {
+        route = MEM_ROUTE_MMAP;
+    }
+
+    return route;
+} /* mem_route() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Anonymous mappings are zero filled by the kernel.  Alignments beyond
+ *   the page size over-map and trim the excess.
+ *
+ ****************************************************************************
+ */
+static void *
+mem_mmap( size_t bytes,
+          size_t align )
+{
+    char   *p_mem = NULL;
+    size_t  page  = getpagesize();
+    size_t  len   = MEM_ROUNDUP(bytes, page);
+    size_t  extra = (align > page) ? align : 0;
+    size_t  head  = 0;
+    size_t  tail  = 0;
+
+    p_mem = mmap(NULL, len + extra, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == p_mem) {
+        p_mem = NULL;
+        goto exception;
+    }
+
+    if (extra) {
+        head = MEM_ROUNDUP((uintptr_t) p_mem, align) - (uintptr_t) p_mem;
+        tail = extra - head;
+        if (head) {
+            munmap(p_mem, head);
+        }
+        if (tail) {
+            munmap(p_mem + head + len, tail);
+        }
+        p_mem += head;
+    }
+
+exception:
+    return p_mem;
+} /* mem_mmap() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Reserved huge pages are preferred since backing is guaranteed.  The
+ *   fallback mapping is huge page aligned such that the kernel is able to
+ *   promote every huge page sized extent.
+ *
+ ****************************************************************************
+ */
+static void *
+mem_mmap_huge( size_t bytes )
+{
+    void   *p_mem = NULL;
+    size_t  len   = MEM_ROUNDUP(bytes, ADTS_MEM_HUGEPAGE_BYTES);
+
+#ifdef MAP_HUGETLB
+    p_mem = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (MAP_FAILED != p_mem) {
+        goto exception;
+    }
+#endif
+
+    p_mem = mem_mmap(len, ADTS_MEM_HUGEPAGE_BYTES);
+#ifdef MADV_HUGEPAGE
+    if (p_mem) {
+        /* advisory, failure leaves a usable regular mapping */
+        (void) madvise(p_mem, len, MADV_HUGEPAGE);
+    }
+#endif
+
+exception:
+    return p_mem;
+} /* mem_mmap_huge() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Apply the scrub policy to memory about to be released.
+ *
+ ****************************************************************************
+ */
+static inline void
+mem_scrub_apply( void   *p_mem,
+                 size_t  bytes )
+{
+    switch (__atomic_load_n(&(mem_scrub), __ATOMIC_RELAXED)) {
+        case ADTS_MEM_SCRUB_SECURE:
+            explicit_bzero(p_mem, bytes);
+            break;
+
+        case ADTS_MEM_SCRUB_POISON:
+            /* a store ahead of free() is otherwise dead and elided */
+            memset(p_mem, ADTS_MEM_POISON, bytes);
+            __asm__ volatile("" : : "r"(p_mem) : "memory");
+            break;
+
+        default:
+            break;
+    }
+
+    return;
+} /* mem_scrub_apply() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void *
+mem_class_alloc( size_t class,
+                 size_t bytes )
+{
+    void        *p_mem   = NULL;
+    bool         recycle = false;
+    size_t       size    = 1UL << (class + MEM_CLASS_SHIFT_MIN);
+    mem_class_t *p_class = &(mem_classes[class]);
+
+    pthread_mutex_lock(&(p_class->lock));
+
+    if (likely(p_class->p_free)) {
+        p_mem            = p_class->p_free;
+        p_class->p_free  = p_class->p_free->p_next;
+        recycle          = true;
+    }else {
+        if (unlikely((p_class->p_carve + size) > p_class->p_limit)) {
+            char *p_chunk = mem_mmap(MEM_CHUNK_BYTES, ADTS_MEM_ALIGN_PAGE);
+
+            if (unlikely(NULL == p_chunk)) {
+                goto exception;
+            }
+            p_class->p_carve = p_chunk;
+            p_class->p_limit = p_chunk + MEM_CHUNK_BYTES;
+            p_class->chunks++;
+        }
+
+        p_mem             = p_class->p_carve;
+        p_class->p_carve += size;
+    }
+
+exception:
+    pthread_mutex_unlock(&(p_class->lock));
+
+    if (recycle) {
+        /* fresh carves are zero courtesy of mmap() */
+        memset(p_mem, 0, bytes);
+    }
+
+    return p_mem;
+} /* mem_class_alloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+mem_class_free( size_t  class,
+                void   *p_mem )
+{
+    mem_obj_t   *p_obj   = p_mem;
+    mem_class_t *p_class = &(mem_classes[class]);
+
+    pthread_mutex_lock(&(p_class->lock));
+    p_obj->p_next   = p_class->p_free;
+    p_class->p_free = p_obj;
+    pthread_mutex_unlock(&(p_class->lock));
+
+    return;
+} /* mem_class_free() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline size_t
+mem_hist_bucket( size_t bytes )
+{
+    size_t bucket = 0;
+
+    if (bytes > ADTS_MEM_CLASS_BYTES_MIN) {
+        /* ceil(log2(bytes)) - log2(64) */
+        bucket = (64 - __builtin_clzll(bytes - 1)) - MEM_CLASS_SHIFT_MIN;
+    }
+
+    return MIN(bucket, ADTS_MEM_HIST_BUCKETS - 1);
+} /* mem_hist_bucket() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+mem_acct_charge( adts_mem_stats_t *p_stats,
+                 size_t            bytes )
+{
+    size_t            bucket = mem_hist_bucket(bytes);
+    size_t            curr   = 0;
+    size_t            peak   = 0;
+    adts_mem_stats_t *p_type = &(mem_type_stats[ADTS_MEM_TYPE_OTHER]);
+
+    if (p_stats) {
+        assert(p_stats->type < ADTS_MEM_TYPES);
+        p_type = &(mem_type_stats[p_stats->type]);
+
+        p_stats->bytes_curr += bytes;
+        p_stats->bytes_peak  = MAX(p_stats->bytes_peak, p_stats->bytes_curr);
+        p_stats->allocs++;
+        p_stats->hist[bucket]++;
+    }
+
+    curr = __atomic_add_fetch(&(p_type->bytes_curr), bytes, __ATOMIC_RELAXED);
+    peak = __atomic_load_n(&(p_type->bytes_peak), __ATOMIC_RELAXED);
+    while ((curr > peak) &&
+           !__atomic_compare_exchange_n(&(p_type->bytes_peak), &(peak), curr,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+        /* peak refreshed on failure */
+    }
+    /* type allocs are the histogram sum, see adts_mem_stats_type() */
+    __atomic_add_fetch(&(p_type->hist[bucket]), 1, __ATOMIC_RELAXED);
+
+    return;
+} /* mem_acct_charge() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+mem_acct_credit( adts_mem_stats_t *p_stats,
+                 size_t            bytes )
+{
+    adts_mem_stats_t *p_type = &(mem_type_stats[ADTS_MEM_TYPE_OTHER]);
+
+    if (p_stats) {
+        assert(p_stats->bytes_curr >= bytes);
+        p_type = &(mem_type_stats[p_stats->type]);
+
+        p_stats->bytes_curr -= bytes;
+        p_stats->frees++;
+    }
+
+    __atomic_sub_fetch(&(p_type->bytes_curr), bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&(p_type->frees), 1, __ATOMIC_RELAXED);
+
+    return;
+} /* mem_acct_credit() */
 
 
 /*
@@ -25,3 +467,906 @@ adts_mem_zalloc( size_t bytes )
 exception:
     return p_mem;
 } /* adts_mem_zalloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void *
+adts_mem_zalloc_ext( size_t bytes,
+                     size_t align )
+{
+    void    *p_mem = NULL;
+    size_t   class = 0;
+    int32_t  rc    = 0;
+
+    if (ADTS_MEM_ALIGN_DEFAULT == align) {
+        align = ADTS_MEM_ALIGN_CACHELINE;
+    }
+
+    if (unlikely((0 == bytes) || (align & (align - 1)))) {
+        goto exception;
+    }
+
+    switch (mem_route(bytes, align, &class)) {
+        case MEM_ROUTE_CLASS:
+            p_mem = mem_class_alloc(class, bytes);
+            break;
+
+        case MEM_ROUTE_MMAP:
+            p_mem = mem_mmap(bytes, align);
+            break;
+
+        case MEM_ROUTE_HUGE:
+            p_mem = mem_mmap_huge(bytes);
+            break;
+
+        case MEM_ROUTE_HEAP:
+            rc = posix_memalign(&(p_mem), align, bytes);
+            if (rc) {
+                p_mem = NULL;
+                goto exception;
+            }
+            memset(p_mem, 0, bytes);
+            break;
+
+        default:
+            assert(0);
+    }
+
+exception:
+    return p_mem;
+} /* adts_mem_zalloc_ext() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   NULL is tolerated.
+ *
+ ****************************************************************************
+ */
+void
+adts_mem_free_ext( void   *p_mem,
+                   size_t  bytes,
+                   size_t  align )
+{
+    size_t class = 0;
+
+    if (NULL == p_mem) {
+        goto exception;
+    }
+
+    if (ADTS_MEM_ALIGN_DEFAULT == align) {
+        align = ADTS_MEM_ALIGN_CACHELINE;
+    }
+
+    switch (mem_route(bytes, align, &class)) {
+        case MEM_ROUTE_CLASS:
+            mem_scrub_apply(p_mem, bytes);
+            mem_class_free(class, p_mem);
+            break;
+
+        case MEM_ROUTE_MMAP:
+            /* never scrubbed, see ADTS_MEM_SCRUB_NONE */
+            munmap(p_mem, MEM_ROUNDUP(bytes, getpagesize()));
+            break;
+
+        case MEM_ROUTE_HUGE:
+            munmap(p_mem, MEM_ROUNDUP(bytes, ADTS_MEM_HUGEPAGE_BYTES));
+            break;
+
+        case MEM_ROUTE_HEAP:
+            mem_scrub_apply(p_mem, bytes);
+            free(p_mem);
+            break;
+
+        default:
+            assert(0);
+    }
+
+exception:
+    return;
+} /* adts_mem_free_ext() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_mem_scrub_set( adts_mem_scrub_t policy )
+{
+    int32_t rc = 0;
+
+    if (policy >= ADTS_MEM_SCRUBS) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    __atomic_store_n(&(mem_scrub), policy, __ATOMIC_RELAXED);
+
+exception:
+    return rc;
+} /* adts_mem_scrub_set() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_mem_scrub_t
+adts_mem_scrub_get( void )
+{
+    return __atomic_load_n(&(mem_scrub), __ATOMIC_RELAXED);
+} /* adts_mem_scrub_get() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void *
+adts_mem_zalloc_acct( adts_mem_stats_t *p_stats,
+                      size_t            bytes,
+                      size_t            align )
+{
+    void *p_mem = NULL;
+
+    p_mem = adts_mem_zalloc_ext(bytes, align);
+    if (likely(p_mem)) {
+        mem_acct_charge(p_stats, bytes);
+    }
+
+    return p_mem;
+} /* adts_mem_zalloc_acct() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   NULL is tolerated and not accounted.
+ *
+ ****************************************************************************
+ */
+void
+adts_mem_free_acct( adts_mem_stats_t *p_stats,
+                    void             *p_mem,
+                    size_t            bytes,
+                    size_t            align )
+{
+    if (p_mem) {
+        mem_acct_credit(p_stats, bytes);
+        adts_mem_free_ext(p_mem, bytes, align);
+    }
+
+    return;
+} /* adts_mem_free_acct() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+const char *
+adts_mem_type_name( adts_mem_type_t type )
+{
+    const char *p_name = "invalid";
+
+    if (type < ADTS_MEM_TYPES) {
+        p_name = mem_type_names[type];
+    }
+
+    return p_name;
+} /* adts_mem_type_name() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_mem_stats_type( adts_mem_type_t   type,
+                     adts_mem_stats_t *p_stats )
+{
+    adts_mem_stats_t *p_type = NULL;
+
+    memset(p_stats, 0, sizeof(*p_stats));
+    if (type >= ADTS_MEM_TYPES) {
+        goto exception;
+    }
+
+    p_type              = &(mem_type_stats[type]);
+    p_stats->type       = type;
+    p_stats->bytes_curr = __atomic_load_n(&(p_type->bytes_curr), __ATOMIC_RELAXED);
+    p_stats->bytes_peak = __atomic_load_n(&(p_type->bytes_peak), __ATOMIC_RELAXED);
+    p_stats->frees      = __atomic_load_n(&(p_type->frees), __ATOMIC_RELAXED);
+    for (size_t idx = 0; idx < ADTS_MEM_HIST_BUCKETS; idx++) {
+        p_stats->hist[idx] = __atomic_load_n(&(p_type->hist[idx]),
+                                             __ATOMIC_RELAXED);
+        p_stats->allocs   += p_stats->hist[idx];
+    }
+
+exception:
+    return;
+} /* adts_mem_stats_type() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_mem_stats_display( const adts_mem_stats_t *p_stats )
+{
+    printf("%-6s  curr: %zu  peak: %zu  allocs: %zu  frees: %zu\n",
+           adts_mem_type_name(p_stats->type),
+           p_stats->bytes_curr,
+           p_stats->bytes_peak,
+           p_stats->allocs,
+           p_stats->frees);
+
+    for (size_t idx = 0; idx < ADTS_MEM_HIST_BUCKETS; idx++) {
+        size_t      limit = (size_t) ADTS_MEM_CLASS_BYTES_MIN << idx;
+        const char *p_op  = "<=";
+
+        /* the last bucket is open ended */
+        if ((ADTS_MEM_HIST_BUCKETS - 1) == idx) {
+            limit >>= 1;
+            p_op    = "> ";
+        }
+
+        if (p_stats->hist[idx]) {
+            printf("    %s %8zu: %zu\n", p_op, limit, p_stats->hist[idx]);
+        }
+    }
+
+    return;
+} /* adts_mem_stats_display() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_mem_align_hugepage( size_t bytes )
+{
+    size_t align = ADTS_MEM_ALIGN_DEFAULT;
+
+    if (bytes >= ADTS_MEM_HUGEPAGE_BYTES) {
+        align = ADTS_MEM_ALIGN_HUGEPAGE;
+    }
+
+    return align;
+} /* adts_mem_align_hugepage() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sum the transparent and hugetlb backed sizes of the mapping holding
+ *   p_mem.  The kernel may merge adjacent mappings with identical
+ *   attributes, thus the result is clamped to the allocation itself.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_mem_hugepage_bytes( const void *p_mem,
+                         size_t      bytes )
+{
+    FILE      *p_file = NULL;
+    char       line[256];
+    bool       found  = false;
+    size_t     kbytes = 0;
+    size_t     huge   = 0;
+    uintptr_t  addr   = (uintptr_t) p_mem;
+
+    if (NULL == p_mem) {
+        goto exception;
+    }
+
+    p_file = fopen("/proc/self/smaps", "r");
+    if (NULL == p_file) {
+        goto exception;
+    }
+
+    while (fgets(line, sizeof(line), p_file)) {
+        uintptr_t start = 0;
+        uintptr_t end   = 0;
+
+        if (2 == sscanf(line, "%" SCNxPTR "-%" SCNxPTR " ", &start, &end)) {
+            /* mapping header, fields of interest follow */
+            if (found) {
+                break;
+            }
+            found = ((start <= addr) && (addr < end));
+            continue;
+        }
+
+        if (found &&
+            ((1 == sscanf(line, "AnonHugePages: %zu kB", &kbytes)) ||
+             (1 == sscanf(line, "Private_Hugetlb: %zu kB", &kbytes)) ||
+             (1 == sscanf(line, "Shared_Hugetlb: %zu kB", &kbytes)))) {
+            huge += kbytes * 1024;
+        }
+    }
+
+    fclose(p_file);
+
+    huge = MIN(huge, MEM_ROUNDUP(bytes, ADTS_MEM_HUGEPAGE_BYTES));
+
+exception:
+    return huge;
+} /* adts_mem_hugepage_bytes() */
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+#define UTEST_MEM_ITERS (100000)
+#define UTEST_MEM_ADTS  (10000)
+
+#define UTEST_MEM_HUGE_ELEMS (512 * 1024)
+#define UTEST_MEM_TLB_BYTES  (512 * 1024 * 1024)
+#define UTEST_MEM_TLB_READS  (10 * 1000 * 1000)
+#define UTEST_MEM_SCRUB_ITERS (200)
+
+/* defeat dead store elimination of the zero fill */
+#define UTEST_MEM_ESCAPE( _p ) __asm__ volatile("" : : "r"(_p) : "memory")
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static bool
+utest_mem_is_zero( const char *p_mem,
+                   size_t      bytes )
+{
+    bool rc = true;
+
+    for (size_t idx = 0; idx < bytes; idx++) {
+        if (p_mem[idx]) {
+            rc = false;
+            break;
+        }
+    }
+
+    return rc;
+} /* utest_mem_is_zero() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static hash_idx_t
+utest_mem_hash( struct hash_s *p_hash,
+                const void    *p_key )
+{
+    adts_hash_t *p_adts_hash = (adts_hash_t *) p_hash;
+
+    return (uintptr_t) p_key % p_adts_hash->pub.elems_limit;
+} /* utest_mem_hash() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Raw allocate + free throughput, legacy page aligned vs routed.
+ *
+ ****************************************************************************
+ */
+static void
+utest_mem_benchmark_raw( void )
+{
+    const size_t sizes[] = { 64, 256, 1024, 8192, 256 * 1024 };
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: zalloc + free, legacy vs ext");
+
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx++) {
+        uint64_t start  = 0;
+        uint64_t legacy = 0;
+        uint64_t ext    = 0;
+        size_t   bytes  = sizes[idx];
+        size_t   iters  = (bytes >= ADTS_MEM_MMAP_BYTES) ? 1000 : UTEST_MEM_ITERS;
+
+        start = adts_tstamp();
+        for (size_t iter = 0; iter < iters; iter++) {
+            void *p_mem = adts_mem_zalloc(bytes);
+
+            assert(p_mem);
+            UTEST_MEM_ESCAPE(p_mem);
+            free(p_mem);
+        }
+        legacy = (adts_tstamp() - start) / iters;
+
+        start = adts_tstamp();
+        for (size_t iter = 0; iter < iters; iter++) {
+            void *p_mem = adts_mem_zalloc_ext(bytes, ADTS_MEM_ALIGN_DEFAULT);
+
+            assert(p_mem);
+            UTEST_MEM_ESCAPE(p_mem);
+            adts_mem_free_ext(p_mem, bytes, ADTS_MEM_ALIGN_DEFAULT);
+        }
+        ext = (adts_tstamp() - start) / iters;
+
+        CDISPLAY("bytes: %8zu  legacy: %6llu ns  ext: %6llu ns",
+                bytes, legacy, ext);
+    }
+
+    return;
+} /* utest_mem_benchmark_raw() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   ADT create + destroy throughput.
+ *
+ ****************************************************************************
+ */
+#define UTEST_MEM_BENCH( _name, _create, _destroy )                  \
+    do {                                                             \
+        uint64_t _start = adts_tstamp();                             \
+                                                                     \
+        for (size_t _iter = 0; _iter < UTEST_MEM_ADTS; _iter++) {    \
+            void *_p_adt = (_create);                                \
+                                                                     \
+            assert(_p_adt);                                          \
+            _destroy(_p_adt);                                        \
+        }                                                            \
+        CDISPLAY("%-6s create + destroy: %6llu ns",                  \
+                _name,                                               \
+                (adts_tstamp() - _start) / UTEST_MEM_ADTS);          \
+    } while (0)
+
+static void
+utest_mem_benchmark_adts( void )
+{
+    adts_hash_create_t hash_op = {0};
+    adts_pool_create_t pool_op = {0};
+
+    hash_op.p_func    = utest_mem_hash;
+    pool_op.obj_bytes = 64;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: ADT create + destroy");
+
+    UTEST_MEM_BENCH("stack", adts_stack_create(), adts_stack_destroy);
+    UTEST_MEM_BENCH("queue", adts_queue_create(), adts_queue_destroy);
+    UTEST_MEM_BENCH("list",  adts_list_create(),  adts_list_destroy);
+    UTEST_MEM_BENCH("hash",  adts_hash_create(&hash_op), adts_hash_destroy);
+    UTEST_MEM_BENCH("heap",  adts_heap_create(ADTS_HEAP_MIN), adts_heap_destroy);
+    UTEST_MEM_BENCH("ring",  adts_ring_create(64, 64), adts_ring_destroy);
+    UTEST_MEM_BENCH("pool",  adts_pool_create(&pool_op), adts_pool_destroy);
+    UTEST_MEM_BENCH("arena", adts_arena_create(0), adts_arena_destroy);
+
+    return;
+} /* utest_mem_benchmark_adts() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Hash teardown per scrub policy, the workspace is populated such that
+ *   every page is resident.  legacy is the memset + free previously done
+ *   unconditionally by adts_hash_destroy().
+ *
+ ****************************************************************************
+ */
+static void
+utest_mem_benchmark_scrub( void )
+{
+    const size_t           elems[]    = { 16 * 1024, 1024 * 1024 };
+    const adts_mem_scrub_t policies[] = { ADTS_MEM_SCRUB_NONE,
+                                          ADTS_MEM_SCRUB_SECURE,
+                                          ADTS_MEM_SCRUB_POISON };
+    const char            *names[]    = { "none", "secure", "poison" };
+    adts_mem_scrub_t       policy     = adts_mem_scrub_get();
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: hash destroy per scrub policy");
+
+    for (size_t edx = 0; edx < sizeof(elems) / sizeof(elems[0]); edx++) {
+        size_t            bytes   = elems[edx] * sizeof(void *);
+        size_t            stride  = ADTS_MEM_ALIGN_PAGE / sizeof(void *);
+        uint64_t          legacy  = 0;
+        adts_hash_node_t *p_nodes = calloc(elems[edx] / stride, sizeof(*p_nodes));
+
+        assert(p_nodes);
+
+        for (size_t iter = 0; iter < UTEST_MEM_SCRUB_ITERS; iter++) {
+            void     *p_mem = adts_mem_zalloc_ext(bytes, 0);
+            uint64_t  start = 0;
+
+            memset(p_mem, 1, bytes);
+            start = adts_tstamp();
+            memset(p_mem, 0, bytes);
+            UTEST_MEM_ESCAPE(p_mem);
+            adts_mem_free_ext(p_mem, bytes, 0);
+            legacy += adts_tstamp() - start;
+        }
+
+        CDISPLAY("elems: %8zu  %-6s  destroy: %8llu ns",
+                 elems[edx], "legacy", legacy / UTEST_MEM_SCRUB_ITERS);
+
+        for (size_t pdx = 0; pdx < sizeof(policies) / sizeof(policies[0]); pdx++) {
+            uint64_t           total   = 0;
+            adts_hash_create_t hash_op = {0};
+
+            hash_op.options                   = ADTS_HASH_OPTS_DISABLE_RESIZE;
+            hash_op.p_func                    = utest_mem_hash;
+            hash_op.opts.disable_resize.elems = elems[edx];
+
+            adts_mem_scrub_set(policies[pdx]);
+            for (size_t iter = 0; iter < UTEST_MEM_SCRUB_ITERS; iter++) {
+                uint64_t     start  = 0;
+                adts_hash_t *p_hash = adts_hash_create(&hash_op);
+
+                assert(p_hash);
+
+                /* a single slot per page */
+                for (size_t idx = 0; idx < (elems[edx] / stride); idx++) {
+                    adts_hash_node_public_t input = {0};
+
+                    input.p_key = (void *) (idx * stride);
+                    assert(0 == adts_hash_insert(p_hash, &(p_nodes[idx]), &input));
+                }
+
+                start = adts_tstamp();
+                adts_hash_destroy(p_hash);
+                total += adts_tstamp() - start;
+            }
+
+            CDISPLAY("elems: %8zu  %-6s  destroy: %8llu ns",
+                     elems[edx], names[pdx], total / UTEST_MEM_SCRUB_ITERS);
+        }
+
+        free(p_nodes);
+    }
+
+    adts_mem_scrub_set(policy);
+
+    return;
+} /* utest_mem_benchmark_scrub() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Random reads over a workspace well beyond dTLB reach, regular pages vs
+ *   huge page placement.
+ *
+ ****************************************************************************
+ */
+static void
+utest_mem_benchmark_hugepage( void )
+{
+    const size_t bytes = UTEST_MEM_TLB_BYTES;
+    const size_t elems = bytes / sizeof(uint64_t);
+    const size_t align[] = { ADTS_MEM_ALIGN_PAGE, ADTS_MEM_ALIGN_HUGEPAGE };
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: random reads over %zu MB", bytes >> 20);
+
+    for (size_t adx = 0; adx < sizeof(align) / sizeof(align[0]); adx++) {
+        uint64_t  start  = 0;
+        uint64_t  sum    = 0;
+        uint64_t  seed   = 0x9E3779B97F4A7C15ULL;
+        uint64_t *p_mem  = adts_mem_zalloc_ext(bytes, align[adx]);
+
+        assert(p_mem);
+        memset(p_mem, 1, bytes);
+
+        start = adts_tstamp();
+        for (size_t iter = 0; iter < UTEST_MEM_TLB_READS; iter++) {
+            /* xorshift, cheap enough to not mask the miss */
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            sum  += p_mem[seed % elems];
+        }
+
+        CDISPLAY("%-9s %5llu ns/read  huge backed: %zu MB  (%llu)",
+                 (ADTS_MEM_ALIGN_HUGEPAGE == align[adx]) ? "hugepage" : "page",
+                 (adts_tstamp() - start) / UTEST_MEM_TLB_READS,
+                 adts_mem_hugepage_bytes(p_mem, bytes) >> 20,
+                 sum);
+
+        adts_mem_free_ext(p_mem, bytes, align[adx]);
+    }
+
+    return;
+} /* utest_mem_benchmark_hugepage() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: routing and alignment");
+
+        const size_t sizes[]  = { 1, 63, 64, 65, 2048, 2049, 65536, 100000 };
+        const size_t aligns[] = { ADTS_MEM_ALIGN_DEFAULT, 16, 64, 256,
+                                  ADTS_MEM_ALIGN_PAGE, ADTS_MEM_ALIGN_HUGEPAGE };
+
+        for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+            for (size_t adx = 0; adx < sizeof(aligns) / sizeof(aligns[0]); adx++) {
+                size_t  bytes = sizes[sdx];
+                size_t  align = aligns[adx];
+                char   *p_mem = adts_mem_zalloc_ext(bytes, align);
+
+                assert(p_mem);
+                assert(0 == ((uintptr_t) p_mem % MAX(align, ADTS_MEM_ALIGN_CACHELINE)));
+                assert(utest_mem_is_zero(p_mem, bytes));
+
+                /* dirty the memory such that reuse must clear it */
+                memset(p_mem, 0xA5, bytes);
+                adts_mem_free_ext(p_mem, bytes, align);
+            }
+        }
+
+        assert(NULL == adts_mem_zalloc_ext(64, 3));
+        assert(NULL == adts_mem_zalloc_ext(0, 0));
+        adts_mem_free_ext(NULL, 64, 0);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: size class reuse is zeroed");
+
+        char *p_a = adts_mem_zalloc_ext(100, 0);
+        char *p_b = NULL;
+
+        memset(p_a, 0xFF, 100);
+        adts_mem_free_ext(p_a, 100, 0);
+
+        p_b = adts_mem_zalloc_ext(128, 0);
+        assert(p_a == p_b);
+        assert(utest_mem_is_zero(p_b, 128));
+        adts_mem_free_ext(p_b, 128, 0);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: huge page workspaces");
+
+        adts_hash_create_t  hash_op  = {0};
+        adts_stack_create_t stack_op = {0};
+        adts_heap_create_t  heap_op  = {0};
+        adts_hash_t        *p_hash   = NULL;
+        adts_stack_t       *p_stack  = NULL;
+        adts_heap_t        *p_heap   = NULL;
+        adts_heap_node_t   *p_nodes  = NULL;
+        const size_t        elems    = UTEST_MEM_HUGE_ELEMS;
+
+        assert(ADTS_MEM_ALIGN_DEFAULT == adts_mem_align_hugepage(4096));
+        assert(ADTS_MEM_ALIGN_HUGEPAGE ==
+               adts_mem_align_hugepage(ADTS_MEM_HUGEPAGE_BYTES));
+
+        hash_op.options                   = ADTS_HASH_OPTS_DISABLE_RESIZE |
+                                            ADTS_HASH_OPTS_HUGEPAGE;
+        hash_op.p_func                    = utest_mem_hash;
+        hash_op.opts.disable_resize.elems = elems;
+        p_hash = adts_hash_create(&hash_op);
+        assert(p_hash);
+
+        stack_op.options = ADTS_STACK_OPTS_HUGEPAGE;
+        p_stack = adts_stack_create_ext(&stack_op);
+        assert(p_stack);
+
+        heap_op.type    = ADTS_HEAP_MIN;
+        heap_op.options = ADTS_HEAP_OPTS_HUGEPAGE;
+        p_heap = adts_heap_create_ext(&heap_op);
+        assert(p_heap);
+
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        /* workspaces start below a huge page */
+        assert(0 == adts_stack_hugepage_bytes(p_stack));
+        assert(0 == adts_heap_hugepage_bytes(p_heap));
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            int32_t rc = 0;
+
+            rc = adts_stack_push(p_stack, (void *) idx, sizeof(idx));
+            assert(0 == rc);
+            rc = adts_heap_push(p_heap, &(p_nodes[idx]), p_nodes, sizeof(idx), idx);
+            assert(0 == rc);
+        }
+
+        /* backing is at the discretion of the kernel, report it */
+        CDISPLAY("hash:  %zu bytes huge page backed",
+                 adts_hash_hugepage_bytes(p_hash));
+        CDISPLAY("stack: %zu bytes huge page backed",
+                 adts_stack_hugepage_bytes(p_stack));
+        CDISPLAY("heap:  %zu bytes huge page backed",
+                 adts_heap_hugepage_bytes(p_heap));
+
+        adts_hash_destroy(p_hash);
+        adts_stack_destroy(p_stack);
+        adts_heap_destroy(p_heap);
+        free(p_nodes);
+
+        /* invalid options */
+        stack_op.options = (1 << 7);
+        assert(NULL == adts_stack_create_ext(&stack_op));
+        heap_op.options  = (1 << 7);
+        assert(NULL == adts_heap_create_ext(&heap_op));
+        hash_op.options |= (1 << 7);
+        assert(NULL == adts_hash_create(&hash_op));
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: accounting");
+
+        adts_mem_stats_t    base     = {0};
+        adts_mem_stats_t    type     = {0};
+        adts_mem_stats_t    inst     = {0};
+        adts_mem_stats_t    owner    = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_OTHER);
+        adts_pool_create_t  pool_op  = {0};
+        adts_stack_t       *p_stack  = NULL;
+        adts_pool_t        *p_pool   = NULL;
+        size_t              hist     = 0;
+        void               *p_mem    = NULL;
+
+        assert(0 == strcmp("stack", adts_mem_type_name(ADTS_MEM_TYPE_STACK)));
+        assert(0 == strcmp("invalid", adts_mem_type_name(ADTS_MEM_TYPES)));
+
+        /* bucket boundaries */
+        p_mem = adts_mem_zalloc_acct(&(owner), 64, 0);
+        adts_mem_free_acct(&(owner), p_mem, 64, 0);
+        p_mem = adts_mem_zalloc_acct(&(owner), 65, 0);
+        adts_mem_free_acct(&(owner), p_mem, 65, 0);
+        p_mem = adts_mem_zalloc_acct(&(owner), ADTS_MEM_HUGEPAGE_BYTES, 0);
+        adts_mem_free_acct(&(owner), p_mem, ADTS_MEM_HUGEPAGE_BYTES, 0);
+        assert(1 == owner.hist[0]);
+        assert(1 == owner.hist[1]);
+        assert(1 == owner.hist[ADTS_MEM_HIST_BUCKETS - 1]);
+        assert(3 == owner.allocs);
+        assert(3 == owner.frees);
+        assert(0 == owner.bytes_curr);
+        assert(ADTS_MEM_HUGEPAGE_BYTES == owner.bytes_peak);
+
+        /* instance record follows workspace growth */
+        adts_mem_stats_type(ADTS_MEM_TYPE_STACK, &base);
+
+        p_stack = adts_stack_create();
+        assert(p_stack);
+        adts_stack_mem_stats(p_stack, &inst);
+        assert(ADTS_MEM_TYPE_STACK == inst.type);
+        assert(2 == inst.allocs);
+        assert(0 == inst.frees);
+
+        for (size_t idx = 0; idx < UTEST_MEM_HUGE_ELEMS; idx++) {
+            adts_stack_push(p_stack, (void *) idx, sizeof(idx));
+        }
+
+        adts_stack_mem_stats(p_stack, &inst);
+        assert(inst.allocs > 2);
+        assert(inst.allocs == inst.frees + 2);
+        assert(inst.bytes_peak >= inst.bytes_curr);
+        assert(inst.bytes_curr > UTEST_MEM_HUGE_ELEMS * sizeof(void *));
+        for (size_t idx = 0; idx < ADTS_MEM_HIST_BUCKETS; idx++) {
+            hist += inst.hist[idx];
+        }
+        assert(hist == inst.allocs);
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_STACK, &type);
+        assert(type.bytes_curr == base.bytes_curr + inst.bytes_curr);
+        adts_mem_stats_display(&inst);
+
+        /* type totals return to baseline */
+        adts_stack_destroy(p_stack);
+        adts_mem_stats_type(ADTS_MEM_TYPE_STACK, &type);
+        assert(type.bytes_curr == base.bytes_curr);
+        assert(type.allocs - base.allocs == type.frees - base.frees);
+
+        /* a pool charges its owner, and reports the owner record */
+        owner             = (adts_mem_stats_t) ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_GRAPH);
+        pool_op.obj_bytes = 64;
+        pool_op.p_stats   = &(owner);
+        p_pool = adts_pool_create(&pool_op);
+        assert(p_pool);
+        assert(adts_pool_alloc(p_pool));
+        assert(owner.bytes_curr > 0);
+        adts_pool_mem_stats(p_pool, &inst);
+        assert(ADTS_MEM_TYPE_GRAPH == inst.type);
+        assert(owner.bytes_curr == inst.bytes_curr);
+        adts_pool_destroy(p_pool);
+        assert(0 == owner.bytes_curr);
+        assert(owner.allocs == owner.frees);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: scrub policy");
+
+        const size_t      bytes  = 256;
+        adts_mem_scrub_t  policy = adts_mem_scrub_get();
+        char             *p_mem  = NULL;
+
+        assert(ADTS_MEM_SCRUB_DEFAULT == policy);
+        assert(EINVAL == adts_mem_scrub_set(ADTS_MEM_SCRUBS));
+
+        /* size classes retain the memory, the first word is the free link */
+        assert(0 == adts_mem_scrub_set(ADTS_MEM_SCRUB_POISON));
+        p_mem = adts_mem_zalloc_ext(bytes, 0);
+        adts_mem_free_ext(p_mem, bytes, 0);
+        for (size_t idx = sizeof(void *); idx < bytes; idx++) {
+            assert(ADTS_MEM_POISON == (uint8_t) p_mem[idx]);
+        }
+
+        /* reuse is zeroed regardless of the policy */
+        assert(p_mem == adts_mem_zalloc_ext(bytes, 0));
+        assert(utest_mem_is_zero(p_mem, bytes));
+        memset(p_mem, 0xFF, bytes);
+
+        assert(0 == adts_mem_scrub_set(ADTS_MEM_SCRUB_SECURE));
+        adts_mem_free_ext(p_mem, bytes, 0);
+        assert(utest_mem_is_zero(p_mem + sizeof(void *), bytes - sizeof(void *)));
+
+        assert(p_mem == adts_mem_zalloc_ext(bytes, 0));
+        memset(p_mem, 0xFF, bytes);
+
+        assert(0 == adts_mem_scrub_set(ADTS_MEM_SCRUB_NONE));
+        adts_mem_free_ext(p_mem, bytes, 0);
+        assert((char) 0xFF == p_mem[bytes - 1]);
+
+        adts_mem_scrub_set(policy);
+    }
+
+    utest_mem_benchmark_raw();
+    utest_mem_benchmark_adts();
+    utest_mem_benchmark_scrub();
+    utest_mem_benchmark_hugepage();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_memory( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_memory() */
@@ -15,6 +15,148 @@
  #####     #    #     #  #####   #####     #     #####  #     # #######  #####
 ******************************************************************************/
 
+/**
+ **************************************************************************
+ * \details
+ *   Alignment selectors for adts_mem_zalloc_ext().  Any power of 2 is
+ *   accepted, ADTS_MEM_ALIGN_DEFAULT selects the cacheline.
+ *
+ **************************************************************************
+ */
+#define ADTS_MEM_ALIGN_DEFAULT   (0)
+#define ADTS_MEM_ALIGN_CACHELINE (64)
+#define ADTS_MEM_ALIGN_PAGE      (4096)
+#define ADTS_MEM_ALIGN_HUGEPAGE  (ADTS_MEM_HUGEPAGE_BYTES)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Requests aligned to ADTS_MEM_ALIGN_HUGEPAGE are rounded up to a whole
+ *   number of huge pages and placed in a MAP_HUGETLB mapping when the
+ *   system has huge pages reserved.  Otherwise a huge page aligned mapping
+ *   is advised via MADV_HUGEPAGE such that transparent huge pages may back
+ *   it.  Workspaces below ADTS_MEM_HUGEPAGE_BYTES gain nothing from huge
+ *   pages, see adts_mem_align_hugepage().
+ *
+ **************************************************************************
+ */
+#define ADTS_MEM_HUGEPAGE_BYTES  (2 * 1024 * 1024)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Allocation routing:
+ *     - <= ADTS_MEM_CLASS_BYTES_MAX:  power of 2 size class free lists
+ *     - >= ADTS_MEM_MMAP_BYTES:       fresh anonymous mappings, zeroed by
+ *                                     the kernel thus never memset
+ *     - otherwise:                    posix_memalign() at the requested
+ *                                     alignment + memset()
+ *
+ **************************************************************************
+ */
+#define ADTS_MEM_CLASS_BYTES_MIN (64)
+#define ADTS_MEM_CLASS_BYTES_MAX (2048)
+#define ADTS_MEM_MMAP_BYTES      (256 * 1024)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Scrub policy, applied to memory released via the ext and acct APIs:
+ *     - NONE:    released as is
+ *     - SECURE:  cleared via a store the compiler may not elide
+ *     - POISON:  filled with ADTS_MEM_POISON such that use after free is
+ *                evident
+ *
+ *   Released mappings are never scrubbed, the kernel zero fills pages
+ *   prior to any reuse and stale accesses fault.  ADTs thus do not scrub
+ *   on destroy or resize, the policy is the single point of control.
+ *
+ *   The build default is overridden via -DADTS_MEM_SCRUB_DEFAULT and the
+ *   process wide policy via adts_mem_scrub_set().
+ *
+ **************************************************************************
+ */
+typedef enum {
+    ADTS_MEM_SCRUB_NONE = 0,
+    ADTS_MEM_SCRUB_SECURE,
+    ADTS_MEM_SCRUB_POISON,
+    ADTS_MEM_SCRUBS,
+} adts_mem_scrub_t;
+
+#ifndef ADTS_MEM_SCRUB_DEFAULT
+#define ADTS_MEM_SCRUB_DEFAULT ADTS_MEM_SCRUB_NONE
+#endif
+
+#define ADTS_MEM_POISON (0xA5)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Accounting owners.  Every library allocation is charged to an
+ *   instance record, and through it to the per type totals.
+ *
+ **************************************************************************
+ */
+typedef enum {
+    ADTS_MEM_TYPE_OTHER = 0,
+    ADTS_MEM_TYPE_ARENA,
+    ADTS_MEM_TYPE_BTREE,
+    ADTS_MEM_TYPE_GRAPH,
+    ADTS_MEM_TYPE_HASH,
+    ADTS_MEM_TYPE_HEAP,
+    ADTS_MEM_TYPE_LIST,
+    ADTS_MEM_TYPE_MEAS,
+    ADTS_MEM_TYPE_MULTIQ,
+    ADTS_MEM_TYPE_PHEAP,
+    ADTS_MEM_TYPE_POOL,
+    ADTS_MEM_TYPE_QUEUE,
+    ADTS_MEM_TYPE_RBT,
+    ADTS_MEM_TYPE_REGION,
+    ADTS_MEM_TYPE_RING,
+    ADTS_MEM_TYPE_SORT,
+    ADTS_MEM_TYPE_STACK,
+    ADTS_MEM_TYPE_TIME,
+    ADTS_MEM_TYPE_TREE,
+    ADTS_MEM_TYPES,
+} adts_mem_type_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Allocation size histogram, log2 buckets:
+ *     - [0]:      <= 64 bytes
+ *     - [n]:      (32 << n, 64 << n] bytes
+ *     - [last]:   > 1MB
+ *
+ **************************************************************************
+ */
+#define ADTS_MEM_HIST_BUCKETS (16)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Memory accounting record, both the per instance record embedded in
+ *   each ADT and the result of every query.
+ *
+ **************************************************************************
+ */
+typedef struct {
+    adts_mem_type_t type;
+    size_t          bytes_curr;  /**< bytes currently held */
+    size_t          bytes_peak;  /**< high watermark */
+    size_t          allocs;
+    size_t          frees;
+    size_t          hist[ ADTS_MEM_HIST_BUCKETS ]; /**< allocs by size */
+} adts_mem_stats_t;
+
+#define ADTS_MEM_STATS_INIT( _type ) { .type = (_type) }
+
 
 
 /******************************************************************************
@@ -32,8 +174,138 @@
  *   Simple API for memory allocation on page boundaries
  *
  * \details
+ *   Released via free() and thus not accounted, the library itself uses
+ *   adts_mem_zalloc_acct().
  *
  **************************************************************************
  */
 void *
 adts_mem_zalloc( size_t bytes );
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Zeroed allocation with explicit alignment
+ *
+ * \details
+ *   Memory must be returned via adts_mem_free_ext() with the identical
+ *   bytes and align used on allocation, never via free().  Returns NULL
+ *   on failure or if align is not a power of 2.
+ *
+ **************************************************************************
+ */
+void *
+adts_mem_zalloc_ext( size_t bytes,
+                     size_t align );
+
+void
+adts_mem_free_ext( void   *p_mem,
+                   size_t  bytes,
+                   size_t  align );
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Huge page placement for large workspaces
+ *
+ * \details
+ *   adts_mem_align_hugepage() returns the alignment to pass to the ext API
+ *   for a workspace of the given size, ADTS_MEM_ALIGN_HUGEPAGE when the
+ *   workspace spans at least one huge page and ADTS_MEM_ALIGN_DEFAULT
+ *   otherwise.  The result depends on bytes alone, thus resize and free
+ *   paths recompute the identical alignment.
+ *
+ *   adts_mem_hugepage_bytes() reports how much of a huge page aligned
+ *   allocation the kernel currently backs with huge pages.  The value is
+ *   read from /proc/self/smaps and is intended for diagnostics, not for
+ *   the datapath.
+ *
+ **************************************************************************
+ */
+size_t
+adts_mem_align_hugepage( size_t bytes );
+
+size_t
+adts_mem_hugepage_bytes( const void *p_mem,
+                         size_t      bytes );
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Process wide scrub policy
+ *
+ * \details
+ *   May be changed at any time, applies to subsequent releases.  Returns
+ *   EINVAL for an unknown policy.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_mem_scrub_set( adts_mem_scrub_t policy );
+
+adts_mem_scrub_t
+adts_mem_scrub_get( void );
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Accounted allocation
+ *
+ * \details
+ *   Identical to the ext API, the allocation is additionally charged to
+ *   p_stats and to the totals of p_stats->type.  The instance record is
+ *   serialized by the ADT consumer, same as the ADT it is embedded in,
+ *   the per type totals are updated atomically.  A NULL p_stats charges
+ *   ADTS_MEM_TYPE_OTHER only.
+ *
+ **************************************************************************
+ */
+void *
+adts_mem_zalloc_acct( adts_mem_stats_t *p_stats,
+                      size_t            bytes,
+                      size_t            align );
+void
+adts_mem_free_acct( adts_mem_stats_t *p_stats,
+                    void             *p_mem,
+                    size_t            bytes,
+                    size_t            align );
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Accounting queries
+ *
+ * \details
+ *   adts_mem_stats_type() returns a snapshot of the totals across every
+ *   instance of a type, including instances since destroyed.  Individual
+ *   counters are read atomically, the snapshot as a whole is not.
+ *   Per instance records are available via adts_<type>_mem_stats().
+ *   adts_mem_type_name() is a stable lowercase name suitable as a metric
+ *   label.
+ *
+ **************************************************************************
+ */
+const char *
+adts_mem_type_name( adts_mem_type_t type );
+
+void
+adts_mem_stats_type( adts_mem_type_t   type,
+                     adts_mem_stats_t *p_stats );
+void
+adts_mem_stats_display( const adts_mem_stats_t *p_stats );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_memory( void );
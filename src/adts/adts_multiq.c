@@ -0,0 +1,1003 @@
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <unistd.h>  /* sysconf() */
+
+/* Toolbox */
+#include <adts_heap.h>
+#include <adts_time.h>
+#include <adts_multiq.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - sticky heap selection, reuse the sampled heaps for a few operations
+ *      to improve locality at a bounded quality cost
+ *    - per thread insertion buffers
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sampled pop attempts prior to sweeping every heap.
+ *
+ ****************************************************************************
+ */
+#define MULTIQ_CACHELINE_BYTES (64)
+#define MULTIQ_POP_ATTEMPTS    (16)
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Internal heap, padded to a cacheline to avoid false sharing between
+ *   neighbouring locks.  The top key and entries are published under the
+ *   lock and read without it to select a heap.
+ *
+ ****************************************************************************
+ */
+typedef union {
+    struct {
+        pthread_spinlock_t  lock;
+        int64_t             top;    /**< root key, valid while elems */
+        size_t              elems;
+        adts_heap_t        *p_heap;
+    };
+    char pad[ MULTIQ_CACHELINE_BYTES ];
+} multiq_shard_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    size_t            shards;
+    multiq_shard_t   *p_shards;
+    adts_heap_type_t  type;
+    adts_mem_stats_t  mem;
+} multiq_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Per thread sampling state, seeded on first use.
+ *
+ ****************************************************************************
+ */
+static __thread uint64_t multiq_seed = 0;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   xorshift, cheap enough to not dominate the operation.
+ *
+ ****************************************************************************
+ */
+static inline multiq_shard_t *
+multiq_shard_random( multiq_t *p_mq )
+{
+    uint64_t seed = multiq_seed;
+
+    if (unlikely(0 == seed)) {
+        seed = adts_tstamp() ^ (uint64_t) (uintptr_t) &(multiq_seed);
+        seed = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    }
+
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    multiq_seed = seed;
+
+    return &(p_mq->p_shards[seed % p_mq->shards]);
+} /* multiq_shard_random() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Called with the shard lock held.
+ *
+ ****************************************************************************
+ */
+static inline void
+multiq_shard_publish( multiq_shard_t *p_shard )
+{
+    size_t            elems  = adts_heap_entries(p_shard->p_heap);
+    adts_heap_node_t *p_node = NULL;
+
+    if (elems) {
+        p_node = adts_heap_peek(p_shard->p_heap);
+        __atomic_store_n(&(p_shard->top), adts_heap_node_key(p_node),
+                         __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&(p_shard->elems), elems, __ATOMIC_RELEASE);
+
+    return;
+} /* multiq_shard_publish() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The better of two shards by their published tops, NULL when both
+ *   appear empty.
+ *
+ ****************************************************************************
+ */
+static inline multiq_shard_t *
+multiq_shard_better( multiq_t       *p_mq,
+                     multiq_shard_t *p_a,
+                     multiq_shard_t *p_b )
+{
+    int64_t top_a = 0;
+    int64_t top_b = 0;
+
+    if (0 == __atomic_load_n(&(p_a->elems), __ATOMIC_ACQUIRE)) {
+        p_a = NULL;
+    }
+    if (0 == __atomic_load_n(&(p_b->elems), __ATOMIC_ACQUIRE)) {
+        p_b = NULL;
+    }
+    if ((NULL == p_a) || (NULL == p_b)) {
+        return p_a ? p_a : p_b;
+    }
+
+    top_a = __atomic_load_n(&(p_a->top), __ATOMIC_RELAXED);
+    top_b = __atomic_load_n(&(p_b->top), __ATOMIC_RELAXED);
+    if (ADTS_HEAP_MAX == p_mq->type) {
+        return (top_a >= top_b) ? p_a : p_b;
+    }
+
+    return (top_a <= top_b) ? p_a : p_b;
+} /* multiq_shard_better() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Called with the shard lock held.
+ *
+ ****************************************************************************
+ */
+static inline adts_heap_node_t *
+multiq_shard_pop( multiq_shard_t *p_shard )
+{
+    adts_heap_node_t *p_node = NULL;
+
+    p_node = adts_heap_pop(p_shard->p_heap);
+    if (p_node) {
+        multiq_shard_publish(p_shard);
+    }
+
+    return p_node;
+} /* multiq_shard_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_multiq_heaps( adts_multiq_t *p_adts_multiq )
+{
+    multiq_t *p_mq = (multiq_t *) p_adts_multiq;
+
+    return p_mq->shards;
+} /* adts_multiq_heaps() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_multiq_entries( adts_multiq_t *p_adts_multiq )
+{
+    size_t    elems = 0;
+    multiq_t *p_mq  = (multiq_t *) p_adts_multiq;
+
+    for (size_t idx = 0; idx < p_mq->shards; idx++) {
+        elems += __atomic_load_n(&(p_mq->p_shards[idx].elems),
+                                 __ATOMIC_RELAXED);
+    }
+
+    return elems;
+} /* adts_multiq_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_multiq_is_empty( adts_multiq_t *p_adts_multiq )
+{
+    return (0 == adts_multiq_entries(p_adts_multiq));
+} /* adts_multiq_is_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_multiq_display( adts_multiq_t *p_adts_multiq )
+{
+    multiq_t       *p_mq    = (multiq_t *) p_adts_multiq;
+    multiq_shard_t *p_shard = NULL;
+
+    printf("heaps: %zu  entries: %zu\n", p_mq->shards,
+           adts_multiq_entries(p_adts_multiq));
+    for (size_t idx = 0; idx < p_mq->shards; idx++) {
+        p_shard = &(p_mq->p_shards[idx]);
+
+        pthread_spin_lock(&(p_shard->lock));
+        printf("[%3zu]  entries: %-10zu  top: %lld\n",
+               idx, p_shard->elems, p_shard->elems ? p_shard->top : 0);
+        pthread_spin_unlock(&(p_shard->lock));
+    }
+
+    return;
+} /* adts_multiq_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The multiq record plus every internal heap.  Peak is the sum of the
+ *   individual peaks, an upper bound.
+ *
+ ****************************************************************************
+ */
+void
+adts_multiq_mem_stats( adts_multiq_t    *p_adts_multiq,
+                       adts_mem_stats_t *p_stats )
+{
+    multiq_t         *p_mq    = (multiq_t *) p_adts_multiq;
+    multiq_shard_t   *p_shard = NULL;
+    adts_mem_stats_t  heap    = {0};
+
+    *p_stats = p_mq->mem;
+    for (size_t idx = 0; idx < p_mq->shards; idx++) {
+        p_shard = &(p_mq->p_shards[idx]);
+
+        pthread_spin_lock(&(p_shard->lock));
+        adts_heap_mem_stats(p_shard->p_heap, &(heap));
+        pthread_spin_unlock(&(p_shard->lock));
+
+        p_stats->bytes_curr += heap.bytes_curr;
+        p_stats->bytes_peak += heap.bytes_peak;
+        p_stats->allocs     += heap.allocs;
+        p_stats->frees      += heap.frees;
+        for (size_t b = 0; b < ADTS_MEM_HIST_BUCKETS; b++) {
+            p_stats->hist[b] += heap.hist[b];
+        }
+    }
+
+    return;
+} /* adts_multiq_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_heap_node_t *
+adts_multiq_pop( adts_multiq_t *p_adts_multiq )
+{
+    multiq_t         *p_mq    = (multiq_t *) p_adts_multiq;
+    multiq_shard_t   *p_shard = NULL;
+    adts_heap_node_t *p_node  = NULL;
+
+    for (size_t attempt = 0; attempt < MULTIQ_POP_ATTEMPTS; attempt++) {
+        p_shard = multiq_shard_better(p_mq, multiq_shard_random(p_mq),
+                                      multiq_shard_random(p_mq));
+        if ((NULL == p_shard) || pthread_spin_trylock(&(p_shard->lock))) {
+            /* both empty, or contended */
+            continue;
+        }
+
+        p_node = multiq_shard_pop(p_shard);
+        pthread_spin_unlock(&(p_shard->lock));
+        if (p_node) {
+            goto exception;
+        }
+    }
+
+    /* sweep, NULL only once every heap was observed empty */
+    for (size_t idx = 0; idx < p_mq->shards; idx++) {
+        p_shard = &(p_mq->p_shards[idx]);
+
+        pthread_spin_lock(&(p_shard->lock));
+        p_node = multiq_shard_pop(p_shard);
+        pthread_spin_unlock(&(p_shard->lock));
+        if (p_node) {
+            break;
+        }
+    }
+
+exception:
+    return p_node;
+} /* adts_multiq_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_multiq_push( adts_multiq_t    *p_adts_multiq,
+                  adts_heap_node_t *p_adts_node_heap,
+                  void             *p_data,
+                  size_t            bytes,
+                  int64_t           key )
+{
+    int32_t         rc      = 0;
+    multiq_t       *p_mq    = (multiq_t *) p_adts_multiq;
+    multiq_shard_t *p_shard = NULL;
+
+    for (;;) {
+        p_shard = multiq_shard_random(p_mq);
+        if (0 == pthread_spin_trylock(&(p_shard->lock))) {
+            break;
+        }
+    }
+
+    rc = adts_heap_push(p_shard->p_heap, p_adts_node_heap, p_data, bytes,
+                        key);
+    if (0 == rc) {
+        multiq_shard_publish(p_shard);
+    }
+    pthread_spin_unlock(&(p_shard->lock));
+
+    return rc;
+} /* adts_multiq_push() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Tears down the first shards heaps only, such that create may unwind a
+ *   partially built multiq.
+ *
+ ****************************************************************************
+ */
+static void
+multiq_teardown( multiq_t *p_mq,
+                 size_t    shards )
+{
+    adts_mem_stats_t mem = {0};
+
+    if (p_mq->p_shards) {
+        for (size_t idx = 0; idx < shards; idx++) {
+            adts_heap_destroy(p_mq->p_shards[idx].p_heap);
+            pthread_spin_destroy(&(p_mq->p_shards[idx].lock));
+        }
+        adts_mem_free_acct(&(p_mq->mem), p_mq->p_shards,
+                           p_mq->shards * sizeof(multiq_shard_t),
+                           ADTS_MEM_ALIGN_CACHELINE);
+    }
+
+    /* the record is released along with the handle */
+    mem = p_mq->mem;
+    adts_mem_free_acct(&(mem), p_mq, sizeof(adts_multiq_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    return;
+} /* multiq_teardown() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Queued nodes remain consumer owned.  The consumer guarantees no
+ *   concurrent operation is in flight.
+ *
+ ****************************************************************************
+ */
+void
+adts_multiq_destroy( adts_multiq_t *p_adts_multiq )
+{
+    multiq_t *p_mq = (multiq_t *) p_adts_multiq;
+
+    multiq_teardown(p_mq, p_mq->shards);
+
+    return;
+} /* adts_multiq_destroy() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_multiq_t *
+adts_multiq_create( const adts_multiq_create_t *p_op )
+{
+    size_t              threads      = 0;
+    size_t              factor       = 0;
+    size_t              idx          = 0;
+    int32_t             rc           = 0;
+    multiq_t           *p_mq         = NULL;
+    adts_multiq_t      *p_adts_mq    = NULL;
+    adts_heap_create_t  heap         = {0};
+    adts_mem_stats_t    mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_MULTIQ);
+
+    if ((NULL == p_op) ||
+        ((ADTS_HEAP_MIN != p_op->type) && (ADTS_HEAP_MAX != p_op->type))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    threads = p_op->threads ? p_op->threads :
+                              (size_t) sysconf(_SC_NPROCESSORS_ONLN);
+    factor  = p_op->factor ? p_op->factor : ADTS_MULTIQ_FACTOR_DEFAULT;
+    threads = threads ? threads : 1;
+    if (threads > (SIZE_MAX / sizeof(multiq_shard_t) / factor)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    p_adts_mq = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_mq),
+                                     ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_mq) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_mq         = (multiq_t *) p_adts_mq;
+    p_mq->type   = p_op->type;
+    p_mq->shards = threads * factor;
+    p_mq->mem    = mem;
+
+    p_mq->p_shards = adts_mem_zalloc_acct(&(p_mq->mem),
+                                          p_mq->shards * sizeof(multiq_shard_t),
+                                          ADTS_MEM_ALIGN_CACHELINE);
+    if (NULL == p_mq->p_shards) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    heap.type    = p_op->type;
+    heap.options = p_op->options;
+    heap.arity   = p_op->arity;
+    for (idx = 0; idx < p_mq->shards; idx++) {
+        multiq_shard_t *p_shard = &(p_mq->p_shards[idx]);
+
+        p_shard->p_heap = adts_heap_create_ext(&(heap));
+        if (NULL == p_shard->p_heap) {
+            rc = EINVAL;
+            goto exception;
+        }
+        (void) pthread_spin_init(&(p_shard->lock), PTHREAD_PROCESS_PRIVATE);
+    }
+
+exception:
+    if (rc) {
+        if (p_adts_mq) {
+            multiq_teardown(p_mq, idx);
+            p_adts_mq = NULL;
+        }
+    }
+
+    return p_adts_mq;
+} /* adts_multiq_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_multiq_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(multiq_t));
+    CDISPLAY("[%u]", sizeof(adts_multiq_t));
+
+    _Static_assert(sizeof(multiq_t) <= sizeof(adts_multiq_t),
+        "Mismatch structs detected");
+
+    _Static_assert(sizeof(multiq_shard_t) == MULTIQ_CACHELINE_BYTES,
+        "Mismatch structs detected");
+
+    return;
+} /* utest_multiq_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Benchmark workload, a steady state scheduler.  Each operation pops a
+ *   job and requeues it later by a random delay.
+ *
+ ****************************************************************************
+ */
+#define UTEST_MULTIQ_JOBS    (1000 * 1000)
+#define UTEST_MULTIQ_OPS     (4 * 1000 * 1000)
+#define UTEST_MULTIQ_THREADS (8)
+
+typedef struct {
+    adts_multiq_t   *p_mq;
+    adts_heap_t     *p_heap;  /**< baseline, serialized via p_lock */
+    pthread_mutex_t *p_lock;
+    size_t           ops;
+    uint64_t         seed;
+} utest_multiq_worker_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline int64_t
+utest_multiq_delay( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return (int64_t) (*p_seed % 1024) + 1;
+} /* utest_multiq_delay() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void *
+utest_multiq_worker( void *p_arg )
+{
+    utest_multiq_worker_t *p_worker = p_arg;
+    adts_heap_node_t      *p_node   = NULL;
+    int64_t                key      = 0;
+
+    for (size_t idx = 0; idx < p_worker->ops; idx++) {
+        if (p_worker->p_mq) {
+            p_node = adts_multiq_pop(p_worker->p_mq);
+            assert(p_node);
+            key = adts_heap_node_key(p_node) +
+                  utest_multiq_delay(&(p_worker->seed));
+            assert(0 == adts_multiq_push(p_worker->p_mq, p_node, p_node, 1,
+                                         key));
+            continue;
+        }
+
+        pthread_mutex_lock(p_worker->p_lock);
+        p_node = adts_heap_pop(p_worker->p_heap);
+        assert(p_node);
+        key = adts_heap_node_key(p_node) +
+              utest_multiq_delay(&(p_worker->seed));
+        assert(0 == adts_heap_push(p_worker->p_heap, p_node, p_node, 1, key));
+        pthread_mutex_unlock(p_worker->p_lock);
+    }
+
+    return NULL;
+} /* utest_multiq_worker() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Throughput, multiq vs a single mutex serialized adts_heap, across
+ *   thread counts.
+ *
+ ****************************************************************************
+ */
+static void
+utest_multiq_benchmark_throughput( void )
+{
+    adts_heap_node_t *p_nodes = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: %u jobs, %u ops, multiq vs locked heap",
+             UTEST_MULTIQ_JOBS, UTEST_MULTIQ_OPS);
+
+    p_nodes = calloc(UTEST_MULTIQ_JOBS, sizeof(*p_nodes));
+    assert(p_nodes);
+
+    for (size_t threads = 1; threads <= UTEST_MULTIQ_THREADS; threads *= 2) {
+        uint64_t               ns[2]  = {0};
+        pthread_t              tid[ UTEST_MULTIQ_THREADS ];
+        utest_multiq_worker_t  worker[ UTEST_MULTIQ_THREADS ];
+
+        for (size_t locked = 0; locked < 2; locked++) {
+            uint64_t             start  = 0;
+            uint64_t             seed   = 0x9E3779B97F4A7C15ULL;
+            adts_multiq_t       *p_mq   = NULL;
+            adts_heap_t         *p_heap = NULL;
+            pthread_mutex_t      lock   = PTHREAD_MUTEX_INITIALIZER;
+            adts_multiq_create_t op     = {0};
+
+            op.type    = ADTS_HEAP_MIN;
+            op.threads = threads;
+            if (locked) {
+                p_heap = adts_heap_create(ADTS_HEAP_MIN);
+                assert(p_heap);
+            } else {
+                p_mq = adts_multiq_create(&(op));
+                assert(p_mq);
+            }
+
+            for (size_t idx = 0; idx < UTEST_MULTIQ_JOBS; idx++) {
+                int64_t key = utest_multiq_delay(&(seed));
+
+                if (locked) {
+                    assert(0 == adts_heap_push(p_heap, &(p_nodes[idx]),
+                                               &(p_nodes[idx]), 1, key));
+                } else {
+                    assert(0 == adts_multiq_push(p_mq, &(p_nodes[idx]),
+                                                 &(p_nodes[idx]), 1, key));
+                }
+            }
+
+            start = adts_tstamp();
+            for (size_t idx = 0; idx < threads; idx++) {
+                worker[idx].p_mq   = p_mq;
+                worker[idx].p_heap = p_heap;
+                worker[idx].p_lock = &(lock);
+                worker[idx].ops    = UTEST_MULTIQ_OPS / threads;
+                worker[idx].seed   = seed + idx + 1;
+                pthread_create(&(tid[idx]), NULL, utest_multiq_worker,
+                               &(worker[idx]));
+            }
+            for (size_t idx = 0; idx < threads; idx++) {
+                pthread_join(tid[idx], NULL);
+            }
+            ns[locked] = adts_tstamp() - start;
+
+            if (locked) {
+                assert(UTEST_MULTIQ_JOBS == adts_heap_entries(p_heap));
+                adts_heap_destroy(p_heap);
+            } else {
+                assert(UTEST_MULTIQ_JOBS == adts_multiq_entries(p_mq));
+                adts_multiq_destroy(p_mq);
+            }
+        }
+
+        CDISPLAY("threads: %zu  multiq: %5llu ns/op  locked heap: %5llu ns/op",
+                 threads, ns[0] / UTEST_MULTIQ_OPS, ns[1] / UTEST_MULTIQ_OPS);
+    }
+
+    free(p_nodes);
+
+    return;
+} /* utest_multiq_benchmark_throughput() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Quality, the rank error of every pop while draining a permutation of
+ *   0 .. N-1.  The rank of key k is the number of queued keys below k,
+ *   tracked by a Fenwick tree over the key space.  Single threaded, thus
+ *   the structural relaxation of c * P heaps in isolation.
+ *
+ ****************************************************************************
+ */
+static void
+utest_multiq_benchmark_quality( void )
+{
+    const size_t      elems   = UTEST_MULTIQ_JOBS;
+    uint32_t         *p_tree  = NULL;
+    int64_t          *p_keys  = NULL;
+    adts_heap_node_t *p_nodes = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: rank error draining %zu keys", elems);
+
+    p_tree  = calloc(elems + 1, sizeof(*p_tree));
+    p_keys  = calloc(elems, sizeof(*p_keys));
+    p_nodes = calloc(elems, sizeof(*p_nodes));
+    assert(p_tree && p_keys && p_nodes);
+
+    for (size_t threads = 1; threads <= UTEST_MULTIQ_THREADS; threads *= 2) {
+        uint64_t              seed  = 0x9E3779B97F4A7C15ULL;
+        uint64_t              sum   = 0;
+        uint64_t              worst = 0;
+        adts_multiq_t        *p_mq  = NULL;
+        adts_multiq_create_t  op    = {0};
+
+        /* shuffled permutation */
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_keys[idx] = (int64_t) idx;
+        }
+        for (size_t idx = elems - 1; idx > 0; idx--) {
+            size_t  j   = utest_multiq_delay(&(seed)) * 1009 % (idx + 1);
+            int64_t tmp = p_keys[idx];
+
+            p_keys[idx] = p_keys[j];
+            p_keys[j]   = tmp;
+        }
+
+        op.type    = ADTS_HEAP_MIN;
+        op.threads = threads;
+        p_mq       = adts_multiq_create(&(op));
+        assert(p_mq);
+
+        memset(p_tree, 0, (elems + 1) * sizeof(*p_tree));
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_multiq_push(p_mq, &(p_nodes[idx]),
+                                         &(p_nodes[idx]), 1, p_keys[idx]));
+            for (size_t i = (size_t) p_keys[idx] + 1; i <= elems; i += i & -i) {
+                p_tree[i]++;
+            }
+        }
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            adts_heap_node_t *p_node = adts_multiq_pop(p_mq);
+            uint64_t          rank   = 0;
+            size_t            key    = 0;
+
+            assert(p_node);
+            key = (size_t) adts_heap_node_key(p_node);
+            for (size_t i = key; i > 0; i -= i & -i) {
+                rank += p_tree[i];
+            }
+            for (size_t i = key + 1; i <= elems; i += i & -i) {
+                p_tree[i]--;
+            }
+
+            sum  += rank;
+            worst = (rank > worst) ? rank : worst;
+        }
+        assert(NULL == adts_multiq_pop(p_mq));
+
+        CDISPLAY("threads: %zu  heaps: %3zu  rank error mean: %6.2f  max: %llu",
+                 threads, adts_multiq_heaps(p_mq), (double) sum / elems, worst);
+
+        adts_multiq_destroy(p_mq);
+    }
+
+    free(p_nodes);
+    free(p_keys);
+    free(p_tree);
+
+    return;
+} /* utest_multiq_benchmark_quality() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_multiq_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> destroy, accounting");
+
+        adts_multiq_t        *p_mq   = NULL;
+        adts_multiq_create_t  op     = {0};
+        adts_mem_stats_t      before = {0};
+        adts_mem_stats_t      after  = {0};
+        adts_mem_stats_t      stats  = {0};
+
+        op.type = ADTS_HEAP_RADIX;
+        assert(NULL == adts_multiq_create(&(op)));
+        assert(NULL == adts_multiq_create(NULL));
+        op.type    = ADTS_HEAP_MIN;
+        op.options = ADTS_HEAP_OPTS_DARY;
+        op.arity   = 3;
+        assert(NULL == adts_multiq_create(&(op)));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_MULTIQ, &(before));
+        op.arity   = 0;
+        op.threads = 4;
+        p_mq       = adts_multiq_create(&(op));
+        assert(p_mq);
+        assert((4 * ADTS_MULTIQ_FACTOR_DEFAULT) == adts_multiq_heaps(p_mq));
+        assert(adts_multiq_is_empty(p_mq));
+        assert(NULL == adts_multiq_pop(p_mq));
+
+        adts_multiq_mem_stats(p_mq, &(stats));
+        assert(stats.bytes_curr > sizeof(adts_multiq_t));
+        adts_multiq_display(p_mq);
+
+        adts_multiq_destroy(p_mq);
+        adts_mem_stats_type(ADTS_MEM_TYPE_MULTIQ, &(after));
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: every node popped exactly once, MIN and MAX");
+
+        const size_t          elems   = 4096;
+        adts_multiq_t        *p_mq    = NULL;
+        adts_heap_node_t     *p_nodes = NULL;
+        bool                 *p_seen  = NULL;
+        adts_multiq_create_t  op      = {0};
+
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        p_seen  = calloc(elems, sizeof(*p_seen));
+        assert(p_nodes && p_seen);
+
+        for (size_t tdx = 0; tdx < 2; tdx++) {
+            op.type    = tdx ? ADTS_HEAP_MAX : ADTS_HEAP_MIN;
+            op.threads = 2;
+            p_mq       = adts_multiq_create(&(op));
+            assert(p_mq);
+
+            memset(p_seen, 0, elems * sizeof(*p_seen));
+            for (size_t idx = 0; idx < elems; idx++) {
+                assert(0 == adts_multiq_push(p_mq, &(p_nodes[idx]),
+                                             &(p_nodes[idx]), 1,
+                                             (int64_t) idx));
+            }
+            assert(elems == adts_multiq_entries(p_mq));
+
+            for (size_t idx = 0; idx < elems; idx++) {
+                adts_heap_node_t *p_node = adts_multiq_pop(p_mq);
+
+                assert(p_node);
+                assert(false == p_seen[p_node - p_nodes]);
+                p_seen[p_node - p_nodes] = true;
+            }
+            assert(NULL == adts_multiq_pop(p_mq));
+            assert(adts_multiq_is_empty(p_mq));
+
+            /* single heap, strict order */
+            adts_multiq_destroy(p_mq);
+            op.threads = 1;
+            op.factor  = 1;
+            p_mq       = adts_multiq_create(&(op));
+            assert(p_mq);
+            for (size_t idx = 0; idx < elems; idx++) {
+                assert(0 == adts_multiq_push(p_mq, &(p_nodes[idx]),
+                                             &(p_nodes[idx]), 1,
+                                             (int64_t) idx));
+            }
+            for (size_t idx = 0; idx < elems; idx++) {
+                int64_t expect = tdx ? (int64_t) (elems - 1 - idx) :
+                                       (int64_t) idx;
+
+                assert(expect == adts_heap_node_key(adts_multiq_pop(p_mq)));
+            }
+            op.factor = 0;
+            adts_multiq_destroy(p_mq);
+        }
+
+        free(p_seen);
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: concurrent push / pop conserves nodes");
+
+        const size_t           threads = 4;
+        adts_multiq_t         *p_mq    = NULL;
+        adts_heap_node_t      *p_nodes = NULL;
+        pthread_t              tid[ 4 ];
+        utest_multiq_worker_t  worker[ 4 ];
+        adts_multiq_create_t   op      = {0};
+
+        p_nodes = calloc(1024, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        op.type    = ADTS_HEAP_MIN;
+        op.threads = threads;
+        p_mq       = adts_multiq_create(&(op));
+        assert(p_mq);
+        for (size_t idx = 0; idx < 1024; idx++) {
+            assert(0 == adts_multiq_push(p_mq, &(p_nodes[idx]),
+                                         &(p_nodes[idx]), 1, 0));
+        }
+
+        for (size_t idx = 0; idx < threads; idx++) {
+            worker[idx].p_mq   = p_mq;
+            worker[idx].p_heap = NULL;
+            worker[idx].p_lock = NULL;
+            worker[idx].ops    = 100 * 1000;
+            worker[idx].seed   = idx + 1;
+            pthread_create(&(tid[idx]), NULL, utest_multiq_worker,
+                           &(worker[idx]));
+        }
+        for (size_t idx = 0; idx < threads; idx++) {
+            pthread_join(tid[idx], NULL);
+        }
+        assert(1024 == adts_multiq_entries(p_mq));
+
+        for (size_t idx = 0; idx < 1024; idx++) {
+            assert(adts_multiq_pop(p_mq));
+        }
+        assert(NULL == adts_multiq_pop(p_mq));
+
+        adts_multiq_destroy(p_mq);
+        free(p_nodes);
+    }
+
+    utest_multiq_benchmark_throughput();
+    utest_multiq_benchmark_quality();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_multiq( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_multiq() */
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_heap.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_MULTIQ_BYTES (256)
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_MULTIQ_BYTES ];
+} adts_multiq_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   multiq create parameters
+ *     - type:    ADTS_HEAP_MIN or ADTS_HEAP_MAX.
+ *     - threads: P, the number of threads expected to operate on the
+ *       multiq concurrently, 0 selects the online processors.
+ *     - factor:  c, heaps per thread, 0 selects ADTS_MULTIQ_FACTOR_DEFAULT.
+ *     - options / arity: applied to every internal heap, see
+ *       adts_heap_create_ext().
+ *
+ **************************************************************************
+ */
+#define ADTS_MULTIQ_FACTOR_DEFAULT (2)
+
+typedef struct {
+    adts_heap_type_t     type;
+    size_t               threads;
+    size_t               factor;
+    adts_heap_options_t  options;
+    size_t               arity;
+} adts_multiq_create_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Relaxed concurrent priority queue (MultiQueue).  c * P internal heaps,
+ *   each serialized by its own lock.  Safe for concurrent use by any
+ *   number of threads, no external serialization is required.
+ *
+ *   - push: a uniformly random heap is try-locked, on contention another
+ *     is drawn.
+ *   - pop:  two random heaps are sampled, and the better of their cached
+ *     tops is try-locked and popped.  After repeated misses every heap is
+ *     swept under its lock, such that NULL is only returned once each heap
+ *     was observed empty.
+ *
+ *   Ordering is relaxed.  With n = c * P heaps, the rank error of a pop,
+ *   i.e. the number of queued elements that would have been popped
+ *   earlier by a strict heap, is O(n) in expectation and O(n log n) with
+ *   high probability, independent of the number of elements.  A larger c
+ *   reduces contention at the cost of quality, c = 2 is the customary
+ *   balance.  Elements of equal priority carry no FIFO guarantee.
+ *
+ *   Nodes are adts_heap_node_t, consumer owned, see adts_heap_push().
+ *   Entries is a snapshot and may be stale under concurrency.
+ *
+ **************************************************************************
+ */
+size_t
+adts_multiq_heaps( adts_multiq_t *p_adts_multiq );
+
+size_t
+adts_multiq_entries( adts_multiq_t *p_adts_multiq );
+
+bool
+adts_multiq_is_empty( adts_multiq_t *p_adts_multiq );
+
+void
+adts_multiq_display( adts_multiq_t *p_adts_multiq );
+
+void
+adts_multiq_mem_stats( adts_multiq_t    *p_adts_multiq,
+                       adts_mem_stats_t *p_stats );
+
+adts_heap_node_t *
+adts_multiq_pop( adts_multiq_t *p_adts_multiq );
+
+int32_t
+adts_multiq_push( adts_multiq_t    *p_adts_multiq,
+                  adts_heap_node_t *p_adts_node_heap,
+                  void             *p_data,
+                  size_t            bytes,
+                  int64_t           key );
+void
+adts_multiq_destroy( adts_multiq_t *p_adts_multiq );
+
+adts_multiq_t *
+adts_multiq_create( const adts_multiq_create_t *p_op );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_multiq( void );
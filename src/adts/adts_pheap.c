@@ -0,0 +1,985 @@
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Toolbox */
+#include <adts_heap.h>
+#include <adts_time.h>
+#include <adts_pheap.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - auxiliary root list, deferring the pairing of pushed nodes to pop
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Children are a sibling list headed by p_child.  p_prev is the left
+ *   sibling, or the parent for the first child, and NULL for the root and
+ *   for nodes that are not queued.
+ *
+ ****************************************************************************
+ */
+typedef struct pheap_node_s {
+    void                *p_data;    /**< consumer datapointer */
+    size_t               bytes;     /**< data bytes for p_data */
+    int64_t              key;
+    struct pheap_node_s *p_child;
+    struct pheap_node_s *p_sibling;
+    struct pheap_node_s *p_prev;
+} pheap_node_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    pheap_node_t     *p_root;
+    size_t            elems;
+    adts_sanity_t     sanity;
+    adts_heap_type_t  type;
+    adts_mem_stats_t  mem;
+} pheap_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   True when key a belongs above key b.
+ *
+ ****************************************************************************
+ */
+static inline bool
+pheap_above( const pheap_t *p_pheap,
+             int64_t        a,
+             int64_t        b )
+{
+    return (ADTS_HEAP_MAX == p_pheap->type) ? (a > b) : (a < b);
+} /* pheap_above() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Link two detached roots, the loser becomes the first child of the
+ *   winner.  Either may be NULL.
+ *
+ ****************************************************************************
+ */
+static inline pheap_node_t *
+pheap_link( pheap_t      *p_pheap,
+            pheap_node_t *p_a,
+            pheap_node_t *p_b )
+{
+    pheap_node_t *p_tmp = NULL;
+
+    if ((NULL == p_a) || (NULL == p_b)) {
+        return p_a ? p_a : p_b;
+    }
+
+    if (pheap_above(p_pheap, p_b->key, p_a->key)) {
+        p_tmp = p_a;
+        p_a   = p_b;
+        p_b   = p_tmp;
+    }
+
+    p_b->p_sibling = p_a->p_child;
+    if (p_a->p_child) {
+        p_a->p_child->p_prev = p_b;
+    }
+    p_b->p_prev  = p_a;
+    p_a->p_child = p_b;
+
+    return p_a;
+} /* pheap_link() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Detach a non root node, along with its subtree, from its parent.
+ *
+ ****************************************************************************
+ */
+static inline void
+pheap_cut( pheap_node_t *p_node )
+{
+    if (p_node->p_prev->p_child == p_node) {
+        p_node->p_prev->p_child = p_node->p_sibling;
+    } else {
+        p_node->p_prev->p_sibling = p_node->p_sibling;
+    }
+    if (p_node->p_sibling) {
+        p_node->p_sibling->p_prev = p_node->p_prev;
+    }
+    p_node->p_prev    = NULL;
+    p_node->p_sibling = NULL;
+
+    return;
+} /* pheap_cut() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Two pass pairing of a sibling list into a single root.  The first
+ *   pass links pairs left to right, stacking each result through
+ *   p_sibling.  The second pass links the stack right to left.  Iterative,
+ *   the sibling list of a root may span every node.
+ *
+ ****************************************************************************
+ */
+static pheap_node_t *
+pheap_pair( pheap_t      *p_pheap,
+            pheap_node_t *p_first )
+{
+    pheap_node_t *p_a     = NULL;
+    pheap_node_t *p_b     = NULL;
+    pheap_node_t *p_next  = NULL;
+    pheap_node_t *p_stack = NULL;
+    pheap_node_t *p_root  = NULL;
+
+    while (p_first) {
+        p_a    = p_first;
+        p_b    = p_a->p_sibling;
+        p_next = p_b ? p_b->p_sibling : NULL;
+
+        p_a->p_prev = p_a->p_sibling = NULL;
+        if (p_b) {
+            p_b->p_prev = p_b->p_sibling = NULL;
+        }
+
+        p_a            = pheap_link(p_pheap, p_a, p_b);
+        p_a->p_sibling = p_stack;
+        p_stack        = p_a;
+        p_first        = p_next;
+    }
+
+    while (p_stack) {
+        p_next             = p_stack->p_sibling;
+        p_stack->p_sibling = NULL;
+        p_root             = pheap_link(p_pheap, p_root, p_stack);
+        p_stack            = p_next;
+    }
+
+    return p_root;
+} /* pheap_pair() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Unlink a queued node, its children are paired and linked back.
+ *
+ ****************************************************************************
+ */
+static void
+pheap_unlink( pheap_t      *p_pheap,
+              pheap_node_t *p_node )
+{
+    pheap_node_t *p_sub = NULL;
+
+    if (p_node == p_pheap->p_root) {
+        p_pheap->p_root = pheap_pair(p_pheap, p_node->p_child);
+    } else {
+        pheap_cut(p_node);
+        p_sub           = pheap_pair(p_pheap, p_node->p_child);
+        p_pheap->p_root = pheap_link(p_pheap, p_pheap->p_root, p_sub);
+    }
+    p_node->p_child = NULL;
+    p_pheap->elems--;
+
+    return;
+} /* pheap_unlink() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Only the root of a queued node lacks a p_prev.
+ *
+ ****************************************************************************
+ */
+static inline bool
+pheap_node_queued( pheap_t      *p_pheap,
+                   pheap_node_t *p_node )
+{
+    return (p_node->p_prev || (p_node == p_pheap->p_root));
+} /* pheap_node_queued() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_pheap_is_empty( adts_pheap_t *p_adts_pheap )
+{
+    pheap_t *p_pheap = (pheap_t *) p_adts_pheap;
+
+    return (NULL == p_pheap->p_root);
+} /* adts_pheap_is_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_pheap_entries( adts_pheap_t *p_adts_pheap )
+{
+    pheap_t *p_pheap = (pheap_t *) p_adts_pheap;
+
+    return p_pheap->elems;
+} /* adts_pheap_entries() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Pre-order walk, iterative as the tree depth is unbounded.  The parent
+ *   of a node is found by walking p_prev back to the first sibling.
+ *
+ ****************************************************************************
+ */
+void
+adts_pheap_display( adts_pheap_t *p_adts_pheap )
+{
+    size_t         depth    = 0;
+    pheap_t       *p_pheap  = (pheap_t *) p_adts_pheap;
+    pheap_node_t  *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    printf("entries: %zu\n", p_pheap->elems);
+
+    p_node = p_pheap->p_root;
+    while (p_node) {
+        printf("[%6zu]  node: %p  vaddr: %p  bytes: %zu  key: 0x%016llx %-lld\n",
+               depth, p_node, p_node->p_data, p_node->bytes, p_node->key,
+               p_node->key);
+
+        if (p_node->p_child) {
+            p_node = p_node->p_child;
+            depth++;
+            continue;
+        }
+
+        while (p_node && (NULL == p_node->p_sibling)) {
+            /* ascend to the parent */
+            while (p_node->p_prev && (p_node->p_prev->p_child != p_node)) {
+                p_node = p_node->p_prev;
+            }
+            p_node = p_node->p_prev;
+            depth--;
+        }
+        p_node = p_node ? p_node->p_sibling : NULL;
+    }
+
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_pheap_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Nodes are consumer owned and not included, the handle is the only
+ *   allocation.
+ *
+ ****************************************************************************
+ */
+void
+adts_pheap_mem_stats( adts_pheap_t     *p_adts_pheap,
+                      adts_mem_stats_t *p_stats )
+{
+    pheap_t *p_pheap = (pheap_t *) p_adts_pheap;
+
+    *p_stats = p_pheap->mem;
+
+    return;
+} /* adts_pheap_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_pheap_node_t *
+adts_pheap_peek( adts_pheap_t *p_adts_pheap )
+{
+    pheap_t *p_pheap = (pheap_t *) p_adts_pheap;
+
+    return (adts_pheap_node_t *) p_pheap->p_root;
+} /* adts_pheap_peek() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Key of a queued or popped node.
+ *
+ ****************************************************************************
+ */
+int64_t
+adts_pheap_node_key( const adts_pheap_node_t *p_adts_node_pheap )
+{
+    const pheap_node_t *p_node = (const pheap_node_t *) p_adts_node_pheap;
+
+    return p_node->key;
+} /* adts_pheap_node_key() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_pheap_node_t *
+adts_pheap_pop( adts_pheap_t *p_adts_pheap )
+{
+    pheap_t       *p_pheap  = (pheap_t *) p_adts_pheap;
+    pheap_node_t  *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = p_pheap->p_root;
+    if (unlikely(NULL == p_node)) {
+        /* empty heap */
+        goto exception;
+    }
+
+    pheap_unlink(p_pheap, p_node);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return (adts_pheap_node_t *) p_node;
+} /* adts_pheap_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_pheap_push( adts_pheap_t      *p_adts_pheap,
+                 adts_pheap_node_t *p_adts_node_pheap,
+                 void              *p_data,
+                 size_t             bytes,
+                 int64_t            key )
+{
+    int32_t        rc       = 0;
+    pheap_t       *p_pheap  = (pheap_t *) p_adts_pheap;
+    pheap_node_t  *p_node   = (pheap_node_t *) p_adts_node_pheap;
+    adts_sanity_t *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* Key not validated. Duplicates and 0 value allowed */
+    assert(p_node);
+    assert(p_data);
+    assert(bytes);
+
+    /* Populate the consumers node structure */
+    p_node->p_data    = p_data;
+    p_node->bytes     = bytes;
+    p_node->key       = key;
+    p_node->p_child   = NULL;
+    p_node->p_sibling = NULL;
+    p_node->p_prev    = NULL;
+
+    p_pheap->p_root = pheap_link(p_pheap, p_pheap->p_root, p_node);
+    p_pheap->elems++;
+
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_pheap_push() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Toward the root the node is cut, with its subtree intact, and linked
+ *   to the root.  Away from the root the node is unlinked and pushed
+ *   again.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_pheap_update_key( adts_pheap_t      *p_adts_pheap,
+                       adts_pheap_node_t *p_adts_node_pheap,
+                       int64_t            key )
+{
+    int32_t        rc       = 0;
+    pheap_t       *p_pheap  = (pheap_t *) p_adts_pheap;
+    pheap_node_t  *p_node   = (pheap_node_t *) p_adts_node_pheap;
+    adts_sanity_t *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((NULL == p_node) || (false == pheap_node_queued(p_pheap, p_node))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    if (false == pheap_above(p_pheap, p_node->key, key)) {
+        /* toward the root, or unchanged */
+        p_node->key = key;
+        if (p_node != p_pheap->p_root) {
+            pheap_cut(p_node);
+            p_pheap->p_root = pheap_link(p_pheap, p_pheap->p_root, p_node);
+        }
+        goto exception;
+    }
+
+    pheap_unlink(p_pheap, p_node);
+    p_node->key     = key;
+    p_pheap->p_root = pheap_link(p_pheap, p_pheap->p_root, p_node);
+    p_pheap->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_pheap_update_key() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_pheap_remove_node( adts_pheap_t      *p_adts_pheap,
+                        adts_pheap_node_t *p_adts_node_pheap )
+{
+    int32_t        rc       = 0;
+    pheap_t       *p_pheap  = (pheap_t *) p_adts_pheap;
+    pheap_node_t  *p_node   = (pheap_node_t *) p_adts_node_pheap;
+    adts_sanity_t *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((NULL == p_node) || (false == pheap_node_queued(p_pheap, p_node))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    pheap_unlink(p_pheap, p_node);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_pheap_remove_node() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_pheap_meld( adts_pheap_t *p_adts_pheap_dst,
+                 adts_pheap_t *p_adts_pheap_src )
+{
+    int32_t  rc     = 0;
+    pheap_t *p_dst  = (pheap_t *) p_adts_pheap_dst;
+    pheap_t *p_src  = (pheap_t *) p_adts_pheap_src;
+
+    if ((p_dst == p_src) || (p_dst->type != p_src->type)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    adts_sanity_entry(&(p_dst->sanity));
+    adts_sanity_entry(&(p_src->sanity));
+
+    p_dst->p_root = pheap_link(p_dst, p_dst->p_root, p_src->p_root);
+    p_dst->elems += p_src->elems;
+    p_src->p_root = NULL;
+    p_src->elems  = 0;
+
+    adts_sanity_exit(&(p_src->sanity));
+    adts_sanity_exit(&(p_dst->sanity));
+
+exception:
+    return rc;
+} /* adts_pheap_meld() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Queued nodes remain consumer owned and are not visited.
+ *
+ ****************************************************************************
+ */
+void
+adts_pheap_destroy( adts_pheap_t *p_adts_pheap )
+{
+    pheap_t          *p_pheap  = (pheap_t *) p_adts_pheap;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_pheap->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* the record is released along with the handle */
+    mem = p_pheap->mem;
+    adts_mem_free_acct(&(mem), p_pheap, sizeof(adts_pheap_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_pheap_destroy() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_pheap_t *
+adts_pheap_create( adts_heap_type_t type )
+{
+    pheap_t          *p_pheap      = NULL;
+    adts_pheap_t     *p_adts_pheap = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_PHEAP);
+
+    if ((ADTS_HEAP_MIN != type) && (ADTS_HEAP_MAX != type)) {
+        goto exception;
+    }
+
+    p_adts_pheap = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_pheap),
+                                        ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_pheap) {
+        goto exception;
+    }
+
+    p_pheap       = (pheap_t *) p_adts_pheap;
+    p_pheap->type = type;
+    p_pheap->mem  = mem;
+
+exception:
+    return p_adts_pheap;
+} /* adts_pheap_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_pheap_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(pheap_t));
+    CDISPLAY("[%u]", sizeof(adts_pheap_t));
+
+    _Static_assert(sizeof(pheap_t) <= sizeof(adts_pheap_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(pheap_node_t));
+    CDISPLAY("[%u]", sizeof(adts_pheap_node_t));
+
+    _Static_assert(sizeof(pheap_node_t) <= sizeof(adts_pheap_node_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_pheap_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   xorshift keys, non-negative such that INT64_MIN / MAX bound the drain.
+ *
+ ****************************************************************************
+ */
+static inline int64_t
+utest_pheap_key( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return (int64_t) (*p_seed >> 1);
+} /* utest_pheap_key() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Pop elems, verifying order on the way out.
+ *
+ ****************************************************************************
+ */
+static void
+utest_pheap_drain( adts_pheap_t *p_pheap,
+                   size_t        elems )
+{
+    int64_t       prev = 0;
+    bool          max  = false;
+    pheap_t      *p_h  = (pheap_t *) p_pheap;
+    pheap_node_t *p_n  = NULL;
+
+    max  = (ADTS_HEAP_MAX == p_h->type);
+    prev = max ? INT64_MAX : INT64_MIN;
+    for (size_t idx = 0; idx < elems; idx++) {
+        p_n = (pheap_node_t *) adts_pheap_pop(p_pheap);
+        assert(p_n);
+        assert(max ? (p_n->key <= prev) : (p_n->key >= prev));
+        assert((NULL == p_n->p_prev) && (NULL == p_n->p_child));
+        prev = p_n->key;
+    }
+    assert(adts_pheap_is_empty(p_pheap));
+    assert(0 == adts_pheap_entries(p_pheap));
+
+    return;
+} /* utest_pheap_drain() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Per thread candidate heaps merged into one and drained.  adts_heap
+ *   merges by popping every node of each local heap and pushing it into
+ *   the first, the pairing heap melds each local root in O(1).
+ *
+ ****************************************************************************
+ */
+#define UTEST_PHEAP_ELEMS  (1000 * 1000)
+#define UTEST_PHEAP_LOCALS (8)
+
+static void
+utest_pheap_benchmark( void )
+{
+    const size_t        elems    = UTEST_PHEAP_ELEMS;
+    const size_t        locals   = UTEST_PHEAP_LOCALS;
+    const size_t        share    = elems / locals;
+    adts_heap_node_t   *p_hnodes = NULL;
+    adts_pheap_node_t  *p_pnodes = NULL;
+    adts_heap_t        *p_heap[ UTEST_PHEAP_LOCALS ];
+    adts_pheap_t       *p_pheap[ UTEST_PHEAP_LOCALS ];
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: %zu x %zu candidates, merge + drain", locals, share);
+
+    p_hnodes = calloc(elems, sizeof(*p_hnodes));
+    p_pnodes = calloc(elems, sizeof(*p_pnodes));
+    assert(p_hnodes && p_pnodes);
+
+    for (size_t rdx = 0; rdx < 2; rdx++) {
+        uint64_t seed     = 0x9E3779B97F4A7C15ULL;
+        uint64_t build    = 0;
+        uint64_t merge    = 0;
+        uint64_t drain    = 0;
+        bool     pairing  = (1 == rdx);
+
+        /* local heaps */
+        build = adts_tstamp();
+        for (size_t ldx = 0; ldx < locals; ldx++) {
+            if (pairing) {
+                p_pheap[ldx] = adts_pheap_create(ADTS_HEAP_MIN);
+                assert(p_pheap[ldx]);
+            } else {
+                p_heap[ldx] = adts_heap_create(ADTS_HEAP_MIN);
+                assert(p_heap[ldx]);
+            }
+
+            for (size_t idx = ldx * share; idx < (ldx + 1) * share; idx++) {
+                int64_t key = utest_pheap_key(&(seed));
+
+                if (pairing) {
+                    assert(0 == adts_pheap_push(p_pheap[ldx], &(p_pnodes[idx]),
+                                                &(p_pnodes[idx]), 1, key));
+                } else {
+                    assert(0 == adts_heap_push(p_heap[ldx], &(p_hnodes[idx]),
+                                               &(p_hnodes[idx]), 1, key));
+                }
+            }
+        }
+        build = adts_tstamp() - build;
+
+        /* merge into the first */
+        merge = adts_tstamp();
+        for (size_t ldx = 1; ldx < locals; ldx++) {
+            if (pairing) {
+                assert(0 == adts_pheap_meld(p_pheap[0], p_pheap[ldx]));
+                continue;
+            }
+
+            for (size_t idx = 0; idx < share; idx++) {
+                adts_heap_node_t *p_n = adts_heap_pop(p_heap[ldx]);
+
+                assert(0 == adts_heap_push(p_heap[0], p_n, p_n, 1,
+                                           adts_heap_node_key(p_n)));
+            }
+        }
+        merge = adts_tstamp() - merge;
+
+        /* drain */
+        drain = adts_tstamp();
+        for (size_t idx = 0; idx < share * locals; idx++) {
+            if (pairing) {
+                assert(adts_pheap_pop(p_pheap[0]));
+            } else {
+                assert(adts_heap_pop(p_heap[0]));
+            }
+        }
+        drain = adts_tstamp() - drain;
+
+        for (size_t ldx = 0; ldx < locals; ldx++) {
+            if (pairing) {
+                assert(adts_pheap_is_empty(p_pheap[ldx]));
+                adts_pheap_destroy(p_pheap[ldx]);
+            } else {
+                assert(adts_heap_is_empty(p_heap[ldx]));
+                adts_heap_destroy(p_heap[ldx]);
+            }
+        }
+
+        CDISPLAY("%-12s  push: %6llu us  merge: %6llu us  drain: %6llu us",
+                 pairing ? "pairing heap" : "adts_heap", build / 1000,
+                 merge / 1000, drain / 1000);
+    }
+
+    free(p_pnodes);
+    free(p_hnodes);
+
+    return;
+} /* utest_pheap_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_pheap_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> destroy, accounting");
+
+        adts_pheap_t     *p_pheap = NULL;
+        adts_pheap_node_t node    = {0};
+        adts_mem_stats_t  before  = {0};
+        adts_mem_stats_t  after   = {0};
+
+        assert(NULL == adts_pheap_create(ADTS_HEAP_RADIX));
+        assert(NULL == adts_pheap_create(ADTS_HEAP_MINMAX));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_PHEAP, &(before));
+        p_pheap = adts_pheap_create(ADTS_HEAP_MIN);
+        assert(p_pheap);
+        assert(adts_pheap_is_empty(p_pheap));
+        assert(NULL == adts_pheap_peek(p_pheap));
+        assert(NULL == adts_pheap_pop(p_pheap));
+        assert(EINVAL == adts_pheap_update_key(p_pheap, &(node), 0));
+        assert(EINVAL == adts_pheap_remove_node(p_pheap, &(node)));
+
+        assert(0 == adts_pheap_push(p_pheap, &(node), &(node), 1, 7));
+        assert(&(node) == adts_pheap_peek(p_pheap));
+        assert(0 == adts_pheap_update_key(p_pheap, &(node), 9));
+        assert(9 == adts_pheap_node_key(adts_pheap_peek(p_pheap)));
+        adts_pheap_display(p_pheap);
+        assert(&(node) == adts_pheap_pop(p_pheap));
+        assert(EINVAL == adts_pheap_remove_node(p_pheap, &(node)));
+
+        adts_pheap_destroy(p_pheap);
+        adts_mem_stats_type(ADTS_MEM_TYPE_PHEAP, &(after));
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: push, update_key, remove_node, pop order, MIN and MAX");
+
+        const size_t        limit   = 64 * 1024;
+        uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+        size_t              removed = 0;
+        adts_pheap_t       *p_pheap = NULL;
+        pheap_node_t       *p_n     = NULL;
+        adts_pheap_node_t  *p_nodes = NULL;
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        for (size_t tdx = 0; tdx < 2; tdx++) {
+            p_pheap = adts_pheap_create(tdx ? ADTS_HEAP_MAX : ADTS_HEAP_MIN);
+            assert(p_pheap);
+
+            /* ascending and descending runs, flat and deep trees */
+            for (size_t i = 0; i < limit; i++) {
+                int64_t key = (i < limit / 2) ? (int64_t) i : -(int64_t) i;
+
+                assert(0 == adts_pheap_push(p_pheap, &(p_nodes[i]),
+                                            &(p_nodes[i]), 1, key));
+            }
+            assert(limit == adts_pheap_entries(p_pheap));
+
+            /* move keys both toward the root and the leaves */
+            for (size_t i = 0; i < limit; i += 2) {
+                assert(0 == adts_pheap_update_key(p_pheap, &(p_nodes[i]),
+                                                  utest_pheap_key(&(seed))));
+            }
+            assert(0 == adts_pheap_update_key(p_pheap, &(p_nodes[1]),
+                                              tdx ? INT64_MAX : INT64_MIN));
+            assert(&(p_nodes[1]) == adts_pheap_peek(p_pheap));
+
+            /* remove a third, and the root */
+            removed = 0;
+            for (size_t i = 0; i < limit; i += 3) {
+                assert(0 == adts_pheap_remove_node(p_pheap, &(p_nodes[i])));
+                assert(EINVAL == adts_pheap_remove_node(p_pheap,
+                                                        &(p_nodes[i])));
+                removed++;
+            }
+            p_n = (pheap_node_t *) adts_pheap_peek(p_pheap);
+            assert(0 == adts_pheap_remove_node(p_pheap,
+                                               (adts_pheap_node_t *) p_n));
+            removed++;
+            assert((limit - removed) == adts_pheap_entries(p_pheap));
+            utest_pheap_drain(p_pheap, limit - removed);
+
+            adts_pheap_destroy(p_pheap);
+        }
+
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: meld");
+
+        const size_t        limit   = 4096;
+        uint64_t            seed    = 0x9E3779B97F4A7C15ULL;
+        adts_pheap_t       *p_a     = NULL;
+        adts_pheap_t       *p_b     = NULL;
+        adts_pheap_t       *p_max   = NULL;
+        adts_pheap_node_t  *p_nodes = NULL;
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        assert(p_nodes);
+
+        p_a   = adts_pheap_create(ADTS_HEAP_MIN);
+        p_b   = adts_pheap_create(ADTS_HEAP_MIN);
+        p_max = adts_pheap_create(ADTS_HEAP_MAX);
+        assert(p_a && p_b && p_max);
+
+        assert(EINVAL == adts_pheap_meld(p_a, p_a));
+        assert(EINVAL == adts_pheap_meld(p_a, p_max));
+        assert(0 == adts_pheap_meld(p_a, p_b));
+        assert(adts_pheap_is_empty(p_a));
+
+        for (size_t i = 0; i < limit; i++) {
+            assert(0 == adts_pheap_push((i & 1) ? p_a : p_b, &(p_nodes[i]),
+                                        &(p_nodes[i]), 1,
+                                        utest_pheap_key(&(seed))));
+        }
+        assert(0 == adts_pheap_meld(p_a, p_b));
+        assert(limit == adts_pheap_entries(p_a));
+        assert(adts_pheap_is_empty(p_b));
+        assert(NULL == adts_pheap_pop(p_b));
+
+        /* melded nodes remain indexed by the destination */
+        assert(0 == adts_pheap_update_key(p_a, &(p_nodes[0]), -1));
+        assert(&(p_nodes[0]) == adts_pheap_peek(p_a));
+        assert(0 == adts_pheap_remove_node(p_a, &(p_nodes[2])));
+        utest_pheap_drain(p_a, limit - 1);
+
+        adts_pheap_destroy(p_max);
+        adts_pheap_destroy(p_b);
+        adts_pheap_destroy(p_a);
+        free(p_nodes);
+    }
+
+    utest_pheap_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_pheap( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_pheap() */
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_heap.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_PHEAP_BYTES      (256)
+#define ADTS_PHEAP_NODE_BYTES (48)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Pairing heap, a pointer based heap over consumer owned nodes.  No
+ *   workspace is allocated, the tree is linked through the nodes.
+ *
+ *   - push, meld:              O(1)
+ *   - peek:                    O(1)
+ *   - pop, remove_node:        O(log n) amortized
+ *   - update_key toward root:  O(1), O(log n) amortized bound
+ *   - update_key away:         O(log n) amortized
+ *
+ *   Type is ADTS_HEAP_MIN or ADTS_HEAP_MAX.  A node must not be copied or
+ *   moved while queued.  A node that is not queued, e.g. popped or
+ *   removed, returns EINVAL from update_key / remove_node.  A node queued
+ *   in another pairing heap is undefined, since meld does not track node
+ *   ownership.
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_PHEAP_NODE_BYTES ];
+} adts_pheap_node_t;
+
+typedef struct {
+    const char reserved[ ADTS_PHEAP_BYTES ];
+} adts_pheap_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+void
+adts_pheap_mem_stats( adts_pheap_t     *p_adts_pheap,
+                      adts_mem_stats_t *p_stats );
+
+bool
+adts_pheap_is_empty( adts_pheap_t *p_adts_pheap );
+
+size_t
+adts_pheap_entries( adts_pheap_t *p_adts_pheap );
+
+void
+adts_pheap_display( adts_pheap_t *p_adts_pheap );
+
+adts_pheap_node_t *
+adts_pheap_peek( adts_pheap_t *p_adts_pheap );
+
+int64_t
+adts_pheap_node_key( const adts_pheap_node_t *p_adts_node_pheap );
+
+adts_pheap_node_t *
+adts_pheap_pop( adts_pheap_t *p_adts_pheap );
+
+int32_t
+adts_pheap_push( adts_pheap_t      *p_adts_pheap,
+                 adts_pheap_node_t *p_adts_node_pheap,
+                 void              *p_data,
+                 size_t             bytes,
+                 int64_t            key );
+
+int32_t
+adts_pheap_update_key( adts_pheap_t      *p_adts_pheap,
+                       adts_pheap_node_t *p_adts_node_pheap,
+                       int64_t            key );
+
+int32_t
+adts_pheap_remove_node( adts_pheap_t      *p_adts_pheap,
+                        adts_pheap_node_t *p_adts_node_pheap );
+
+/**
+ **************************************************************************
+ * \details
+ *   Move every node of src into dst in O(1), src is left empty and may be
+ *   reused or destroyed.  Both heaps must share a type, otherwise EINVAL.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_pheap_meld( adts_pheap_t *p_adts_pheap_dst,
+                 adts_pheap_t *p_adts_pheap_src );
+
+void
+adts_pheap_destroy( adts_pheap_t *p_adts_pheap );
+
+adts_pheap_t *
+adts_pheap_create( adts_heap_type_t type );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_pheap( void );
@@ -0,0 +1,1599 @@
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <malloc.h>  /* malloc_trim() */
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <unistd.h>  /* sysconf() */
+
+/* Toolbox */
+#include <adts_pool.h>
+#include <adts_time.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - return fully free slabs to the system under memory pressure
+ *    - size magazines dynamically based on depot contention
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Object alignment within a slab.  Sufficient for every ADT node type.
+ *
+ ****************************************************************************
+ */
+#define POOL_OBJ_ALIGN   (16)
+#define POOL_SLAB_OBJS   (16)  /**< minimum objects per slab */
+
+#define POOL_ROUNDUP( _val, _align ) \
+    ((((_val) + (_align) - 1) / (_align)) * (_align))
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Slab header, resident at the base of every slab.  Objects are carved
+ *   from the remainder of the slab.
+ *
+ ****************************************************************************
+ */
+typedef struct pool_slab_s {
+    struct pool_slab_s *p_next;
+} pool_slab_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Free objects are chained through their first word.
+ *
+ ****************************************************************************
+ */
+typedef struct pool_obj_s {
+    struct pool_obj_s *p_next;
+} pool_obj_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Magazine, a stack of free objects sized to four cachelines.
+ *
+ ****************************************************************************
+ */
+#define POOL_MAG_OBJS (30)
+
+typedef struct pool_mag_s {
+    struct pool_mag_s *p_next;  /**< depot linkage */
+    size_t             rounds;  /**< objects currently held */
+    void              *p_objs[ POOL_MAG_OBJS ];
+} pool_mag_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Per thread magazine pair for a single pool.  The previous magazine is
+ *   always either full or empty, thus a thread alternates between the two
+ *   and only visits the depot once per POOL_MAG_OBJS operations at worst.
+ *
+ *   Bound caches are linked into the pool registry such that destroying
+ *   the pool can unbind them.  Binding, unbinding and the registry are
+ *   serialized by pool_tcache_lock.
+ *
+ ****************************************************************************
+ */
+typedef struct pool_tcache_s {
+    struct pool_s         *p_pool;      /**< NULL when unbound */
+    pool_mag_t            *p_loaded;
+    pool_mag_t            *p_previous;
+    struct pool_tcache_s  *p_next;      /**< pool registry linkage */
+    struct pool_tcache_s **pp_prev;
+} pool_tcache_t;
+
+static pthread_mutex_t  pool_tcache_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t   pool_tcache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t    pool_tcache_key;
+static int32_t          pool_tcache_rc   = 0;
+
+static __thread pool_tcache_t pool_tcaches[ ADTS_POOL_MAGAZINE_POOLS ];
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct pool_s {
+    adts_pool_create_t  params;
+    size_t              obj_bytes;  /**< rounded object size */
+    size_t              slab_bytes;
+    pool_obj_t         *p_free;     /**< recycled objects */
+    char               *p_carve;    /**< next uncarved object in slab */
+    char               *p_limit;    /**< end of the current slab */
+    pool_slab_t        *p_slabs;
+    adts_pool_stats_t   stats;
+    pthread_spinlock_t  lock;       /**< ADTS_POOL_OPTS_SHARED only */
+    adts_sanity_t       sanity;
+    adts_mem_stats_t    mem;        /**< unless charged to an owner */
+
+    /**< ADTS_POOL_OPTS_MAGAZINE only, serialized via lock */
+    pool_mag_t         *p_mags_full;   /**< depot */
+    pool_mag_t         *p_mags_empty;  /**< depot */
+    size_t              mags_full;
+    pool_tcache_t      *p_tcaches;     /**< bound thread caches */
+} pool_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Shared pools are serialized internally, all others are expected to be
+ *   serialized by the consumer.
+ *
+ ****************************************************************************
+ */
+static inline void
+pool_enter( pool_t *p_pool )
+{
+    if (p_pool->params.options & ADTS_POOL_OPTS_SHARED) {
+        pthread_spin_lock(&(p_pool->lock));
+    }else {
+        adts_sanity_entry(&(p_pool->sanity));
+    }
+
+    return;
+} /* pool_enter() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void
+pool_exit( pool_t *p_pool )
+{
+    if (p_pool->params.options & ADTS_POOL_OPTS_SHARED) {
+        pthread_spin_unlock(&(p_pool->lock));
+    }else {
+        adts_sanity_exit(&(p_pool->sanity));
+    }
+
+    return;
+} /* pool_exit() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Accounting record charged for every slab and the handle.
+ *
+ ****************************************************************************
+ */
+static inline adts_mem_stats_t *
+pool_mem( pool_t *p_pool )
+{
+    return p_pool->params.p_stats ? p_pool->params.p_stats : &(p_pool->mem);
+} /* pool_mem() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Acquire a new slab.  Objects are carved lazily such that untouched
+ *   portions of the slab are never faulted in.
+ *
+ ****************************************************************************
+ */
+static int32_t
+pool_slab_grow( pool_t *p_pool )
+{
+    int32_t      rc     = 0;
+    pool_slab_t *p_slab = NULL;
+
+    if (p_pool->params.p_arena) {
+        p_slab = adts_arena_zalloc(p_pool->params.p_arena, p_pool->slab_bytes);
+    }else {
+        p_slab = adts_mem_zalloc_acct(pool_mem(p_pool), p_pool->slab_bytes,
+                                      ADTS_MEM_ALIGN_PAGE);
+    }
+    if (unlikely(NULL == p_slab)) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_slab->p_next   = p_pool->p_slabs;
+    p_pool->p_slabs  = p_slab;
+    p_pool->p_carve  = ((char *) p_slab) + POOL_ROUNDUP(sizeof(*p_slab), POOL_OBJ_ALIGN);
+    p_pool->p_limit  = ((char *) p_slab) + p_pool->slab_bytes;
+    p_pool->stats.slabs++;
+
+exception:
+    return rc;
+} /* pool_slab_grow() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Slab layer allocate, the pool must be entered.  Recycled objects are
+ *   preferred over fresh objects such that the working set remains cache
+ *   resident.
+ *
+ ****************************************************************************
+ */
+static inline pool_obj_t *
+pool_slab_alloc( pool_t *p_pool,
+                 bool   *p_fresh )
+{
+    int32_t     rc    = 0;
+    pool_obj_t *p_obj = NULL;
+
+    if (likely(p_pool->p_free)) {
+        p_obj          = p_pool->p_free;
+        p_pool->p_free = p_obj->p_next;
+    }else {
+        if (unlikely((p_pool->p_carve + p_pool->obj_bytes) > p_pool->p_limit)) {
+            rc = pool_slab_grow(p_pool);
+            if (unlikely(rc)) {
+                goto exception;
+            }
+        }
+
+        p_obj            = (pool_obj_t *) p_pool->p_carve;
+        p_pool->p_carve += p_pool->obj_bytes;
+        *p_fresh         = true;
+    }
+
+    p_pool->stats.allocs++;
+    p_pool->stats.objs_curr++;
+    p_pool->stats.objs_max = MAX(p_pool->stats.objs_max, p_pool->stats.objs_curr);
+
+exception:
+    return p_obj;
+} /* pool_slab_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Slab layer free, the pool must be entered.
+ *
+ ****************************************************************************
+ */
+static inline void
+pool_slab_free( pool_t *p_pool,
+                void   *p_obj )
+{
+    pool_obj_t *p_node = p_obj;
+
+    p_node->p_next = p_pool->p_free;
+    p_pool->p_free = p_node;
+
+    p_pool->stats.frees++;
+    p_pool->stats.objs_curr--;
+
+    return;
+} /* pool_slab_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Depot operations, the pool must be entered.  A magazine is allocated
+ *   on demand when the depot holds no empty magazine.
+ *
+ ****************************************************************************
+ */
+static inline void
+pool_depot_put( pool_t     *p_pool,
+                pool_mag_t *p_mag )
+{
+    if (POOL_MAG_OBJS == p_mag->rounds) {
+        p_mag->p_next       = p_pool->p_mags_full;
+        p_pool->p_mags_full = p_mag;
+        p_pool->mags_full++;
+    }else {
+        assert(0 == p_mag->rounds);
+        p_mag->p_next        = p_pool->p_mags_empty;
+        p_pool->p_mags_empty = p_mag;
+    }
+
+    return;
+} /* pool_depot_put() */
+
+static inline pool_mag_t *
+pool_depot_get_full( pool_t *p_pool )
+{
+    pool_mag_t *p_mag = p_pool->p_mags_full;
+
+    if (p_mag) {
+        p_pool->p_mags_full = p_mag->p_next;
+        p_pool->mags_full--;
+    }
+
+    return p_mag;
+} /* pool_depot_get_full() */
+
+static inline pool_mag_t *
+pool_depot_get_empty( pool_t *p_pool )
+{
+    pool_mag_t *p_mag = p_pool->p_mags_empty;
+
+    if (p_mag) {
+        p_pool->p_mags_empty = p_mag->p_next;
+    }else {
+        p_mag = adts_mem_zalloc_acct(pool_mem(p_pool), sizeof(*p_mag),
+                                     ADTS_MEM_ALIGN_CACHELINE);
+        if (p_mag) {
+            p_pool->stats.mags++;
+        }
+    }
+
+    return p_mag;
+} /* pool_depot_get_empty() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release a magazine to the system, the pool must be entered.
+ *
+ ****************************************************************************
+ */
+static void
+pool_mag_release( pool_t     *p_pool,
+                  pool_mag_t *p_mag )
+{
+    if (p_mag) {
+        adts_mem_free_acct(pool_mem(p_pool), p_mag, sizeof(*p_mag),
+                           ADTS_MEM_ALIGN_CACHELINE);
+        p_pool->stats.mags--;
+    }
+
+    return;
+} /* pool_mag_release() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Return a thread's magazines to the depot and remove the cache from the
+ *   pool registry.  Partially filled magazines are flushed to the slabs.
+ *   pool_tcache_lock must be held.
+ *
+ ****************************************************************************
+ */
+static void
+pool_tcache_unbind( pool_tcache_t *p_tc )
+{
+    pool_t     *p_pool = p_tc->p_pool;
+    pool_mag_t *p_mags[] = { p_tc->p_loaded, p_tc->p_previous };
+
+    pool_enter(p_pool);
+
+    for (size_t idx = 0; idx < (sizeof(p_mags) / sizeof(p_mags[0])); idx++) {
+        pool_mag_t *p_mag = p_mags[idx];
+
+        if (NULL == p_mag) {
+            continue;
+        }
+
+        if (POOL_MAG_OBJS != p_mag->rounds) {
+            while (p_mag->rounds) {
+                pool_slab_free(p_pool, p_mag->p_objs[--(p_mag->rounds)]);
+            }
+        }
+        pool_depot_put(p_pool, p_mag);
+    }
+
+    *(p_tc->pp_prev) = p_tc->p_next;
+    if (p_tc->p_next) {
+        p_tc->p_next->pp_prev = p_tc->pp_prev;
+    }
+
+    pool_exit(p_pool);
+
+    memset(p_tc, 0, sizeof(*p_tc));
+
+    return;
+} /* pool_tcache_unbind() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Thread exit, return every cached object to its pool.
+ *
+ ****************************************************************************
+ */
+static void
+pool_tcache_exit( void *p_arg )
+{
+    pool_tcache_t *p_tcaches = p_arg;
+
+    pthread_mutex_lock(&(pool_tcache_lock));
+    for (size_t idx = 0; idx < ADTS_POOL_MAGAZINE_POOLS; idx++) {
+        if (p_tcaches[idx].p_pool) {
+            pool_tcache_unbind(&(p_tcaches[idx]));
+        }
+    }
+    pthread_mutex_unlock(&(pool_tcache_lock));
+
+    return;
+} /* pool_tcache_exit() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+pool_tcache_init( void )
+{
+    pool_tcache_rc = pthread_key_create(&(pool_tcache_key), pool_tcache_exit);
+
+    return;
+} /* pool_tcache_init() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bind a free thread cache slot to the pool.  Returns NULL when every
+ *   slot is in use, in which case the caller falls back to the depot.
+ *
+ ****************************************************************************
+ */
+static pool_tcache_t *
+pool_tcache_bind( pool_t *p_pool )
+{
+    pool_tcache_t *p_tc = NULL;
+
+    pthread_once(&(pool_tcache_once), pool_tcache_init);
+    if (unlikely(pool_tcache_rc)) {
+        goto exception;
+    }
+
+    pthread_mutex_lock(&(pool_tcache_lock));
+
+    for (size_t idx = 0; idx < ADTS_POOL_MAGAZINE_POOLS; idx++) {
+        if (NULL == pool_tcaches[idx].p_pool) {
+            p_tc = &(pool_tcaches[idx]);
+            break;
+        }
+    }
+
+    if (p_tc) {
+        /* arms the exit destructor, idempotent */
+        pthread_setspecific(pool_tcache_key, pool_tcaches);
+
+        pool_enter(p_pool);
+        p_tc->p_pool  = p_pool;
+        p_tc->p_next  = p_pool->p_tcaches;
+        p_tc->pp_prev = &(p_pool->p_tcaches);
+        if (p_tc->p_next) {
+            p_tc->p_next->pp_prev = &(p_tc->p_next);
+        }
+        p_pool->p_tcaches = p_tc;
+        pool_exit(p_pool);
+    }
+
+    pthread_mutex_unlock(&(pool_tcache_lock));
+
+exception:
+    return p_tc;
+} /* pool_tcache_bind() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline pool_tcache_t *
+pool_tcache_get( pool_t *p_pool )
+{
+    pool_tcache_t *p_tc = NULL;
+
+    for (size_t idx = 0; idx < ADTS_POOL_MAGAZINE_POOLS; idx++) {
+        if (likely(p_pool == pool_tcaches[idx].p_pool)) {
+            p_tc = &(pool_tcaches[idx]);
+            goto exception;
+        }
+    }
+
+    p_tc = pool_tcache_bind(p_pool);
+
+exception:
+    return p_tc;
+} /* pool_tcache_get() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Magazine layer allocate.  Served from the loaded magazine, else the
+ *   previous magazine if full, else a full magazine from the depot, else
+ *   the slabs.
+ *
+ ****************************************************************************
+ */
+static void *
+pool_mag_alloc( pool_t *p_pool,
+                bool   *p_fresh )
+{
+    void          *p_obj = NULL;
+    pool_mag_t    *p_tmp = NULL;
+    pool_tcache_t *p_tc  = pool_tcache_get(p_pool);
+
+    if (unlikely(NULL == p_tc)) {
+        pool_enter(p_pool);
+        p_obj = pool_slab_alloc(p_pool, p_fresh);
+        pool_exit(p_pool);
+        goto exception;
+    }
+
+    if (likely(p_tc->p_loaded && p_tc->p_loaded->rounds)) {
+        goto pop;
+    }
+
+    if (p_tc->p_previous && p_tc->p_previous->rounds) {
+        p_tmp              = p_tc->p_loaded;
+        p_tc->p_loaded     = p_tc->p_previous;
+        p_tc->p_previous   = p_tmp;
+        goto pop;
+    }
+
+    /* both empty, exchange the previous for a full magazine */
+    pool_enter(p_pool);
+    p_tmp = pool_depot_get_full(p_pool);
+    if (p_tmp) {
+        if (p_tc->p_previous) {
+            pool_depot_put(p_pool, p_tc->p_previous);
+        }
+        p_tc->p_previous = p_tc->p_loaded;
+        p_tc->p_loaded   = p_tmp;
+    }else {
+        p_obj = pool_slab_alloc(p_pool, p_fresh);
+    }
+    pool_exit(p_pool);
+
+    if (NULL == p_tmp) {
+        goto exception;
+    }
+
+pop:
+    p_obj = p_tc->p_loaded->p_objs[--(p_tc->p_loaded->rounds)];
+
+exception:
+    return p_obj;
+} /* pool_mag_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Magazine layer free.  Mirror of pool_mag_alloc(), the full previous
+ *   magazine is exchanged for an empty one.  Absent an empty magazine the
+ *   object is returned to the slabs.
+ *
+ ****************************************************************************
+ */
+static void
+pool_mag_free( pool_t *p_pool,
+               void   *p_obj )
+{
+    pool_mag_t    *p_tmp = NULL;
+    pool_tcache_t *p_tc  = pool_tcache_get(p_pool);
+
+    if (unlikely(NULL == p_tc)) {
+        pool_enter(p_pool);
+        pool_slab_free(p_pool, p_obj);
+        pool_exit(p_pool);
+        goto exception;
+    }
+
+    if (likely(p_tc->p_loaded && (POOL_MAG_OBJS > p_tc->p_loaded->rounds))) {
+        goto push;
+    }
+
+    if (p_tc->p_previous && (0 == p_tc->p_previous->rounds)) {
+        p_tmp              = p_tc->p_loaded;
+        p_tc->p_loaded     = p_tc->p_previous;
+        p_tc->p_previous   = p_tmp;
+        goto push;
+    }
+
+    /* both full, exchange the previous for an empty magazine */
+    pool_enter(p_pool);
+    p_tmp = pool_depot_get_empty(p_pool);
+    if (p_tmp) {
+        if (p_tc->p_previous) {
+            pool_depot_put(p_pool, p_tc->p_previous);
+        }
+        p_tc->p_previous = p_tc->p_loaded;
+        p_tc->p_loaded   = p_tmp;
+    }else {
+        pool_slab_free(p_pool, p_obj);
+    }
+    pool_exit(p_pool);
+
+    if (NULL == p_tmp) {
+        goto exception;
+    }
+
+push:
+    p_tc->p_loaded->p_objs[(p_tc->p_loaded->rounds)++] = p_obj;
+
+exception:
+    return;
+} /* pool_mag_free() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_pool_obj_bytes( adts_pool_t *p_adts_pool )
+{
+    pool_t *p_pool = (pool_t *) p_adts_pool;
+
+    return p_pool->params.obj_bytes;
+} /* adts_pool_obj_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_pool_stats( adts_pool_t       *p_adts_pool,
+                 adts_pool_stats_t *p_stats )
+{
+    pool_t *p_pool = (pool_t *) p_adts_pool;
+
+    pool_enter(p_pool);
+    *p_stats             = p_pool->stats;
+    p_stats->objs_cached = p_pool->mags_full * POOL_MAG_OBJS;
+    pool_exit(p_pool);
+
+    return;
+} /* adts_pool_stats() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Pools charged to an owner report the owner's record.
+ *
+ ****************************************************************************
+ */
+void
+adts_pool_mem_stats( adts_pool_t      *p_adts_pool,
+                     adts_mem_stats_t *p_stats )
+{
+    pool_t *p_pool = (pool_t *) p_adts_pool;
+
+    pool_enter(p_pool);
+    *p_stats = *(pool_mem(p_pool));
+    pool_exit(p_pool);
+
+    return;
+} /* adts_pool_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_pool_display( adts_pool_t *p_adts_pool )
+{
+    pool_t            *p_pool = (pool_t *) p_adts_pool;
+    adts_pool_stats_t  stats  = {0};
+
+    adts_pool_stats(p_adts_pool, &stats);
+
+    printf("pool: %p  obj_bytes: %zu (%zu)  slab_bytes: %zu  slabs: %zu \n",
+            p_pool,
+            p_pool->params.obj_bytes,
+            p_pool->obj_bytes,
+            p_pool->slab_bytes,
+            stats.slabs);
+    printf("  allocs: %zu  frees: %zu  curr: %zu  max: %zu \n",
+            stats.allocs,
+            stats.frees,
+            stats.objs_curr,
+            stats.objs_max);
+    if (p_pool->params.options & ADTS_POOL_OPTS_MAGAZINE) {
+        printf("  mags: %zu  cached: %zu \n", stats.mags, stats.objs_cached);
+    }
+
+    return;
+} /* adts_pool_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Return an object to the pool.  NULL is tolerated.
+ *
+ ****************************************************************************
+ */
+void
+adts_pool_free( adts_pool_t *p_adts_pool,
+                void        *p_obj )
+{
+    pool_t *p_pool = (pool_t *) p_adts_pool;
+
+    if (unlikely(NULL == p_obj)) {
+        goto exception;
+    }
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_MAGAZINE) {
+        pool_mag_free(p_pool, p_obj);
+        goto exception;
+    }
+
+    pool_enter(p_pool);
+    pool_slab_free(p_pool, p_obj);
+    pool_exit(p_pool);
+
+exception:
+    return;
+} /* adts_pool_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Allocate a single object.  Constructors and zeroing are applied
+ *   outside of the pool lock.
+ *
+ ****************************************************************************
+ */
+void *
+adts_pool_alloc( adts_pool_t *p_adts_pool )
+{
+    bool        fresh  = false;
+    pool_t     *p_pool = (pool_t *) p_adts_pool;
+    pool_obj_t *p_obj  = NULL;
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_MAGAZINE) {
+        p_obj = pool_mag_alloc(p_pool, &fresh);
+    }else {
+        pool_enter(p_pool);
+        p_obj = pool_slab_alloc(p_pool, &fresh);
+        pool_exit(p_pool);
+    }
+
+    if (likely(p_obj)) {
+        if (p_pool->params.options & ADTS_POOL_OPTS_ZERO) {
+            memset(p_obj, 0, p_pool->params.obj_bytes);
+        }else if (fresh && p_pool->params.p_ctor) {
+            /* constructed once, objects are returned in constructed state */
+            p_pool->params.p_ctor(p_obj, p_pool->params.obj_bytes);
+        }else if (fresh) {
+            /* slab memory is zeroed, clear the free list linkage only */
+            p_obj->p_next = NULL;
+        }
+    }
+
+    return p_obj;
+} /* adts_pool_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release every slab, including any objects still outstanding.
+ *
+ ****************************************************************************
+ */
+void
+adts_pool_destroy( adts_pool_t *p_adts_pool )
+{
+    pool_t           *p_pool  = (pool_t *) p_adts_pool;
+    pool_slab_t      *p_slab  = NULL;
+    adts_arena_t     *p_arena = NULL;
+    adts_mem_stats_t  mem     = {0};
+    adts_mem_stats_t *p_mem   = NULL;
+
+    if (NULL == p_adts_pool) {
+        goto exception;
+    }
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_MAGAZINE) {
+        /* lock order: pool_tcache_lock, then the pool */
+        pthread_mutex_lock(&(pool_tcache_lock));
+    }
+
+    pool_enter(p_pool);
+
+    /* thread caches are unbound, their objects are released with the slabs */
+    while (p_pool->p_tcaches) {
+        pool_tcache_t *p_tc = p_pool->p_tcaches;
+
+        pool_mag_release(p_pool, p_tc->p_loaded);
+        pool_mag_release(p_pool, p_tc->p_previous);
+        p_pool->p_tcaches = p_tc->p_next;
+        memset(p_tc, 0, sizeof(*p_tc));
+    }
+    while (p_pool->p_mags_full) {
+        pool_mag_release(p_pool, pool_depot_get_full(p_pool));
+    }
+    while (p_pool->p_mags_empty) {
+        pool_mag_t *p_mag = p_pool->p_mags_empty;
+
+        p_pool->p_mags_empty = p_mag->p_next;
+        pool_mag_release(p_pool, p_mag);
+    }
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_MAGAZINE) {
+        pthread_mutex_unlock(&(pool_tcache_lock));
+    }
+
+    /* arena owned memory is reclaimed on arena reset */
+    p_arena = p_pool->params.p_arena;
+    p_mem   = pool_mem(p_pool);
+    p_slab  = p_pool->p_slabs;
+    while (p_slab && (NULL == p_arena)) {
+        pool_slab_t *p_next = p_slab->p_next;
+
+        adts_mem_free_acct(p_mem, p_slab, p_pool->slab_bytes, ADTS_MEM_ALIGN_PAGE);
+        p_slab = p_next;
+    }
+
+    if (p_mem == &(p_pool->mem)) {
+        /* the record is released along with the handle */
+        mem   = p_pool->mem;
+        p_mem = &(mem);
+    }
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_SHARED) {
+        pthread_spin_unlock(&(p_pool->lock));
+        pthread_spin_destroy(&(p_pool->lock));
+    }
+
+    if (NULL == p_arena) {
+        adts_mem_free_acct(p_mem, p_pool, sizeof(adts_pool_t), ADTS_MEM_ALIGN_DEFAULT);
+    }else {
+        /* arena memory is outside of the scrub policy, invalidate only */
+        memset(p_pool, 0, sizeof(*p_pool));
+    }
+
+    /* No pool_exit() since we've freed the memory */
+
+exception:
+    return;
+} /* adts_pool_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Objects are rounded up to POOL_OBJ_ALIGN.  Slabs hold a minimum of
+ *   POOL_SLAB_OBJS objects and are rounded up to the system page size,
+ *   arena sourced slabs are not page rounded.
+ *
+ ****************************************************************************
+ */
+adts_pool_t *
+adts_pool_create( const adts_pool_create_t *p_op )
+{
+    int32_t           rc          = 0;
+    size_t            page        = sysconf(_SC_PAGESIZE);
+    size_t            slab_bytes  = 0;
+    pool_t           *p_pool      = NULL;
+    adts_pool_t      *p_adts_pool = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_POOL);
+    adts_mem_stats_t *p_mem       = &(mem);
+
+    if (unlikely((NULL == p_op) || (0 == p_op->obj_bytes))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    if (p_op->p_stats) {
+        p_mem = p_op->p_stats;
+    }
+
+    if (p_op->p_arena) {
+        p_adts_pool = adts_arena_zalloc(p_op->p_arena, sizeof(*p_adts_pool));
+    }else {
+        p_adts_pool = adts_mem_zalloc_acct(p_mem, sizeof(*p_adts_pool),
+                                           ADTS_MEM_ALIGN_DEFAULT);
+    }
+    if (NULL == p_adts_pool) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_pool            = (pool_t *) p_adts_pool;
+    p_pool->params    = *p_op;
+    p_pool->mem       = mem;
+    if (p_op->options & ADTS_POOL_OPTS_MAGAZINE) {
+        p_pool->params.options |= ADTS_POOL_OPTS_SHARED;
+    }
+    p_pool->obj_bytes = POOL_ROUNDUP(MAX(p_op->obj_bytes, sizeof(pool_obj_t)),
+                                     POOL_OBJ_ALIGN);
+
+    slab_bytes = p_op->slab_bytes ? p_op->slab_bytes : ADTS_POOL_SLAB_BYTES;
+    slab_bytes = MAX(slab_bytes,
+                     POOL_ROUNDUP(sizeof(pool_slab_t), POOL_OBJ_ALIGN) +
+                     (POOL_SLAB_OBJS * p_pool->obj_bytes));
+    p_pool->slab_bytes = POOL_ROUNDUP(slab_bytes, p_op->p_arena ? POOL_OBJ_ALIGN : page);
+
+    if (p_pool->params.options & ADTS_POOL_OPTS_SHARED) {
+        rc = pthread_spin_init(&(p_pool->lock), PTHREAD_PROCESS_PRIVATE);
+        if (rc) {
+            goto exception;
+        }
+    }
+
+exception:
+    if (rc) {
+        if (p_adts_pool && (NULL == p_op->p_arena)) {
+            adts_mem_free_acct(p_mem, p_adts_pool, sizeof(*p_adts_pool),
+                               ADTS_MEM_ALIGN_DEFAULT);
+        }
+        p_adts_pool = NULL;
+    }
+
+    return p_adts_pool;
+} /* adts_pool_create() */
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+#define UTEST_POOL_OBJS   (1 << 20)
+#define UTEST_POOL_THREADS      (4)
+#define UTEST_POOL_SCALE        (8)   /**< max benchmark threads */
+#define UTEST_POOL_SCALE_OPS    (1 << 22)
+#define UTEST_POOL_XFER    (1 << 14)
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_pool_bytes( void )
+{
+    CDISPLAY("[%u]", sizeof(pool_t));
+    CDISPLAY("[%u]", sizeof(adts_pool_t));
+
+    _Static_assert(sizeof(pool_t) <= sizeof(adts_pool_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_pool_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Resident set size in bytes, sourced from procfs.
+ *
+ ****************************************************************************
+ */
+static size_t
+utest_pool_rss( void )
+{
+    size_t  pages = 0;
+    size_t  rss   = 0;
+    FILE   *p_fd  = NULL;
+
+    p_fd = fopen("/proc/self/statm", "r");
+    if (p_fd) {
+        if (2 != fscanf(p_fd, "%zu %zu", &pages, &rss)) {
+            rss = 0;
+        }
+        fclose(p_fd);
+    }
+
+    return rss * sysconf(_SC_PAGESIZE);
+} /* utest_pool_rss() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+utest_pool_ctor( void   *p_obj,
+                 size_t  bytes )
+{
+    memset(p_obj, 0xA5, bytes);
+
+    return;
+} /* utest_pool_ctor() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void *
+utest_pool_worker( void *p_arg )
+{
+    adts_pool_t *p_pool = p_arg;
+    void        *p_objs[ 64 ];
+
+    for (int32_t iter = 0; iter < 1024; iter++) {
+        for (int32_t idx = 0; idx < 64; idx++) {
+            p_objs[idx] = adts_pool_alloc(p_pool);
+            assert(p_objs[idx]);
+            *((uint64_t *) p_objs[idx]) = idx;
+        }
+        for (int32_t idx = 0; idx < 64; idx++) {
+            assert(idx == *((uint64_t *) p_objs[idx]));
+            adts_pool_free(p_pool, p_objs[idx]);
+        }
+    }
+
+    return NULL;
+} /* utest_pool_worker() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Allocate into or free from a transfer array, such that objects are
+ *   freed by a thread other than the allocating thread.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    adts_pool_t  *p_pool;
+    void        **p_objs;
+    bool          alloc;
+} utest_pool_xfer_t;
+
+static void *
+utest_pool_xfer( void *p_arg )
+{
+    utest_pool_xfer_t *p_xfer = p_arg;
+
+    for (size_t idx = 0; idx < UTEST_POOL_XFER; idx++) {
+        if (p_xfer->alloc) {
+            p_xfer->p_objs[idx] = adts_pool_alloc(p_xfer->p_pool);
+            assert(p_xfer->p_objs[idx]);
+        }else {
+            adts_pool_free(p_xfer->p_pool, p_xfer->p_objs[idx]);
+        }
+    }
+
+    return NULL;
+} /* utest_pool_xfer() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Benchmark worker, bursts of allocations followed by their frees.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    adts_pool_t *p_pool;
+    size_t       ops;
+} utest_pool_scale_t;
+
+static void *
+utest_pool_scale_worker( void *p_arg )
+{
+    utest_pool_scale_t *p_scale = p_arg;
+    void               *p_objs[ 64 ];
+
+    for (size_t iter = 0; iter < p_scale->ops; iter += 64) {
+        for (int32_t idx = 0; idx < 64; idx++) {
+            p_objs[idx] = adts_pool_alloc(p_scale->p_pool);
+        }
+        for (int32_t idx = 0; idx < 64; idx++) {
+            adts_pool_free(p_scale->p_pool, p_objs[idx]);
+        }
+    }
+
+    return NULL;
+} /* utest_pool_scale_worker() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Multithreaded alloc + free throughput, a single lock versus magazines,
+ *   across thread counts.  The total operation count is fixed, thus ideal
+ *   scaling shows as a constant wall clock cost per operation divided by
+ *   the number of threads which may run in parallel.
+ *
+ ****************************************************************************
+ */
+static void
+utest_pool_benchmark_threads( void )
+{
+    const adts_pool_options_t options[] = { ADTS_POOL_OPTS_SHARED,
+                                            ADTS_POOL_OPTS_MAGAZINE };
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: shared vs magazine, %ld cpus",
+             sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (size_t odx = 0; odx < sizeof(options) / sizeof(options[0]); odx++) {
+        for (size_t threads = 1; threads <= UTEST_POOL_SCALE; threads <<= 1) {
+            uint64_t            start  = 0;
+            adts_pool_t        *p_pool = NULL;
+            adts_pool_create_t  op     = {0};
+            pthread_t           tid[ UTEST_POOL_SCALE ];
+            utest_pool_scale_t  scale  = {0};
+
+            op.obj_bytes = 64;
+            op.options   = options[odx];
+            p_pool = adts_pool_create(&op);
+            assert(p_pool);
+
+            scale.p_pool = p_pool;
+            scale.ops    = UTEST_POOL_SCALE_OPS / threads;
+
+            start = adts_tstamp();
+            for (size_t idx = 0; idx < threads; idx++) {
+                pthread_create(&(tid[idx]), NULL, utest_pool_scale_worker, &scale);
+            }
+            for (size_t idx = 0; idx < threads; idx++) {
+                pthread_join(tid[idx], NULL);
+            }
+
+            CDISPLAY("%-8s threads: %zu  alloc + free: %4llu ns wall",
+                     (ADTS_POOL_OPTS_MAGAZINE == options[odx]) ? "magazine" : "shared",
+                     threads,
+                     (adts_tstamp() - start) / UTEST_POOL_SCALE_OPS);
+
+            adts_pool_destroy(p_pool);
+        }
+    }
+
+    return;
+} /* utest_pool_benchmark_threads() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Allocation throughput and resident memory of the slab pool versus the
+ *   page aligned adts_mem_zalloc() path previously used for ADT nodes.
+ *
+ ****************************************************************************
+ */
+static void
+utest_pool_benchmark( size_t bytes )
+{
+    void **p_objs = NULL;
+
+    p_objs = calloc(UTEST_POOL_OBJS, sizeof(*p_objs));
+    assert(p_objs);
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: adts_pool, %zu byte objects", bytes);
+
+        uint64_t            start  = 0;
+        uint64_t            stop   = 0;
+        size_t              rss    = utest_pool_rss();
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_create_t  op     = {0};
+
+        op.obj_bytes = bytes;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        start = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            p_objs[idx] = adts_pool_alloc(p_pool);
+            assert(p_objs[idx]);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("objs: %u  alloc per obj: %llu ns  rss delta: %lld KB",
+                UTEST_POOL_OBJS,
+                (stop - start) / UTEST_POOL_OBJS,
+                ((int64_t) utest_pool_rss() - (int64_t) rss) / 1024);
+
+        start = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            adts_pool_free(p_pool, p_objs[idx]);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("free per obj: %llu ns", (stop - start) / UTEST_POOL_OBJS);
+
+        /* steady state: recycled objects only */
+        start = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            p_objs[idx] = adts_pool_alloc(p_pool);
+        }
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            adts_pool_free(p_pool, p_objs[idx]);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("recycled alloc + free per obj: %llu ns",
+                (stop - start) / UTEST_POOL_OBJS);
+
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: adts_mem_zalloc, %zu byte objects", bytes);
+
+        uint64_t start = 0;
+        uint64_t stop  = 0;
+        size_t   rss   = utest_pool_rss();
+
+        start = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            p_objs[idx] = adts_mem_zalloc(bytes);
+            assert(p_objs[idx]);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("objs: %u  alloc per obj: %llu ns  rss delta: %lld KB",
+                UTEST_POOL_OBJS,
+                (stop - start) / UTEST_POOL_OBJS,
+                ((int64_t) utest_pool_rss() - (int64_t) rss) / 1024);
+
+        start = adts_tstamp();
+        for (size_t idx = 0; idx < UTEST_POOL_OBJS; idx++) {
+            free(p_objs[idx]);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("free per obj: %llu ns", (stop - start) / UTEST_POOL_OBJS);
+
+        /* return the heap to the system ahead of subsequent measurements */
+        malloc_trim(0);
+    }
+
+    free(p_objs);
+
+    return;
+} /* utest_pool_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_pool_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> alloc -> free -> destroy");
+
+        void               *p_a    = NULL;
+        void               *p_b    = NULL;
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_stats_t   stats  = {0};
+        adts_pool_create_t  op     = {0};
+
+        p_pool = adts_pool_create(&op);
+        assert(NULL == p_pool);
+
+        op.obj_bytes = 24;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+        assert(24 == adts_pool_obj_bytes(p_pool));
+
+        p_a = adts_pool_alloc(p_pool);
+        p_b = adts_pool_alloc(p_pool);
+        assert(p_a && p_b && (p_a != p_b));
+        assert(0 == (((uintptr_t) p_a) % POOL_OBJ_ALIGN));
+        assert(0 == (((uintptr_t) p_b) % POOL_OBJ_ALIGN));
+
+        /* most recently freed object is recycled first */
+        adts_pool_free(p_pool, p_a);
+        assert(p_a == adts_pool_alloc(p_pool));
+
+        adts_pool_stats(p_pool, &stats);
+        assert(1 == stats.slabs);
+        assert(3 == stats.allocs);
+        assert(1 == stats.frees);
+        assert(2 == stats.objs_curr);
+        assert(2 == stats.objs_max);
+
+        adts_pool_display(p_pool);
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: constructor and zero options");
+
+        uint8_t            *p_obj  = NULL;
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_create_t  op     = {0};
+
+        op.obj_bytes = 32;
+        op.p_ctor    = utest_pool_ctor;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        p_obj = adts_pool_alloc(p_pool);
+        assert(0xA5 == p_obj[0]);
+        assert(0xA5 == p_obj[31]);
+        adts_pool_destroy(p_pool);
+
+        op.options = ADTS_POOL_OPTS_ZERO;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        p_obj = adts_pool_alloc(p_pool);
+        memset(p_obj, 0xFF, 32);
+        adts_pool_free(p_pool, p_obj);
+        p_obj = adts_pool_alloc(p_pool);
+        for (int32_t idx = 0; idx < 32; idx++) {
+            assert(0 == p_obj[idx]);
+        }
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: slab growth");
+
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_stats_t   stats  = {0};
+        adts_pool_create_t  op     = {0};
+
+        op.obj_bytes  = 64;
+        op.slab_bytes = 4096;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        for (int32_t idx = 0; idx < 1000; idx++) {
+            assert(adts_pool_alloc(p_pool));
+        }
+
+        adts_pool_stats(p_pool, &stats);
+        assert(1 < stats.slabs);
+        assert(1000 == stats.objs_curr);
+
+        /* outstanding objects are released along with the slabs */
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: shared pool, %u threads", UTEST_POOL_THREADS);
+
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_stats_t   stats  = {0};
+        adts_pool_create_t  op     = {0};
+        pthread_t           tid[ UTEST_POOL_THREADS ];
+
+        op.obj_bytes = sizeof(uint64_t);
+        op.options   = ADTS_POOL_OPTS_SHARED;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        for (int32_t idx = 0; idx < UTEST_POOL_THREADS; idx++) {
+            pthread_create(&(tid[idx]), NULL, utest_pool_worker, p_pool);
+        }
+        for (int32_t idx = 0; idx < UTEST_POOL_THREADS; idx++) {
+            pthread_join(tid[idx], NULL);
+        }
+
+        adts_pool_stats(p_pool, &stats);
+        assert(0 == stats.objs_curr);
+        assert(stats.allocs == stats.frees);
+        assert((UTEST_POOL_THREADS * 64) >= stats.objs_max);
+
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: magazine pool");
+
+        void               *p_objs[ 4 * POOL_MAG_OBJS ];
+        uint8_t            *p_obj  = NULL;
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_stats_t   stats  = {0};
+        adts_pool_create_t  op     = {0};
+
+        op.obj_bytes = 32;
+        op.options   = ADTS_POOL_OPTS_MAGAZINE | ADTS_POOL_OPTS_ZERO;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        /* most recently freed object is recycled first, and zeroed */
+        p_obj = adts_pool_alloc(p_pool);
+        memset(p_obj, 0xFF, 32);
+        adts_pool_free(p_pool, p_obj);
+        assert(p_obj == adts_pool_alloc(p_pool));
+        for (int32_t idx = 0; idx < 32; idx++) {
+            assert(0 == p_obj[idx]);
+        }
+        adts_pool_free(p_pool, p_obj);
+
+        /* spill full magazines to the depot */
+        for (size_t idx = 0; idx < (4 * POOL_MAG_OBJS); idx++) {
+            p_objs[idx] = adts_pool_alloc(p_pool);
+            assert(p_objs[idx]);
+        }
+        for (size_t idx = 0; idx < (4 * POOL_MAG_OBJS); idx++) {
+            adts_pool_free(p_pool, p_objs[idx]);
+        }
+
+        adts_pool_stats(p_pool, &stats);
+        assert(0 < stats.objs_cached);
+        assert(stats.objs_curr >= stats.objs_cached);
+        assert(3 <= stats.mags);
+        adts_pool_display(p_pool);
+
+        /* destroy with the calling thread still bound */
+        adts_pool_destroy(p_pool);
+
+        /* objects freed by a thread other than the allocating thread */
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        {
+            void              **p_xobjs = calloc(UTEST_POOL_XFER, sizeof(void *));
+            pthread_t           tid     = {0};
+            utest_pool_xfer_t   xfer    = { p_pool, p_xobjs, true };
+
+            assert(p_xobjs);
+            pthread_create(&tid, NULL, utest_pool_xfer, &xfer);
+            pthread_join(tid, NULL);
+
+            xfer.alloc = false;
+            pthread_create(&tid, NULL, utest_pool_xfer, &xfer);
+            pthread_join(tid, NULL);
+
+            /* exited threads hold nothing, every object is in the depot */
+            adts_pool_stats(p_pool, &stats);
+            assert(stats.objs_curr == stats.objs_cached);
+            free(p_xobjs);
+        }
+
+        /* thread cache slots exhausted, further pools take the locked path */
+        {
+            adts_pool_t *p_pools[ ADTS_POOL_MAGAZINE_POOLS + 1 ];
+
+            for (size_t idx = 0; idx < ADTS_POOL_MAGAZINE_POOLS + 1; idx++) {
+                p_pools[idx] = adts_pool_create(&op);
+                assert(p_pools[idx]);
+
+                p_obj = adts_pool_alloc(p_pools[idx]);
+                assert(p_obj);
+                adts_pool_free(p_pools[idx], p_obj);
+            }
+
+            adts_pool_stats(p_pools[ADTS_POOL_MAGAZINE_POOLS], &stats);
+            assert(0 == stats.objs_curr);
+            assert(0 == stats.mags);
+
+            for (size_t idx = 0; idx < ADTS_POOL_MAGAZINE_POOLS + 1; idx++) {
+                adts_pool_destroy(p_pools[idx]);
+            }
+        }
+
+        adts_pool_destroy(p_pool);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: magazine pool, %u threads", UTEST_POOL_THREADS);
+
+        adts_pool_t        *p_pool = NULL;
+        adts_pool_stats_t   stats  = {0};
+        adts_pool_create_t  op     = {0};
+        pthread_t           tid[ UTEST_POOL_THREADS ];
+
+        op.obj_bytes = sizeof(uint64_t);
+        op.options   = ADTS_POOL_OPTS_MAGAZINE;
+        p_pool = adts_pool_create(&op);
+        assert(p_pool);
+
+        for (int32_t idx = 0; idx < UTEST_POOL_THREADS; idx++) {
+            pthread_create(&(tid[idx]), NULL, utest_pool_worker, p_pool);
+        }
+        for (int32_t idx = 0; idx < UTEST_POOL_THREADS; idx++) {
+            pthread_join(tid[idx], NULL);
+        }
+
+        adts_pool_stats(p_pool, &stats);
+        assert(stats.objs_curr == stats.objs_cached);
+        assert(stats.allocs - stats.frees == stats.objs_curr);
+
+        adts_pool_destroy(p_pool);
+    }
+
+    utest_pool_benchmark(32);
+    utest_pool_benchmark(64);
+    utest_pool_benchmark_threads();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_pool( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_pool() */
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_POOL_BYTES (512)
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_POOL_BYTES ];
+} adts_pool_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   pool create options
+ *     - SHARED: the pool is internally serialized and may be used by
+ *       multiple threads concurrently.  Default pools rely on the ADT
+ *       consumer for serialization, same as every other ADT.
+ *     - ZERO:   objects are cleared on every allocation.
+ *     - MAGAZINE: implies SHARED.  Each thread caches free objects in a
+ *       pair of magazines, exchanged with a pool wide depot as whole
+ *       magazines, such that the common alloc/free path takes no lock and
+ *       touches no shared cache line.  A thread caches up to
+ *       ADTS_POOL_MAGAZINE_POOLS magazine pools, further pools fall back to
+ *       the locked path.  Cached objects are returned to the pool when the
+ *       thread exits.
+ *
+ *   When an arena is provided the handle and all slabs are sourced from the
+ *   arena, destroy releases nothing and memory is reclaimed on arena reset.
+ *
+ *   When p_stats is provided the handle and all slabs are charged to that
+ *   accounting record rather than the pool's own, such that an ADT built
+ *   on a pool reports the memory it holds.  The record must outlive the
+ *   pool and is updated under the same serialization as the pool.
+ *
+ **************************************************************************
+ */
+#define ADTS_POOL_OPTS_NONE          (0) /**< Default */
+#define ADTS_POOL_OPTS_SHARED   (1 << 1)
+#define ADTS_POOL_OPTS_ZERO     (1 << 2)
+#define ADTS_POOL_OPTS_MAGAZINE (1 << 3)
+typedef uint64_t adts_pool_options_t;
+
+#define ADTS_POOL_MAGAZINE_POOLS (4)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Optional object constructor.  Invoked once per object when the object
+ *   is first carved from a slab, not on every allocation.  Objects are
+ *   expected to be returned to the pool in their constructed state.
+ *
+ **************************************************************************
+ */
+typedef void (*adts_pool_ctor_t)( void   *p_obj,
+                                  size_t  bytes );
+
+typedef struct {
+    adts_pool_options_t  options;    /**< options bitfield */
+    size_t               obj_bytes;  /**< fixed object size */
+    size_t               slab_bytes; /**< 0 == ADTS_POOL_SLAB_BYTES */
+    adts_pool_ctor_t     p_ctor;     /**< optional, may be NULL */
+    adts_arena_t        *p_arena;    /**< optional slab source */
+    adts_mem_stats_t    *p_stats;    /**< optional owner to charge */
+} adts_pool_create_t;
+
+#define ADTS_POOL_SLAB_BYTES (64 * 1024)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   lifetime pool statistics
+ *
+ *   Magazine pools count objects as they leave and re-enter the slabs,
+ *   thus objects cached in magazines are included in objs_curr.  Those
+ *   resident in the depot are reported via objs_cached, those held by
+ *   thread magazines are not visible.
+ *
+ **************************************************************************
+ */
+typedef struct {
+    size_t slabs;       /**< slabs currently held */
+    size_t allocs;
+    size_t frees;
+    size_t objs_curr;   /**< objects currently allocated */
+    size_t objs_max;    /**< high watermark */
+    size_t mags;        /**< magazines currently held */
+    size_t objs_cached; /**< objects in full depot magazines */
+} adts_pool_stats_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   pool public prototypes
+ *
+ **************************************************************************
+ */
+size_t
+adts_pool_obj_bytes( adts_pool_t *p_adts_pool );
+
+void
+adts_pool_stats( adts_pool_t       *p_adts_pool,
+                 adts_pool_stats_t *p_stats );
+void
+adts_pool_mem_stats( adts_pool_t      *p_adts_pool,
+                     adts_mem_stats_t *p_stats );
+void
+adts_pool_display( adts_pool_t *p_adts_pool );
+
+void
+adts_pool_free( adts_pool_t *p_adts_pool,
+                void        *p_obj );
+void *
+adts_pool_alloc( adts_pool_t *p_adts_pool );
+
+void
+adts_pool_destroy( adts_pool_t *p_adts_pool );
+
+adts_pool_t *
+adts_pool_create( const adts_pool_create_t *p_op );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_pool( void );
+
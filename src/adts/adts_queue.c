@@ -3,11 +3,15 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
+#include <adts_pool.h>
+#include <adts_arena.h>
 #include <adts_queue.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -42,13 +46,29 @@ typedef struct queue_node_s {
  ****************************************************************************
  */
 typedef struct {
-    size_t        elems_curr;
-    queue_node_t *p_head;
-    queue_node_t *p_tail;
-    adts_sanity_t sanity;
+    size_t            elems_curr;
+    queue_node_t     *p_head;
+    queue_node_t     *p_tail;
+    adts_pool_t      *p_pool;  /**< node cache */
+    adts_arena_t     *p_arena; /**< optional, owns all memory */
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;     /**< charged for the node cache as well */
+    queue_node_t     *p_free;  /**< embedded node cache, p_pool unused */
+    bool              embedded;
 } queue_t;
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Arena sourced nodes are carved in small slabs since arena backed
+ *   queues are expected to be short lived.
+ *
+ ****************************************************************************
+ */
+#define QUEUE_ARENA_SLAB_BYTES (2048)
+
+
 /******************************************************************************
  * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
  * #       #     # ##    # #     #    #       #    #     # ##    # #     #
@@ -59,6 +79,52 @@ typedef struct {
  * #        #####  #     #  #####     #      ###   ####### #     #  #####
 ******************************************************************************/
 
+/*
+ ****************************************************************************
+ * \details
+ *   Embedded queues carve every node from the caller's memory at create
+ *   time, exhaustion is final.
+ *
+ ****************************************************************************
+ */
+static inline queue_node_t *
+queue_node_alloc( queue_t *p_queue )
+{
+    queue_node_t *p_node = NULL;
+
+    if (p_queue->embedded) {
+        p_node = p_queue->p_free;
+        if (p_node) {
+            p_queue->p_free = p_node->p_next;
+        }
+    }else {
+        p_node = adts_pool_alloc(p_queue->p_pool);
+    }
+
+    return p_node;
+} /* queue_node_alloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void
+queue_node_free( queue_t      *p_queue,
+                 queue_node_t *p_node )
+{
+    if (p_queue->embedded) {
+        p_node->p_next  = p_queue->p_free;
+        p_queue->p_free = p_node;
+    }else {
+        adts_pool_free(p_queue->p_pool, p_node);
+    }
+
+    return;
+} /* queue_node_free() */
+
+
 /*
  ****************************************************************************
  *
@@ -175,8 +241,8 @@ adts_queue_dequeue( adts_queue_t *p_adts_queue )
         p_queue->p_tail->p_next = NULL;
     }
 
-    /* Remove the node memory */
-    free(p_node);
+    /* Return the node to the cache */
+    queue_node_free(p_queue, p_node);
     p_queue->elems_curr--;
 
 exception:
@@ -203,13 +269,15 @@ adts_queue_enqueue( adts_queue_t *p_adts_queue,
 
     adts_sanity_entry(p_sanity);
 
-    p_node = adts_mem_zalloc(sizeof(*p_node));
+    p_node = queue_node_alloc(p_queue);
     if (unlikely(NULL == p_node)) {
-        rc = ENOMEM;
+        rc = p_queue->embedded ? ENOSPC : ENOMEM;
         goto exception;
     }
     p_node->p_data = p_data;
     p_node->bytes  = bytes;
+    p_node->p_prev = NULL;
+    p_node->p_next = NULL;
 
     if ((NULL == p_queue->p_head) &&
         (NULL == p_queue->p_tail)) {
@@ -232,6 +300,26 @@ exception:
 
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Includes the node cache.  Arena backed and embedded queues report
+ *   nothing, the arena or the caller holds the memory.
+ *
+ ****************************************************************************
+ */
+void
+adts_queue_mem_stats( adts_queue_t     *p_adts_queue,
+                      adts_mem_stats_t *p_stats )
+{
+    queue_t *p_queue = (queue_t *) p_adts_queue;
+
+    *p_stats = p_queue->mem;
+
+    return;
+} /* adts_queue_mem_stats() */
+
+
 /*
  ****************************************************************************
  *
@@ -241,13 +329,27 @@ exception:
 void
 adts_queue_destroy( adts_queue_t *p_adts_queue )
 {
-    queue_t       *p_queue  = (queue_t *) p_adts_queue;
-    adts_sanity_t *p_sanity = &(p_queue->sanity);
+    queue_t          *p_queue  = (queue_t *) p_adts_queue;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_queue->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    free(p_queue);
+    if (p_queue->embedded) {
+        /* caller owned */
+        goto exception;
+    }
+
+    /* Outstanding nodes are released along with the cache */
+    adts_pool_destroy(p_queue->p_pool);
+    if (NULL == p_queue->p_arena) {
+        /* the record is released along with the handle */
+        mem = p_queue->mem;
+        adts_mem_free_acct(&(mem), p_queue, sizeof(adts_queue_t),
+                           ADTS_MEM_ALIGN_DEFAULT);
+    }
 
+exception:
     /* No adts_sanity_exit() since we've freed the memory */
 
     return;
@@ -257,15 +359,137 @@ adts_queue_destroy( adts_queue_t *p_adts_queue )
 /*
  ****************************************************************************
  *
+ ****************************************************************************
+ */
+static adts_queue_t *
+queue_create( adts_arena_t *p_arena )
+{
+    queue_t            *p_queue      = NULL;
+    adts_queue_t       *p_adts_queue = NULL;
+    adts_pool_create_t  pool_op      = {0};
+    adts_mem_stats_t    mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_QUEUE);
+
+    if (p_arena) {
+        p_adts_queue       = adts_arena_zalloc(p_arena, sizeof(*p_adts_queue));
+        pool_op.p_arena    = p_arena;
+        pool_op.slab_bytes = QUEUE_ARENA_SLAB_BYTES;
+    }else {
+        p_adts_queue = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_queue),
+                                            ADTS_MEM_ALIGN_DEFAULT);
+    }
+    if (NULL == p_adts_queue) {
+        goto exception;
+    }
+
+    p_queue           = (queue_t *) p_adts_queue;
+    p_queue->p_arena  = p_arena;
+    p_queue->mem      = mem;
+    pool_op.obj_bytes = sizeof(queue_node_t);
+    pool_op.p_stats   = &(p_queue->mem);
+    p_queue->p_pool   = adts_pool_create(&pool_op);
+    if (NULL == p_queue->p_pool) {
+        if (NULL == p_arena) {
+            mem = p_queue->mem;
+            adts_mem_free_acct(&(mem), p_adts_queue, sizeof(*p_adts_queue),
+                               ADTS_MEM_ALIGN_DEFAULT);
+        }
+        p_adts_queue = NULL;
+    }
+
+exception:
+    return p_adts_queue;
+} /* queue_create() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bytes required for an embedded queue of the given capacity.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_queue_embedded_bytes( size_t elems )
+{
+    return sizeof(adts_queue_t) + (elems * sizeof(queue_node_t));
+} /* adts_queue_embedded_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The handle and every node reside in the caller's memory and the
+ *   allocator is never called.  Capacity is derived from bytes, an enqueue
+ *   to a full queue returns ENOSPC.  p_mem must be 8B aligned and hold at
+ *   least one element, otherwise NULL.  Destroy releases nothing.
  *
  ****************************************************************************
  */
 adts_queue_t *
-adts_queue_create( void )
+adts_queue_create_embedded( void   *p_mem,
+                            size_t  bytes )
 {
-    adts_queue_t *p_adts_queue = adts_mem_zalloc(sizeof(*p_adts_queue));
+    size_t            elems        = 0;
+    queue_t          *p_queue      = NULL;
+    queue_node_t     *p_nodes      = NULL;
+    adts_queue_t     *p_adts_queue = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_QUEUE);
+
+    if ((NULL == p_mem) || ((uintptr_t) p_mem & 0x7) ||
+        (bytes < adts_queue_embedded_bytes(1))) {
+        goto exception;
+    }
+
+    p_adts_queue = p_mem;
+    memset(p_adts_queue, 0, sizeof(*p_adts_queue));
+
+    p_queue           = (queue_t *) p_adts_queue;
+    p_queue->embedded = true;
+    p_queue->mem      = mem;
+
+    /* thread every node onto the free list */
+    p_nodes = (queue_node_t *) (p_adts_queue + 1);
+    elems   = (bytes - sizeof(*p_adts_queue)) / sizeof(*p_nodes);
+    for (size_t idx = elems; idx > 0; idx--) {
+        queue_node_free(p_queue, &(p_nodes[idx - 1]));
+    }
 
+exception:
     return p_adts_queue;
+} /* adts_queue_create_embedded() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   All memory is sourced from the arena, destroy is O(1) and the memory is
+ *   reclaimed on arena reset.
+ *
+ ****************************************************************************
+ */
+adts_queue_t *
+adts_queue_create_arena( adts_arena_t *p_arena )
+{
+    adts_queue_t *p_adts_queue = NULL;
+
+    if (p_arena) {
+        p_adts_queue = queue_create(p_arena);
+    }
+
+    return p_adts_queue;
+} /* adts_queue_create_arena() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+adts_queue_t *
+adts_queue_create( void )
+{
+    return queue_create(NULL);
 } /* adts_queue_create() */
 
 
@@ -326,6 +550,45 @@ utest_control( void )
         adts_queue_destroy(p_queue);
     }
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: embedded, fixed capacity, no allocation");
+
+        uint64_t          arr[ 96 ];
+        size_t            limit   = 0;
+        adts_queue_t     *p_queue = NULL;
+        adts_mem_stats_t  before  = {0};
+        adts_mem_stats_t  after   = {0};
+
+        assert(NULL == adts_queue_create_embedded(arr, sizeof(adts_queue_t)));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_QUEUE, &(before));
+        p_queue = adts_queue_create_embedded(arr, sizeof(arr));
+        assert(p_queue);
+
+        limit = (sizeof(arr) - sizeof(adts_queue_t)) / sizeof(queue_node_t);
+        assert(adts_queue_embedded_bytes(limit) <= sizeof(arr));
+
+        /* nodes are recycled across repeated fill -> drain */
+        for (int32_t iter = 0; iter < 3; iter++) {
+            for (uintptr_t idx = 1; idx <= limit; idx++) {
+                assert(0 == adts_queue_enqueue(p_queue, (void *) idx, 0));
+            }
+            assert(ENOSPC == adts_queue_enqueue(p_queue, NULL, 0));
+            assert(limit == adts_queue_entries(p_queue));
+
+            for (uintptr_t idx = 1; idx <= limit; idx++) {
+                assert(idx == (uintptr_t) adts_queue_dequeue(p_queue));
+            }
+            assert(adts_queue_is_empty(p_queue));
+        }
+
+        adts_queue_destroy(p_queue);
+        adts_mem_stats_type(ADTS_MEM_TYPE_QUEUE, &(after));
+        assert(before.allocs == after.allocs);
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
     return;
 } /* utest_control() */
 
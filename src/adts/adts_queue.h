@@ -3,6 +3,8 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 
 
 /**
@@ -11,7 +13,7 @@
  *
  **************************************************************************
  */
-#define ADTS_QUEUE_BYTES (64)
+#define ADTS_QUEUE_BYTES (256)
 
 
 /**
@@ -54,8 +56,21 @@ adts_queue_enqueue( adts_queue_t *p_adts_queue,
                     size_t        bytes );
 
 void
+adts_queue_mem_stats( adts_queue_t     *p_adts_queue,
+                      adts_mem_stats_t *p_stats );
+void
 adts_queue_destroy( adts_queue_t *p_adts_queue );
 
+size_t
+adts_queue_embedded_bytes( size_t elems );
+
+adts_queue_t *
+adts_queue_create_embedded( void   *p_mem,
+                            size_t  bytes );
+
+adts_queue_t *
+adts_queue_create_arena( adts_arena_t *p_arena );
+
 adts_queue_t *
 adts_queue_create( void );
 
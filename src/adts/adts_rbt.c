@@ -4,13 +4,19 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_rbt.h>
-#include <adts_stack.h>
-#include <adts_queue.h>
+#include <adts_tree.h>
+#include <adts_pool.h>
+#include <adts_time.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
 
@@ -33,7 +39,7 @@ typedef enum {
 
 typedef struct {
     //size_t height;
-    size_t children;
+    size_t children; /**< intrusive, subtree nodes including self */
 } rbt_stats_t;
 
 typedef struct rbt_node_s {
@@ -43,8 +49,102 @@ typedef struct rbt_node_s {
     struct rbt_node_s  *p_right;
     rbt_color_t         color;
     rbt_stats_t         stats;
+    union {
+        struct rbt_node_s  *p_parent;  /**< intrusive, NULL at the root */
+        struct {
+            uint64_t            seq;       /**< persistent, creating version */
+            struct rbt_node_s  *p_retired; /**< persistent, writer private */
+        };
+    };
 } rbt_node_t;
 
+/*
+ * Height is bounded by 2 * log2(n + 1), and 64B nodes within a 48 bit
+ * address space bound n below 2^42, thus 96 levels exceeds any tree.
+ */
+#define RBT_HEIGHT_MAX (96)
+
+/*
+ * The path top is the node under the cursor, see rbt_iter_init().
+ */
+typedef struct {
+    rbt_node_t            *a_path[ RBT_HEIGHT_MAX ];
+    rbt_node_t            *p_root;
+    uint32_t               depth;
+    uint32_t               level;  /**< level order, depth visited */
+    adts_rbt_iter_order_t  order;
+    bool                   more;   /**< level order, a deeper level exists */
+} rbt_iter_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Intrusive tree over consumer owned nodes.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    rbt_node_t       *p_root;
+    size_t            elems_curr;
+    size_t            elems_max;
+    adts_rbt_cmp_t    cmp;
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;
+} rbt_t;
+
+typedef struct {
+    const rbt_t *p_tree;
+    rbt_node_t  *p_next;  /**< next in order, not yet checked against hi */
+    const void  *hi;
+} rbt_range_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Persistent tree version, reclaimed oldest first.  p_retired chains
+ *   the nodes the successor version replaced.
+ *
+ ****************************************************************************
+ */
+typedef struct prbt_version_s {
+    rbt_node_t             *p_root;
+    uint64_t                seq;
+    uint64_t                refs;      /**< reader references, atomic */
+    size_t                  elems;
+    rbt_node_t             *p_retired;
+    struct prbt_version_s  *p_next;    /**< successor, or free list link */
+} prbt_version_t;
+
+typedef struct {
+    prbt_version_t   *p_curr;    /**< published, atomic */
+    prbt_version_t   *p_oldest;  /**< unreclaimed, through p_next */
+    prbt_version_t   *p_free;    /**< recycled records */
+    size_t            versions;  /**< unreclaimed, current included */
+    rbt_node_t       *p_draft;   /**< writer private root */
+    rbt_node_t       *p_retired; /**< replaced by the draft */
+    rbt_node_t       *p_spare;   /**< reserved for the next update */
+    size_t            spares;
+    size_t            elems;     /**< within the draft */
+    uint64_t          seq;       /**< draft sequence */
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;
+} prbt_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Absent a tree handle, nodes are sourced from a single module wide
+ *   shared cache created on first use.
+ *
+ ****************************************************************************
+ */
+static pthread_once_t   rbt_pool_once = PTHREAD_ONCE_INIT;
+static adts_pool_t     *p_rbt_pool    = NULL;
+static adts_mem_stats_t rbt_mem       = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_RBT);
+
 
 /******************************************************************************
  * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
@@ -56,18 +156,46 @@ typedef struct rbt_node_s {
  * #        #####  #     #  #####     #      ###   ####### #     #  #####
 ******************************************************************************/
 
-// rbt_delete
-// rbt_get_value
-// rbt_key_present
-// rbt_key_missing
-// rbt_nodes
-// rbt_peek_min
-// rbt_peek_max
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+rbt_pool_init( void )
+{
+    adts_pool_create_t op = {0};
+
+    op.obj_bytes = sizeof(rbt_node_t);
+    op.options   = ADTS_POOL_OPTS_SHARED | ADTS_POOL_OPTS_ZERO;
+    op.p_stats   = &(rbt_mem); /* serialized by the shared cache */
+    p_rbt_pool   = adts_pool_create(&op);
+
+    return;
+} /* rbt_pool_init() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline rbt_node_t *
+rbt_node_alloc( void )
+{
+    rbt_node_t *p_node = NULL;
+
+    pthread_once(&rbt_pool_once, rbt_pool_init);
+    if (likely(p_rbt_pool)) {
+        p_node = adts_pool_alloc(p_rbt_pool);
+    }
+
+    return p_node;
+} /* rbt_node_alloc() */
+
+
 // rbt_delete_min
 // rbt_delete_max
-// rbt_floor
-// rbt_cieling
-// rbt_rank
 
 
 /**
@@ -92,31 +220,246 @@ rbt_node_display( rbt_node_t *p_node )
 
 /**
  **************************************************************************
+ * \details
+ *   In-order, push p_node and its leftmost descendants, or rightmost when
+ *   descending.  The path top is the node under the cursor and below it
+ *   the ancestors yet to be visited.
  *
  *************************************************************************
  */
-void
-adts_rbt_display_preorder( adts_rbt_node_t *p_adts_rbt_node )
+static inline void
+rbt_iter_push_edge( rbt_iter_t *p_iter,
+                    rbt_node_t *p_node,
+                    bool        reverse )
 {
-    assert(p_adts_rbt_node);
+    while (p_node) {
+        p_iter->a_path[p_iter->depth++] = p_node;
+        p_node = (reverse) ? p_node->p_right : p_node->p_left;
+    }
 
-    rbt_node_t    *p_node   = (rbt_node_t *) p_adts_rbt_node;
-    adts_stack_t  *p_stack  = adts_stack_create();
+    return;
+} /* rbt_iter_push_edge() */
 
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            rbt_node_display(p_node);
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            p_node = (rbt_node_t *) adts_stack_pop(p_stack);
-            p_node = p_node->p_right;
+
+/**
+ **************************************************************************
+ * \details
+ *   Post-order, push p_node and descend to the first leaf, preferring the
+ *   left child.  The path is the root to leaf path.
+ *
+ *************************************************************************
+ */
+static inline void
+rbt_iter_push_leaf( rbt_iter_t *p_iter,
+                    rbt_node_t *p_node )
+{
+    while (p_node) {
+        p_iter->a_path[p_iter->depth++] = p_node;
+        p_node = (p_node->p_left) ? p_node->p_left : p_node->p_right;
+    }
+
+    return;
+} /* rbt_iter_push_leaf() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Level order, depth first search for the next node at depth level,
+ *   resuming from the path top having returned from its child p_up, NULL
+ *   on first arrival.  The path is the root to node path.
+ *
+ *************************************************************************
+ */
+static rbt_node_t *
+rbt_iter_level_scan( rbt_iter_t *p_iter,
+                     rbt_node_t *p_up )
+{
+    rbt_node_t *p_top  = NULL;
+    rbt_node_t *p_next = NULL;
+
+    while (p_iter->depth) {
+        p_top  = p_iter->a_path[p_iter->depth - 1];
+        p_next = NULL;
+
+        if (NULL == p_up) {
+            if ((p_iter->depth - 1) == p_iter->level) {
+                p_iter->more |= (p_top->p_left || p_top->p_right);
+                return p_top;
+            }
+            p_next = (p_top->p_left) ? p_top->p_left : p_top->p_right;
+        } else if (p_up == p_top->p_left) {
+            p_next = p_top->p_right;
+        }
+
+        if (p_next) {
+            p_iter->a_path[p_iter->depth++] = p_next;
+            p_up = NULL;
+        } else {
+            p_up = p_top;
+            p_iter->depth--;
         }
     }
 
+    return NULL;
+} /* rbt_iter_level_scan() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Next level down, while the level just completed had children.
+ *
+ *************************************************************************
+ */
+static rbt_node_t *
+rbt_iter_level_descend( rbt_iter_t *p_iter )
+{
+    rbt_node_t *p_node = NULL;
+
+    while ((NULL == p_node) && p_iter->more) {
+        p_iter->more  = false;
+        p_iter->level++;
+        p_iter->depth = 0;
+        p_iter->a_path[p_iter->depth++] = p_iter->p_root;
+        p_node = rbt_iter_level_scan(p_iter, NULL);
+    }
+
+    return p_node;
+} /* rbt_iter_level_descend() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static inline rbt_node_t *
+rbt_iter_curr( const rbt_iter_t *p_iter )
+{
+    return (p_iter->depth) ? p_iter->a_path[p_iter->depth - 1] : NULL;
+} /* rbt_iter_curr() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Iterate the subtree at p_root.
+ *
+ *************************************************************************
+ */
+static rbt_node_t *
+rbt_iter_init( rbt_iter_t            *p_iter,
+               rbt_node_t            *p_root,
+               adts_rbt_iter_order_t  order )
+{
+    p_iter->p_root = p_root;
+    p_iter->depth  = 0;
+    p_iter->level  = 0;
+    p_iter->order  = order;
+    p_iter->more   = false;
+
+    if (NULL == p_root) {
+        goto exception;
+    }
+
+    switch (order) {
+        case ADTS_RBT_ITER_INORDER:
+            rbt_iter_push_edge(p_iter, p_root, false);
+            break;
+        case ADTS_RBT_ITER_REVERSE:
+            rbt_iter_push_edge(p_iter, p_root, true);
+            break;
+        case ADTS_RBT_ITER_PREORDER:
+            p_iter->a_path[p_iter->depth++] = p_root;
+            break;
+        case ADTS_RBT_ITER_POSTORDER:
+            rbt_iter_push_leaf(p_iter, p_root);
+            break;
+        case ADTS_RBT_ITER_LEVEL:
+            p_iter->a_path[p_iter->depth++] = p_root;
+            (void) rbt_iter_level_scan(p_iter, NULL);
+            break;
+        default:
+            break;
+    }
+
+exception:
+    return rbt_iter_curr(p_iter);
+} /* rbt_iter_init() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static rbt_node_t *
+rbt_iter_next( rbt_iter_t *p_iter )
+{
+    rbt_node_t *p_node = NULL;
+    rbt_node_t *p_top  = NULL;
+
+    if (unlikely(0 == p_iter->depth)) {
+        goto exception;
+    }
+
+    p_node = p_iter->a_path[--p_iter->depth];
+
+    switch (p_iter->order) {
+        case ADTS_RBT_ITER_INORDER:
+            rbt_iter_push_edge(p_iter, p_node->p_right, false);
+            break;
+        case ADTS_RBT_ITER_REVERSE:
+            rbt_iter_push_edge(p_iter, p_node->p_left, true);
+            break;
+        case ADTS_RBT_ITER_PREORDER:
+            /* pending right subtrees beneath, left on top */
+            if (p_node->p_right) {
+                p_iter->a_path[p_iter->depth++] = p_node->p_right;
+            }
+            if (p_node->p_left) {
+                p_iter->a_path[p_iter->depth++] = p_node->p_left;
+            }
+            break;
+        case ADTS_RBT_ITER_POSTORDER:
+            p_top = rbt_iter_curr(p_iter);
+            if (p_top && (p_node == p_top->p_left)) {
+                rbt_iter_push_leaf(p_iter, p_top->p_right);
+            }
+            break;
+        case ADTS_RBT_ITER_LEVEL:
+            if (NULL == rbt_iter_level_scan(p_iter, p_node)) {
+                (void) rbt_iter_level_descend(p_iter);
+            }
+            break;
+        default:
+            break;
+    }
+
 exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    return rbt_iter_curr(p_iter);
+} /* rbt_iter_next() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+void
+adts_rbt_display_preorder( adts_rbt_node_t *p_adts_rbt_node )
+{
+    assert(p_adts_rbt_node);
+
+    rbt_iter_t  iter;
+    rbt_node_t *p_node = NULL;
+
+    for (p_node = rbt_iter_init(&(iter), (rbt_node_t *) p_adts_rbt_node,
+                                ADTS_RBT_ITER_PREORDER);
+         p_node;
+         p_node = rbt_iter_next(&(iter))) {
+        rbt_node_display(p_node);
     }
 
     return;
@@ -133,23 +476,14 @@ adts_rbt_display_inorder( adts_rbt_node_t *p_adts_rbt_node )
 {
     assert(p_adts_rbt_node);
 
-    rbt_node_t    *p_node   = (rbt_node_t *) p_adts_rbt_node;
-    adts_stack_t  *p_stack  = adts_stack_create();
-
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            p_node = (rbt_node_t *) adts_stack_pop(p_stack);
-            rbt_node_display(p_node);
-            p_node = p_node->p_right;
-        }
-    }
+    rbt_iter_t  iter;
+    rbt_node_t *p_node = NULL;
 
-exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    for (p_node = rbt_iter_init(&(iter), (rbt_node_t *) p_adts_rbt_node,
+                                ADTS_RBT_ITER_INORDER);
+         p_node;
+         p_node = rbt_iter_next(&(iter))) {
+        rbt_node_display(p_node);
     }
 
     return;
@@ -166,35 +500,14 @@ adts_rbt_display_postorder( adts_rbt_node_t *p_adts_rbt_node )
 {
     assert(p_adts_rbt_node);
 
-    rbt_node_t    *p_node   = (rbt_node_t *) p_adts_rbt_node;
-    rbt_node_t    *p_last   = NULL;
-    adts_stack_t  *p_stack  = adts_stack_create();
-
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            rbt_node_t *p_peek = NULL;
-
-            /* If last node processed was not p_right, then process p_right. */
-            p_peek = (rbt_node_t *) adts_stack_peek(p_stack);
-            if (p_peek->p_right && (p_peek->p_right != p_last)) {
-                p_node = p_peek->p_right;
-            }else {
-                /* Pop and discard since we already have the node pointer via
-                 * p_peek.  We cannot use p_node since ir has a predefined
-                 * meaning in this loop. */
-                (void) adts_stack_pop(p_stack);
-                rbt_node_display(p_peek);
-                p_last = p_peek;
-            }
-        }
-    }
+    rbt_iter_t  iter;
+    rbt_node_t *p_node = NULL;
 
-exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    for (p_node = rbt_iter_init(&(iter), (rbt_node_t *) p_adts_rbt_node,
+                                ADTS_RBT_ITER_POSTORDER);
+         p_node;
+         p_node = rbt_iter_next(&(iter))) {
+        rbt_node_display(p_node);
     }
 
     return;
@@ -211,33 +524,91 @@ adts_rbt_display_level( adts_rbt_node_t *p_adts_rbt_node )
 {
     assert(p_adts_rbt_node);
 
-    rbt_node_t    *p_node   = (rbt_node_t *) p_adts_rbt_node;
-    adts_queue_t  *p_queue  = adts_queue_create();
-
-    while (p_node) {
+    rbt_iter_t  iter;
+    rbt_node_t *p_node = NULL;
 
+    for (p_node = rbt_iter_init(&(iter), (rbt_node_t *) p_adts_rbt_node,
+                                ADTS_RBT_ITER_LEVEL);
+         p_node;
+         p_node = rbt_iter_next(&(iter))) {
         rbt_node_display(p_node);
+    }
 
-        if (p_node->p_left) {
-            adts_queue_enqueue(p_queue,
-                    p_node->p_left, sizeof(*(p_node->p_left)));
-        }
+    return;
+} /* adts_rbt_display_level() */
 
-        if (p_node->p_right) {
-            adts_queue_enqueue(p_queue,
-                    p_node->p_right, sizeof(*(p_node->p_right)));
-        }
 
-        p_node = adts_queue_dequeue(p_queue);
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_iter_begin( adts_rbt_node_t       *p_adts_root,
+                     adts_rbt_iter_t       *p_adts_iter,
+                     adts_rbt_iter_order_t  order )
+{
+    rbt_iter_t *p_iter = (rbt_iter_t *) p_adts_iter;
+
+    return (adts_rbt_node_t *) rbt_iter_init(p_iter,
+                                             (rbt_node_t *) p_adts_root,
+                                             order);
+} /* adts_rbt_iter_begin() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Descend toward key retaining only the ancestors yet to be visited,
+ *   those left of the descent for ascending order, right for descending.
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_iter_seek( adts_rbt_node_t       *p_adts_root,
+                    adts_rbt_iter_t       *p_adts_iter,
+                    adts_rbt_iter_order_t  order,
+                    const void            *key )
+{
+    bool        reverse = (ADTS_RBT_ITER_REVERSE == order);
+    rbt_node_t *p_node  = (rbt_node_t *) p_adts_root;
+    rbt_iter_t *p_iter  = (rbt_iter_t *) p_adts_iter;
+
+    (void) rbt_iter_init(p_iter, NULL, order);
+    p_iter->p_root = p_node;
+
+    if ((ADTS_RBT_ITER_INORDER != order) && (false == reverse)) {
+        goto exception;
     }
 
-exception:
-    if (p_queue) {
-        adts_queue_destroy(p_queue);
+    while (p_node) {
+        if (key == p_node->key) {
+            p_iter->a_path[p_iter->depth++] = p_node;
+            break;
+        }
+        if ((key < p_node->key) != reverse) {
+            p_iter->a_path[p_iter->depth++] = p_node;
+        }
+        p_node = (key < p_node->key) ? p_node->p_left : p_node->p_right;
     }
 
-    return;
-} /* adts_rbt_display_level() */
+exception:
+    return (adts_rbt_node_t *) rbt_iter_curr(p_iter);
+} /* adts_rbt_iter_seek() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_iter_next( adts_rbt_iter_t *p_adts_iter )
+{
+    rbt_iter_t *p_iter = (rbt_iter_t *) p_adts_iter;
+
+    return (adts_rbt_node_t *) rbt_iter_next(p_iter);
+} /* adts_rbt_iter_next() */
 
 
 /*
@@ -288,7 +659,6 @@ rbt_rotate_left( rbt_node_t *p_root )
     p_tmp->color  = p_root->color;
     p_root->color = RED;
 
-    CDISPLAY("");
     return p_tmp;
 } /* rbt_rotate_left() */
 
@@ -315,127 +685,10 @@ rbt_rotate_right( rbt_node_t *p_root )
     p_tmp->color  = p_root->color;
     p_root->color = RED;
 
-    CDISPLAY("");
     return p_tmp;
 } /* rbt_rotate_right() */
 
 
-/*
- ****************************************************************************
- *
- ****************************************************************************
- */
-static void
-rbt_color_change( rbt_node_t *p_root )
-{
-    assert(false == rbt_is_red(p_root));
-    assert(rbt_is_red(p_root->p_left));
-    assert(rbt_is_red(p_root->p_right));
-
-    p_root->color          = RED;
-    p_root->p_left->color  = BLACK;
-    p_root->p_right->color = BLACK;
-
-    return;
-} /* rbt_color_change() */
-
-
-/*
- ****************************************************************************
- *
- ****************************************************************************
- */
-static size_t
-rbt_nodes( rbt_node_t *p_root )
-{
-    size_t nodes = 0;
-
-    if (p_root) {
-        nodes = p_root->stats.children;
-    }
-
-    return nodes;
-} /* rbt_nodes() */
-
-
-/*
- ****************************************************************************
- *
- ****************************************************************************
- */
-static void
-rbt_delete( rbt_node_t *p_root,
-            const void *key )
-{
-    assert(0);
-    return;
-} /* rbt_delete() */
-
-
-/*
- ****************************************************************************
- *
- * \details
- *   This algorithm leverages recursion to obtain 0-cost staistics on
- *   child nodes.
- *
- ****************************************************************************
- */
-static rbt_node_t *
-rbt_insert( rbt_node_t  *p_root,
-            const void  *key,
-            const void  *p_data )
-{
-    rbt_stats_t *p_stats = NULL;
-
-    if (NULL == p_root) {
-        p_root = adts_mem_zalloc(sizeof(*p_root));
-        if (NULL == p_root) {
-            goto exception;
-        }
-        p_root->key    = key;
-        p_root->p_data = p_data;
-        CDISPLAY("%c", p_root->key);
-	}else {
-		CDISPLAY("%c", key);
-
-		if (key < p_root->key) {
-			CDISPLAY("");
-			p_root->p_left = rbt_insert(p_root->p_left, key, p_data);
-		}else if (key > p_root->key) {
-			CDISPLAY("");
-			p_root->p_right = rbt_insert(p_root->p_right, key, p_data);
-		}else {
-			CDISPLAY("");
-			p_root->p_data = p_data;
-		}
-
-		if (rbt_is_red(p_root->p_right) && (false == rbt_is_red(p_root->p_left))) {
-			CDISPLAY("");
-			p_root = rbt_rotate_left(p_root);
-		}
-
-		if (rbt_is_red(p_root->p_left) && (false == rbt_is_red(p_root->p_left->p_left))) {
-			CDISPLAY("");
-			p_root = rbt_rotate_right(p_root);
-		}
-
-		if (rbt_is_red(p_root->p_left) && rbt_is_red(p_root->p_right)) {
-			CDISPLAY("");
-			rbt_color_change(p_root);
-		}
-
-		p_stats            = &(p_root->stats);
-		p_stats->children  = 1; /* self */
-		p_stats->children += rbt_nodes(p_root->p_left);
-		p_stats->children += rbt_nodes(p_root->p_right);
-	}
-
-exception:
-    return p_root;
-} /* rbt_insert() */
-
-
 /*
  ****************************************************************************
  *
@@ -508,230 +761,2669 @@ rbt_find_max( rbt_node_t *p_root )
 /*
  ****************************************************************************
  * \details
- *  Floor is defined as: "Largest Key <= Input Key"
+ *   Intrusive tree, key order per the consumer comparator, unsigned
+ *   integer order absent one.
  *
  ****************************************************************************
  */
-static rbt_node_t *
-rbt_find_floor( rbt_node_t *p_root,
-                const void *key )
+static inline int32_t
+rbt_cmp( const rbt_t *p_tree,
+         const void  *p_a,
+         const void  *p_b )
 {
-    rbt_node_t *p_tmp = NULL;
-
-    if (NULL == p_root) {
-        goto exception;
+    if (p_tree->cmp) {
+        return p_tree->cmp(p_a, p_b);
     }
 
-    if (key == p_root->key) {
-        p_tmp = p_root;
-    }else if (key < p_root->key) {
-        p_tmp = rbt_find_floor(p_root->p_left, key);
-    }else {
-        rbt_node_t *temp = NULL;
+    return ((uintptr_t) p_a > (uintptr_t) p_b) -
+           ((uintptr_t) p_a < (uintptr_t) p_b);
+} /* rbt_cmp() */
 
-        temp  = rbt_find_floor(p_root->p_right, key);
-        p_tmp = (temp) ? temp : p_root;
+
+/*
+ ****************************************************************************
+ * \details
+ *   Redirect the parent link of p_old, or the root, to p_new.
+ *
+ ****************************************************************************
+ */
+static inline void
+rbt_relink( rbt_t      *p_tree,
+            rbt_node_t *p_parent,
+            rbt_node_t *p_old,
+            rbt_node_t *p_new )
+{
+    if (NULL == p_parent) {
+        p_tree->p_root = p_new;
+    } else if (p_old == p_parent->p_left) {
+        p_parent->p_left = p_new;
+    } else {
+        p_parent->p_right = p_new;
     }
 
-exception:
-    return p_tmp;
-} /* rbt_find_floor() */
+    return;
+} /* rbt_relink() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline size_t
+rbt_nodes( const rbt_node_t *p_node )
+{
+    return (p_node) ? p_node->stats.children : 0;
+} /* rbt_nodes() */
 
 
 /*
  ****************************************************************************
  * \details
- *  Ceiling is defined as: "Smallest Key >= Input Key"
+ *   Parent linked rotations, colors are left to the caller.  Only the two
+ *   rotated nodes change subtree membership, the pivot inherits the size
+ *   of the subtree and the demoted node is recounted from its children.
  *
  ****************************************************************************
  */
-static rbt_node_t *
-rbt_find_ceiling( rbt_node_t *p_root,
-                  const void *key )
+static inline void
+rbt_link_rotate_left( rbt_t      *p_tree,
+                      rbt_node_t *p_node )
 {
-    rbt_node_t *p_tmp = NULL;
+    rbt_node_t *p_pivot = p_node->p_right;
 
-    if (NULL == p_root) {
-        goto exception;
+    p_node->p_right = p_pivot->p_left;
+    if (p_pivot->p_left) {
+        p_pivot->p_left->p_parent = p_node;
     }
 
-    if (key == p_root->key) {
-        p_tmp = p_root;
-    }else if (key > p_root->key) {
-        p_tmp = rbt_find_ceiling(p_root->p_right, key);
-    }else {
-        rbt_node_t *temp = NULL;
+    p_pivot->p_parent = p_node->p_parent;
+    rbt_relink(p_tree, p_node->p_parent, p_node, p_pivot);
 
-        temp  = rbt_find_ceiling(p_root->p_left, key);
-        p_tmp = (temp) ? temp : p_root;
-    }
+    p_pivot->p_left  = p_node;
+    p_node->p_parent = p_pivot;
 
-exception:
-    return p_tmp;
-} /* rbt_find_ceiling() */
+    p_pivot->stats.children = p_node->stats.children;
+    p_node->stats.children  = 1 + rbt_nodes(p_node->p_left) +
+                              rbt_nodes(p_node->p_right);
 
+    return;
+} /* rbt_link_rotate_left() */
 
+static inline void
+rbt_link_rotate_right( rbt_t      *p_tree,
+                       rbt_node_t *p_node )
+{
+    rbt_node_t *p_pivot = p_node->p_left;
 
+    p_node->p_left = p_pivot->p_right;
+    if (p_pivot->p_right) {
+        p_pivot->p_right->p_parent = p_node;
+    }
 
+    p_pivot->p_parent = p_node->p_parent;
+    rbt_relink(p_tree, p_node->p_parent, p_node, p_pivot);
 
-/******************************************************************************
- * #     # #     #   ###   ####### ####### #######  #####  #######  #####
- * #     # ##    #    #       #       #    #       #     #    #    #     #
- * #     # # #   #    #       #       #    #       #          #    #
- * #     # #  #  #    #       #       #    #####    #####     #     #####
- * #     # #   # #    #       #       #    #             #    #          #
- * #     # #    ##    #       #       #    #       #     #    #    #     #
- *  #####  #     #   ###      #       #    #######  #####     #     #####
-******************************************************************************/
+    p_pivot->p_right = p_node;
+    p_node->p_parent = p_pivot;
 
+    p_pivot->stats.children = p_node->stats.children;
+    p_node->stats.children  = 1 + rbt_nodes(p_node->p_left) +
+                              rbt_nodes(p_node->p_right);
 
-/**
- **************************************************************************
- * \brief
- *   Compile time structure sanity
- *
+    return;
+} /* rbt_link_rotate_right() */
+
+
+/*
+ ****************************************************************************
  * \details
- *   Sanitize the abstract data type interface.  Enforced in header file so
- *   as to catch improper usage/include by unauthorized callers.
+ *   Restore the red-black invariants after linking the red leaf p_node.
+ *   Recoloring climbs two levels per pass, at most two rotations end it.
  *
- **************************************************************************
+ ****************************************************************************
  */
 static void
-utest_rbt_bytes( void )
+rbt_insert_fixup( rbt_t      *p_tree,
+                  rbt_node_t *p_node )
 {
+    rbt_node_t *p_parent = NULL;
+    rbt_node_t *p_grand  = NULL;
+    rbt_node_t *p_uncle  = NULL;
+
+    while (rbt_is_red(p_parent = p_node->p_parent)) {
+        /* a red parent is never the root */
+        p_grand = p_parent->p_parent;
+
+        if (p_parent == p_grand->p_left) {
+            p_uncle = p_grand->p_right;
+            if (rbt_is_red(p_uncle)) {
+                p_parent->color = BLACK;
+                p_uncle->color  = BLACK;
+                p_grand->color  = RED;
+                p_node          = p_grand;
+                continue;
+            }
 
-    CDISPLAY("[%u]", sizeof(rbt_node_t));
-    CDISPLAY("[%u]", sizeof(adts_rbt_node_t));
+            if (p_node == p_parent->p_right) {
+                rbt_link_rotate_left(p_tree, p_parent);
+                p_parent = p_node;
+            }
+            p_parent->color = BLACK;
+            p_grand->color  = RED;
+            rbt_link_rotate_right(p_tree, p_grand);
+        } else {
+            p_uncle = p_grand->p_left;
+            if (rbt_is_red(p_uncle)) {
+                p_parent->color = BLACK;
+                p_uncle->color  = BLACK;
+                p_grand->color  = RED;
+                p_node          = p_grand;
+                continue;
+            }
 
-    _Static_assert(sizeof(rbt_node_t) <= sizeof(adts_rbt_node_t),
-        "Mismatch structs detected");
+            if (p_node == p_parent->p_left) {
+                rbt_link_rotate_right(p_tree, p_parent);
+                p_parent = p_node;
+            }
+            p_parent->color = BLACK;
+            p_grand->color  = RED;
+            rbt_link_rotate_left(p_tree, p_grand);
+        }
+        break;
+    }
 
-    return;
-} /* utest_rbt_bytes() */
+    p_tree->p_root->color = BLACK;
 
+    return;
+} /* rbt_insert_fixup() */
 
 
 /*
  ****************************************************************************
+ * \details
+ *   Restore the black height after unlinking a black node, p_node is the
+ *   doubly black replacement, possibly NULL, beneath p_parent.
  *
  ****************************************************************************
  */
-static rbt_node_t *
-utest_rbt_generate_node( void *key,
-                         void *p_data )
+static void
+rbt_remove_fixup( rbt_t      *p_tree,
+                  rbt_node_t *p_node,
+                  rbt_node_t *p_parent )
 {
-    rbt_node_t *p_node = NULL;
+    rbt_node_t *p_sibling = NULL;
+
+    while ((p_node != p_tree->p_root) && (false == rbt_is_red(p_node))) {
+        if (p_node == p_parent->p_left) {
+            p_sibling = p_parent->p_right;
+            if (rbt_is_red(p_sibling)) {
+                p_sibling->color = BLACK;
+                p_parent->color  = RED;
+                rbt_link_rotate_left(p_tree, p_parent);
+                p_sibling = p_parent->p_right;
+            }
 
-    p_node = adts_mem_zalloc(sizeof(*p_node));
-    if (NULL == p_node) {
-        goto exception;
+            if ((false == rbt_is_red(p_sibling->p_left)) &&
+                (false == rbt_is_red(p_sibling->p_right))) {
+                p_sibling->color = RED;
+                p_node           = p_parent;
+                p_parent         = p_node->p_parent;
+                continue;
+            }
+
+            if (false == rbt_is_red(p_sibling->p_right)) {
+                p_sibling->p_left->color = BLACK;
+                p_sibling->color         = RED;
+                rbt_link_rotate_right(p_tree, p_sibling);
+                p_sibling = p_parent->p_right;
+            }
+            p_sibling->color          = p_parent->color;
+            p_parent->color           = BLACK;
+            p_sibling->p_right->color = BLACK;
+            rbt_link_rotate_left(p_tree, p_parent);
+        } else {
+            p_sibling = p_parent->p_left;
+            if (rbt_is_red(p_sibling)) {
+                p_sibling->color = BLACK;
+                p_parent->color  = RED;
+                rbt_link_rotate_right(p_tree, p_parent);
+                p_sibling = p_parent->p_left;
+            }
+
+            if ((false == rbt_is_red(p_sibling->p_left)) &&
+                (false == rbt_is_red(p_sibling->p_right))) {
+                p_sibling->color = RED;
+                p_node           = p_parent;
+                p_parent         = p_node->p_parent;
+                continue;
+            }
+
+            if (false == rbt_is_red(p_sibling->p_left)) {
+                p_sibling->p_right->color = BLACK;
+                p_sibling->color          = RED;
+                rbt_link_rotate_left(p_tree, p_sibling);
+                p_sibling = p_parent->p_left;
+            }
+            p_sibling->color         = p_parent->color;
+            p_parent->color          = BLACK;
+            p_sibling->p_left->color = BLACK;
+            rbt_link_rotate_right(p_tree, p_parent);
+        }
+
+        p_node = p_tree->p_root;
+        break;
     }
 
-    p_node->key    = key;
-    p_node->p_data = p_data;
+    if (p_node) {
+        p_node->color = BLACK;
+    }
 
-exception:
-    return p_node;
-} /* utest_rbt_generate_node() */
+    return;
+} /* rbt_remove_fixup() */
 
 
 /*
  ****************************************************************************
+ * \details
+ *   Link p_node as a red leaf, EEXIST if key is present in which case
+ *   p_node is untouched.
  *
  ****************************************************************************
  */
-static adts_rbt_node_t *
-utest_rbt_generate_ascii( void )
+static int32_t
+rbt_link( rbt_t      *p_tree,
+          rbt_node_t *p_node,
+          const void *key,
+          void       *p_data )
 {
-    rbt_node_t *p_root = NULL;
-
-    p_root                            = utest_rbt_generate_node('F', -1);
-    p_root->p_left                    = utest_rbt_generate_node('B', -1);
-
-    p_root->p_left->p_left            = utest_rbt_generate_node('A', -1);
-    p_root->p_left->p_right           = utest_rbt_generate_node('D', -1);
-
-    p_root->p_left->p_right->p_left   = utest_rbt_generate_node('C', -1);
-    p_root->p_left->p_right->p_right  = utest_rbt_generate_node('E', -1);
+    int32_t      rc       = 0;
+    int32_t      cmp      = 0;
+    rbt_node_t  *p_parent = NULL;
+    rbt_node_t **pp_link  = &(p_tree->p_root);
+
+    /* count the key along the path, the line is already at hand */
+    while (*pp_link) {
+        p_parent = *pp_link;
+        cmp      = rbt_cmp(p_tree, key, p_parent->key);
+        if (cmp < 0) {
+            pp_link = &(p_parent->p_left);
+        } else if (cmp > 0) {
+            pp_link = &(p_parent->p_right);
+        } else {
+            /* present, uncount the path above the match */
+            while ((p_parent = p_parent->p_parent)) {
+                p_parent->stats.children--;
+            }
+            rc = EEXIST;
+            goto exception;
+        }
+        p_parent->stats.children++;
+    }
 
-    p_root->p_right                   = utest_rbt_generate_node('G', -1);
-    p_root->p_right->p_right          = utest_rbt_generate_node('I', -1);
+    p_node->key            = (void *) key;
+    p_node->p_data         = p_data;
+    p_node->p_left         = NULL;
+    p_node->p_right        = NULL;
+    p_node->p_parent       = p_parent;
+    p_node->color          = RED;
+    p_node->stats.children = 1;
+    *pp_link               = p_node;
 
-    p_root->p_right->p_right->p_left  = utest_rbt_generate_node('H', -1);
+    rbt_insert_fixup(p_tree, p_node);
 
-    return (adts_rbt_node_t *) p_root;
-} /* utest_rbt_generate_ascii() */
+exception:
+    return rc;
+} /* rbt_link() */
 
 
 /*
  ****************************************************************************
+ * \details
+ *   Unlink p_node, a member of the tree.  A node with two children is
+ *   replaced by its successor, node identity is preserved as the nodes
+ *   are consumer owned.  Subtree sizes are decremented from the point of
+ *   physical removal up, before rebalancing.
  *
  ****************************************************************************
  */
-static adts_rbt_node_t *
-utest_rbt_generate_number( void )
+static void
+rbt_unlink( rbt_t      *p_tree,
+            rbt_node_t *p_node )
 {
-    rbt_node_t *p_root = NULL;
+    rbt_color_t  color    = p_node->color;
+    rbt_node_t  *p_child  = NULL;
+    rbt_node_t  *p_parent = p_node->p_parent;
+    rbt_node_t  *p_succ   = NULL;
+    rbt_node_t  *p_tmp    = NULL;
+
+    if ((p_node->p_left) && (p_node->p_right)) {
+        p_succ = rbt_find_min(p_node->p_right);
+    }
 
-    p_root                            = utest_rbt_generate_node(6, -1);
-    p_root->p_left                    = utest_rbt_generate_node(2, -1);
+    for (p_tmp = (p_succ) ? p_succ->p_parent : p_parent;
+         p_tmp;
+         p_tmp = p_tmp->p_parent) {
+        p_tmp->stats.children--;
+    }
 
-    p_root->p_left->p_left            = utest_rbt_generate_node(1, -1);
-    p_root->p_left->p_right           = utest_rbt_generate_node(4, -1);
+    if (NULL == p_node->p_left) {
+        p_child = p_node->p_right;
+        rbt_relink(p_tree, p_parent, p_node, p_child);
+    } else if (NULL == p_node->p_right) {
+        p_child = p_node->p_left;
+        rbt_relink(p_tree, p_parent, p_node, p_child);
+    } else {
+        color   = p_succ->color;
+        p_child = p_succ->p_right;
+
+        if (p_succ->p_parent == p_node) {
+            p_parent = p_succ;
+        } else {
+            p_parent         = p_succ->p_parent;
+            p_parent->p_left = p_child;
+
+            p_succ->p_right           = p_node->p_right;
+            p_succ->p_right->p_parent = p_succ;
+        }
 
-    p_root->p_left->p_right->p_left   = utest_rbt_generate_node(3, -1);
-    p_root->p_left->p_right->p_right  = utest_rbt_generate_node(5, -1);
+        rbt_relink(p_tree, p_node->p_parent, p_node, p_succ);
+        p_succ->p_parent         = p_node->p_parent;
+        p_succ->p_left           = p_node->p_left;
+        p_succ->p_left->p_parent = p_succ;
+        p_succ->color            = p_node->color;
+        p_succ->stats.children   = p_node->stats.children;
+    }
 
-    p_root->p_right                   = utest_rbt_generate_node(7, -1);
-    p_root->p_right->p_right          = utest_rbt_generate_node(9, -1);
+    if (p_child) {
+        p_child->p_parent = p_parent;
+    }
 
-    p_root->p_right->p_right->p_left  = utest_rbt_generate_node(8, -1);
+    if (BLACK == color) {
+        rbt_remove_fixup(p_tree, p_child, p_parent);
+    }
 
-    return (adts_rbt_node_t *) p_root;
-} /* utest_rbt_generate_number() */
+    p_node->p_left   = NULL;
+    p_node->p_right  = NULL;
+    p_node->p_parent = NULL;
+
+    return;
+} /* rbt_unlink() */
 
 
 /*
  ****************************************************************************
- * test control
  *
  ****************************************************************************
  */
-static void
-utest_control( void )
+static rbt_node_t *
+rbt_search( const rbt_t *p_tree,
+            const void  *key )
 {
+    int32_t     cmp    = 0;
+    rbt_node_t *p_node = p_tree->p_root;
 
-    CDISPLAY("=========================================================");
-    {
-        CDISPLAY("Test 2: size verification ");
-        utest_rbt_bytes();
+    while (p_node) {
+        cmp = rbt_cmp(p_tree, key, p_node->key);
+        if (0 == cmp) {
+            break;
+        }
+        p_node = (cmp < 0) ? p_node->p_left : p_node->p_right;
     }
-#if 0
-    CDISPLAY("=========================================================");
-    {
-        CDISPLAY("Test 3: preorder traversal ");
-
-        adts_rbt_node_t *p_node = NULL;
 
-        p_node = utest_rbt_generate_ascii();
-        adts_rbt_display_preorder(p_node);
-    }
+    return p_node;
+} /* rbt_search() */
 
-    CDISPLAY("=========================================================");
-    {
-        CDISPLAY("Test 4: inorder traversal ");
 
-        adts_rbt_node_t *p_node = NULL;
+/*
+ ****************************************************************************
+ * \details
+ *   In-order neighbours via the parent links, O(1) amortized.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+rbt_successor( rbt_node_t *p_node )
+{
+    rbt_node_t *p_parent = NULL;
 
-        p_node = utest_rbt_generate_ascii();
-        adts_rbt_display_inorder(p_node);
+    if (p_node->p_right) {
+        return rbt_find_min(p_node->p_right);
     }
 
-    CDISPLAY("=========================================================");
-    {
-        CDISPLAY("Test 5: postorder traversal ");
+    p_parent = p_node->p_parent;
+    while (p_parent && (p_node == p_parent->p_right)) {
+        p_node   = p_parent;
+        p_parent = p_node->p_parent;
+    }
 
-        adts_rbt_node_t *p_node = NULL;
+    return p_parent;
+} /* rbt_successor() */
+
+static rbt_node_t *
+rbt_predecessor( rbt_node_t *p_node )
+{
+    rbt_node_t *p_parent = NULL;
+
+    if (p_node->p_left) {
+        return rbt_find_max(p_node->p_left);
+    }
+
+    p_parent = p_node->p_parent;
+    while (p_parent && (p_node == p_parent->p_left)) {
+        p_node   = p_parent;
+        p_parent = p_node->p_parent;
+    }
+
+    return p_parent;
+} /* rbt_predecessor() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *  Floor is defined as: "Largest Key <= Input Key"
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+rbt_find_floor( const rbt_t *p_tree,
+                const void  *key )
+{
+    int32_t     cmp     = 0;
+    rbt_node_t *p_node  = p_tree->p_root;
+    rbt_node_t *p_floor = NULL;
+
+    while (p_node) {
+        cmp = rbt_cmp(p_tree, key, p_node->key);
+        if (0 == cmp) {
+            return p_node;
+        }
+
+        if (cmp < 0) {
+            p_node = p_node->p_left;
+        } else {
+            p_floor = p_node;
+            p_node  = p_node->p_right;
+        }
+    }
+
+    return p_floor;
+} /* rbt_find_floor() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *  Ceiling is defined as: "Smallest Key >= Input Key"
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+rbt_find_ceiling( const rbt_t *p_tree,
+                  const void  *key )
+{
+    int32_t     cmp    = 0;
+    rbt_node_t *p_node = p_tree->p_root;
+    rbt_node_t *p_ceil = NULL;
+
+    while (p_node) {
+        cmp = rbt_cmp(p_tree, key, p_node->key);
+        if (0 == cmp) {
+            return p_node;
+        }
+
+        if (cmp > 0) {
+            p_node = p_node->p_right;
+        } else {
+            p_ceil = p_node;
+            p_node = p_node->p_left;
+        }
+    }
+
+    return p_ceil;
+} /* rbt_find_ceiling() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Keys ordered before key, or also equal to it when inclusive.  Each
+ *   right turn counts the node and its left subtree.
+ *
+ ****************************************************************************
+ */
+static size_t
+rbt_rank( const rbt_t *p_tree,
+          const void  *key,
+          bool         inclusive )
+{
+    int32_t     cmp    = 0;
+    size_t      rank   = 0;
+    rbt_node_t *p_node = p_tree->p_root;
+
+    while (p_node) {
+        cmp = rbt_cmp(p_tree, key, p_node->key);
+        if ((cmp < 0) || ((0 == cmp) && (false == inclusive))) {
+            p_node = p_node->p_left;
+        } else {
+            rank  += 1 + rbt_nodes(p_node->p_left);
+            p_node = p_node->p_right;
+        }
+    }
+
+    return rank;
+} /* rbt_rank() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The node of the given 0 based rank, NULL if rank >= entries.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+rbt_select( const rbt_t *p_tree,
+            size_t       rank )
+{
+    size_t      left   = 0;
+    rbt_node_t *p_node = p_tree->p_root;
+
+    while (p_node) {
+        left = rbt_nodes(p_node->p_left);
+        if (rank == left) {
+            break;
+        }
+
+        if (rank < left) {
+            p_node = p_node->p_left;
+        } else {
+            rank  -= left + 1;
+            p_node = p_node->p_right;
+        }
+    }
+
+    return p_node;
+} /* rbt_select() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+size_t
+adts_rbt_entries( adts_rbt_t *p_adts_rbt )
+{
+    rbt_t *p_tree = (rbt_t *) p_adts_rbt;
+
+    return p_tree->elems_curr;
+} /* adts_rbt_entries() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_root( adts_rbt_t *p_adts_rbt )
+{
+    rbt_t *p_tree = (rbt_t *) p_adts_rbt;
+
+    return (adts_rbt_node_t *) p_tree->p_root;
+} /* adts_rbt_root() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_find( adts_rbt_t *p_adts_rbt,
+               const void *key )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_search(p_tree, key);
+
+    adts_sanity_exit(p_sanity);
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_find() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_peek_min( adts_rbt_t *p_adts_rbt )
+{
+    rbt_t *p_tree = (rbt_t *) p_adts_rbt;
+
+    return (adts_rbt_node_t *) rbt_find_min(p_tree->p_root);
+} /* adts_rbt_peek_min() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_peek_max( adts_rbt_t *p_adts_rbt )
+{
+    rbt_t *p_tree = (rbt_t *) p_adts_rbt;
+
+    return (adts_rbt_node_t *) rbt_find_max(p_tree->p_root);
+} /* adts_rbt_peek_max() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_next( adts_rbt_node_t *p_adts_rbt_node )
+{
+    return (adts_rbt_node_t *) rbt_successor((rbt_node_t *) p_adts_rbt_node);
+} /* adts_rbt_next() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_prev( adts_rbt_node_t *p_adts_rbt_node )
+{
+    return (adts_rbt_node_t *) rbt_predecessor((rbt_node_t *) p_adts_rbt_node);
+} /* adts_rbt_prev() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_floor( adts_rbt_t *p_adts_rbt,
+                const void *key )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_find_floor(p_tree, key);
+
+    adts_sanity_exit(p_sanity);
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_floor() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_ceiling( adts_rbt_t *p_adts_rbt,
+                  const void *key )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_find_ceiling(p_tree, key);
+
+    adts_sanity_exit(p_sanity);
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_ceiling() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+size_t
+adts_rbt_rank( adts_rbt_t *p_adts_rbt,
+               const void *key )
+{
+    size_t         rank     = 0;
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    rank = rbt_rank(p_tree, key, false);
+
+    adts_sanity_exit(p_sanity);
+    return rank;
+} /* adts_rbt_rank() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_select( adts_rbt_t *p_adts_rbt,
+                 size_t      rank )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_select(p_tree, rank);
+
+    adts_sanity_exit(p_sanity);
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_select() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+size_t
+adts_rbt_count_range( adts_rbt_t *p_adts_rbt,
+                      const void *lo,
+                      const void *hi )
+{
+    size_t         count    = 0;
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (rbt_cmp(p_tree, lo, hi) <= 0) {
+        count = rbt_rank(p_tree, hi, true) - rbt_rank(p_tree, lo, false);
+    }
+
+    adts_sanity_exit(p_sanity);
+    return count;
+} /* adts_rbt_count_range() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_range_begin( adts_rbt_t       *p_adts_rbt,
+                      adts_rbt_range_t *p_adts_range,
+                      const void       *lo,
+                      const void       *hi )
+{
+    rbt_t       *p_tree  = (rbt_t *) p_adts_rbt;
+    rbt_range_t *p_range = (rbt_range_t *) p_adts_range;
+
+    p_range->p_tree = p_tree;
+    p_range->hi     = hi;
+    p_range->p_next = NULL;
+    if (rbt_cmp(p_tree, lo, hi) <= 0) {
+        p_range->p_next = rbt_find_ceiling(p_tree, lo);
+    }
+
+    return adts_rbt_range_next(p_adts_range);
+} /* adts_rbt_range_begin() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_range_next( adts_rbt_range_t *p_adts_range )
+{
+    rbt_range_t *p_range = (rbt_range_t *) p_adts_range;
+    rbt_node_t  *p_node  = p_range->p_next;
+
+    if (p_node && (rbt_cmp(p_range->p_tree, p_node->key, p_range->hi) > 0)) {
+        p_node = NULL;
+    }
+    p_range->p_next = (p_node) ? rbt_successor(p_node) : NULL;
+
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_range_next() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+int32_t
+adts_rbt_insert( adts_rbt_t      *p_adts_rbt,
+                 adts_rbt_node_t *p_adts_rbt_node,
+                 const void      *key,
+                 void            *p_data )
+{
+    assert(p_adts_rbt);
+    assert(p_adts_rbt_node);
+
+    int32_t        rc       = 0;
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = (rbt_node_t *) p_adts_rbt_node;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    rc = rbt_link(p_tree, p_node, key, p_data);
+    if (rc) {
+        goto exception;
+    }
+
+    p_tree->elems_curr++;
+    p_tree->elems_max = MAX(p_tree->elems_max, p_tree->elems_curr);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_rbt_insert() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+void
+adts_rbt_remove_node( adts_rbt_t      *p_adts_rbt,
+                      adts_rbt_node_t *p_adts_rbt_node )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    rbt_unlink(p_tree, (rbt_node_t *) p_adts_rbt_node);
+    p_tree->elems_curr--;
+
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_rbt_remove_node() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_remove( adts_rbt_t *p_adts_rbt,
+                 const void *key )
+{
+    rbt_t         *p_tree   = (rbt_t *) p_adts_rbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_search(p_tree, key);
+    if (p_node) {
+        rbt_unlink(p_tree, p_node);
+        p_tree->elems_curr--;
+    }
+
+    adts_sanity_exit(p_sanity);
+    return (adts_rbt_node_t *) p_node;
+} /* adts_rbt_remove() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Nodes are consumer owned and not released.
+ *
+ *************************************************************************
+ */
+void
+adts_rbt_destroy( adts_rbt_t *p_adts_rbt )
+{
+    rbt_t            *p_tree   = (rbt_t *) p_adts_rbt;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* the record is released along with the handle */
+    mem = p_tree->mem;
+    adts_mem_free_acct(&(mem), p_tree, sizeof(adts_rbt_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_rbt_destroy() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_t *
+adts_rbt_create_ext( const adts_rbt_create_t *p_op )
+{
+    rbt_t            *p_tree     = NULL;
+    adts_rbt_t       *p_adts_rbt = NULL;
+    adts_mem_stats_t  mem        = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_RBT);
+
+    if (NULL == p_op) {
+        goto exception;
+    }
+
+    p_adts_rbt = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_rbt),
+                                      ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_rbt) {
+        goto exception;
+    }
+
+    p_tree      = (rbt_t *) p_adts_rbt;
+    p_tree->cmp = p_op->cmp;
+    p_tree->mem = mem;
+
+exception:
+    return p_adts_rbt;
+} /* adts_rbt_create_ext() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_rbt_t *
+adts_rbt_create( void )
+{
+    adts_rbt_create_t op = {0};
+
+    return adts_rbt_create_ext(&(op));
+} /* adts_rbt_create() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Persistent tree.  Nodes owned by the draft carry the draft sequence
+ *   and may be modified in place, any other node is published and is
+ *   copied before modification, see prbt_own().
+ *
+ ****************************************************************************
+ */
+static inline void
+prbt_node_give( prbt_t     *p_tree,
+                rbt_node_t *p_node )
+{
+    p_node->p_retired = p_tree->p_spare;
+    p_tree->p_spare   = p_node;
+    p_tree->spares++;
+
+    return;
+} /* prbt_node_give() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline rbt_node_t *
+prbt_node_take( prbt_t *p_tree )
+{
+    rbt_node_t *p_node = p_tree->p_spare;
+
+    /* prbt_reserve() bounds every update */
+    assert(p_node);
+    p_tree->p_spare = p_node->p_retired;
+    p_tree->spares--;
+
+    return p_node;
+} /* prbt_node_take() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Reserve the nodes an update may copy, such that ENOMEM is raised
+ *   before the draft is touched.  Height is bounded by 2 * log2(n + 1) and
+ *   each level copies at most the node, its children and a grandchild.
+ *
+ ****************************************************************************
+ */
+static int32_t
+prbt_reserve( prbt_t *p_tree )
+{
+    int32_t     rc     = 0;
+    size_t      lg     = 64 - __builtin_clzll(p_tree->elems + 1);
+    size_t      need   = 8 * ((2 * lg) + 2);
+    rbt_node_t *p_node = NULL;
+
+    while (p_tree->spares < need) {
+        p_node = rbt_node_alloc();
+        if (NULL == p_node) {
+            rc = ENOMEM;
+            break;
+        }
+        prbt_node_give(p_tree, p_node);
+    }
+
+    return rc;
+} /* prbt_reserve() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Writable instance of p_node within the draft.  A published node is
+ *   copied and retired, it remains reachable from older versions.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_own( prbt_t     *p_tree,
+          rbt_node_t *p_node )
+{
+    rbt_node_t *p_copy = NULL;
+
+    if (p_node->seq == p_tree->seq) {
+        return p_node;
+    }
+
+    p_copy            = prbt_node_take(p_tree);
+    *p_copy           = *p_node;
+    p_copy->seq       = p_tree->seq;
+    p_copy->p_retired = NULL;
+
+    /* p_retired is never read by readers */
+    p_node->p_retired = p_tree->p_retired;
+    p_tree->p_retired = p_node;
+
+    return p_copy;
+} /* prbt_own() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline rbt_node_t *
+prbt_rotate_left( prbt_t     *p_tree,
+                  rbt_node_t *p_root )
+{
+    p_root->p_right = prbt_own(p_tree, p_root->p_right);
+
+    return rbt_rotate_left(p_root);
+} /* prbt_rotate_left() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline rbt_node_t *
+prbt_rotate_right( prbt_t     *p_tree,
+                   rbt_node_t *p_root )
+{
+    p_root->p_left = prbt_own(p_tree, p_root->p_left);
+
+    return rbt_rotate_right(p_root);
+} /* prbt_rotate_right() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Color flip in either direction, splitting a 4-node on the way up or
+ *   joining a 3-node on the way down during removal.
+ *
+ ****************************************************************************
+ */
+static void
+prbt_flip( prbt_t     *p_tree,
+           rbt_node_t *p_root )
+{
+    p_root->p_left  = prbt_own(p_tree, p_root->p_left);
+    p_root->p_right = prbt_own(p_tree, p_root->p_right);
+
+    p_root->color          = rbt_is_red(p_root) ? BLACK : RED;
+    p_root->p_left->color  = rbt_is_red(p_root->p_left) ? BLACK : RED;
+    p_root->p_right->color = rbt_is_red(p_root->p_right) ? BLACK : RED;
+
+    return;
+} /* prbt_flip() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Restore the left leaning invariants at an owned node, the fixup of
+ *   rbt_insert() with the left-left test.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_balance( prbt_t     *p_tree,
+              rbt_node_t *p_root )
+{
+    if (rbt_is_red(p_root->p_right) && (false == rbt_is_red(p_root->p_left))) {
+        p_root = prbt_rotate_left(p_tree, p_root);
+    }
+
+    if (rbt_is_red(p_root->p_left) && rbt_is_red(p_root->p_left->p_left)) {
+        p_root = prbt_rotate_right(p_tree, p_root);
+    }
+
+    if (rbt_is_red(p_root->p_left) && rbt_is_red(p_root->p_right)) {
+        prbt_flip(p_tree, p_root);
+    }
+
+    return p_root;
+} /* prbt_balance() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_insert( prbt_t     *p_tree,
+             rbt_node_t *p_root,
+             const void *key,
+             void       *p_data )
+{
+    if (NULL == p_root) {
+        p_root = prbt_node_take(p_tree);
+        memset(p_root, 0, sizeof(*p_root));
+        p_root->key    = key;
+        p_root->p_data = p_data;
+        p_root->color  = RED;
+        p_root->seq    = p_tree->seq;
+        p_tree->elems++;
+        goto exception;
+    }
+
+    p_root = prbt_own(p_tree, p_root);
+
+    if (key < p_root->key) {
+        p_root->p_left = prbt_insert(p_tree, p_root->p_left, key, p_data);
+    }else if (key > p_root->key) {
+        p_root->p_right = prbt_insert(p_tree, p_root->p_right, key, p_data);
+    }else {
+        p_root->p_data = p_data;
+    }
+
+    p_root = prbt_balance(p_tree, p_root);
+
+exception:
+    return p_root;
+} /* prbt_insert() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_move_red_left( prbt_t     *p_tree,
+                    rbt_node_t *p_root )
+{
+    prbt_flip(p_tree, p_root);
+    if (rbt_is_red(p_root->p_right->p_left)) {
+        p_root->p_right = prbt_rotate_right(p_tree, p_root->p_right);
+        p_root          = prbt_rotate_left(p_tree, p_root);
+        prbt_flip(p_tree, p_root);
+    }
+
+    return p_root;
+} /* prbt_move_red_left() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_move_red_right( prbt_t     *p_tree,
+                     rbt_node_t *p_root )
+{
+    prbt_flip(p_tree, p_root);
+    if (rbt_is_red(p_root->p_left->p_left)) {
+        p_root = prbt_rotate_right(p_tree, p_root);
+        prbt_flip(p_tree, p_root);
+    }
+
+    return p_root;
+} /* prbt_move_red_right() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The draft owned minimum is discarded, its key having been moved.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_remove_min( prbt_t     *p_tree,
+                 rbt_node_t *p_root )
+{
+    p_root = prbt_own(p_tree, p_root);
+
+    if (NULL == p_root->p_left) {
+        prbt_node_give(p_tree, p_root);
+        return NULL;
+    }
+
+    if ((false == rbt_is_red(p_root->p_left)) &&
+        (false == rbt_is_red(p_root->p_left->p_left))) {
+        p_root = prbt_move_red_left(p_tree, p_root);
+    }
+    p_root->p_left = prbt_remove_min(p_tree, p_root->p_left);
+
+    return prbt_balance(p_tree, p_root);
+} /* prbt_remove_min() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Top down left leaning removal, key is known to be present.  A red
+ *   link is pushed down the search path such that the removed leaf is
+ *   never a 2-node.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+prbt_remove( prbt_t     *p_tree,
+             rbt_node_t *p_root,
+             const void *key )
+{
+    rbt_node_t *p_min = NULL;
+
+    p_root = prbt_own(p_tree, p_root);
+
+    if (key < p_root->key) {
+        if ((false == rbt_is_red(p_root->p_left)) &&
+            (false == rbt_is_red(p_root->p_left->p_left))) {
+            p_root = prbt_move_red_left(p_tree, p_root);
+        }
+        p_root->p_left = prbt_remove(p_tree, p_root->p_left, key);
+    }else {
+        if (rbt_is_red(p_root->p_left)) {
+            p_root = prbt_rotate_right(p_tree, p_root);
+        }
+
+        if ((key == p_root->key) && (NULL == p_root->p_right)) {
+            prbt_node_give(p_tree, p_root);
+            return NULL;
+        }
+
+        if ((false == rbt_is_red(p_root->p_right)) &&
+            (false == rbt_is_red(p_root->p_right->p_left))) {
+            p_root = prbt_move_red_right(p_tree, p_root);
+        }
+
+        if (key == p_root->key) {
+            p_min           = rbt_find_min(p_root->p_right);
+            p_root->key     = p_min->key;
+            p_root->p_data  = p_min->p_data;
+            p_root->p_right = prbt_remove_min(p_tree, p_root->p_right);
+        }else {
+            p_root->p_right = prbt_remove(p_tree, p_root->p_right, key);
+        }
+    }
+
+    return prbt_balance(p_tree, p_root);
+} /* prbt_remove() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+prbt_chain_free( rbt_node_t *p_node )
+{
+    rbt_node_t *p_next = NULL;
+
+    for (; p_node; p_node = p_next) {
+        p_next = p_node->p_retired;
+        adts_pool_free(p_rbt_pool, p_node);
+    }
+
+    return;
+} /* prbt_chain_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Free the nodes retired by released versions, oldest first.  A reader
+ *   increments refs before confirming its version is current, thus once a
+ *   superseded version reads 0 no reader can dereference it.
+ *
+ ****************************************************************************
+ */
+static void
+prbt_reclaim( prbt_t *p_tree )
+{
+    prbt_version_t *p_ver = NULL;
+
+    while ((p_tree->p_oldest != p_tree->p_curr) &&
+           (0 == __atomic_load_n(&(p_tree->p_oldest->refs), __ATOMIC_SEQ_CST))) {
+        p_ver = p_tree->p_oldest;
+        prbt_chain_free(p_ver->p_retired);
+
+        p_tree->p_oldest = p_ver->p_next;
+        p_tree->versions--;
+
+        /* records are recycled, never freed while the tree exists */
+        p_ver->p_retired = NULL;
+        p_ver->p_next    = p_tree->p_free;
+        p_tree->p_free   = p_ver;
+    }
+
+    return;
+} /* prbt_reclaim() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static prbt_version_t *
+prbt_version_alloc( prbt_t *p_tree )
+{
+    prbt_version_t *p_ver = p_tree->p_free;
+
+    if (p_ver) {
+        p_tree->p_free = p_ver->p_next;
+    } else {
+        p_ver = adts_mem_zalloc_acct(&(p_tree->mem), sizeof(*p_ver),
+                                     ADTS_MEM_ALIGN_CACHELINE);
+    }
+
+    return p_ver;
+} /* prbt_version_alloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_prbt_entries( adts_prbt_t *p_adts_prbt )
+{
+    prbt_t *p_tree = (prbt_t *) p_adts_prbt;
+
+    return p_tree->elems;
+} /* adts_prbt_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_prbt_versions( adts_prbt_t *p_adts_prbt )
+{
+    prbt_t *p_tree = (prbt_t *) p_adts_prbt;
+
+    return p_tree->versions;
+} /* adts_prbt_versions() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_prbt_mem_stats( adts_prbt_t      *p_adts_prbt,
+                     adts_mem_stats_t *p_stats )
+{
+    prbt_t *p_tree = (prbt_t *) p_adts_prbt;
+
+    *p_stats = p_tree->mem;
+
+    return;
+} /* adts_prbt_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_prbt_insert( adts_prbt_t *p_adts_prbt,
+                  const void  *key,
+                  void        *p_data )
+{
+    int32_t        rc       = 0;
+    prbt_t        *p_tree   = (prbt_t *) p_adts_prbt;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    rc = prbt_reserve(p_tree);
+    if (unlikely(rc)) {
+        goto exception;
+    }
+
+    p_tree->p_draft        = prbt_insert(p_tree, p_tree->p_draft, key, p_data);
+    p_tree->p_draft->color = BLACK;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_prbt_insert() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_prbt_remove( adts_prbt_t  *p_adts_prbt,
+                  const void   *key,
+                  void        **pp_data )
+{
+    int32_t        rc       = 0;
+    prbt_t        *p_tree   = (prbt_t *) p_adts_prbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_find_node(p_tree->p_draft, key);
+    if (NULL == p_node) {
+        rc = ENOENT;
+        goto exception;
+    }
+
+    rc = prbt_reserve(p_tree);
+    if (unlikely(rc)) {
+        goto exception;
+    }
+
+    if (pp_data) {
+        *pp_data = p_node->p_data;
+    }
+
+    /* root of a 2-node tree reddened, such that a red link descends */
+    p_node = prbt_own(p_tree, p_tree->p_draft);
+    if ((false == rbt_is_red(p_node->p_left)) &&
+        (false == rbt_is_red(p_node->p_right))) {
+        p_node->color = RED;
+    }
+
+    p_tree->p_draft = prbt_remove(p_tree, p_node, key);
+    if (p_tree->p_draft) {
+        p_tree->p_draft->color = BLACK;
+    }
+    p_tree->elems--;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_prbt_remove() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_prbt_find( adts_prbt_t  *p_adts_prbt,
+                const void   *key,
+                void        **pp_data )
+{
+    int32_t        rc       = ENOENT;
+    prbt_t        *p_tree   = (prbt_t *) p_adts_prbt;
+    rbt_node_t    *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = rbt_find_node(p_tree->p_draft, key);
+    if (p_node) {
+        *pp_data = p_node->p_data;
+        rc       = 0;
+    }
+
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_prbt_find() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The nodes the draft replaced are reachable from the current version
+ *   and older, they are recorded against the current version which the
+ *   draft supersedes.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_prbt_publish( adts_prbt_t *p_adts_prbt )
+{
+    int32_t         rc       = 0;
+    prbt_t         *p_tree   = (prbt_t *) p_adts_prbt;
+    prbt_version_t *p_prev   = p_tree->p_curr;
+    prbt_version_t *p_ver    = NULL;
+    adts_sanity_t  *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (p_tree->p_draft == p_prev->p_root) {
+        /* every update copies the root */
+        goto exception;
+    }
+
+    p_ver = prbt_version_alloc(p_tree);
+    if (NULL == p_ver) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    /* refs is left as is, stray readers balance their own increments */
+    p_ver->p_root    = p_tree->p_draft;
+    p_ver->seq       = p_tree->seq;
+    p_ver->elems     = p_tree->elems;
+    p_ver->p_retired = NULL;
+    p_ver->p_next    = NULL;
+
+    p_prev->p_retired = p_tree->p_retired;
+    p_prev->p_next    = p_ver;
+    p_tree->p_retired = NULL;
+    p_tree->versions++;
+
+    __atomic_store_n(&(p_tree->p_curr), p_ver, __ATOMIC_SEQ_CST);
+
+    /* draft nodes are now published */
+    p_tree->seq++;
+
+    prbt_reclaim(p_tree);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_prbt_publish() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_prbt_reclaim( adts_prbt_t *p_adts_prbt )
+{
+    prbt_t        *p_tree   = (prbt_t *) p_adts_prbt;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+    prbt_reclaim(p_tree);
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_prbt_reclaim() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The version may be superseded, reclaimed and even recycled between
+ *   the load and the increment, records are never freed while the tree
+ *   exists.  The reference holds only if the version is still current
+ *   once counted, after which the writer observes it.
+ *
+ ****************************************************************************
+ */
+const adts_prbt_version_t *
+adts_prbt_acquire( adts_prbt_t *p_adts_prbt )
+{
+    prbt_t         *p_tree = (prbt_t *) p_adts_prbt;
+    prbt_version_t *p_ver  = NULL;
+
+    for (;;) {
+        p_ver = __atomic_load_n(&(p_tree->p_curr), __ATOMIC_SEQ_CST);
+        (void) __atomic_add_fetch(&(p_ver->refs), 1, __ATOMIC_SEQ_CST);
+        if (likely(p_ver == __atomic_load_n(&(p_tree->p_curr),
+                                            __ATOMIC_SEQ_CST))) {
+            break;
+        }
+        (void) __atomic_sub_fetch(&(p_ver->refs), 1, __ATOMIC_SEQ_CST);
+    }
+
+    return (const adts_prbt_version_t *) p_ver;
+} /* adts_prbt_acquire() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_prbt_release( const adts_prbt_version_t *p_adts_version )
+{
+    prbt_version_t *p_ver = (prbt_version_t *) p_adts_version;
+
+    (void) __atomic_sub_fetch(&(p_ver->refs), 1, __ATOMIC_SEQ_CST);
+
+    return;
+} /* adts_prbt_release() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_rbt_node_t *
+adts_prbt_version_root( const adts_prbt_version_t *p_adts_version )
+{
+    const prbt_version_t *p_ver = (const prbt_version_t *) p_adts_version;
+
+    return (adts_rbt_node_t *) p_ver->p_root;
+} /* adts_prbt_version_root() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_prbt_version_entries( const adts_prbt_version_t *p_adts_version )
+{
+    const prbt_version_t *p_ver = (const prbt_version_t *) p_adts_version;
+
+    return p_ver->elems;
+} /* adts_prbt_version_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+uint64_t
+adts_prbt_version_seq( const adts_prbt_version_t *p_adts_version )
+{
+    const prbt_version_t *p_ver = (const prbt_version_t *) p_adts_version;
+
+    return p_ver->seq;
+} /* adts_prbt_version_seq() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_prbt_version_find( const adts_prbt_version_t  *p_adts_version,
+                        const void                 *key,
+                        void                      **pp_data )
+{
+    const prbt_version_t *p_ver  = (const prbt_version_t *) p_adts_version;
+    rbt_node_t           *p_node = NULL;
+
+    p_node = rbt_find_node(p_ver->p_root, key);
+    if (NULL == p_node) {
+        return ENOENT;
+    }
+    *pp_data = p_node->p_data;
+
+    return 0;
+} /* adts_prbt_version_find() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Live nodes are those reachable from the draft, and those retired by
+ *   the draft or by an unreclaimed version.
+ *
+ ****************************************************************************
+ */
+void
+adts_prbt_destroy( adts_prbt_t *p_adts_prbt )
+{
+    prbt_t           *p_tree   = (prbt_t *) p_adts_prbt;
+    prbt_version_t   *p_ver    = NULL;
+    prbt_version_t   *p_next   = NULL;
+    rbt_node_t       *p_node   = NULL;
+    rbt_iter_t        iter;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    /* post-order visits a node after its subtrees, never to revisit it */
+    for (p_node = rbt_iter_init(&(iter), p_tree->p_draft,
+                                ADTS_RBT_ITER_POSTORDER);
+         p_node;
+         p_node = rbt_iter_next(&(iter))) {
+        adts_pool_free(p_rbt_pool, p_node);
+    }
+    prbt_chain_free(p_tree->p_retired);
+    prbt_chain_free(p_tree->p_spare);
+
+    for (p_ver = p_tree->p_oldest; p_ver; p_ver = p_next) {
+        assert(0 == p_ver->refs);
+        p_next = p_ver->p_next;
+        prbt_chain_free(p_ver->p_retired);
+        adts_mem_free_acct(&(p_tree->mem), p_ver, sizeof(*p_ver),
+                           ADTS_MEM_ALIGN_CACHELINE);
+    }
+    for (p_ver = p_tree->p_free; p_ver; p_ver = p_next) {
+        p_next = p_ver->p_next;
+        adts_mem_free_acct(&(p_tree->mem), p_ver, sizeof(*p_ver),
+                           ADTS_MEM_ALIGN_CACHELINE);
+    }
+
+    /* the record is released along with the handle */
+    mem = p_tree->mem;
+    adts_mem_free_acct(&(mem), p_tree, sizeof(adts_prbt_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_prbt_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   An empty version 0 is current, the draft is version 1.
+ *
+ ****************************************************************************
+ */
+adts_prbt_t *
+adts_prbt_create( void )
+{
+    prbt_t           *p_tree      = NULL;
+    adts_prbt_t      *p_adts_prbt = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_RBT);
+
+    pthread_once(&rbt_pool_once, rbt_pool_init);
+    if (NULL == p_rbt_pool) {
+        goto exception;
+    }
+
+    p_adts_prbt = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_prbt),
+                                       ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_prbt) {
+        goto exception;
+    }
+
+    p_tree      = (prbt_t *) p_adts_prbt;
+    p_tree->mem = mem;
+
+    p_tree->p_curr = prbt_version_alloc(p_tree);
+    if (NULL == p_tree->p_curr) {
+        mem = p_tree->mem;
+        adts_mem_free_acct(&(mem), p_tree, sizeof(*p_adts_prbt),
+                           ADTS_MEM_ALIGN_DEFAULT);
+        p_adts_prbt = NULL;
+        goto exception;
+    }
+    p_tree->p_oldest = p_tree->p_curr;
+    p_tree->versions = 1;
+    p_tree->seq      = 1;
+
+exception:
+    return p_adts_prbt;
+} /* adts_prbt_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_rbt_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(rbt_node_t));
+    CDISPLAY("[%u]", sizeof(adts_rbt_node_t));
+
+    _Static_assert(sizeof(rbt_node_t) <= sizeof(adts_rbt_node_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(rbt_t));
+    CDISPLAY("[%u]", sizeof(adts_rbt_t));
+
+    _Static_assert(sizeof(rbt_t) <= sizeof(adts_rbt_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(rbt_range_t));
+    CDISPLAY("[%u]", sizeof(adts_rbt_range_t));
+
+    _Static_assert(sizeof(rbt_range_t) <= sizeof(adts_rbt_range_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(rbt_iter_t));
+    CDISPLAY("[%u]", sizeof(adts_rbt_iter_t));
+
+    _Static_assert(sizeof(rbt_iter_t) <= sizeof(adts_rbt_iter_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(prbt_t));
+    CDISPLAY("[%u]", sizeof(adts_prbt_t));
+
+    _Static_assert(sizeof(prbt_t) <= sizeof(adts_prbt_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(prbt_version_t));
+    CDISPLAY("[%u]", sizeof(adts_prbt_version_t));
+
+    _Static_assert(sizeof(prbt_version_t) <= sizeof(adts_prbt_version_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_rbt_bytes() */
+
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+utest_rbt_generate_node( void *key,
+                         void *p_data )
+{
+    rbt_node_t *p_node = NULL;
+
+    p_node = adts_mem_zalloc(sizeof(*p_node));
+    if (NULL == p_node) {
+        goto exception;
+    }
+
+    p_node->key    = key;
+    p_node->p_data = p_data;
+
+exception:
+    return p_node;
+} /* utest_rbt_generate_node() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static adts_rbt_node_t *
+utest_rbt_generate_ascii( void )
+{
+    rbt_node_t *p_root = NULL;
+
+    p_root                            = utest_rbt_generate_node('F', -1);
+    p_root->p_left                    = utest_rbt_generate_node('B', -1);
+
+    p_root->p_left->p_left            = utest_rbt_generate_node('A', -1);
+    p_root->p_left->p_right           = utest_rbt_generate_node('D', -1);
+
+    p_root->p_left->p_right->p_left   = utest_rbt_generate_node('C', -1);
+    p_root->p_left->p_right->p_right  = utest_rbt_generate_node('E', -1);
+
+    p_root->p_right                   = utest_rbt_generate_node('G', -1);
+    p_root->p_right->p_right          = utest_rbt_generate_node('I', -1);
+
+    p_root->p_right->p_right->p_left  = utest_rbt_generate_node('H', -1);
+
+    return (adts_rbt_node_t *) p_root;
+} /* utest_rbt_generate_ascii() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static adts_rbt_node_t *
+utest_rbt_generate_number( void )
+{
+    rbt_node_t *p_root = NULL;
+
+    p_root                            = utest_rbt_generate_node(6, -1);
+    p_root->p_left                    = utest_rbt_generate_node(2, -1);
+
+    p_root->p_left->p_left            = utest_rbt_generate_node(1, -1);
+    p_root->p_left->p_right           = utest_rbt_generate_node(4, -1);
+
+    p_root->p_left->p_right->p_left   = utest_rbt_generate_node(3, -1);
+    p_root->p_left->p_right->p_right  = utest_rbt_generate_node(5, -1);
+
+    p_root->p_right                   = utest_rbt_generate_node(7, -1);
+    p_root->p_right->p_right          = utest_rbt_generate_node(9, -1);
+
+    p_root->p_right->p_right->p_left  = utest_rbt_generate_node(8, -1);
+
+    return (adts_rbt_node_t *) p_root;
+} /* utest_rbt_generate_number() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release a generated tree, post-order.
+ *
+ ****************************************************************************
+ */
+static void
+utest_rbt_generate_free( rbt_node_t *p_node )
+{
+    if (p_node) {
+        utest_rbt_generate_free(p_node->p_left);
+        utest_rbt_generate_free(p_node->p_right);
+        free(p_node);
+    }
+
+    return;
+} /* utest_rbt_generate_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Walk the tree at p_root in order and match the keys to expect.
+ *
+ ****************************************************************************
+ */
+static void
+utest_rbt_iter_expect( adts_rbt_node_t       *p_root,
+                       adts_rbt_iter_order_t  order,
+                       const char            *p_expect )
+{
+    size_t           idx    = 0;
+    adts_rbt_node_t *p_node = NULL;
+    adts_rbt_iter_t  iter   = {0};
+
+    for (p_node = adts_rbt_iter_begin(p_root, &(iter), order);
+         p_node;
+         p_node = adts_rbt_iter_next(&(iter))) {
+        assert(p_expect[idx] == (char) (uintptr_t) p_node->pub.key);
+        idx++;
+    }
+    assert('\0' == p_expect[idx]);
+    assert(NULL == adts_rbt_iter_next(&(iter)));
+
+    return;
+} /* utest_rbt_iter_expect() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Perfectly balanced tree over a_nodes[lo, hi), key 2 * idx.
+ *
+ ****************************************************************************
+ */
+static rbt_node_t *
+utest_rbt_generate_balanced( rbt_node_t *a_nodes,
+                             size_t      lo,
+                             size_t      hi )
+{
+    size_t      mid    = lo + ((hi - lo) / 2);
+    rbt_node_t *p_node = NULL;
+
+    if (lo < hi) {
+        p_node          = &(a_nodes[mid]);
+        p_node->key     = (void *) (2 * mid);
+        p_node->p_left  = utest_rbt_generate_balanced(a_nodes, lo, mid);
+        p_node->p_right = utest_rbt_generate_balanced(a_nodes, mid + 1, hi);
+    }
+
+    return p_node;
+} /* utest_rbt_generate_balanced() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Red-black invariants of the intrusive subtree at p_node, keys within
+ *   (p_lo, p_hi) exclusive per the tree order, NULL unbounded, and the
+ *   subtree sizes.  Returns the black height.
+ *
+ ****************************************************************************
+ */
+static size_t
+utest_rbt_node_valid( const rbt_t *p_tree,
+                      rbt_node_t  *p_node,
+                      rbt_node_t  *p_parent,
+                      rbt_node_t  *p_lo,
+                      rbt_node_t  *p_hi,
+                      size_t      *p_elems )
+{
+    size_t left  = 0;
+    size_t right = 0;
+    size_t below = *p_elems;
+
+    if (NULL == p_node) {
+        return 1;
+    }
+
+    assert(p_parent == p_node->p_parent);
+    assert((NULL == p_lo) || (rbt_cmp(p_tree, p_lo->key, p_node->key) < 0));
+    assert((NULL == p_hi) || (rbt_cmp(p_tree, p_node->key, p_hi->key) < 0));
+    assert((false == rbt_is_red(p_node)) ||
+           ((false == rbt_is_red(p_node->p_left)) &&
+            (false == rbt_is_red(p_node->p_right))));
+
+    left  = utest_rbt_node_valid(p_tree, p_node->p_left, p_node, p_lo, p_node,
+                                 p_elems);
+    right = utest_rbt_node_valid(p_tree, p_node->p_right, p_node, p_node, p_hi,
+                                 p_elems);
+    assert(left == right);
+    (*p_elems)++;
+    assert((*p_elems - below) == p_node->stats.children);
+
+    return left + (rbt_is_red(p_node) ? 0 : 1);
+} /* utest_rbt_node_valid() */
+
+static void
+utest_rbt_valid( adts_rbt_t *p_adts_rbt )
+{
+    size_t  count  = 0;
+    rbt_t  *p_tree = (rbt_t *) p_adts_rbt;
+
+    assert(false == rbt_is_red(p_tree->p_root));
+    (void) utest_rbt_node_valid(p_tree, p_tree->p_root, NULL, NULL, NULL,
+                                &(count));
+    assert(p_tree->elems_curr == count);
+
+    return;
+} /* utest_rbt_valid() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int32_t
+utest_rbt_cmp_reverse( const void *p_a,
+                       const void *p_b )
+{
+    return ((uintptr_t) p_b > (uintptr_t) p_a) -
+           ((uintptr_t) p_b < (uintptr_t) p_a);
+} /* utest_rbt_cmp_reverse() */
+
+static int32_t
+utest_rbt_cmp_signed( const void *p_a,
+                      const void *p_b )
+{
+    return ((int64_t) p_a > (int64_t) p_b) - ((int64_t) p_a < (int64_t) p_b);
+} /* utest_rbt_cmp_signed() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Intrusive red-black tree vs the AVL tree, both over consumer nodes,
+ *   random insert, find and remove.  The comparator run adds the callback
+ *   per level.
+ *
+ ****************************************************************************
+ */
+static void
+utest_rbt_benchmark( void )
+{
+    const size_t sizes[] = { 1000 * 1000, 4 * 1000 * 1000 };
+    uint64_t     seed    = 0x9E3779B97F4A7C15ULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: red-black tree vs AVL tree, random keys");
+
+    for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+        const size_t        elems      = sizes[sdx];
+        uint64_t            t_ins[3]   = {0};
+        uint64_t            t_find[3]  = {0};
+        uint64_t            t_del[3]   = {0};
+        uintptr_t          *p_key      = NULL;
+        adts_rbt_node_t    *p_rnodes   = NULL;
+        adts_tree_node_t   *p_anodes   = NULL;
+        adts_rbt_t         *p_rbt      = NULL;
+        adts_tree_t        *p_avl      = NULL;
+        adts_rbt_create_t   op         = {0};
+
+        p_key    = calloc(elems, sizeof(*p_key));
+        p_rnodes = calloc(elems, sizeof(*p_rnodes));
+        p_anodes = calloc(elems, sizeof(*p_anodes));
+        assert(p_key && p_rnodes && p_anodes);
+
+        /* distinct keys, a shuffle of a strided sequence */
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_key[idx] = idx * 7919;
+        }
+        for (size_t idx = elems - 1; idx > 0; idx--) {
+            size_t    jdx = 0;
+            uintptr_t tmp = 0;
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            jdx = seed % (idx + 1);
+
+            tmp        = p_key[idx];
+            p_key[idx] = p_key[jdx];
+            p_key[jdx] = tmp;
+        }
+
+        /* red-black, default order then comparator */
+        for (size_t run = 0; run < 2; run++) {
+            op.cmp = (run) ? utest_rbt_cmp_signed : NULL;
+            p_rbt  = adts_rbt_create_ext(&(op));
+            assert(p_rbt);
+
+            t_ins[run] = adts_tstamp();
+            for (size_t idx = 0; idx < elems; idx++) {
+                (void) adts_rbt_insert(p_rbt, &(p_rnodes[idx]),
+                                       (void *) p_key[idx], NULL);
+            }
+            t_ins[run] = adts_tstamp() - t_ins[run];
+
+            t_find[run] = adts_tstamp();
+            for (size_t idx = elems; idx > 0; idx--) {
+                if (NULL == adts_rbt_find(p_rbt, (void *) p_key[idx - 1])) {
+                    assert(0);
+                }
+            }
+            t_find[run] = adts_tstamp() - t_find[run];
+
+            t_del[run] = adts_tstamp();
+            for (size_t idx = 0; idx < elems; idx++) {
+                (void) adts_rbt_remove(p_rbt, (void *) p_key[idx]);
+            }
+            t_del[run] = adts_tstamp() - t_del[run];
+            assert(0 == adts_rbt_entries(p_rbt));
+            adts_rbt_destroy(p_rbt);
+        }
+
+        /* AVL */
+        p_avl = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_avl);
+        t_ins[2] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_insert(p_avl, &(p_anodes[idx]),
+                                    (void *) p_key[idx], 0);
+        }
+        t_ins[2] = adts_tstamp() - t_ins[2];
+
+        t_find[2] = adts_tstamp();
+        for (size_t idx = elems; idx > 0; idx--) {
+            if (NULL == adts_tree_find(p_avl, (void *) p_key[idx - 1])) {
+                assert(0);
+            }
+        }
+        t_find[2] = adts_tstamp() - t_find[2];
+
+        t_del[2] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_remove(p_avl, (void *) p_key[idx]);
+        }
+        t_del[2] = adts_tstamp() - t_del[2];
+        assert(0 == adts_tree_entries(p_avl));
+        adts_tree_destroy(p_avl);
+
+        CDISPLAY("%9zu keys  insert %4llu / %4llu / %4llu ns/op"
+                 "  (rbt / rbt cmp / avl)", elems, t_ins[0] / elems,
+                 t_ins[1] / elems, t_ins[2] / elems);
+        CDISPLAY("%9zu keys  find   %4llu / %4llu / %4llu ns/op", elems,
+                 t_find[0] / elems, t_find[1] / elems, t_find[2] / elems);
+        CDISPLAY("%9zu keys  remove %4llu / %4llu / %4llu ns/op", elems,
+                 t_del[0] / elems, t_del[1] / elems, t_del[2] / elems);
+
+        free(p_anodes);
+        free(p_rnodes);
+        free(p_key);
+    }
+
+    return;
+} /* utest_rbt_benchmark() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int
+utest_rbt_qsort_cmp( const void *p_a,
+                     const void *p_b )
+{
+    uintptr_t a = *(const uintptr_t *) p_a;
+    uintptr_t b = *(const uintptr_t *) p_b;
+
+    return (a > b) - (a < b);
+} /* utest_rbt_qsort_cmp() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Order statistics over a live tree versus the copy and sort they
+ *   replace, a percentile there costs O(n log n).
+ *
+ ****************************************************************************
+ */
+static void
+utest_rbt_order_benchmark( void )
+{
+    const size_t      elems    = 1000 * 1000;
+    const size_t      queries  = 1000 * 1000;
+    uint64_t          seed     = 0x9E3779B97F4A7C15ULL;
+    uint64_t          t_rank   = 0;
+    uint64_t          t_select = 0;
+    uint64_t          t_count  = 0;
+    uint64_t          t_sort   = 0;
+    size_t            sum      = 0;
+    uintptr_t        *p_key    = NULL;
+    uintptr_t        *p_copy   = NULL;
+    adts_rbt_node_t  *p_nodes  = NULL;
+    adts_rbt_node_t  *p_node   = NULL;
+    adts_rbt_t       *p_rbt    = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: red-black tree order statistics");
+
+    p_key   = calloc(elems, sizeof(*p_key));
+    p_copy  = calloc(elems, sizeof(*p_copy));
+    p_nodes = calloc(elems, sizeof(*p_nodes));
+    p_rbt   = adts_rbt_create();
+    assert(p_key && p_copy && p_nodes && p_rbt);
+
+    for (size_t idx = 0; idx < elems; idx++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        p_key[idx] = seed;
+        (void) adts_rbt_insert(p_rbt, &(p_nodes[idx]), (void *) seed, NULL);
+    }
+
+    t_rank = adts_tstamp();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += adts_rbt_rank(p_rbt, (void *) p_key[idx % elems]);
+    }
+    t_rank = adts_tstamp() - t_rank;
+
+    t_select = adts_tstamp();
+    for (size_t idx = 0; idx < queries; idx++) {
+        p_node = adts_rbt_select(p_rbt, (idx * 7919) % elems);
+        sum   += (uintptr_t) p_node->pub.key & 1;
+    }
+    t_select = adts_tstamp() - t_select;
+
+    t_count = adts_tstamp();
+    for (size_t idx = 1; idx < queries; idx++) {
+        sum += adts_rbt_count_range(p_rbt, (void *) (p_key[idx - 1] / 2),
+                                    (void *) p_key[idx]);
+    }
+    t_count = adts_tstamp() - t_count;
+
+    /* the alternative, one percentile from a sorted copy */
+    t_sort = adts_tstamp();
+    memcpy(p_copy, p_key, elems * sizeof(*p_copy));
+    qsort(p_copy, elems, sizeof(*p_copy), utest_rbt_qsort_cmp);
+    t_sort = adts_tstamp() - t_sort;
+    assert(p_copy[elems / 2] ==
+           (uintptr_t) adts_rbt_select(p_rbt, elems / 2)->pub.key);
+
+    CDISPLAY("%zu keys  rank %llu  select %llu  count_range %llu ns/op",
+             elems, t_rank / queries, t_select / queries, t_count / queries);
+    CDISPLAY("%zu keys  copy + sort for one percentile %llu us  (%zu)",
+             elems, t_sort / 1000, sum & 1);
+
+    adts_rbt_destroy(p_rbt);
+    free(p_nodes);
+    free(p_copy);
+    free(p_key);
+
+    return;
+} /* utest_rbt_order_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Left leaning red-black invariants of the subtree at p_node, within
+ *   (lo, hi) exclusive, returning its black height.
+ *
+ ****************************************************************************
+ */
+static size_t
+utest_prbt_node_valid( rbt_node_t *p_node,
+                       uintptr_t   lo,
+                       uintptr_t   hi,
+                       size_t     *p_elems )
+{
+    size_t    left  = 0;
+    size_t    right = 0;
+    uintptr_t key   = 0;
+
+    if (NULL == p_node) {
+        return 1;
+    }
+
+    key = (uintptr_t) p_node->key;
+    assert((lo < key) && (key < hi));
+    assert(false == rbt_is_red(p_node->p_right));
+    assert((false == rbt_is_red(p_node)) ||
+           (false == rbt_is_red(p_node->p_left)));
+
+    left  = utest_prbt_node_valid(p_node->p_left, lo, key, p_elems);
+    right = utest_prbt_node_valid(p_node->p_right, key, hi, p_elems);
+    assert(left == right);
+    (*p_elems)++;
+
+    return left + (rbt_is_red(p_node) ? 0 : 1);
+} /* utest_prbt_node_valid() */
+
+static void
+utest_prbt_valid( rbt_node_t *p_root,
+                  size_t      elems )
+{
+    size_t count = 0;
+
+    assert(false == rbt_is_red(p_root));
+    (void) utest_prbt_node_valid(p_root, 0, UINTPTR_MAX, &(count));
+    assert(elems == count);
+
+    return;
+} /* utest_prbt_valid() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   A version's content against its reference presence map, p_data is
+ *   key * 3 + gen for the generation the key was last written.
+ *
+ ****************************************************************************
+ */
+static void
+utest_prbt_version_match( const adts_prbt_version_t *p_ver,
+                          const uint8_t             *p_ref,
+                          size_t                     limit )
+{
+    size_t           key    = 1;
+    size_t           count  = 0;
+    adts_rbt_node_t *p_node = NULL;
+    adts_rbt_iter_t  iter   = {0};
+
+    utest_prbt_valid((rbt_node_t *) adts_prbt_version_root(p_ver),
+                     adts_prbt_version_entries(p_ver));
+
+    for (p_node = adts_rbt_iter_begin(adts_prbt_version_root(p_ver), &(iter),
+                                      ADTS_RBT_ITER_INORDER);
+         p_node;
+         p_node = adts_rbt_iter_next(&(iter))) {
+        while ((key < limit) && (0 == p_ref[key])) {
+            key++;
+        }
+        assert(key == (uintptr_t) p_node->pub.key);
+        assert(((3 * key) + p_ref[key]) == (uintptr_t) p_node->pub.p_data);
+        key++;
+        count++;
+    }
+    while ((key < limit) && (0 == p_ref[key])) {
+        key++;
+    }
+    assert(key >= limit);
+    assert(count == adts_prbt_version_entries(p_ver));
+
+    return;
+} /* utest_prbt_version_match() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The writer slides a window of keys [lo, lo + window), one insert and
+ *   one remove per published version, such that every consistent snapshot
+ *   is a contiguous run of window keys.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    adts_prbt_t *p_prbt;
+    size_t       window;
+    size_t       snapshots;
+    bool         done;
+} utest_prbt_share_t;
+
+static void *
+utest_prbt_reader( void *p_arg )
+{
+    utest_prbt_share_t *p_share = p_arg;
+    uint64_t            seq     = 0;
+
+    while (false == __atomic_load_n(&(p_share->done), __ATOMIC_ACQUIRE)) {
+        const adts_prbt_version_t *p_ver  = adts_prbt_acquire(p_share->p_prbt);
+        adts_rbt_node_t           *p_node = NULL;
+        adts_rbt_iter_t            iter   = {0};
+        uintptr_t                  first  = 0;
+        size_t                     count  = 0;
+
+        assert(adts_prbt_version_seq(p_ver) >= seq);
+        seq = adts_prbt_version_seq(p_ver);
+
+        for (p_node = adts_rbt_iter_begin(adts_prbt_version_root(p_ver),
+                                          &(iter), ADTS_RBT_ITER_INORDER);
+             p_node;
+             p_node = adts_rbt_iter_next(&(iter))) {
+            if (0 == count) {
+                first = (uintptr_t) p_node->pub.key;
+            }
+            assert((first + count) == (uintptr_t) p_node->pub.key);
+            count++;
+        }
+        assert(count == adts_prbt_version_entries(p_ver));
+        assert((0 == seq) || (p_share->window == count));
+
+        adts_prbt_release(p_ver);
+        (void) __atomic_add_fetch(&(p_share->snapshots), 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+} /* utest_prbt_reader() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Persistent tree update cost, publishing each update versus batches,
+ *   and the reader acquire + find cost.
+ *
+ ****************************************************************************
+ */
+static void
+utest_prbt_benchmark( void )
+{
+    const size_t  elems   = 1000 * 1000;
+    const size_t  batch   = 1024;
+    uint64_t      seed    = 0x9E3779B97F4A7C15ULL;
+    uint64_t      t_one   = 0;
+    uint64_t      t_batch = 0;
+    uint64_t      t_find  = 0;
+    uint64_t      t_del   = 0;
+    uintptr_t    *p_key   = NULL;
+    void         *p_data  = NULL;
+    adts_prbt_t  *p_prbt  = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: persistent red-black tree");
+
+    p_key = calloc(elems, sizeof(*p_key));
+    assert(p_key);
+    for (size_t idx = 0; idx < elems; idx++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        p_key[idx] = (seed | 1);
+    }
+
+    /* publish every insert */
+    p_prbt = adts_prbt_create();
+    assert(p_prbt);
+    t_one = adts_tstamp();
+    for (size_t idx = 0; idx < elems; idx++) {
+        (void) adts_prbt_insert(p_prbt, (void *) p_key[idx], NULL);
+        (void) adts_prbt_publish(p_prbt);
+    }
+    t_one = adts_tstamp() - t_one;
+
+    t_find = adts_tstamp();
+    for (size_t idx = 0; idx < elems; idx++) {
+        const adts_prbt_version_t *p_ver = adts_prbt_acquire(p_prbt);
+
+        if (adts_prbt_version_find(p_ver, (void *) p_key[idx], &(p_data))) {
+            assert(0);
+        }
+        adts_prbt_release(p_ver);
+    }
+    t_find = adts_tstamp() - t_find;
+
+    t_del = adts_tstamp();
+    for (size_t idx = 0; idx < elems; idx++) {
+        (void) adts_prbt_remove(p_prbt, (void *) p_key[idx], NULL);
+        (void) adts_prbt_publish(p_prbt);
+    }
+    t_del = adts_tstamp() - t_del;
+    adts_prbt_destroy(p_prbt);
+
+    /* publish every batch */
+    p_prbt = adts_prbt_create();
+    assert(p_prbt);
+    t_batch = adts_tstamp();
+    for (size_t idx = 0; idx < elems; idx++) {
+        (void) adts_prbt_insert(p_prbt, (void *) p_key[idx], NULL);
+        if (0 == ((idx + 1) % batch)) {
+            (void) adts_prbt_publish(p_prbt);
+        }
+    }
+    (void) adts_prbt_publish(p_prbt);
+    t_batch = adts_tstamp() - t_batch;
+    assert(elems == adts_prbt_entries(p_prbt));
+    adts_prbt_destroy(p_prbt);
+
+    CDISPLAY("%zu keys  insert + publish %llu  remove + publish %llu ns/op",
+             elems, t_one / elems, t_del / elems);
+    CDISPLAY("%zu keys  insert, publish per %zu %llu ns/op", elems, batch,
+             t_batch / elems);
+    CDISPLAY("%zu keys  acquire + find + release %llu ns/op", elems,
+             t_find / elems);
+
+    free(p_key);
+
+    return;
+} /* utest_prbt_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 2: size verification ");
+        utest_rbt_bytes();
+    }
+#if 0
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 3: preorder traversal ");
+
+        adts_rbt_node_t *p_node = NULL;
+
+        p_node = utest_rbt_generate_ascii();
+        adts_rbt_display_preorder(p_node);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 4: inorder traversal ");
+
+        adts_rbt_node_t *p_node = NULL;
+
+        p_node = utest_rbt_generate_ascii();
+        adts_rbt_display_inorder(p_node);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 5: postorder traversal ");
+
+        adts_rbt_node_t *p_node = NULL;
 
         p_node = utest_rbt_generate_ascii();
         adts_rbt_display_postorder(p_node);
@@ -751,27 +3443,554 @@ utest_control( void )
     CDISPLAY("=========================================================");
     {
         CDISPLAY("Test 7: formal generation ");
-        char        keys[]     = {'A','B','C','D','E','F','G','H','I'};
-        size_t      elems      = sizeof(keys) / sizeof(keys[0]);
-        rbt_node_t *p_tmp      = NULL;
-        rbt_node_t *p_node[32] = {0};
 
-        elems = 3;
+        const char       keys[] = "ABCDEFGHI";
+        adts_rbt_node_t  a_nodes[ 9 ];
+        adts_rbt_t      *p_rbt  = NULL;
+
+        memset(a_nodes, 0, sizeof(a_nodes));
+        p_rbt = adts_rbt_create();
+        assert(p_rbt);
+
+        for (size_t idx = 0; idx < 9; idx++) {
+            assert(0 == adts_rbt_insert(p_rbt, &(a_nodes[idx]),
+                                        (void *) (uintptr_t) keys[idx], NULL));
+            utest_rbt_valid(p_rbt);
+        }
+        assert(EEXIST == adts_rbt_insert(p_rbt, &(a_nodes[0]), (void *) 'E',
+                                         NULL));
+
+        /* D(B(A, C), F(E, H(G, I))), B, F, G and I red */
+        utest_rbt_iter_expect(adts_rbt_root(p_rbt), ADTS_RBT_ITER_INORDER,
+                              "ABCDEFGHI");
+        utest_rbt_iter_expect(adts_rbt_root(p_rbt), ADTS_RBT_ITER_LEVEL,
+                              "DBFACEHGI");
+        adts_rbt_display_level(adts_rbt_root(p_rbt));
+
+        adts_rbt_destroy(p_rbt);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 8: iterators");
+
+        const size_t     elems   = 1000;
+        rbt_node_t      *p_nodes = NULL;
+        adts_rbt_node_t *p_root  = NULL;
+        adts_rbt_node_t *p_node  = NULL;
+        adts_rbt_iter_t  iter    = {0};
+
+        /* F(B(A, D(C, E)), G(-, I(H, -))) */
+        p_root = utest_rbt_generate_ascii();
+        utest_rbt_iter_expect(p_root, ADTS_RBT_ITER_INORDER,   "ABCDEFGHI");
+        utest_rbt_iter_expect(p_root, ADTS_RBT_ITER_REVERSE,   "IHGFEDCBA");
+        utest_rbt_iter_expect(p_root, ADTS_RBT_ITER_PREORDER,  "FBADCEGIH");
+        utest_rbt_iter_expect(p_root, ADTS_RBT_ITER_POSTORDER, "ACEDBHIGF");
+        utest_rbt_iter_expect(p_root, ADTS_RBT_ITER_LEVEL,     "FBGADICEH");
+        utest_rbt_iter_expect(NULL, ADTS_RBT_ITER_INORDER, "");
+
+        p_node = adts_rbt_iter_seek(p_root, &(iter), ADTS_RBT_ITER_INORDER,
+                                    (void *) 'D');
+        assert('D' == (uintptr_t) p_node->pub.key);
+        assert('E' == (uintptr_t) adts_rbt_iter_next(&(iter))->pub.key);
+        assert(NULL == adts_rbt_iter_seek(p_root, &(iter),
+                                          ADTS_RBT_ITER_PREORDER,
+                                          (void *) 'D'));
+        utest_rbt_generate_free((rbt_node_t *) p_root);
+
+        /* balanced, even keys, seek to present, absent and out of range */
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        assert(p_nodes);
+        p_root  = (adts_rbt_node_t *)
+                  utest_rbt_generate_balanced(p_nodes, 0, elems);
+
+        for (size_t key = 0; key < ((2 * elems) + 2); key++) {
+            size_t ceil  = (key + 1) & ~1ULL;
+            size_t floor = MIN(key & ~1ULL, 2 * (elems - 1));
+            size_t count = 0;
+
+            for (p_node = adts_rbt_iter_seek(p_root, &(iter),
+                                             ADTS_RBT_ITER_INORDER,
+                                             (void *) key);
+                 p_node;
+                 p_node = adts_rbt_iter_next(&(iter))) {
+                assert((ceil + (2 * count)) == (uintptr_t) p_node->pub.key);
+                count++;
+            }
+            assert(count == ((ceil < (2 * elems)) ? (elems - (ceil / 2)) : 0));
+
+            count = 0;
+            for (p_node = adts_rbt_iter_seek(p_root, &(iter),
+                                             ADTS_RBT_ITER_REVERSE,
+                                             (void *) key);
+                 p_node;
+                 p_node = adts_rbt_iter_next(&(iter))) {
+                assert((floor - (2 * count)) == (uintptr_t) p_node->pub.key);
+                count++;
+            }
+            assert(count == ((floor / 2) + 1));
+        }
+
+        /* level order of a complete tree visits each level in full */
+        {
+            size_t count = 0;
+            size_t depth = 0;
+
+            for (p_node = adts_rbt_iter_begin(p_root, &(iter),
+                                              ADTS_RBT_ITER_LEVEL);
+                 p_node;
+                 p_node = adts_rbt_iter_next(&(iter))) {
+                depth = ((rbt_iter_t *) &(iter))->depth - 1;
+                assert(depth == (63 - __builtin_clzll(count + 1)));
+                count++;
+            }
+            assert(elems == count);
+        }
+
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 9: persistent tree, snapshots survive updates");
+
+        const size_t                limit   = 2048;
+        const size_t                held    = 4;
+        uint64_t                    seed    = 0x9E3779B97F4A7C15ULL;
+        uint8_t                    *p_ref   = NULL;
+        uint8_t                    *p_snap  = NULL;
+        void                       *p_data  = NULL;
+        adts_prbt_t                *p_prbt  = NULL;
+        prbt_t                     *p_tree  = NULL;
+        const adts_prbt_version_t  *a_ver[ 4 ] = {0};
+        adts_pool_stats_t           before  = {0};
+        adts_pool_stats_t           after   = {0};
+
+        pthread_once(&rbt_pool_once, rbt_pool_init);
+        adts_pool_stats(p_rbt_pool, &(before));
+
+        p_ref  = calloc(limit, sizeof(*p_ref));
+        p_snap = calloc(held * limit, sizeof(*p_snap));
+        p_prbt = adts_prbt_create();
+        assert(p_ref && p_snap && p_prbt);
+        p_tree = (prbt_t *) p_prbt;
+
+        /* empty */
+        a_ver[0] = adts_prbt_acquire(p_prbt);
+        assert(0 == adts_prbt_version_entries(a_ver[0]));
+        assert(NULL == adts_prbt_version_root(a_ver[0]));
+        assert(ENOENT == adts_prbt_version_find(a_ver[0], (void *) 1,
+                                                &(p_data)));
+        assert(ENOENT == adts_prbt_remove(p_prbt, (void *) 1, NULL));
+        assert(0 == adts_prbt_publish(p_prbt));
+        assert(1 == adts_prbt_versions(p_prbt));
+        adts_prbt_release(a_ver[0]);
+        a_ver[0] = NULL;
+
+        for (size_t step = 0; step < 4096; step++) {
+            size_t slot = step % held;
+            size_t ops  = 1 + (step % 13);
+
+            /* keys 1 .. limit - 1, p_data tagged with a write generation */
+            for (size_t op = 0; op < ops; op++) {
+                size_t key = 0;
+
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                key = 1 + ((seed >> 8) % (limit - 1));
+
+                if ((seed & 0xff) < ((step < 2048) ? 170 : 90)) {
+                    p_ref[key] = 1 + (p_ref[key] % 2);
+                    assert(0 == adts_prbt_insert(p_prbt, (void *) key,
+                                                 (void *) ((3 * key) +
+                                                           p_ref[key])));
+                } else if (p_ref[key]) {
+                    assert(0 == adts_prbt_remove(p_prbt, (void *) key,
+                                                 &(p_data)));
+                    assert(((3 * key) + p_ref[key]) == (uintptr_t) p_data);
+                    p_ref[key] = 0;
+                } else {
+                    assert(ENOENT == adts_prbt_remove(p_prbt, (void *) key,
+                                                      NULL));
+                }
+            }
+            utest_prbt_valid(p_tree->p_draft, adts_prbt_entries(p_prbt));
+            assert(0 == adts_prbt_publish(p_prbt));
+
+            /* hold the last few versions while the writer moves on */
+            if (a_ver[slot]) {
+                utest_prbt_version_match(a_ver[slot], &(p_snap[slot * limit]),
+                                         limit);
+                adts_prbt_release(a_ver[slot]);
+            }
+            a_ver[slot] = adts_prbt_acquire(p_prbt);
+            memcpy(&(p_snap[slot * limit]), p_ref, limit);
+
+            for (size_t idx = 0; idx < held; idx++) {
+                if (a_ver[idx] && (0 == (step % 64))) {
+                    utest_prbt_version_match(a_ver[idx],
+                                             &(p_snap[idx * limit]), limit);
+                }
+            }
+            assert(adts_prbt_versions(p_prbt) <= (held + 1));
+        }
+
+        for (size_t idx = 0; idx < held; idx++) {
+            adts_prbt_release(a_ver[idx]);
+        }
+        adts_prbt_reclaim(p_prbt);
+        assert(1 == adts_prbt_versions(p_prbt));
+
+        /* an unchanged draft publishes nothing */
+        assert(0 == adts_prbt_publish(p_prbt));
+        assert(1 == adts_prbt_versions(p_prbt));
+
+        adts_prbt_destroy(p_prbt);
+        adts_pool_stats(p_rbt_pool, &(after));
+        assert(before.objs_curr == after.objs_curr);
+
+        free(p_snap);
+        free(p_ref);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 10: persistent tree, concurrent readers");
+
+        const size_t        steps   = 20000;
+        utest_prbt_share_t  share   = {0};
+        pthread_t           tid[ 2 ];
+
+        share.window = 256;
+        share.p_prbt = adts_prbt_create();
+        assert(share.p_prbt);
+
+        for (size_t key = 1; key <= share.window; key++) {
+            assert(0 == adts_prbt_insert(share.p_prbt, (void *) key, NULL));
+        }
+        assert(0 == adts_prbt_publish(share.p_prbt));
+
+        for (size_t idx = 0; idx < 2; idx++) {
+            pthread_create(&(tid[idx]), NULL, utest_prbt_reader, &(share));
+        }
+
+        for (size_t lo = 1; lo <= steps; lo++) {
+            assert(0 == adts_prbt_insert(share.p_prbt,
+                                         (void *) (lo + share.window), NULL));
+            assert(0 == adts_prbt_remove(share.p_prbt, (void *) lo, NULL));
+            assert(0 == adts_prbt_publish(share.p_prbt));
+            if (0 == (lo % 256)) {
+                sched_yield();
+            }
+        }
+
+        __atomic_store_n(&(share.done), true, __ATOMIC_RELEASE);
+        for (size_t idx = 0; idx < 2; idx++) {
+            pthread_join(tid[idx], NULL);
+        }
+        adts_prbt_reclaim(share.p_prbt);
+        assert(1 == adts_prbt_versions(share.p_prbt));
+        CDISPLAY("%zu versions published, %zu snapshots read", steps,
+                 share.snapshots);
+
+        adts_prbt_destroy(share.p_prbt);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 11: intrusive tree, random updates against a reference");
+
+        const size_t      limit   = 4096;
+        uint64_t          seed    = 0x9E3779B97F4A7C15ULL;
+        uint8_t          *p_ref   = NULL;
+        adts_rbt_node_t  *p_nodes = NULL;
+        adts_rbt_node_t  *p_node  = NULL;
+        adts_rbt_t       *p_rbt   = NULL;
+        size_t            elems   = 0;
+
+        p_ref   = calloc(limit, sizeof(*p_ref));
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        p_rbt   = adts_rbt_create();
+        assert(p_ref && p_nodes && p_rbt);
+
+        assert(NULL == adts_rbt_peek_min(p_rbt));
+        assert(NULL == adts_rbt_find(p_rbt, (void *) 1));
+        assert(NULL == adts_rbt_remove(p_rbt, (void *) 1));
+
+        /* node idx carries key 2 * idx + 1, p_data idx */
+        for (size_t op = 0; op < 200 * 1000; op++) {
+            size_t idx = 0;
+            void  *key = NULL;
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            idx = (seed >> 8) % limit;
+            key = (void *) ((2 * idx) + 1);
+
+            switch (seed % 4) {
+                case 0:
+                case 1:
+                    if (p_ref[idx]) {
+                        assert(EEXIST == adts_rbt_insert(p_rbt, &(p_nodes[0]),
+                                                         key, NULL));
+                    } else {
+                        assert(0 == adts_rbt_insert(p_rbt, &(p_nodes[idx]),
+                                                    key, (void *) idx));
+                        p_ref[idx] = 1;
+                        elems++;
+                    }
+                    break;
+                case 2:
+                    p_node = adts_rbt_remove(p_rbt, key);
+                    assert(p_node == (p_ref[idx] ? &(p_nodes[idx]) : NULL));
+                    elems -= p_ref[idx];
+                    p_ref[idx] = 0;
+                    break;
+                default:
+                    p_node = adts_rbt_find(p_rbt, key);
+                    assert(p_node == (p_ref[idx] ? &(p_nodes[idx]) : NULL));
+                    if (p_node) {
+                        assert(idx == (uintptr_t) p_node->pub.p_data);
+                        adts_rbt_remove_node(p_rbt, p_node);
+                        p_ref[idx] = 0;
+                        elems--;
+                    }
+                    break;
+            }
+            assert(elems == adts_rbt_entries(p_rbt));
+
+            if (0 == (op % 1024)) {
+                size_t kdx = 0;
+
+                utest_rbt_valid(p_rbt);
+
+                /* ascending via next, descending via prev */
+                for (p_node = adts_rbt_peek_min(p_rbt);
+                     p_node;
+                     p_node = adts_rbt_next(p_node)) {
+                    while (0 == p_ref[kdx]) {
+                        kdx++;
+                    }
+                    assert(&(p_nodes[kdx]) == p_node);
+                    kdx++;
+                }
+                kdx = limit;
+                for (p_node = adts_rbt_peek_max(p_rbt);
+                     p_node;
+                     p_node = adts_rbt_prev(p_node)) {
+                    while (0 == p_ref[kdx - 1]) {
+                        kdx--;
+                    }
+                    assert(&(p_nodes[kdx - 1]) == p_node);
+                    kdx--;
+                }
+            }
+        }
+
+        /* drain */
+        while ((p_node = adts_rbt_peek_min(p_rbt))) {
+            adts_rbt_remove_node(p_rbt, p_node);
+            if (0 == (adts_rbt_entries(p_rbt) % 256)) {
+                utest_rbt_valid(p_rbt);
+            }
+        }
+        assert(NULL == adts_rbt_root(p_rbt));
+        adts_rbt_destroy(p_rbt);
+
+        /* comparator order, descending keys */
+        {
+            adts_rbt_create_t op = {0};
+
+            op.cmp = utest_rbt_cmp_reverse;
+            p_rbt  = adts_rbt_create_ext(&(op));
+            assert(p_rbt);
+
+            for (size_t idx = 0; idx < limit; idx++) {
+                size_t kdx = (idx * 1031) % limit;
+
+                assert(0 == adts_rbt_insert(p_rbt, &(p_nodes[kdx]),
+                                            (void *) kdx, NULL));
+            }
+            utest_rbt_valid(p_rbt);
+
+            elems = limit;
+            for (p_node = adts_rbt_peek_min(p_rbt);
+                 p_node;
+                 p_node = adts_rbt_next(p_node)) {
+                elems--;
+                assert(elems == (uintptr_t) p_node->pub.key);
+            }
+            assert(0 == elems);
+            assert(&(p_nodes[0]) == adts_rbt_peek_max(p_rbt));
+            adts_rbt_destroy(p_rbt);
+        }
+
+        free(p_nodes);
+        free(p_ref);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 12: order statistics against a reference");
+
+        const size_t       limit   = 2048;
+        uint64_t           seed    = 0x2545F4914F6CDD1DULL;
+        uint8_t           *p_ref   = NULL;
+        size_t            *p_below = NULL;
+        adts_rbt_node_t   *p_nodes = NULL;
+        adts_rbt_node_t   *p_node  = NULL;
+        adts_rbt_t        *p_rbt   = NULL;
+        adts_rbt_range_t   range   = {0};
+
+        /* p_below[k]: reference keys ordered before key k */
+        p_ref   = calloc(limit, sizeof(*p_ref));
+        p_below = calloc(limit + 1, sizeof(*p_below));
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        p_rbt   = adts_rbt_create();
+        assert(p_ref && p_below && p_nodes && p_rbt);
+
+        assert(0 == adts_rbt_rank(p_rbt, (void *) 5));
+        assert(NULL == adts_rbt_select(p_rbt, 0));
+        assert(NULL == adts_rbt_floor(p_rbt, (void *) 5));
+        assert(NULL == adts_rbt_ceiling(p_rbt, (void *) 5));
+        assert(0 == adts_rbt_count_range(p_rbt, (void *) 0, (void *) 9));
+        assert(NULL == adts_rbt_range_begin(p_rbt, &(range), (void *) 0,
+                                            (void *) 9));
+
+        /* odd keys 2 * idx + 1 are stored, even keys probe the gaps */
+        for (size_t op = 0; op < 64 * 1024; op++) {
+            size_t idx = 0;
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            idx = (seed >> 8) % limit;
+
+            if ((seed & 0xff) < ((op < 32 * 1024) ? 180 : 80)) {
+                if (0 == p_ref[idx]) {
+                    assert(0 == adts_rbt_insert(p_rbt, &(p_nodes[idx]),
+                                                (void *) ((2 * idx) + 1),
+                                                NULL));
+                    p_ref[idx] = 1;
+                }
+            } else if (p_ref[idx]) {
+                adts_rbt_remove_node(p_rbt, &(p_nodes[idx]));
+                p_ref[idx] = 0;
+            }
+
+            if (op % 512) {
+                continue;
+            }
+            utest_rbt_valid(p_rbt);
+
+            for (size_t kdx = 0; kdx < limit; kdx++) {
+                p_below[kdx + 1] = p_below[kdx] + p_ref[kdx];
+            }
+
+            for (size_t qdx = 0; qdx < 256; qdx++) {
+                size_t           lo     = 0;
+                size_t           hi     = 0;
+                size_t           rank   = 0;
+                size_t           count  = 0;
+                adts_rbt_node_t *p_want = NULL;
+
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                lo = (seed >> 8) % ((2 * limit) + 1);
+                hi = (seed >> 32) % ((2 * limit) + 1);
+
+                /* key lo sits between node lo / 2 - 1 and node lo / 2 */
+                rank = p_below[lo / 2];
+                assert(rank == adts_rbt_rank(p_rbt, (void *) lo));
+
+                p_node = adts_rbt_select(p_rbt, rank);
+                assert(p_node == adts_rbt_ceiling(p_rbt, (void *) lo));
+                if (p_node) {
+                    assert(rank == adts_rbt_rank(p_rbt, p_node->pub.key));
+                } else {
+                    assert(rank == adts_rbt_entries(p_rbt));
+                }
+
+                /* floor: the greatest stored key <= lo */
+                p_want = NULL;
+                for (size_t kdx = ((lo + 1) / 2); kdx > 0; kdx--) {
+                    if (p_ref[kdx - 1]) {
+                        p_want = &(p_nodes[kdx - 1]);
+                        break;
+                    }
+                }
+                assert(p_want == adts_rbt_floor(p_rbt, (void *) lo));
+
+                count = (lo <= hi) ?
+                        (p_below[(hi + 1) / 2] - p_below[lo / 2]) : 0;
+                assert(count == adts_rbt_count_range(p_rbt, (void *) lo,
+                                                     (void *) hi));
+
+                for (p_node = adts_rbt_range_begin(p_rbt, &(range),
+                                                   (void *) lo, (void *) hi);
+                     p_node;
+                     p_node = adts_rbt_range_next(&(range))) {
+                    assert(((uintptr_t) p_node->pub.key >= lo) &&
+                           ((uintptr_t) p_node->pub.key <= hi));
+                    count--;
+                }
+                assert(0 == count);
+            }
+        }
+
+        /* every rank selects the node of that rank */
+        {
+            size_t rank = 0;
+
+            for (p_node = adts_rbt_peek_min(p_rbt);
+                 p_node;
+                 p_node = adts_rbt_next(p_node)) {
+                assert(p_node == adts_rbt_select(p_rbt, rank));
+                rank++;
+            }
+            assert(rank == adts_rbt_entries(p_rbt));
+            assert(NULL == adts_rbt_select(p_rbt, rank));
+        }
+        adts_rbt_destroy(p_rbt);
+
+        /* comparator order, rank counts keys ordered before */
+        {
+            adts_rbt_create_t op = {0};
 
-        for (int32_t idx = 0; idx < elems; idx++) {
-            p_node[idx] = rbt_insert(p_tmp, keys[idx], -1);
-            p_tmp = p_node[idx];
+            op.cmp = utest_rbt_cmp_reverse;
+            p_rbt  = adts_rbt_create_ext(&(op));
+            assert(p_rbt);
 
-            printf("\n");
-            //adts_rbt_display_level(p_node[idx]);
+            for (size_t idx = 0; idx < 100; idx++) {
+                assert(0 == adts_rbt_insert(p_rbt, &(p_nodes[idx]),
+                                            (void *) (10 * idx), NULL));
+            }
+            utest_rbt_valid(p_rbt);
+
+            assert(0 == adts_rbt_rank(p_rbt, (void *) 990));
+            assert(10 == adts_rbt_rank(p_rbt, (void *) 895));
+            assert(&(p_nodes[99]) == adts_rbt_select(p_rbt, 0));
+            assert(&(p_nodes[91]) == adts_rbt_floor(p_rbt, (void *) 905));
+            assert(&(p_nodes[90]) == adts_rbt_ceiling(p_rbt, (void *) 905));
+            assert(11 == adts_rbt_count_range(p_rbt, (void *) 200,
+                                              (void *) 100));
+            assert(0 == adts_rbt_count_range(p_rbt, (void *) 100,
+                                             (void *) 200));
+            adts_rbt_destroy(p_rbt);
         }
-        //p_tmp = p_node[0];
-        adts_rbt_display_level(p_tmp);
-        //adts_rbt_display_preorder(p_tmp);
-        //adts_rbt_display_inorder(p_tmp);
-        //adts_rbt_display_postorder(p_tmp);
+
+        free(p_nodes);
+        free(p_below);
+        free(p_ref);
     }
 
+    utest_prbt_benchmark();
+    utest_rbt_benchmark();
+    utest_rbt_order_benchmark();
+
     return;
 } /* utest_control() */
 
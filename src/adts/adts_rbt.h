@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_memory.h>
 
 
 /**
@@ -11,7 +12,12 @@
  *
  *************************************************************************
  */
-#define ADTS_RBT_NODE_BYTES (64)
+#define ADTS_RBT_BYTES              (256)
+#define ADTS_RBT_NODE_BYTES         (64)
+#define ADTS_RBT_ITER_BYTES         (800)
+#define ADTS_RBT_RANGE_BYTES        (32)
+#define ADTS_PRBT_BYTES             (256)
+#define ADTS_PRBT_VERSION_BYTES     (64)
 
 
 /**
@@ -21,9 +27,353 @@
  **************************************************************************
  */
 typedef struct {
-    const char reserved[ ADTS_RBT_NODE_BYTES ];
+    const char reserved[ ADTS_RBT_BYTES ];
+} adts_rbt_t;
+
+typedef struct {
+    void *key;
+    void *p_data;
+} adts_rbt_node_public_t;
+
+typedef union {
+    const char                   reserved[ ADTS_RBT_NODE_BYTES ];
+    const adts_rbt_node_public_t pub; /**< read only */
 } adts_rbt_node_t;
 
+typedef struct {
+    const char reserved[ ADTS_RBT_ITER_BYTES ];
+} adts_rbt_iter_t;
+
+typedef struct {
+    const char reserved[ ADTS_RBT_RANGE_BYTES ];
+} adts_rbt_range_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Traversal orders, see adts_rbt_iter_begin().
+ *
+ **************************************************************************
+ */
+typedef enum {
+    ADTS_RBT_ITER_INORDER = 1, /**< ascending */
+    ADTS_RBT_ITER_REVERSE,     /**< descending */
+    ADTS_RBT_ITER_PREORDER,
+    ADTS_RBT_ITER_POSTORDER,
+    ADTS_RBT_ITER_LEVEL,       /**< breadth first, left to right */
+} adts_rbt_iter_order_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Cursor iteration over the tree at p_root, allocation free.  The
+ *   iterator retains the root to current path, bounded by the tree height,
+ *   and is resumable: each call returns the node under the cursor, NULL
+ *   once exhausted.  Any modification of the tree invalidates the
+ *   iterator.
+ *
+ *   seek positions an in-order iteration at the first node with key >=
+ *   key, or for ADTS_RBT_ITER_REVERSE the last node with key <= key.  Other
+ *   orders have no key position and the iterator is returned exhausted.
+ *
+ **************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_iter_begin( adts_rbt_node_t       *p_root,
+                     adts_rbt_iter_t       *p_iter,
+                     adts_rbt_iter_order_t  order );
+
+adts_rbt_node_t *
+adts_rbt_iter_seek( adts_rbt_node_t       *p_root,
+                    adts_rbt_iter_t       *p_iter,
+                    adts_rbt_iter_order_t  order,
+                    const void            *key );
+
+adts_rbt_node_t *
+adts_rbt_iter_next( adts_rbt_iter_t *p_iter );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Red-black tree over consumer owned nodes, embedded within the consumer
+ *   record.  Keys are unique and ordered by cmp, which returns <0, 0, >0
+ *   as a orders before, equal to, or after b.  A NULL cmp orders keys by
+ *   value as unsigned integers.
+ *
+ *   Insert and remove are iterative over parent links, no memory is
+ *   allocated per node, and at most three rotations rebalance an update.
+ *   The adts_rbt iterators apply to adts_rbt_root(), though seek orders
+ *   keys as unsigned integers, position a comparator tree via find and
+ *   next / prev instead.
+ *
+ *   rbt create parameters
+ *     - cmp: key comparator, optional
+ *
+ **************************************************************************
+ */
+typedef int32_t (*adts_rbt_cmp_t)( const void *p_a,
+                                   const void *p_b );
+
+typedef struct {
+    adts_rbt_cmp_t cmp;
+} adts_rbt_create_t;
+
+size_t
+adts_rbt_entries( adts_rbt_t *p_adts_rbt );
+
+adts_rbt_node_t *
+adts_rbt_root( adts_rbt_t *p_adts_rbt );
+
+adts_rbt_node_t *
+adts_rbt_find( adts_rbt_t *p_adts_rbt,
+               const void *key );
+
+adts_rbt_node_t *
+adts_rbt_peek_min( adts_rbt_t *p_adts_rbt );
+
+adts_rbt_node_t *
+adts_rbt_peek_max( adts_rbt_t *p_adts_rbt );
+
+/**
+ **************************************************************************
+ * \details
+ *   In-order neighbours of a linked node, NULL past either end.
+ *
+ **************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_next( adts_rbt_node_t *p_adts_rbt_node );
+
+adts_rbt_node_t *
+adts_rbt_prev( adts_rbt_node_t *p_adts_rbt_node );
+
+/**
+ **************************************************************************
+ * \details
+ *   Order statistics, O(log n) over subtree sizes maintained by each
+ *   update.  Orders follow the tree comparator.
+ *     floor:       the greatest key <= key, NULL if none.
+ *     ceiling:     the least key >= key, NULL if none.
+ *     rank:        the number of keys ordered before key, present or not.
+ *     select:      the node of 0 based rank, NULL if rank >= entries.
+ *     count_range: the number of keys within [lo, hi], 0 if hi is
+ *                  ordered before lo.
+ *
+ *   The p-th percentile of n entries is select((p * (n - 1)) / 100).
+ *
+ **************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_floor( adts_rbt_t *p_adts_rbt,
+                const void *key );
+
+adts_rbt_node_t *
+adts_rbt_ceiling( adts_rbt_t *p_adts_rbt,
+                  const void *key );
+
+size_t
+adts_rbt_rank( adts_rbt_t *p_adts_rbt,
+               const void *key );
+
+adts_rbt_node_t *
+adts_rbt_select( adts_rbt_t *p_adts_rbt,
+                 size_t      rank );
+
+size_t
+adts_rbt_count_range( adts_rbt_t *p_adts_rbt,
+                      const void *lo,
+                      const void *hi );
+
+/**
+ **************************************************************************
+ * \details
+ *   Ascending iteration over the keys within [lo, hi], allocation free.
+ *   Each call returns the next node, NULL once past hi.  Any update of the
+ *   tree invalidates the range.
+ *
+ *   for (p_node = adts_rbt_range_begin(p_rbt, &(range), lo, hi);
+ *        p_node;
+ *        p_node = adts_rbt_range_next(&(range))) {
+ *       ...
+ *   }
+ *
+ **************************************************************************
+ */
+adts_rbt_node_t *
+adts_rbt_range_begin( adts_rbt_t       *p_adts_rbt,
+                      adts_rbt_range_t *p_adts_range,
+                      const void       *lo,
+                      const void       *hi );
+
+adts_rbt_node_t *
+adts_rbt_range_next( adts_rbt_range_t *p_adts_range );
+
+/**
+ **************************************************************************
+ * \details
+ *   EEXIST if the key is already present.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_rbt_insert( adts_rbt_t      *p_adts_rbt,
+                 adts_rbt_node_t *p_adts_rbt_node,
+                 const void      *key,
+                 void            *p_data );
+
+/**
+ **************************************************************************
+ * \details
+ *   remove_node unlinks a node known to be linked within the tree, remove
+ *   returns the node of key to the consumer, NULL if absent.
+ *
+ **************************************************************************
+ */
+void
+adts_rbt_remove_node( adts_rbt_t      *p_adts_rbt,
+                      adts_rbt_node_t *p_adts_rbt_node );
+
+adts_rbt_node_t *
+adts_rbt_remove( adts_rbt_t *p_adts_rbt,
+                 const void *key );
+
+void
+adts_rbt_destroy( adts_rbt_t *p_adts_rbt );
+
+adts_rbt_t *
+adts_rbt_create_ext( const adts_rbt_create_t *p_op );
+
+adts_rbt_t *
+adts_rbt_create( void );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Persistent red-black tree, a single writer mutates while any number of
+ *   readers hold consistent snapshots without locks.
+ *
+ *   The writer updates a private draft by path copying, a published node
+ *   is never modified: insert and remove copy the root to leaf path, plus
+ *   the siblings a rotation or color flip touches, and share the rest.
+ *   Nodes created within the draft are updated in place, thus a batch of
+ *   updates between publishes copies each path once.  adts_prbt_publish()
+ *   makes the draft a version, atomically replacing the current root.
+ *
+ *   Readers acquire the current version, find and iterate it via
+ *   adts_prbt_version_root() and the adts_rbt iterators, then release it.
+ *   Acquire and release are a pair of atomics, readers never block the
+ *   writer nor each other.
+ *
+ *   A version records the nodes its successor replaced.  Those are freed
+ *   once the version and all older versions are released, by the writer
+ *   within publish or adts_prbt_reclaim().  An unreleased version thus
+ *   retains the memory of every later replacement.
+ *
+ *   Keys are ordered by value as unsigned integers, as in adts_rbt.  The
+ *   writer calls are not thread safe, writers must be serialized by the
+ *   consumer.
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_PRBT_BYTES ];
+} adts_prbt_t;
+
+typedef struct {
+    const char reserved[ ADTS_PRBT_VERSION_BYTES ];
+} adts_prbt_version_t;
+
+/* writer */
+size_t
+adts_prbt_entries( adts_prbt_t *p_adts_prbt );
+
+size_t
+adts_prbt_versions( adts_prbt_t *p_adts_prbt );
+
+void
+adts_prbt_mem_stats( adts_prbt_t      *p_adts_prbt,
+                     adts_mem_stats_t *p_stats );
+
+/**
+ **************************************************************************
+ * \details
+ *   Draft updates, invisible to readers until published.
+ *   insert: replaces p_data if key is present, ENOMEM on allocation
+ *           failure in which case the draft is unchanged.
+ *   remove: ENOENT if absent, otherwise p_data is returned via pp_data,
+ *           which may be NULL.  ENOMEM as insert.
+ *   find:   within the draft, ENOENT if absent.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_prbt_insert( adts_prbt_t *p_adts_prbt,
+                  const void  *key,
+                  void        *p_data );
+
+int32_t
+adts_prbt_remove( adts_prbt_t  *p_adts_prbt,
+                  const void   *key,
+                  void        **pp_data );
+
+int32_t
+adts_prbt_find( adts_prbt_t  *p_adts_prbt,
+                const void   *key,
+                void        **pp_data );
+
+/**
+ **************************************************************************
+ * \details
+ *   Publish the draft, ENOMEM if a version record is unavailable in which
+ *   case the draft remains unpublished.  Publishing an unmodified draft
+ *   is a no-op.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_prbt_publish( adts_prbt_t *p_adts_prbt );
+
+void
+adts_prbt_reclaim( adts_prbt_t *p_adts_prbt );
+
+/* readers, thread safe */
+const adts_prbt_version_t *
+adts_prbt_acquire( adts_prbt_t *p_adts_prbt );
+
+void
+adts_prbt_release( const adts_prbt_version_t *p_adts_version );
+
+adts_rbt_node_t *
+adts_prbt_version_root( const adts_prbt_version_t *p_adts_version );
+
+size_t
+adts_prbt_version_entries( const adts_prbt_version_t *p_adts_version );
+
+uint64_t
+adts_prbt_version_seq( const adts_prbt_version_t *p_adts_version );
+
+int32_t
+adts_prbt_version_find( const adts_prbt_version_t  *p_adts_version,
+                        const void                 *key,
+                        void                      **pp_data );
+
+/**
+ **************************************************************************
+ * \details
+ *   All versions must have been released.
+ *
+ **************************************************************************
+ */
+void
+adts_prbt_destroy( adts_prbt_t *p_adts_prbt );
+
+adts_prbt_t *
+adts_prbt_create( void );
+
 
 /**
  **************************************************************************
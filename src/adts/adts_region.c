@@ -0,0 +1,1933 @@
+#include <stdio.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Toolbox */
+#include <adts_time.h>
+#include <adts_region.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - crash consistency, e.g. an undo log or shadow roots
+ *    - region growth via mremap() with an ftruncate() of the backing file
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+#define REGION_MAGIC       (0x314E475253544441ULL) /* "ADTSRGN1" */
+#define REGION_VERSION     (1)
+#define REGION_CLASSES     (64)
+#define REGION_HDR_BYTES   (1024)
+#define REGION_HASH_ELEMS  (64)
+#define REGION_STACK_ELEMS (64)
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Region header, resident at offset 0 of the file.  Every reference held
+ *   within the region, including the free lists, is an offset thus the
+ *   region may be mapped at any address.
+ *
+ ****************************************************************************
+ */
+typedef union {
+    struct {
+        uint64_t          magic;
+        uint32_t          version;
+        uint32_t          hdr_bytes;
+        uint64_t          bytes;   /**< region size, fixed at create */
+        uint64_t          used;    /**< bump offset */
+        uint64_t          allocs;
+        uint64_t          frees;
+        adts_region_off_t roots[ ADTS_REGION_ROOTS ];
+        adts_region_off_t free[ REGION_CLASSES ];  /**< by log2 size */
+    };
+    char pad[ REGION_HDR_BYTES ];
+} region_hdr_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Process local handle
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    char             *p_base;
+    region_hdr_t     *p_hdr;
+    size_t            bytes;
+    int32_t           fd;
+    bool              rdonly;
+    adts_mem_stats_t  mem;
+    adts_sanity_t     sanity;
+} region_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Free block, the link resides in the block itself.
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    adts_region_off_t next;
+} region_free_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    uint64_t          elems;
+    uint64_t          buckets;  /**< power of 2 */
+    uint64_t          resizes;
+    adts_region_off_t table;    /**< bucket array of node offsets */
+} region_hash_t;
+
+typedef struct {
+    adts_region_off_t next;
+    uint64_t          key;
+    uint64_t          value;
+} region_hash_node_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    adts_region_off_t head;
+    adts_region_off_t tail;
+    uint64_t          elems;
+} region_list_t;
+
+typedef struct {
+    adts_region_off_t next;
+    adts_region_off_t prev;
+    uint64_t          value;
+} region_list_node_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    uint64_t          elems;
+    uint64_t          limit;
+    adts_region_off_t array;
+} region_stack_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Unchecked offset translation for internal use, offsets originate from
+ *   the region itself.
+ *
+ ****************************************************************************
+ */
+static inline void *
+region_ptr( region_t          *p_region,
+            adts_region_off_t  off )
+{
+    assert(off < p_region->bytes);
+
+    return off ? (p_region->p_base + off) : NULL;
+} /* region_ptr() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   log2 size class, allocations never fall below ADTS_REGION_ALIGN.
+ *
+ ****************************************************************************
+ */
+static inline uint32_t
+region_class( size_t bytes )
+{
+    bytes = MAX(bytes, ADTS_REGION_ALIGN);
+
+    return 64 - __builtin_clzll(bytes - 1);
+} /* region_class() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Recycled blocks are cleared, blocks carved from the bump offset are
+ *   zero filled by the file system.  Classes are powers of 2 no smaller
+ *   than ADTS_REGION_ALIGN, thus the bump offset remains aligned.
+ *
+ ****************************************************************************
+ */
+static adts_region_off_t
+region_alloc( region_t *p_region,
+              size_t    bytes )
+{
+    uint32_t           class = 0;
+    size_t             size  = 0;
+    region_hdr_t      *p_hdr = p_region->p_hdr;
+    adts_region_off_t  off   = ADTS_REGION_NULL;
+
+    if (unlikely(p_region->rdonly || (0 == bytes) || (bytes > p_hdr->bytes))) {
+        goto exception;
+    }
+
+    class = region_class(bytes);
+    size  = 1ULL << class;
+
+    off = p_hdr->free[class];
+    if (off) {
+        region_free_t *p_free = region_ptr(p_region, off);
+
+        p_hdr->free[class] = p_free->next;
+        memset(p_free, 0, bytes);
+    }else {
+        if (unlikely(size > (p_hdr->bytes - p_hdr->used))) {
+            goto exception;
+        }
+        off          = p_hdr->used;
+        p_hdr->used += size;
+    }
+
+    p_hdr->allocs++;
+
+exception:
+    return off;
+} /* region_alloc() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+region_free( region_t          *p_region,
+             adts_region_off_t  off,
+             size_t             bytes )
+{
+    uint32_t       class  = region_class(bytes);
+    region_hdr_t  *p_hdr  = p_region->p_hdr;
+    region_free_t *p_free = NULL;
+
+    if (unlikely(p_region->rdonly || (ADTS_REGION_NULL == off))) {
+        goto exception;
+    }
+
+    p_free             = region_ptr(p_region, off);
+    p_free->next       = p_hdr->free[class];
+    p_hdr->free[class] = off;
+    p_hdr->frees++;
+
+exception:
+    return;
+} /* region_free() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_region_bytes_used( adts_region_t *p_adts_region )
+{
+    region_t *p_region = (region_t *) p_adts_region;
+
+    return p_region->p_hdr->used;
+} /* adts_region_bytes_used() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_region_bytes_reserved( adts_region_t *p_adts_region )
+{
+    region_t *p_region = (region_t *) p_adts_region;
+
+    return p_region->bytes;
+} /* adts_region_bytes_reserved() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_region_display( adts_region_t *p_adts_region )
+{
+    region_t     *p_region = (region_t *) p_adts_region;
+    region_hdr_t *p_hdr    = p_region->p_hdr;
+
+    printf("region: %p  base: %p  %s  reserved: %zu  used: %"PRIu64
+           "  allocs: %"PRIu64"  frees: %"PRIu64" \n",
+            p_region,
+            p_region->p_base,
+            p_region->rdonly ? "rdonly" : "rdwr",
+            p_region->bytes,
+            p_hdr->used,
+            p_hdr->allocs,
+            p_hdr->frees);
+
+    return;
+} /* adts_region_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Translate an offset to an address within this mapping.  NULL for
+ *   ADTS_REGION_NULL or any offset beyond the region.
+ *
+ ****************************************************************************
+ */
+void *
+adts_region_ptr( adts_region_t     *p_adts_region,
+                 adts_region_off_t  off )
+{
+    void     *p_mem    = NULL;
+    region_t *p_region = (region_t *) p_adts_region;
+
+    if (likely(off && (off < p_region->bytes))) {
+        p_mem = p_region->p_base + off;
+    }
+
+    return p_mem;
+} /* adts_region_ptr() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Translate an address within this mapping to an offset.
+ *   ADTS_REGION_NULL for NULL or any address outside the region.
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_off( adts_region_t *p_adts_region,
+                 const void    *p_mem )
+{
+    adts_region_off_t  off      = ADTS_REGION_NULL;
+    region_t          *p_region = (region_t *) p_adts_region;
+    uintptr_t          base     = (uintptr_t) p_region->p_base;
+
+    if (likely(((uintptr_t) p_mem > base) &&
+               ((uintptr_t) p_mem < (base + p_region->bytes)))) {
+        off = (uintptr_t) p_mem - base;
+    }
+
+    return off;
+} /* adts_region_off() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Zeroed, ADTS_REGION_ALIGN aligned.  ADTS_REGION_NULL when the region
+ *   is exhausted or mapped read-only.
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_alloc( adts_region_t *p_adts_region,
+                   size_t         bytes )
+{
+    adts_region_off_t  off      = ADTS_REGION_NULL;
+    region_t          *p_region = (region_t *) p_adts_region;
+    adts_sanity_t     *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+    off = region_alloc(p_region, bytes);
+    adts_sanity_exit(p_sanity);
+
+    return off;
+} /* adts_region_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   bytes must match the size requested on allocation.
+ *
+ ****************************************************************************
+ */
+void
+adts_region_free( adts_region_t     *p_adts_region,
+                  adts_region_off_t  off,
+                  size_t             bytes )
+{
+    region_t      *p_region = (region_t *) p_adts_region;
+    adts_sanity_t *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+    region_free(p_region, off, bytes);
+    adts_sanity_exit(p_sanity);
+
+    return;
+} /* adts_region_free() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_root_set( adts_region_t     *p_adts_region,
+                      size_t             idx,
+                      adts_region_off_t  off )
+{
+    int32_t        rc       = 0;
+    region_t      *p_region = (region_t *) p_adts_region;
+    adts_sanity_t *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(idx >= ADTS_REGION_ROOTS)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    p_region->p_hdr->roots[idx] = off;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_root_set() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_root_get( adts_region_t *p_adts_region,
+                      size_t         idx )
+{
+    adts_region_off_t  off      = ADTS_REGION_NULL;
+    region_t          *p_region = (region_t *) p_adts_region;
+
+    if (likely(idx < ADTS_REGION_ROOTS)) {
+        off = p_region->p_hdr->roots[idx];
+    }
+
+    return off;
+} /* adts_region_root_get() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Synchronously write back the region, a no-op if mapped read-only.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_sync( adts_region_t *p_adts_region )
+{
+    int32_t   rc       = 0;
+    region_t *p_region = (region_t *) p_adts_region;
+
+    if (p_region->rdonly) {
+        goto exception;
+    }
+
+    if (msync(p_region->p_base, p_region->bytes, MS_SYNC)) {
+        rc = errno;
+        goto exception;
+    }
+
+exception:
+    return rc;
+} /* adts_region_sync() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Unmap the region, the file persists.  Every pointer obtained via
+ *   adts_region_ptr() is invalidated, offsets remain valid.
+ *
+ ****************************************************************************
+ */
+void
+adts_region_close( adts_region_t *p_adts_region )
+{
+    region_t         *p_region = (region_t *) p_adts_region;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    munmap(p_region->p_base, p_region->bytes);
+    close(p_region->fd);
+
+    /* the record is released along with the handle */
+    mem = p_region->mem;
+    adts_mem_free_acct(&(mem), p_region, sizeof(adts_region_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_region_close() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Map an existing region.  The header is validated against the file,
+ *   NULL for a missing file, foreign file or incompatible version.
+ *
+ ****************************************************************************
+ */
+adts_region_t *
+adts_region_open( const char          *p_path,
+                  adts_region_flags_t  flags )
+{
+    int32_t           rc            = 0;
+    int32_t           fd            = -1;
+    int32_t           prot          = PROT_READ;
+    bool              rdonly        = true;
+    char             *p_base        = MAP_FAILED;
+    region_t         *p_region      = NULL;
+    region_hdr_t     *p_hdr         = NULL;
+    adts_region_t    *p_adts_region = NULL;
+    struct stat       st            = {0};
+    adts_mem_stats_t  mem           = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_REGION);
+
+    if (flags & ADTS_REGION_OPEN_RDWR) {
+        rdonly = false;
+        prot  |= PROT_WRITE;
+    }else if (0 == (flags & ADTS_REGION_OPEN_RDONLY)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    fd = open(p_path, rdonly ? O_RDONLY : O_RDWR);
+    if (fd < 0) {
+        rc = errno;
+        goto exception;
+    }
+
+    if (fstat(fd, &(st)) || (st.st_size < (off_t) sizeof(region_hdr_t))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    p_base = mmap(NULL, st.st_size, prot, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == p_base) {
+        rc = errno;
+        goto exception;
+    }
+
+    p_hdr = (region_hdr_t *) p_base;
+    if ((REGION_MAGIC != p_hdr->magic) ||
+        (REGION_VERSION != p_hdr->version) ||
+        (sizeof(region_hdr_t) != p_hdr->hdr_bytes) ||
+        ((uint64_t) st.st_size != p_hdr->bytes) ||
+        (p_hdr->used < p_hdr->hdr_bytes) ||
+        (p_hdr->used > p_hdr->bytes)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    /* a free block must lie wholly within the allocated extent */
+    for (uint32_t class = 0; class < REGION_CLASSES; class++) {
+        adts_region_off_t off = p_hdr->free[class];
+
+        if ((ADTS_REGION_NULL != off) &&
+            ((off < p_hdr->hdr_bytes) || (off >= p_hdr->used) ||
+             ((p_hdr->used - off) < (1ULL << class)))) {
+            rc = EINVAL;
+            goto exception;
+        }
+    }
+
+    p_adts_region = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_region),
+                                         ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_region) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_region         = (region_t *) p_adts_region;
+    p_region->mem    = mem;
+    p_region->p_base = p_base;
+    p_region->p_hdr  = p_hdr;
+    p_region->bytes  = st.st_size;
+    p_region->fd     = fd;
+    p_region->rdonly = rdonly;
+
+exception:
+    if (rc) {
+        CDISPLAY("%s: %s", p_path, strerror(rc));
+        if (MAP_FAILED != p_base) {
+            munmap(p_base, st.st_size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    return p_adts_region;
+} /* adts_region_open() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Create, or truncate, the backing file and map it read-write.  bytes is
+ *   rounded up to a whole number of pages, the file is sparse thus only
+ *   bytes actually allocated consume storage.
+ *
+ ****************************************************************************
+ */
+adts_region_t *
+adts_region_create( const char *p_path,
+                    size_t      bytes )
+{
+    int32_t        rc            = 0;
+    int32_t        fd            = -1;
+    size_t         page          = sysconf(_SC_PAGESIZE);
+    region_hdr_t  *p_hdr         = NULL;
+    adts_region_t *p_adts_region = NULL;
+
+    bytes = MAX(bytes, 2 * sizeof(region_hdr_t));
+    bytes = (bytes + page - 1) & ~(page - 1);
+
+    fd = open(p_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        rc = errno;
+        goto exception;
+    }
+
+    if (ftruncate(fd, bytes)) {
+        rc = errno;
+        goto exception;
+    }
+
+    p_hdr = mmap(NULL, sizeof(*p_hdr), PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, 0);
+    if (MAP_FAILED == p_hdr) {
+        rc = errno;
+        goto exception;
+    }
+
+    p_hdr->version   = REGION_VERSION;
+    p_hdr->hdr_bytes = sizeof(*p_hdr);
+    p_hdr->bytes     = bytes;
+    p_hdr->used      = sizeof(*p_hdr);
+    /* magic last, a partially initialized header is never recognized */
+    p_hdr->magic     = REGION_MAGIC;
+    munmap(p_hdr, sizeof(*p_hdr));
+
+    p_adts_region = adts_region_open(p_path, ADTS_REGION_OPEN_RDWR);
+    if (NULL == p_adts_region) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+exception:
+    if (rc) {
+        CDISPLAY("%s: %s", p_path, strerror(rc));
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    return p_adts_region;
+} /* adts_region_create() */
+
+
+
+/******************************************************************************
+ * region hash
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   splitmix64 finalizer, sequential keys are spread across every bucket.
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+region_hash_mix( uint64_t key )
+{
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+
+    return key;
+} /* region_hash_mix() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline adts_region_off_t *
+region_hash_bucket( region_t      *p_region,
+                    region_hash_t *p_hash,
+                    uint64_t       key )
+{
+    adts_region_off_t *p_table = region_ptr(p_region, p_hash->table);
+
+    return &(p_table[region_hash_mix(key) & (p_hash->buckets - 1)]);
+} /* region_hash_bucket() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Double the bucket array, nodes are relinked in place.  Failure to
+ *   allocate is benign, chains simply lengthen.
+ *
+ ****************************************************************************
+ */
+static void
+region_hash_grow( region_t      *p_region,
+                  region_hash_t *p_hash )
+{
+    uint64_t           buckets = p_hash->buckets * 2;
+    adts_region_off_t  table   = ADTS_REGION_NULL;
+    adts_region_off_t *p_old   = NULL;
+    adts_region_off_t *p_new   = NULL;
+
+    table = region_alloc(p_region, buckets * sizeof(*p_new));
+    if (unlikely(ADTS_REGION_NULL == table)) {
+        goto exception;
+    }
+
+    p_old = region_ptr(p_region, p_hash->table);
+    p_new = region_ptr(p_region, table);
+    for (uint64_t idx = 0; idx < p_hash->buckets; idx++) {
+        adts_region_off_t off = p_old[idx];
+
+        while (off) {
+            region_hash_node_t *p_node = region_ptr(p_region, off);
+            adts_region_off_t   next   = p_node->next;
+            adts_region_off_t  *p_b    = NULL;
+
+            p_b          = &(p_new[region_hash_mix(p_node->key) & (buckets - 1)]);
+            p_node->next = *p_b;
+            *p_b         = off;
+            off          = next;
+        }
+    }
+
+    region_free(p_region, p_hash->table, p_hash->buckets * sizeof(*p_old));
+    p_hash->table   = table;
+    p_hash->buckets = buckets;
+    p_hash->resizes++;
+
+exception:
+    return;
+} /* region_hash_grow() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_region_hash_elems( adts_region_t     *p_adts_region,
+                        adts_region_off_t  hash )
+{
+    region_t      *p_region = (region_t *) p_adts_region;
+    region_hash_t *p_hash   = region_ptr(p_region, hash);
+
+    return p_hash->elems;
+} /* adts_region_hash_elems() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Read-only safe.  ENOENT if the key is absent.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_hash_find( adts_region_t     *p_adts_region,
+                       adts_region_off_t  hash,
+                       uint64_t           key,
+                       uint64_t          *p_value )
+{
+    int32_t             rc       = ENOENT;
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_hash_t      *p_hash   = region_ptr(p_region, hash);
+    adts_region_off_t   off      = ADTS_REGION_NULL;
+
+    off = *region_hash_bucket(p_region, p_hash, key);
+    while (off) {
+        region_hash_node_t *p_node = region_ptr(p_region, off);
+
+        if (p_node->key == key) {
+            *p_value = p_node->value;
+            rc       = 0;
+            break;
+        }
+        off = p_node->next;
+    }
+
+    return rc;
+} /* adts_region_hash_find() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_hash_remove( adts_region_t     *p_adts_region,
+                         adts_region_off_t  hash,
+                         uint64_t           key )
+{
+    int32_t             rc       = ENOENT;
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_hash_t      *p_hash   = region_ptr(p_region, hash);
+    adts_region_off_t  *p_off    = NULL;
+    adts_sanity_t      *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    p_off = region_hash_bucket(p_region, p_hash, key);
+    while (*p_off) {
+        region_hash_node_t *p_node = region_ptr(p_region, *p_off);
+
+        if (p_node->key == key) {
+            adts_region_off_t off = *p_off;
+
+            *p_off = p_node->next;
+            region_free(p_region, off, sizeof(*p_node));
+            p_hash->elems--;
+            rc = 0;
+            break;
+        }
+        p_off = &(p_node->next);
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_hash_remove() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   EINVAL on a duplicate key, ENOMEM once the region is exhausted.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_hash_insert( adts_region_t     *p_adts_region,
+                         adts_region_off_t  hash,
+                         uint64_t           key,
+                         uint64_t           value )
+{
+    int32_t             rc       = 0;
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_hash_t      *p_hash   = region_ptr(p_region, hash);
+    region_hash_node_t *p_node   = NULL;
+    adts_region_off_t  *p_off    = NULL;
+    adts_region_off_t   off      = ADTS_REGION_NULL;
+    adts_sanity_t      *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    if (p_hash->elems >= p_hash->buckets) {
+        region_hash_grow(p_region, p_hash);
+    }
+
+    p_off = region_hash_bucket(p_region, p_hash, key);
+    for (off = *p_off; off; off = p_node->next) {
+        p_node = region_ptr(p_region, off);
+        if (unlikely(p_node->key == key)) {
+            rc = EINVAL;
+            goto exception;
+        }
+    }
+
+    off = region_alloc(p_region, sizeof(*p_node));
+    if (unlikely(ADTS_REGION_NULL == off)) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_node        = region_ptr(p_region, off);
+    p_node->key   = key;
+    p_node->value = value;
+    p_node->next  = *p_off;
+    *p_off        = off;
+    p_hash->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_hash_insert() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Releases every node and the bucket array, a no-op if read-only.
+ *
+ ****************************************************************************
+ */
+void
+adts_region_hash_destroy( adts_region_t     *p_adts_region,
+                          adts_region_off_t  hash )
+{
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_hash_t      *p_hash   = region_ptr(p_region, hash);
+    adts_region_off_t  *p_table  = NULL;
+    adts_sanity_t      *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        goto exception;
+    }
+
+    p_table = region_ptr(p_region, p_hash->table);
+    for (uint64_t idx = 0; idx < p_hash->buckets; idx++) {
+        adts_region_off_t off = p_table[idx];
+
+        while (off) {
+            region_hash_node_t *p_node = region_ptr(p_region, off);
+            adts_region_off_t   next   = p_node->next;
+
+            region_free(p_region, off, sizeof(*p_node));
+            off = next;
+        }
+    }
+
+    region_free(p_region, p_hash->table, p_hash->buckets * sizeof(*p_table));
+    region_free(p_region, hash, sizeof(*p_hash));
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_region_hash_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   elems sizes the initial bucket array, 0 selects a default.
+ *   ADTS_REGION_NULL on failure.
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_hash_create( adts_region_t *p_adts_region,
+                         size_t         elems )
+{
+    uint64_t           buckets  = REGION_HASH_ELEMS;
+    region_t          *p_region = (region_t *) p_adts_region;
+    region_hash_t     *p_hash   = NULL;
+    adts_region_off_t  hash     = ADTS_REGION_NULL;
+    adts_sanity_t     *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    while (buckets < elems) {
+        buckets *= 2;
+    }
+
+    hash = region_alloc(p_region, sizeof(*p_hash));
+    if (unlikely(ADTS_REGION_NULL == hash)) {
+        goto exception;
+    }
+
+    p_hash          = region_ptr(p_region, hash);
+    p_hash->buckets = buckets;
+    p_hash->table   = region_alloc(p_region,
+                                   buckets * sizeof(adts_region_off_t));
+    if (unlikely(ADTS_REGION_NULL == p_hash->table)) {
+        region_free(p_region, hash, sizeof(*p_hash));
+        hash = ADTS_REGION_NULL;
+        goto exception;
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return hash;
+} /* adts_region_hash_create() */
+
+
+
+/******************************************************************************
+ * region list
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_region_list_elems( adts_region_t     *p_adts_region,
+                        adts_region_off_t  list )
+{
+    region_t      *p_region = (region_t *) p_adts_region;
+    region_list_t *p_list   = region_ptr(p_region, list);
+
+    return p_list->elems;
+} /* adts_region_list_elems() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Iteration: head -> next until ADTS_REGION_NULL, node values via
+ *   adts_region_list_value().
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_list_head( adts_region_t     *p_adts_region,
+                       adts_region_off_t  list )
+{
+    region_t      *p_region = (region_t *) p_adts_region;
+    region_list_t *p_list   = region_ptr(p_region, list);
+
+    return p_list->head;
+} /* adts_region_list_head() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_list_next( adts_region_t     *p_adts_region,
+                       adts_region_off_t  node )
+{
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_list_node_t *p_node   = region_ptr(p_region, node);
+
+    return p_node->next;
+} /* adts_region_list_next() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+uint64_t
+adts_region_list_value( adts_region_t     *p_adts_region,
+                        adts_region_off_t  node )
+{
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_list_node_t *p_node   = region_ptr(p_region, node);
+
+    return p_node->value;
+} /* adts_region_list_value() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   ENOENT if empty.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_list_pop_head( adts_region_t     *p_adts_region,
+                           adts_region_off_t  list,
+                           uint64_t          *p_value )
+{
+    int32_t             rc       = 0;
+    region_t           *p_region = (region_t *) p_adts_region;
+    region_list_t      *p_list   = region_ptr(p_region, list);
+    region_list_node_t *p_node   = NULL;
+    adts_region_off_t   node     = ADTS_REGION_NULL;
+    adts_sanity_t      *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    node = p_list->head;
+    if (ADTS_REGION_NULL == node) {
+        rc = ENOENT;
+        goto exception;
+    }
+
+    p_node       = region_ptr(p_region, node);
+    *p_value     = p_node->value;
+    p_list->head = p_node->next;
+    if (p_node->next) {
+        region_list_node_t *p_next = region_ptr(p_region, p_node->next);
+
+        p_next->prev = ADTS_REGION_NULL;
+    }else {
+        p_list->tail = ADTS_REGION_NULL;
+    }
+    p_list->elems--;
+
+    region_free(p_region, node, sizeof(*p_node));
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_list_pop_head() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int32_t
+region_list_push( region_t          *p_region,
+                  adts_region_off_t  list,
+                  uint64_t           value,
+                  bool               tail )
+{
+    int32_t             rc       = 0;
+    region_list_t      *p_list   = region_ptr(p_region, list);
+    region_list_node_t *p_node   = NULL;
+    adts_region_off_t   node     = ADTS_REGION_NULL;
+    adts_sanity_t      *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    node = region_alloc(p_region, sizeof(*p_node));
+    if (unlikely(ADTS_REGION_NULL == node)) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_node        = region_ptr(p_region, node);
+    p_node->value = value;
+    if (tail) {
+        p_node->prev = p_list->tail;
+        if (p_list->tail) {
+            ((region_list_node_t *) region_ptr(p_region, p_list->tail))->next = node;
+        }else {
+            p_list->head = node;
+        }
+        p_list->tail = node;
+    }else {
+        p_node->next = p_list->head;
+        if (p_list->head) {
+            ((region_list_node_t *) region_ptr(p_region, p_list->head))->prev = node;
+        }else {
+            p_list->tail = node;
+        }
+        p_list->head = node;
+    }
+    p_list->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* region_list_push() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_list_push_tail( adts_region_t     *p_adts_region,
+                            adts_region_off_t  list,
+                            uint64_t           value )
+{
+    return region_list_push((region_t *) p_adts_region, list, value, true);
+} /* adts_region_list_push_tail() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_list_push_head( adts_region_t     *p_adts_region,
+                            adts_region_off_t  list,
+                            uint64_t           value )
+{
+    return region_list_push((region_t *) p_adts_region, list, value, false);
+} /* adts_region_list_push_head() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_region_list_destroy( adts_region_t     *p_adts_region,
+                          adts_region_off_t  list )
+{
+    region_t          *p_region = (region_t *) p_adts_region;
+    region_list_t     *p_list   = region_ptr(p_region, list);
+    adts_region_off_t  node     = ADTS_REGION_NULL;
+    adts_sanity_t     *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        goto exception;
+    }
+
+    node = p_list->head;
+    while (node) {
+        region_list_node_t *p_node = region_ptr(p_region, node);
+        adts_region_off_t   next   = p_node->next;
+
+        region_free(p_region, node, sizeof(*p_node));
+        node = next;
+    }
+
+    region_free(p_region, list, sizeof(*p_list));
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_region_list_destroy() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_list_create( adts_region_t *p_adts_region )
+{
+    region_t          *p_region = (region_t *) p_adts_region;
+    adts_region_off_t  list     = ADTS_REGION_NULL;
+    adts_sanity_t     *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+    list = region_alloc(p_region, sizeof(region_list_t));
+    adts_sanity_exit(p_sanity);
+
+    return list;
+} /* adts_region_list_create() */
+
+
+
+/******************************************************************************
+ * region stack
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_region_stack_elems( adts_region_t     *p_adts_region,
+                         adts_region_off_t  stack )
+{
+    region_t       *p_region = (region_t *) p_adts_region;
+    region_stack_t *p_stack  = region_ptr(p_region, stack);
+
+    return p_stack->elems;
+} /* adts_region_stack_elems() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Read-only safe.  ENOENT if empty.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_stack_peek( adts_region_t     *p_adts_region,
+                        adts_region_off_t  stack,
+                        uint64_t          *p_value )
+{
+    int32_t         rc       = 0;
+    region_t       *p_region = (region_t *) p_adts_region;
+    region_stack_t *p_stack  = region_ptr(p_region, stack);
+    uint64_t       *p_array  = NULL;
+
+    if (0 == p_stack->elems) {
+        rc = ENOENT;
+        goto exception;
+    }
+
+    p_array  = region_ptr(p_region, p_stack->array);
+    *p_value = p_array[p_stack->elems - 1];
+
+exception:
+    return rc;
+} /* adts_region_stack_peek() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   ENOENT if empty.  The array is not shrunk.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_stack_pop( adts_region_t     *p_adts_region,
+                       adts_region_off_t  stack,
+                       uint64_t          *p_value )
+{
+    int32_t         rc       = 0;
+    region_t       *p_region = (region_t *) p_adts_region;
+    region_stack_t *p_stack  = region_ptr(p_region, stack);
+    adts_sanity_t  *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    rc = adts_region_stack_peek(p_adts_region, stack, p_value);
+    if (0 == rc) {
+        p_stack->elems--;
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_stack_pop() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_region_stack_push( adts_region_t     *p_adts_region,
+                        adts_region_off_t  stack,
+                        uint64_t           value )
+{
+    int32_t         rc       = 0;
+    region_t       *p_region = (region_t *) p_adts_region;
+    region_stack_t *p_stack  = region_ptr(p_region, stack);
+    uint64_t       *p_array  = NULL;
+    adts_sanity_t  *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        rc = EROFS;
+        goto exception;
+    }
+
+    if (unlikely(p_stack->elems == p_stack->limit)) {
+        uint64_t          limit = p_stack->limit * 2;
+        adts_region_off_t array = ADTS_REGION_NULL;
+
+        array = region_alloc(p_region, limit * sizeof(*p_array));
+        if (unlikely(ADTS_REGION_NULL == array)) {
+            rc = ENOMEM;
+            goto exception;
+        }
+
+        memcpy(region_ptr(p_region, array),
+               region_ptr(p_region, p_stack->array),
+               p_stack->elems * sizeof(*p_array));
+        region_free(p_region, p_stack->array,
+                    p_stack->limit * sizeof(*p_array));
+        p_stack->array = array;
+        p_stack->limit = limit;
+    }
+
+    p_array = region_ptr(p_region, p_stack->array);
+    p_array[p_stack->elems++] = value;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_region_stack_push() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_region_stack_destroy( adts_region_t     *p_adts_region,
+                           adts_region_off_t  stack )
+{
+    region_t       *p_region = (region_t *) p_adts_region;
+    region_stack_t *p_stack  = region_ptr(p_region, stack);
+    adts_sanity_t  *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(p_region->rdonly)) {
+        goto exception;
+    }
+
+    region_free(p_region, p_stack->array, p_stack->limit * sizeof(uint64_t));
+    region_free(p_region, stack, sizeof(*p_stack));
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_region_stack_destroy() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+adts_region_off_t
+adts_region_stack_create( adts_region_t *p_adts_region )
+{
+    region_t          *p_region = (region_t *) p_adts_region;
+    region_stack_t    *p_stack  = NULL;
+    adts_region_off_t  stack    = ADTS_REGION_NULL;
+    adts_sanity_t     *p_sanity = &(p_region->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    stack = region_alloc(p_region, sizeof(*p_stack));
+    if (unlikely(ADTS_REGION_NULL == stack)) {
+        goto exception;
+    }
+
+    p_stack        = region_ptr(p_region, stack);
+    p_stack->limit = REGION_STACK_ELEMS;
+    p_stack->array = region_alloc(p_region,
+                                  p_stack->limit * sizeof(uint64_t));
+    if (unlikely(ADTS_REGION_NULL == p_stack->array)) {
+        region_free(p_region, stack, sizeof(*p_stack));
+        stack = ADTS_REGION_NULL;
+        goto exception;
+    }
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return stack;
+} /* adts_region_stack_create() */
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+#define UTEST_REGION_ELEMS       (1024)
+#define UTEST_REGION_BENCH_ELEMS (1024 * 1024)
+#define UTEST_REGION_BYTES       (1024 * 1024)
+
+#define UTEST_REGION_ROOT_HASH   (0)
+#define UTEST_REGION_ROOT_LIST   (1)
+#define UTEST_REGION_ROOT_STACK  (2)
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_region_bytes( void )
+{
+    CDISPLAY("[%u]", sizeof(region_t));
+    CDISPLAY("[%u]", sizeof(adts_region_t));
+
+    _Static_assert(sizeof(region_t) <= sizeof(adts_region_t),
+        "Mismatch structs detected");
+    _Static_assert(sizeof(region_hdr_t) == REGION_HDR_BYTES,
+        "Region header overflow");
+    _Static_assert(0 == (REGION_HDR_BYTES % ADTS_REGION_ALIGN),
+        "Misaligned region header");
+
+    return;
+} /* utest_region_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+utest_region_path( char   *p_path,
+                   size_t  bytes )
+{
+    snprintf(p_path, bytes, "/tmp/utest_adts_region.%d", (int) getpid());
+
+    return;
+} /* utest_region_path() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Startup cost: rebuild a hash from source data versus reopening the
+ *   region holding it.  Both are followed by a full lookup pass such that
+ *   the reopen cost includes faulting in the mapping.
+ *
+ ****************************************************************************
+ */
+static void
+utest_region_benchmark( void )
+{
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: startup, hash of %u elems",
+                UTEST_REGION_BENCH_ELEMS);
+
+        int32_t            rc       = 0;
+        uint64_t           start    = 0;
+        uint64_t           stop     = 0;
+        uint64_t           value    = 0;
+        adts_region_t     *p_region = NULL;
+        adts_region_off_t  hash     = ADTS_REGION_NULL;
+        char               path[ 64 ];
+
+        utest_region_path(path, sizeof(path));
+
+        /* rebuild: region create + insert every element */
+        start = adts_tstamp();
+        p_region = adts_region_create(path, 128 * UTEST_REGION_BENCH_ELEMS);
+        assert(p_region);
+        hash = adts_region_hash_create(p_region, UTEST_REGION_BENCH_ELEMS);
+        assert(hash);
+        for (uint64_t key = 0; key < UTEST_REGION_BENCH_ELEMS; key++) {
+            rc = adts_region_hash_insert(p_region, hash, key, ~key);
+            assert(0 == rc);
+        }
+        rc = adts_region_root_set(p_region, UTEST_REGION_ROOT_HASH, hash);
+        assert(0 == rc);
+        stop = adts_tstamp();
+        CDISPLAY("rebuild:        %llu us", (stop - start) / 1000);
+
+        start = adts_tstamp();
+        rc = adts_region_sync(p_region);
+        assert(0 == rc);
+        adts_region_close(p_region);
+        stop = adts_tstamp();
+        CDISPLAY("sync + close:   %llu us", (stop - start) / 1000);
+
+        /* reopen: first lookup */
+        start = adts_tstamp();
+        p_region = adts_region_open(path, ADTS_REGION_OPEN_RDONLY);
+        assert(p_region);
+        hash = adts_region_root_get(p_region, UTEST_REGION_ROOT_HASH);
+        rc   = adts_region_hash_find(p_region, hash, 0, &(value));
+        assert((0 == rc) && (~0ULL == value));
+        stop = adts_tstamp();
+        CDISPLAY("reopen:         %llu us", (stop - start) / 1000);
+
+        start = adts_tstamp();
+        for (uint64_t key = 0; key < UTEST_REGION_BENCH_ELEMS; key++) {
+            rc = adts_region_hash_find(p_region, hash, key, &(value));
+            assert((0 == rc) && (~key == value));
+        }
+        stop = adts_tstamp();
+        CDISPLAY("find all:       %llu us", (stop - start) / 1000);
+
+        adts_region_display(p_region);
+        adts_region_close(p_region);
+        unlink(path);
+    }
+
+    return;
+} /* utest_region_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    char path[ 64 ];
+
+    utest_region_bytes();
+    utest_region_path(path, sizeof(path));
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: alloc, free, recycle, exhaustion");
+
+        adts_region_t     *p_region = NULL;
+        adts_region_off_t  a        = ADTS_REGION_NULL;
+        adts_region_off_t  b        = ADTS_REGION_NULL;
+        size_t             used     = 0;
+        char              *p_mem    = NULL;
+
+        p_region = adts_region_create(path, UTEST_REGION_BYTES);
+        assert(p_region);
+        assert(UTEST_REGION_BYTES == adts_region_bytes_reserved(p_region));
+
+        a = adts_region_alloc(p_region, 1);
+        b = adts_region_alloc(p_region, 24);
+        assert(a && b && (a != b));
+        assert(0 == (a % ADTS_REGION_ALIGN));
+        assert(0 == (b % ADTS_REGION_ALIGN));
+        assert(ADTS_REGION_NULL == adts_region_alloc(p_region, 0));
+
+        /* offset <-> pointer */
+        p_mem = adts_region_ptr(p_region, b);
+        assert(p_mem);
+        assert(b == adts_region_off(p_region, p_mem));
+        assert(NULL == adts_region_ptr(p_region, ADTS_REGION_NULL));
+        assert(NULL == adts_region_ptr(p_region, UTEST_REGION_BYTES));
+        assert(ADTS_REGION_NULL == adts_region_off(p_region, &(p_region)));
+
+        /* same class recycled, zeroed */
+        memset(p_mem, 0xFF, 24);
+        used = adts_region_bytes_used(p_region);
+        adts_region_free(p_region, b, 24);
+        assert(b == adts_region_alloc(p_region, 32));
+        assert(0 == p_mem[0] && 0 == p_mem[23]);
+        assert(used == adts_region_bytes_used(p_region));
+
+        /* exhaustion */
+        assert(ADTS_REGION_NULL ==
+               adts_region_alloc(p_region, 2 * UTEST_REGION_BYTES));
+
+        assert(EINVAL == adts_region_root_set(p_region, ADTS_REGION_ROOTS, a));
+        assert(ADTS_REGION_NULL ==
+               adts_region_root_get(p_region, ADTS_REGION_ROOTS));
+
+        adts_region_display(p_region);
+        adts_region_close(p_region);
+        unlink(path);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: hash, list, stack persist across close -> open");
+
+        int32_t            rc       = 0;
+        uint64_t           value    = 0;
+        uint64_t           expect   = 0;
+        adts_region_t     *p_region = NULL;
+        adts_region_off_t  hash     = ADTS_REGION_NULL;
+        adts_region_off_t  list     = ADTS_REGION_NULL;
+        adts_region_off_t  stack    = ADTS_REGION_NULL;
+        adts_region_off_t  node     = ADTS_REGION_NULL;
+
+        p_region = adts_region_create(path, UTEST_REGION_BYTES);
+        assert(p_region);
+
+        hash  = adts_region_hash_create(p_region, 0);
+        list  = adts_region_list_create(p_region);
+        stack = adts_region_stack_create(p_region);
+        assert(hash && list && stack);
+
+        for (uint64_t idx = 0; idx < UTEST_REGION_ELEMS; idx++) {
+            rc = adts_region_hash_insert(p_region, hash, idx, idx * 3);
+            assert(0 == rc);
+            rc = adts_region_list_push_tail(p_region, list, idx);
+            assert(0 == rc);
+            rc = adts_region_stack_push(p_region, stack, idx);
+            assert(0 == rc);
+        }
+        assert(EINVAL == adts_region_hash_insert(p_region, hash, 7, 0));
+        assert(0 < ((region_hash_t *) adts_region_ptr(p_region, hash))->resizes);
+
+        /* odd keys removed */
+        for (uint64_t idx = 1; idx < UTEST_REGION_ELEMS; idx += 2) {
+            assert(0 == adts_region_hash_remove(p_region, hash, idx));
+        }
+        assert(ENOENT == adts_region_hash_remove(p_region, hash, 1));
+
+        rc  = adts_region_root_set(p_region, UTEST_REGION_ROOT_HASH, hash);
+        rc |= adts_region_root_set(p_region, UTEST_REGION_ROOT_LIST, list);
+        rc |= adts_region_root_set(p_region, UTEST_REGION_ROOT_STACK, stack);
+        assert(0 == rc);
+
+        assert(0 == adts_region_sync(p_region));
+        adts_region_close(p_region);
+
+        /* reopen read-only, located via roots alone */
+        p_region = adts_region_open(path, ADTS_REGION_OPEN_RDONLY);
+        assert(p_region);
+        hash  = adts_region_root_get(p_region, UTEST_REGION_ROOT_HASH);
+        list  = adts_region_root_get(p_region, UTEST_REGION_ROOT_LIST);
+        stack = adts_region_root_get(p_region, UTEST_REGION_ROOT_STACK);
+
+        assert((UTEST_REGION_ELEMS / 2) == adts_region_hash_elems(p_region, hash));
+        for (uint64_t idx = 0; idx < UTEST_REGION_ELEMS; idx++) {
+            rc = adts_region_hash_find(p_region, hash, idx, &(value));
+            if (idx & 1) {
+                assert(ENOENT == rc);
+            }else {
+                assert((0 == rc) && ((idx * 3) == value));
+            }
+        }
+
+        assert(UTEST_REGION_ELEMS == adts_region_list_elems(p_region, list));
+        expect = 0;
+        node   = adts_region_list_head(p_region, list);
+        while (node) {
+            assert(expect++ == adts_region_list_value(p_region, node));
+            node = adts_region_list_next(p_region, node);
+        }
+        assert(UTEST_REGION_ELEMS == expect);
+
+        assert(0 == adts_region_stack_peek(p_region, stack, &(value)));
+        assert((UTEST_REGION_ELEMS - 1) == value);
+
+        /* every mutation rejected */
+        assert(EROFS == adts_region_hash_insert(p_region, hash, ~0ULL, 0));
+        assert(EROFS == adts_region_hash_remove(p_region, hash, 0));
+        assert(EROFS == adts_region_list_push_head(p_region, list, 0));
+        assert(EROFS == adts_region_list_pop_head(p_region, list, &(value)));
+        assert(EROFS == adts_region_stack_push(p_region, stack, 0));
+        assert(EROFS == adts_region_stack_pop(p_region, stack, &(value)));
+        assert(EROFS == adts_region_root_set(p_region, 0, 0));
+        assert(ADTS_REGION_NULL == adts_region_alloc(p_region, 16));
+        adts_region_close(p_region);
+
+        /* reopen read-write, drain */
+        p_region = adts_region_open(path, ADTS_REGION_OPEN_RDWR);
+        assert(p_region);
+        list  = adts_region_root_get(p_region, UTEST_REGION_ROOT_LIST);
+        stack = adts_region_root_get(p_region, UTEST_REGION_ROOT_STACK);
+        hash  = adts_region_root_get(p_region, UTEST_REGION_ROOT_HASH);
+
+        rc = adts_region_list_push_head(p_region, list, ~0ULL);
+        assert(0 == rc);
+        assert(0 == adts_region_list_pop_head(p_region, list, &(value)));
+        assert(~0ULL == value);
+        for (uint64_t idx = 0; idx < UTEST_REGION_ELEMS; idx++) {
+            assert(0 == adts_region_list_pop_head(p_region, list, &(value)));
+            assert(idx == value);
+            assert(0 == adts_region_stack_pop(p_region, stack, &(value)));
+            assert((UTEST_REGION_ELEMS - 1 - idx) == value);
+        }
+        assert(ENOENT == adts_region_list_pop_head(p_region, list, &(value)));
+        assert(ENOENT == adts_region_stack_pop(p_region, stack, &(value)));
+        assert(0 == adts_region_list_elems(p_region, list));
+
+        adts_region_hash_destroy(p_region, hash);
+        adts_region_list_destroy(p_region, list);
+        adts_region_stack_destroy(p_region, stack);
+
+        adts_region_display(p_region);
+        adts_region_close(p_region);
+        unlink(path);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: position independence, concurrent mappings");
+
+        uint64_t           value  = 0;
+        adts_region_t     *p_rw   = NULL;
+        adts_region_t     *p_ro   = NULL;
+        adts_region_off_t  hash   = ADTS_REGION_NULL;
+
+        p_rw = adts_region_create(path, UTEST_REGION_BYTES);
+        assert(p_rw);
+        hash = adts_region_hash_create(p_rw, 0);
+        assert(hash);
+        assert(0 == adts_region_root_set(p_rw, UTEST_REGION_ROOT_HASH, hash));
+
+        /* a second mapping lands at a different address */
+        p_ro = adts_region_open(path, ADTS_REGION_OPEN_RDONLY);
+        assert(p_ro);
+        assert(adts_region_ptr(p_rw, hash) != adts_region_ptr(p_ro, hash));
+
+        /* shared mappings, updates are visible without a sync */
+        assert(0 == adts_region_hash_insert(p_rw, hash, 42, 4242));
+        hash = adts_region_root_get(p_ro, UTEST_REGION_ROOT_HASH);
+        assert(0 == adts_region_hash_find(p_ro, hash, 42, &(value)));
+        assert(4242 == value);
+
+        adts_region_close(p_ro);
+        adts_region_close(p_rw);
+        unlink(path);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: foreign files rejected");
+
+        int32_t        fd       = -1;
+        adts_region_t *p_region = NULL;
+        char           junk[ 2 * REGION_HDR_BYTES ];
+
+        assert(NULL == adts_region_open(path, ADTS_REGION_OPEN_RDONLY));
+        assert(NULL == adts_region_open(path, 0));
+
+        memset(junk, 0x5A, sizeof(junk));
+        fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        assert(sizeof(junk) == write(fd, junk, sizeof(junk)));
+        close(fd);
+
+        p_region = adts_region_open(path, ADTS_REGION_OPEN_RDONLY);
+        assert(NULL == p_region);
+
+        /* truncated region */
+        p_region = adts_region_create(path, UTEST_REGION_BYTES);
+        assert(p_region);
+        adts_region_close(p_region);
+        assert(0 == truncate(path, UTEST_REGION_BYTES / 2));
+        assert(NULL == adts_region_open(path, ADTS_REGION_OPEN_RDWR));
+
+        /* corrupt bump offset and free list heads */
+        {
+            region_hdr_t hdr = {0};
+
+            p_region = adts_region_create(path, UTEST_REGION_BYTES);
+            assert(p_region);
+            adts_region_close(p_region);
+
+            fd = open(path, O_RDWR);
+            assert(fd >= 0);
+            assert(sizeof(hdr) == pread(fd, &(hdr), sizeof(hdr), 0));
+
+            hdr.used = 8;
+            assert(sizeof(hdr) == pwrite(fd, &(hdr), sizeof(hdr), 0));
+            assert(NULL == adts_region_open(path, ADTS_REGION_OPEN_RDWR));
+
+            hdr.used      = hdr.hdr_bytes + 4096;
+            hdr.free[ 6 ] = 8;
+            assert(sizeof(hdr) == pwrite(fd, &(hdr), sizeof(hdr), 0));
+            assert(NULL == adts_region_open(path, ADTS_REGION_OPEN_RDWR));
+
+            hdr.free[ 6 ] = hdr.used - 32;
+            assert(sizeof(hdr) == pwrite(fd, &(hdr), sizeof(hdr), 0));
+            assert(NULL == adts_region_open(path, ADTS_REGION_OPEN_RDWR));
+
+            hdr.free[ 6 ] = hdr.used - 64;
+            assert(sizeof(hdr) == pwrite(fd, &(hdr), sizeof(hdr), 0));
+            p_region = adts_region_open(path, ADTS_REGION_OPEN_RDONLY);
+            assert(p_region);
+            adts_region_close(p_region);
+            close(fd);
+        }
+
+        unlink(path);
+    }
+
+    utest_region_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_region( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_region() */
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_REGION_BYTES (256)
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_REGION_BYTES ];
+} adts_region_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Region relative reference.  Offsets remain valid across processes and
+ *   mappings, pointers do not.  ADTS_REGION_NULL is never a valid
+ *   allocation since the region header resides at offset 0.
+ *
+ **************************************************************************
+ */
+typedef uint64_t adts_region_off_t;
+
+#define ADTS_REGION_NULL  (0)
+#define ADTS_REGION_ROOTS (16)  /**< named entry points */
+#define ADTS_REGION_ALIGN (16)
+
+
+/**
+ **************************************************************************
+ * \details
+ *   open flags
+ *     - RDONLY: mapped read-only, every mutation returns EROFS (or
+ *       ADTS_REGION_NULL).  Multiple processes may map a region read-only
+ *       concurrently.
+ *     - RDWR:   mapped shared read-write, updates are written back to the
+ *       file.  A single process may map a region read-write.
+ *
+ **************************************************************************
+ */
+#define ADTS_REGION_OPEN_RDONLY (1 << 0)
+#define ADTS_REGION_OPEN_RDWR   (1 << 1)
+typedef uint32_t adts_region_flags_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Persistent region, a file backed mapping laid out entirely in region
+ *   relative offsets such that a region built by one process is reopened
+ *   by another with zero deserialization.
+ *
+ *   - The region is sized at create time and never grows.  Allocations
+ *     are rounded up to a power of 2 and recycled through per size free
+ *     lists resident in the region itself.
+ *   - Roots are ADTS_REGION_ROOTS well known slots in the region header
+ *     through which a reopening process locates its structures.
+ *   - The region is not crash consistent, adts_region_sync() prior to
+ *     adts_region_close() is required for a durable image.  The on disk
+ *     format is native endian.
+ *   - The ADT consumer is responsible for serialization.
+ *
+ **************************************************************************
+ */
+size_t
+adts_region_bytes_used( adts_region_t *p_adts_region );
+
+size_t
+adts_region_bytes_reserved( adts_region_t *p_adts_region );
+
+void
+adts_region_display( adts_region_t *p_adts_region );
+
+void *
+adts_region_ptr( adts_region_t     *p_adts_region,
+                 adts_region_off_t  off );
+adts_region_off_t
+adts_region_off( adts_region_t *p_adts_region,
+                 const void    *p_mem );
+
+adts_region_off_t
+adts_region_alloc( adts_region_t *p_adts_region,
+                   size_t         bytes );
+void
+adts_region_free( adts_region_t     *p_adts_region,
+                  adts_region_off_t  off,
+                  size_t             bytes );
+
+int32_t
+adts_region_root_set( adts_region_t     *p_adts_region,
+                      size_t             idx,
+                      adts_region_off_t  off );
+adts_region_off_t
+adts_region_root_get( adts_region_t *p_adts_region,
+                      size_t         idx );
+
+int32_t
+adts_region_sync( adts_region_t *p_adts_region );
+
+void
+adts_region_close( adts_region_t *p_adts_region );
+
+adts_region_t *
+adts_region_open( const char          *p_path,
+                  adts_region_flags_t  flags );
+adts_region_t *
+adts_region_create( const char *p_path,
+                    size_t      bytes );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Region resident ADTs.  Each is referenced by the offset returned from
+ *   its create, typically published via adts_region_root_set().  Values
+ *   are opaque 64 bit quantities, commonly the offset of a record
+ *   allocated within the same region.
+ *
+ *   - hash:  64 bit key to value, chained, resized at a load factor of 1.
+ *            Keys are mixed internally.
+ *   - list:  doubly linked, iterated via head/next.
+ *   - stack: contiguous, grown by doubling.
+ *
+ **************************************************************************
+ */
+size_t
+adts_region_hash_elems( adts_region_t     *p_adts_region,
+                        adts_region_off_t  hash );
+int32_t
+adts_region_hash_find( adts_region_t     *p_adts_region,
+                       adts_region_off_t  hash,
+                       uint64_t           key,
+                       uint64_t          *p_value );
+int32_t
+adts_region_hash_remove( adts_region_t     *p_adts_region,
+                         adts_region_off_t  hash,
+                         uint64_t           key );
+int32_t
+adts_region_hash_insert( adts_region_t     *p_adts_region,
+                         adts_region_off_t  hash,
+                         uint64_t           key,
+                         uint64_t           value );
+void
+adts_region_hash_destroy( adts_region_t     *p_adts_region,
+                          adts_region_off_t  hash );
+adts_region_off_t
+adts_region_hash_create( adts_region_t *p_adts_region,
+                         size_t         elems );
+
+size_t
+adts_region_list_elems( adts_region_t     *p_adts_region,
+                        adts_region_off_t  list );
+adts_region_off_t
+adts_region_list_head( adts_region_t     *p_adts_region,
+                       adts_region_off_t  list );
+adts_region_off_t
+adts_region_list_next( adts_region_t     *p_adts_region,
+                       adts_region_off_t  node );
+uint64_t
+adts_region_list_value( adts_region_t     *p_adts_region,
+                        adts_region_off_t  node );
+int32_t
+adts_region_list_pop_head( adts_region_t     *p_adts_region,
+                           adts_region_off_t  list,
+                           uint64_t          *p_value );
+int32_t
+adts_region_list_push_tail( adts_region_t     *p_adts_region,
+                            adts_region_off_t  list,
+                            uint64_t           value );
+int32_t
+adts_region_list_push_head( adts_region_t     *p_adts_region,
+                            adts_region_off_t  list,
+                            uint64_t           value );
+void
+adts_region_list_destroy( adts_region_t     *p_adts_region,
+                          adts_region_off_t  list );
+adts_region_off_t
+adts_region_list_create( adts_region_t *p_adts_region );
+
+size_t
+adts_region_stack_elems( adts_region_t     *p_adts_region,
+                         adts_region_off_t  stack );
+int32_t
+adts_region_stack_peek( adts_region_t     *p_adts_region,
+                        adts_region_off_t  stack,
+                        uint64_t          *p_value );
+int32_t
+adts_region_stack_pop( adts_region_t     *p_adts_region,
+                       adts_region_off_t  stack,
+                       uint64_t          *p_value );
+int32_t
+adts_region_stack_push( adts_region_t     *p_adts_region,
+                        adts_region_off_t  stack,
+                        uint64_t           value );
+void
+adts_region_stack_destroy( adts_region_t     *p_adts_region,
+                           adts_region_off_t  stack );
+adts_region_off_t
+adts_region_stack_create( adts_region_t *p_adts_region );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_region( void );
@@ -0,0 +1,1090 @@
+
+#include <errno.h>
+#include <sched.h>   /* sched_yield() */
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Toolbox */
+#include <adts_math.h>
+#include <adts_ring.h>
+#include <adts_time.h>
+#include <adts_queue.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/*
+ ****************************************************************************
+ *  Future work items:
+ *    - multi producer claim via atomic fetch-add on the claim sequence
+ *    - pluggable wait strategies (spin, yield, futex based blocking)
+ *
+ ****************************************************************************
+ */
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Busy wait iterations prior to yielding the processor.
+ *
+ ****************************************************************************
+ */
+#define RING_CACHELINE_BYTES (64)
+#define RING_SPIN_LIMIT      (1024)
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Sequence counters are padded to a cacheline to avoid false sharing
+ *   between the producer and each of the consumers.
+ *
+ ****************************************************************************
+ */
+typedef union {
+    volatile uint64_t seq;
+    char              pad[ RING_CACHELINE_BYTES ];
+} ring_seq_t;
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Producer private state, never written by consumers.
+ *
+ ****************************************************************************
+ */
+typedef union {
+    struct {
+        uint64_t      claim;  /**< next sequence to be claimed */
+        uint64_t      gate;   /**< cached slowest consumer sequence */
+        adts_sanity_t sanity; /**< single producer detection */
+    };
+    char pad[ RING_CACHELINE_BYTES ];
+} ring_producer_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct ring_consumer_s {
+    ring_seq_t               sequence; /**< next sequence to be consumed */
+    struct ring_s           *p_ring;
+    uint64_t                 avail;    /**< cached barrier sequence */
+    size_t                   deps;
+    struct ring_consumer_s  *p_deps[ ADTS_RING_DEPS_MAX ];
+} ring_consumer_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct ring_s {
+    ring_seq_t        cursor;   /**< next sequence to be published */
+    ring_producer_t   producer;
+
+    /**< read mostly */
+    uint64_t          elems;
+    uint64_t          mask;
+    size_t            slot_bytes;
+    char             *workspace;
+    size_t            consumers;
+    ring_consumer_t  *p_consumers[ ADTS_RING_CONSUMERS_MAX ];
+    adts_mem_stats_t  mem;
+} ring_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+ring_seq_load( const ring_seq_t *p_seq )
+{
+    return __atomic_load_n(&(p_seq->seq), __ATOMIC_ACQUIRE);
+} /* ring_seq_load() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void
+ring_seq_store( ring_seq_t *p_seq,
+                uint64_t    val )
+{
+    __atomic_store_n(&(p_seq->seq), val, __ATOMIC_RELEASE);
+
+    return;
+} /* ring_seq_store() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline void
+ring_spin( size_t *p_spins )
+{
+    (*p_spins)++;
+    if (unlikely(RING_SPIN_LIMIT <= *p_spins)) {
+        *p_spins = 0;
+        sched_yield();
+    }
+
+    return;
+} /* ring_spin() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Slowest consumer sequence.  Absent consumers the producer is never
+ *   gated and the current claim sequence is returned.
+ *
+ ****************************************************************************
+ */
+static uint64_t
+ring_gate( ring_t *p_ring )
+{
+    uint64_t gate = p_ring->producer.claim;
+
+    for (size_t idx = 0; idx < p_ring->consumers; idx++) {
+        uint64_t seq = ring_seq_load(&(p_ring->p_consumers[idx]->sequence));
+
+        gate = MIN(gate, seq);
+    }
+
+    return gate;
+} /* ring_gate() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Dependency barrier: the highest sequence visible to this consumer is
+ *   bounded by the published cursor and every upstream consumer.
+ *
+ ****************************************************************************
+ */
+static uint64_t
+ring_barrier( ring_consumer_t *p_consumer )
+{
+    uint64_t avail = ring_seq_load(&(p_consumer->p_ring->cursor));
+
+    for (size_t idx = 0; idx < p_consumer->deps; idx++) {
+        uint64_t seq = ring_seq_load(&(p_consumer->p_deps[idx]->sequence));
+
+        avail = MIN(avail, seq);
+    }
+
+    return avail;
+} /* ring_barrier() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline bool
+ring_claim_ok( ring_t *p_ring,
+               size_t  elems )
+{
+    bool     rc   = true;
+    uint64_t hi   = p_ring->producer.claim + elems;
+    uint64_t wrap = 0;
+
+    if (hi <= p_ring->elems) {
+        /* first lap, no slot has been published yet */
+        goto exception;
+    }
+
+    /* sequence each consumer must have released prior to slot reuse */
+    wrap = hi - p_ring->elems;
+    if (wrap > p_ring->producer.gate) {
+        /* cached gate is stale, refresh from the consumers */
+        p_ring->producer.gate = ring_gate(p_ring);
+    }
+
+    rc = (wrap <= p_ring->producer.gate);
+
+exception:
+    return rc;
+} /* ring_claim_ok() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ring_elems( adts_ring_t *p_adts_ring )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+
+    return p_ring->elems;
+} /* adts_ring_elems() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ring_slot_bytes( adts_ring_t *p_adts_ring )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+
+    return p_ring->slot_bytes;
+} /* adts_ring_slot_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+uint64_t
+adts_ring_cursor( adts_ring_t *p_adts_ring )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+
+    return ring_seq_load(&(p_ring->cursor));
+} /* adts_ring_cursor() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_ring_display( adts_ring_t *p_adts_ring )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+
+    printf("ring: %p  elems: %llu  slot_bytes: %zu  cursor: %llu  claim: %llu \n",
+            p_ring,
+            p_ring->elems,
+            p_ring->slot_bytes,
+            ring_seq_load(&(p_ring->cursor)),
+            p_ring->producer.claim);
+
+    for (size_t idx = 0; idx < p_ring->consumers; idx++) {
+        ring_consumer_t *p_consumer = p_ring->p_consumers[idx];
+
+        printf("[%zu]  consumer: %p  sequence: %llu  deps: %zu \n",
+                idx,
+                p_consumer,
+                ring_seq_load(&(p_consumer->sequence)),
+                p_consumer->deps);
+    }
+
+    return;
+} /* adts_ring_display() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_ring_mem_stats( adts_ring_t      *p_adts_ring,
+                     adts_mem_stats_t *p_stats )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+
+    *p_stats = p_ring->mem;
+
+    return;
+} /* adts_ring_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void *
+adts_ring_slot( adts_ring_t *p_adts_ring,
+                uint64_t     seq )
+{
+    ring_t *p_ring = (ring_t *) p_adts_ring;
+    size_t  idx    = seq & p_ring->mask;
+
+    return &(p_ring->workspace[idx * p_ring->slot_bytes]);
+} /* adts_ring_slot() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Non-blocking batch claim.  EAGAIN is returned when the slowest
+ *   consumer has not released sufficient slots.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ring_try_claim( adts_ring_t *p_adts_ring,
+                     size_t       elems,
+                     uint64_t    *p_seq )
+{
+    int32_t        rc       = 0;
+    ring_t        *p_ring   = (ring_t *) p_adts_ring;
+    adts_sanity_t *p_sanity = &(p_ring->producer.sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely((0 == elems) || (elems > p_ring->elems))) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    if (false == ring_claim_ok(p_ring, elems)) {
+        rc = EAGAIN;
+        goto exception;
+    }
+
+    *p_seq                  = p_ring->producer.claim;
+    p_ring->producer.claim += elems;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ring_try_claim() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Blocking batch claim.  Returns the first sequence of the batch.
+ *
+ ****************************************************************************
+ */
+uint64_t
+adts_ring_claim( adts_ring_t *p_adts_ring,
+                 size_t       elems )
+{
+    size_t         spins    = 0;
+    uint64_t       seq      = 0;
+    ring_t        *p_ring   = (ring_t *) p_adts_ring;
+    adts_sanity_t *p_sanity = &(p_ring->producer.sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    assert(elems && (elems <= p_ring->elems));
+
+    while (false == ring_claim_ok(p_ring, elems)) {
+        ring_spin(&(spins));
+    }
+
+    seq                     = p_ring->producer.claim;
+    p_ring->producer.claim += elems;
+
+    adts_sanity_exit(p_sanity);
+    return seq;
+} /* adts_ring_claim() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Publish a previously claimed batch.  Batches must be published in
+ *   claim order.
+ *
+ ****************************************************************************
+ */
+void
+adts_ring_publish( adts_ring_t *p_adts_ring,
+                   uint64_t     seq,
+                   size_t       elems )
+{
+    ring_t        *p_ring   = (ring_t *) p_adts_ring;
+    adts_sanity_t *p_sanity = &(p_ring->producer.sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    assert(seq == p_ring->cursor.seq);
+    assert((seq + elems) <= p_ring->producer.claim);
+
+    ring_seq_store(&(p_ring->cursor), seq + elems);
+
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_ring_publish() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+uint64_t
+adts_ring_consumer_sequence( adts_ring_consumer_t *p_adts_consumer )
+{
+    ring_consumer_t *p_consumer = (ring_consumer_t *) p_adts_consumer;
+
+    return ring_seq_load(&(p_consumer->sequence));
+} /* adts_ring_consumer_sequence() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Non-blocking.  Returns the number of consecutive sequences available
+ *   starting at *p_seq, or 0 if none.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ring_consumer_poll( adts_ring_consumer_t *p_adts_consumer,
+                         uint64_t             *p_seq )
+{
+    ring_consumer_t *p_consumer = (ring_consumer_t *) p_adts_consumer;
+    uint64_t         seq        = p_consumer->sequence.seq;
+
+    if (p_consumer->avail <= seq) {
+        /* cached barrier exhausted, refresh */
+        p_consumer->avail = ring_barrier(p_consumer);
+    }
+
+    *p_seq = seq;
+
+    return p_consumer->avail - seq;
+} /* adts_ring_consumer_poll() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Blocking variant of adts_ring_consumer_poll().
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ring_consumer_wait( adts_ring_consumer_t *p_adts_consumer,
+                         uint64_t             *p_seq )
+{
+    size_t avail = 0;
+    size_t spins = 0;
+
+    for (;;) {
+        avail = adts_ring_consumer_poll(p_adts_consumer, p_seq);
+        if (likely(avail)) {
+            break;
+        }
+        ring_spin(&(spins));
+    }
+
+    return avail;
+} /* adts_ring_consumer_wait() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Release processed sequences to downstream consumers and the producer.
+ *
+ ****************************************************************************
+ */
+void
+adts_ring_consumer_release( adts_ring_consumer_t *p_adts_consumer,
+                            size_t                elems )
+{
+    ring_consumer_t *p_consumer = (ring_consumer_t *) p_adts_consumer;
+    uint64_t         seq        = p_consumer->sequence.seq + elems;
+
+    assert(seq <= p_consumer->avail);
+
+    ring_seq_store(&(p_consumer->sequence), seq);
+
+    return;
+} /* adts_ring_consumer_release() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Register a consumer with optional upstream dependencies.  Upstream
+ *   consumers must be registered before their dependents.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ring_consumer_add( adts_ring_t          *p_adts_ring,
+                        adts_ring_consumer_t *p_adts_consumer,
+                        adts_ring_consumer_t *p_deps[],
+                        size_t                deps )
+{
+    int32_t          rc         = 0;
+    uint64_t         seq        = 0;
+    ring_t          *p_ring     = (ring_t *) p_adts_ring;
+    ring_consumer_t *p_consumer = (ring_consumer_t *) p_adts_consumer;
+    adts_sanity_t   *p_sanity   = &(p_ring->producer.sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if ((ADTS_RING_CONSUMERS_MAX <= p_ring->consumers) ||
+        (ADTS_RING_DEPS_MAX < deps)) {
+        rc = ENOSPC;
+        goto exception;
+    }
+
+    memset(p_consumer, 0, sizeof(*p_consumer));
+    for (size_t idx = 0; idx < deps; idx++) {
+        ring_consumer_t *p_dep = (ring_consumer_t *) p_deps[idx];
+
+        if ((NULL == p_dep) || (p_ring != p_dep->p_ring)) {
+            /* dependency must already be registered on this ring */
+            rc = EINVAL;
+            goto exception;
+        }
+        p_consumer->p_deps[idx] = p_dep;
+    }
+
+    seq                  = ring_seq_load(&(p_ring->cursor));
+    p_consumer->p_ring   = p_ring;
+    p_consumer->deps     = deps;
+    p_consumer->avail    = seq;
+    ring_seq_store(&(p_consumer->sequence), seq);
+
+    p_ring->p_consumers[p_ring->consumers] = p_consumer;
+    p_ring->consumers++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ring_consumer_add() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_ring_destroy( adts_ring_t *p_adts_ring )
+{
+    ring_t           *p_ring   = (ring_t *) p_adts_ring;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_ring->producer.sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    adts_mem_free_acct(&(p_ring->mem), p_ring->workspace,
+                       p_ring->elems * p_ring->slot_bytes,
+                       ADTS_MEM_ALIGN_CACHELINE);
+
+    /* the record is released along with the handle */
+    mem = p_ring->mem;
+    adts_mem_free_acct(&(mem), p_ring, sizeof(adts_ring_t),
+                       ADTS_MEM_ALIGN_CACHELINE);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_ring_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   elems is rounded up to the next pow2 and slot_bytes to pointer size.
+ *
+ ****************************************************************************
+ */
+adts_ring_t *
+adts_ring_create( size_t elems,
+                  size_t slot_bytes )
+{
+    int32_t           rc          = 0;
+    size_t            bytes       = 0;
+    ring_t           *p_ring      = NULL;
+    char             *p_elems     = NULL;
+    adts_ring_t      *p_adts_ring = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_RING);
+
+    if ((0 == elems) || (UINT32_MAX < elems) || (0 == slot_bytes)) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    elems      = adts_pow2_round_up(elems);
+    slot_bytes = (slot_bytes + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    p_adts_ring = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_ring),
+                                       ADTS_MEM_ALIGN_CACHELINE);
+    if (NULL == p_adts_ring) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_ring      = (ring_t *) p_adts_ring;
+    p_ring->mem = mem;
+
+    bytes   = elems * slot_bytes;
+    p_elems = adts_mem_zalloc_acct(&(p_ring->mem), bytes,
+                                   ADTS_MEM_ALIGN_CACHELINE);
+    if (NULL == p_elems) {
+        rc = ENOMEM;
+        goto exception;
+    }
+
+    p_ring->elems      = elems;
+    p_ring->mask       = elems - 1;
+    p_ring->slot_bytes = slot_bytes;
+    p_ring->workspace  = p_elems;
+
+exception:
+    if (rc) {
+        if (p_adts_ring) {
+            mem = p_ring->mem;
+            adts_mem_free_acct(&(mem), p_adts_ring, sizeof(*p_adts_ring),
+                               ADTS_MEM_ALIGN_CACHELINE);
+            p_adts_ring = NULL;
+        }
+    }
+
+    return p_adts_ring;
+} /* adts_ring_create() */
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_ring_bytes( void )
+{
+    CDISPLAY("[%u]", sizeof(ring_t));
+    CDISPLAY("[%u]", sizeof(adts_ring_t));
+
+    _Static_assert(sizeof(ring_t) <= sizeof(adts_ring_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(ring_consumer_t));
+    CDISPLAY("[%u]", sizeof(adts_ring_consumer_t));
+
+    _Static_assert(sizeof(ring_consumer_t) <= sizeof(adts_ring_consumer_t),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_ring_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Benchmark configuration: one producer multicasting to three consumers
+ *   (logger, metrics, processor).
+ *
+ ****************************************************************************
+ */
+#define UTEST_RING_EVENTS    (1024 * 1024)
+#define UTEST_RING_ELEMS     (4096)
+#define UTEST_RING_BATCH     (64)
+#define UTEST_RING_CONSUMERS (3)
+
+typedef struct {
+    uint64_t value;
+} utest_ring_event_t;
+
+typedef struct {
+    adts_ring_t          *p_ring;
+    adts_ring_consumer_t *p_consumer;
+    uint64_t              sum;
+} utest_ring_worker_t;
+
+typedef struct {
+    pthread_mutex_t  lock;
+    adts_queue_t    *p_queue;
+    uint64_t         sum;
+} utest_queue_worker_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void *
+utest_ring_consumer( void *p_arg )
+{
+    uint64_t             seq      = 0;
+    uint64_t             consumed = 0;
+    utest_ring_worker_t *p_worker = p_arg;
+
+    while (consumed < UTEST_RING_EVENTS) {
+        size_t avail = adts_ring_consumer_wait(p_worker->p_consumer, &(seq));
+
+        for (size_t idx = 0; idx < avail; idx++) {
+            utest_ring_event_t *p_event = NULL;
+
+            p_event         = adts_ring_slot(p_worker->p_ring, seq + idx);
+            p_worker->sum  += p_event->value;
+        }
+
+        adts_ring_consumer_release(p_worker->p_consumer, avail);
+        consumed += avail;
+    }
+
+    return NULL;
+} /* utest_ring_consumer() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void *
+utest_queue_consumer( void *p_arg )
+{
+    uint64_t              consumed = 0;
+    utest_queue_worker_t *p_worker = p_arg;
+
+    while (consumed < UTEST_RING_EVENTS) {
+        void *p_data = NULL;
+
+        pthread_mutex_lock(&(p_worker->lock));
+        p_data = adts_queue_dequeue(p_worker->p_queue);
+        pthread_mutex_unlock(&(p_worker->lock));
+
+        if (NULL == p_data) {
+            sched_yield();
+            continue;
+        }
+
+        p_worker->sum += (uint64_t) p_data;
+        consumed++;
+    }
+
+    return NULL;
+} /* utest_queue_consumer() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Multicast via the ring vs. fan out into one locked adts_queue per
+ *   consumer.  Both paths deliver every event to every consumer.
+ *
+ ****************************************************************************
+ */
+static void
+utest_ring_benchmark( void )
+{
+    uint64_t expect = 0;
+
+    for (uint64_t idx = 1; idx <= UTEST_RING_EVENTS; idx++) {
+        expect += idx;
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: ring multicast, %u consumers",
+                UTEST_RING_CONSUMERS);
+
+        uint64_t              start   = 0;
+        uint64_t              stop    = 0;
+        int32_t               rc      = 0;
+        adts_ring_t          *p_ring  = NULL;
+        pthread_t             tid[ UTEST_RING_CONSUMERS ];
+        adts_ring_consumer_t  consumer[ UTEST_RING_CONSUMERS ];
+        utest_ring_worker_t   worker[ UTEST_RING_CONSUMERS ];
+
+        p_ring = adts_ring_create(UTEST_RING_ELEMS, sizeof(utest_ring_event_t));
+        assert(p_ring);
+
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            rc = adts_ring_consumer_add(p_ring, &(consumer[idx]), NULL, 0);
+            assert(0 == rc);
+
+            worker[idx].p_ring     = p_ring;
+            worker[idx].p_consumer = &(consumer[idx]);
+            worker[idx].sum        = 0;
+        }
+
+        start = adts_tstamp();
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            pthread_create(&(tid[idx]), NULL, utest_ring_consumer, &(worker[idx]));
+        }
+
+        for (uint64_t val = 1; val <= UTEST_RING_EVENTS; ) {
+            uint64_t seq = adts_ring_claim(p_ring, UTEST_RING_BATCH);
+
+            for (size_t idx = 0; idx < UTEST_RING_BATCH; idx++, val++) {
+                utest_ring_event_t *p_event = adts_ring_slot(p_ring, seq + idx);
+
+                p_event->value = val;
+            }
+            adts_ring_publish(p_ring, seq, UTEST_RING_BATCH);
+        }
+
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            pthread_join(tid[idx], NULL);
+            assert(expect == worker[idx].sum);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("events: %u  total: %llu ns  per event: %llu ns",
+                UTEST_RING_EVENTS,
+                (stop - start),
+                (stop - start) / UTEST_RING_EVENTS);
+
+        adts_ring_destroy(p_ring);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Benchmark: adts_queue fan out, %u consumers",
+                UTEST_RING_CONSUMERS);
+
+        uint64_t              start  = 0;
+        uint64_t              stop   = 0;
+        int32_t               rc     = 0;
+        pthread_t             tid[ UTEST_RING_CONSUMERS ];
+        utest_queue_worker_t  worker[ UTEST_RING_CONSUMERS ];
+
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            pthread_mutex_init(&(worker[idx].lock), NULL);
+            worker[idx].p_queue = adts_queue_create();
+            worker[idx].sum     = 0;
+            assert(worker[idx].p_queue);
+        }
+
+        start = adts_tstamp();
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            pthread_create(&(tid[idx]), NULL, utest_queue_consumer, &(worker[idx]));
+        }
+
+        for (uint64_t val = 1; val <= UTEST_RING_EVENTS; val++) {
+            for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+                pthread_mutex_lock(&(worker[idx].lock));
+                rc = adts_queue_enqueue(worker[idx].p_queue, (void *) val, 0);
+                pthread_mutex_unlock(&(worker[idx].lock));
+                assert(0 == rc);
+            }
+        }
+
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            pthread_join(tid[idx], NULL);
+            assert(expect == worker[idx].sum);
+        }
+        stop = adts_tstamp();
+
+        CDISPLAY("events: %u  total: %llu ns  per event: %llu ns",
+                UTEST_RING_EVENTS,
+                (stop - start),
+                (stop - start) / UTEST_RING_EVENTS);
+
+        for (int32_t idx = 0; idx < UTEST_RING_CONSUMERS; idx++) {
+            adts_queue_destroy(worker[idx].p_queue);
+            pthread_mutex_destroy(&(worker[idx].lock));
+        }
+    }
+
+    return;
+} /* utest_ring_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_ring_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> destroy");
+
+        adts_ring_t *p_ring = NULL;
+
+        p_ring = adts_ring_create(1000, sizeof(utest_ring_event_t));
+        assert(p_ring);
+        assert(1024 == adts_ring_elems(p_ring));
+        adts_ring_destroy(p_ring);
+
+        p_ring = adts_ring_create(0, sizeof(utest_ring_event_t));
+        assert(NULL == p_ring);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: producer gated by slowest consumer");
+
+        int32_t               rc     = 0;
+        uint64_t              seq    = 0;
+        size_t                avail  = 0;
+        adts_ring_t          *p_ring = NULL;
+        adts_ring_consumer_t  consumer[2];
+
+        p_ring = adts_ring_create(8, sizeof(utest_ring_event_t));
+        assert(p_ring);
+
+        rc = adts_ring_consumer_add(p_ring, &(consumer[0]), NULL, 0);
+        assert(0 == rc);
+        rc = adts_ring_consumer_add(p_ring, &(consumer[1]), NULL, 0);
+        assert(0 == rc);
+
+        rc = adts_ring_try_claim(p_ring, 8, &(seq));
+        assert(0 == rc);
+        assert(0 == seq);
+        adts_ring_publish(p_ring, seq, 8);
+
+        /* ring full until both consumers release */
+        rc = adts_ring_try_claim(p_ring, 1, &(seq));
+        assert(EAGAIN == rc);
+
+        avail = adts_ring_consumer_poll(&(consumer[0]), &(seq));
+        assert(8 == avail);
+        adts_ring_consumer_release(&(consumer[0]), 4);
+
+        rc = adts_ring_try_claim(p_ring, 1, &(seq));
+        assert(EAGAIN == rc);
+
+        avail = adts_ring_consumer_poll(&(consumer[1]), &(seq));
+        assert(8 == avail);
+        adts_ring_consumer_release(&(consumer[1]), 2);
+
+        rc = adts_ring_try_claim(p_ring, 2, &(seq));
+        assert(0 == rc);
+        assert(8 == seq);
+        rc = adts_ring_try_claim(p_ring, 1, &(seq));
+        assert(EAGAIN == rc);
+
+        adts_ring_display(p_ring);
+        adts_ring_destroy(p_ring);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: dependency barrier");
+
+        int32_t               rc         = 0;
+        uint64_t              seq        = 0;
+        size_t                avail      = 0;
+        adts_ring_t          *p_ring     = NULL;
+        adts_ring_consumer_t  logger     = {{0}};
+        adts_ring_consumer_t  metrics    = {{0}};
+        adts_ring_consumer_t  processor  = {{0}};
+        adts_ring_consumer_t *p_deps[]   = {&(logger), &(metrics)};
+
+        p_ring = adts_ring_create(16, sizeof(utest_ring_event_t));
+        assert(p_ring);
+
+        rc  = adts_ring_consumer_add(p_ring, &(logger), NULL, 0);
+        rc |= adts_ring_consumer_add(p_ring, &(metrics), NULL, 0);
+        rc |= adts_ring_consumer_add(p_ring, &(processor), p_deps, 2);
+        assert(0 == rc);
+
+        seq = adts_ring_claim(p_ring, 4);
+        for (size_t idx = 0; idx < 4; idx++) {
+            utest_ring_event_t *p_event = adts_ring_slot(p_ring, seq + idx);
+            p_event->value = idx;
+        }
+        adts_ring_publish(p_ring, seq, 4);
+
+        /* processor observes nothing until both upstream stages release */
+        avail = adts_ring_consumer_poll(&(processor), &(seq));
+        assert(0 == avail);
+
+        avail = adts_ring_consumer_poll(&(logger), &(seq));
+        assert(4 == avail);
+        adts_ring_consumer_release(&(logger), 4);
+
+        avail = adts_ring_consumer_poll(&(metrics), &(seq));
+        assert(4 == avail);
+        adts_ring_consumer_release(&(metrics), 3);
+
+        avail = adts_ring_consumer_poll(&(processor), &(seq));
+        assert(3 == avail);
+        assert(0 == seq);
+        adts_ring_consumer_release(&(processor), 3);
+        assert(3 == adts_ring_consumer_sequence(&(processor)));
+
+        adts_ring_display(p_ring);
+        adts_ring_destroy(p_ring);
+    }
+
+    utest_ring_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_ring( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_ring() */
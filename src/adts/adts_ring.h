@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *   The consumer handle is cacheline aligned such that each consumer
+ *   sequence counter resides on a dedicated cacheline.
+ *
+ **************************************************************************
+ */
+#define ADTS_RING_BYTES          (512)
+#define ADTS_RING_CONSUMER_BYTES (128)
+#define ADTS_RING_CONSUMERS_MAX  (8)
+#define ADTS_RING_DEPS_MAX       (4)
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+typedef struct {
+    const char reserved[ ADTS_RING_BYTES ];
+} adts_ring_t;
+
+typedef struct {
+    const char reserved[ ADTS_RING_CONSUMER_BYTES ];
+} __attribute__((aligned(64))) adts_ring_consumer_t;
+
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Single producer, multicast consumer ring (disruptor pattern).
+ *
+ *   - Slots are preallocated at create time and never copied.  The
+ *     producer claims a batch of sequences, populates the slots in place
+ *     and publishes the batch.
+ *   - Each consumer tracks its own sequence.  A consumer may depend on up
+ *     to ADTS_RING_DEPS_MAX upstream consumers, in which case it only
+ *     observes sequences already released by every upstream consumer.
+ *   - The producer is gated by the slowest consumer.
+ *
+ *   Consumers must be added prior to the first publish operation.
+ *
+ **************************************************************************
+ */
+size_t
+adts_ring_elems( adts_ring_t *p_adts_ring );
+
+size_t
+adts_ring_slot_bytes( adts_ring_t *p_adts_ring );
+
+uint64_t
+adts_ring_cursor( adts_ring_t *p_adts_ring );
+
+void
+adts_ring_display( adts_ring_t *p_adts_ring );
+
+void
+adts_ring_mem_stats( adts_ring_t      *p_adts_ring,
+                     adts_mem_stats_t *p_stats );
+
+void *
+adts_ring_slot( adts_ring_t *p_adts_ring,
+                uint64_t     seq );
+
+int32_t
+adts_ring_try_claim( adts_ring_t *p_adts_ring,
+                     size_t       elems,
+                     uint64_t    *p_seq );
+uint64_t
+adts_ring_claim( adts_ring_t *p_adts_ring,
+                 size_t       elems );
+
+void
+adts_ring_publish( adts_ring_t *p_adts_ring,
+                   uint64_t     seq,
+                   size_t       elems );
+
+uint64_t
+adts_ring_consumer_sequence( adts_ring_consumer_t *p_adts_consumer );
+
+size_t
+adts_ring_consumer_poll( adts_ring_consumer_t *p_adts_consumer,
+                         uint64_t             *p_seq );
+size_t
+adts_ring_consumer_wait( adts_ring_consumer_t *p_adts_consumer,
+                         uint64_t             *p_seq );
+void
+adts_ring_consumer_release( adts_ring_consumer_t *p_adts_consumer,
+                            size_t                elems );
+int32_t
+adts_ring_consumer_add( adts_ring_t          *p_adts_ring,
+                        adts_ring_consumer_t *p_adts_consumer,
+                        adts_ring_consumer_t *p_deps[],
+                        size_t                deps );
+void
+adts_ring_destroy( adts_ring_t *p_adts_ring );
+
+adts_ring_t *
+adts_ring_create( size_t elems,
+                  size_t slot_bytes );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_ring( void );
+
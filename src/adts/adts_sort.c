@@ -10,6 +10,7 @@
 
 /* Toolbox */
 #include <adts_sort.h>
+#include <adts_memory.h>
 #include <adts_private.h>
 #include <adts_display.h>
 
@@ -348,11 +349,13 @@ int32_t
 adts_sort_merge( int32_t arr[],
                  size_t  elems )
 {
-    int32_t  rc    = 0;
-    int32_t *p_tmp = NULL;
+    int32_t           rc    = 0;
+    int32_t          *p_tmp = NULL;
+    adts_mem_stats_t  mem   = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_SORT);
 
     /* Merge sort requires O(n) space, thus allocate here */
-    p_tmp = calloc(elems, sizeof(arr[0]));
+    p_tmp = adts_mem_zalloc_acct(&(mem), elems * sizeof(arr[0]),
+                                 ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_tmp) {
         rc = EINVAL;
         goto exception;
@@ -363,7 +366,8 @@ adts_sort_merge( int32_t arr[],
 
 exception:
     if (p_tmp) {
-        free(p_tmp);
+        adts_mem_free_acct(&(mem), p_tmp, elems * sizeof(arr[0]),
+                           ADTS_MEM_ALIGN_DEFAULT);
     }
 
     return rc;
@@ -3,11 +3,15 @@
 #include <assert.h>
 #include <string.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
 /* Toolbox */
+#include <adts_arena.h>
+#include <adts_math.h>
 #include <adts_stack.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -35,7 +39,6 @@
  *    - optional: force an error on threadhold / assupmtion violations
  *
  *    - adts_stack_create()     - simple defaults
- *    - adts_stack_create_ext() - user defined options
  *
  ****************************************************************************
  */
@@ -127,7 +130,11 @@ typedef struct {
     stack_node_t   *workspace;
     adts_sanity_t   sanity;
     stack_stats_t   stats;
-    stack_resize_t  resize;
+    stack_resize_t         resize;
+    adts_arena_t          *p_arena;  /**< optional, owns all memory */
+    adts_stack_options_t   options;
+    adts_mem_stats_t       mem;
+    bool                   embedded; /**< caller owns all memory */
 } stack_t;
 
 
@@ -271,6 +278,28 @@ stack_resize_limit( size_t            val,
 } /* stack_resize_limit() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Workspace alignment is derived from the options and size alone such
+ *   that the free path resolves the identical alignment.
+ *
+ ****************************************************************************
+ */
+static inline size_t
+stack_workspace_align( stack_t *p_stack,
+                       size_t   bytes )
+{
+    size_t align = ADTS_MEM_ALIGN_DEFAULT;
+
+    if (ADTS_STACK_OPTS_HUGEPAGE & p_stack->options) {
+        align = adts_mem_align_hugepage(bytes);
+    }
+
+    return align;
+} /* stack_workspace_align() */
+
+
 /*
  ****************************************************************************
  * \details
@@ -291,7 +320,12 @@ stack_resize( stack_t          *p_stack,
 
     /* p_tmp used to handle error case and preserve the workspace */
     bytes = limit_new * sizeof(p_stack->workspace[0]);
-    p_tmp = adts_mem_zalloc(bytes);
+    if (p_stack->p_arena) {
+        p_tmp = adts_arena_zalloc(p_stack->p_arena, bytes);
+    }else {
+        p_tmp = adts_mem_zalloc_acct(&(p_stack->mem), bytes,
+                                     stack_workspace_align(p_stack, bytes));
+    }
     if (NULL == p_tmp) {
         rc = ENOMEM;
         goto exception;
@@ -303,9 +337,13 @@ stack_resize( stack_t          *p_stack,
 
     /* Set new stack properties fast by deferring free() */
     p_old                = p_stack->workspace;
+    bytes                = p_stack->elems_limit * sizeof(p_stack->workspace[0]);
     p_stack->workspace   = p_tmp;
     p_stack->elems_limit = limit_new;
-    free(p_old);
+    if (NULL == p_stack->p_arena) {
+        adts_mem_free_acct(&(p_stack->mem), p_old, bytes,
+                           stack_workspace_align(p_stack, bytes));
+    }
 
 exception:
     return rc;
@@ -327,6 +365,12 @@ stack_resize_check_shrink( stack_t *p_stack )
     stack_resize_t    *p_resize  = &(p_stack->resize);
     stack_resize_op_t  op        = STACK_SHRINK;
 
+    if (p_stack->p_arena || p_stack->embedded) {
+        /* arena memory is not reclaimed until reset, embedded memory is
+         * fixed, shrink is futile */
+        goto exception;
+    }
+
     limit_new = stack_resize_limit(p_stack->elems_limit, op);
     if (STACK_DEFAULT_ELEMS > limit_new) {
         /* Prevent shrink to less than min stacktbl slots */
@@ -363,6 +407,12 @@ stack_resize_check_grow( stack_t *p_stack )
     stack_resize_t *p_resize = &(p_stack->resize);
 
     if (unlikely(p_stack->elems_curr == p_stack->elems_limit)) {
+        if (p_stack->embedded) {
+            /* fixed capacity */
+            rc = ENOSPC;
+            goto exception;
+        }
+
         rc = stack_resize(p_stack, STACK_GROW);
         if (rc) {
             p_resize->error++;
@@ -546,6 +596,47 @@ exception:
 } /* adts_stack_push() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Arena backed and embedded stacks report nothing, the arena or the
+ *   caller holds the memory.
+ *
+ ****************************************************************************
+ */
+void
+adts_stack_mem_stats( adts_stack_t     *p_adts_stack,
+                      adts_mem_stats_t *p_stats )
+{
+    stack_t *p_stack = (stack_t *) p_adts_stack;
+
+    *p_stats = p_stack->mem;
+
+    return;
+} /* adts_stack_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_stack_hugepage_bytes( adts_stack_t *p_adts_stack )
+{
+    stack_t *p_stack = (stack_t *) p_adts_stack;
+    size_t   bytes   = p_stack->elems_limit * sizeof(p_stack->workspace[0]);
+    size_t   huge    = 0;
+
+    if ((NULL == p_stack->p_arena) && (false == p_stack->embedded) &&
+        (ADTS_MEM_ALIGN_HUGEPAGE == stack_workspace_align(p_stack, bytes))) {
+        huge = adts_mem_hugepage_bytes(p_stack->workspace, bytes);
+    }
+
+    return huge;
+} /* adts_stack_hugepage_bytes() */
+
+
 /*
  ****************************************************************************
  *
@@ -554,13 +645,23 @@ exception:
 void
 adts_stack_destroy( adts_stack_t *p_adts_stack )
 {
-    stack_t       *p_stack  = (stack_t *) p_adts_stack;
-    adts_sanity_t *p_sanity = &(p_stack->sanity);
+    stack_t          *p_stack  = (stack_t *) p_adts_stack;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_stack->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    free(p_stack->workspace);
-    free(p_stack);
+    if ((NULL == p_stack->p_arena) && (false == p_stack->embedded)) {
+        size_t bytes = p_stack->elems_limit * sizeof(p_stack->workspace[0]);
+
+        adts_mem_free_acct(&(p_stack->mem), p_stack->workspace, bytes,
+                           stack_workspace_align(p_stack, bytes));
+
+        /* the record is released along with the handle */
+        mem = p_stack->mem;
+        adts_mem_free_acct(&(mem), p_stack, sizeof(adts_stack_t),
+                           ADTS_MEM_ALIGN_DEFAULT);
+    }
 
     /* No adts_sanity_exit() since we've freed the memory */
 
@@ -571,48 +672,167 @@ adts_stack_destroy( adts_stack_t *p_adts_stack )
 /*
  ****************************************************************************
  *
- *
  ****************************************************************************
  */
-adts_stack_t *
-adts_stack_create( void )
+static adts_stack_t *
+stack_create( adts_arena_t         *p_arena,
+              adts_stack_options_t  options )
 {
-    int32_t       rc           = 0;
-    stack_t      *p_stack      = NULL;
-    const size_t  elems        = STACK_DEFAULT_ELEMS;
-    stack_node_t *p_elems      = NULL;
-    adts_stack_t *p_adts_stack = NULL;
-
-    p_adts_stack = adts_mem_zalloc(sizeof(*p_adts_stack));
+    int32_t           rc           = 0;
+    stack_t          *p_stack      = NULL;
+    const size_t      elems        = STACK_DEFAULT_ELEMS;
+    const size_t      bytes        = elems * sizeof(p_stack->workspace[0]);
+    stack_node_t     *p_elems      = NULL;
+    adts_stack_t     *p_adts_stack = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_STACK);
+
+    if (p_arena) {
+        p_adts_stack = adts_arena_zalloc(p_arena, sizeof(*p_adts_stack));
+    }else {
+        p_adts_stack = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_stack),
+                                            ADTS_MEM_ALIGN_DEFAULT);
+    }
     if (NULL == p_adts_stack) {
         rc = ENOMEM;
         goto exception;
     }
 
-    p_elems = adts_mem_zalloc(elems * sizeof(*p_elems));
+    p_stack          = (stack_t *) p_adts_stack;
+    p_stack->p_arena = p_arena;
+    p_stack->options = options;
+    p_stack->mem     = mem;
+
+    if (p_arena) {
+        p_elems = adts_arena_zalloc(p_arena, bytes);
+    }else {
+        p_elems = adts_mem_zalloc_acct(&(p_stack->mem), bytes,
+                                       stack_workspace_align(p_stack, bytes));
+    }
     if (NULL == p_elems) {
         rc = ENOMEM;
         goto exception;
     }
 
-    p_stack              = (stack_t *) p_adts_stack;
     p_stack->workspace   = p_elems;
     p_stack->elems_limit = elems;
 
 exception:
     if (rc) {
-        if (p_elems) {
-            free(p_elems);
-			p_elems = NULL;
+        if (p_stack && (NULL == p_arena)) {
+            /* arena memory is reclaimed on reset */
+            mem = p_stack->mem;
+            adts_mem_free_acct(&(mem), p_adts_stack, sizeof(*p_adts_stack),
+                               ADTS_MEM_ALIGN_DEFAULT);
         }
+        p_adts_stack = NULL;
+    }
 
-        if (p_adts_stack) {
-            free(p_adts_stack);
-			p_adts_stack = NULL;
-        }
+    return p_adts_stack;
+} /* stack_create() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Bytes required for an embedded stack of the given capacity.
+ *
+ ****************************************************************************
+ */
+size_t
+adts_stack_embedded_bytes( size_t elems )
+{
+    return sizeof(adts_stack_t) + (elems * sizeof(stack_node_t));
+} /* adts_stack_embedded_bytes() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The handle and workspace reside in the caller's memory and the
+ *   allocator is never called.  Capacity is derived from bytes, a push to
+ *   a full stack returns ENOSPC.  p_mem must be 8B aligned and hold at
+ *   least one element, otherwise NULL.  Destroy releases nothing.
+ *
+ ****************************************************************************
+ */
+adts_stack_t *
+adts_stack_create_embedded( void   *p_mem,
+                            size_t  bytes )
+{
+    stack_t          *p_stack      = NULL;
+    adts_stack_t     *p_adts_stack = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_STACK);
+
+    if ((NULL == p_mem) || ((uintptr_t) p_mem & 0x7) ||
+        (bytes < adts_stack_embedded_bytes(1))) {
+        goto exception;
+    }
+
+    p_adts_stack = p_mem;
+    memset(p_adts_stack, 0, sizeof(*p_adts_stack));
+
+    p_stack              = (stack_t *) p_adts_stack;
+    p_stack->embedded    = true;
+    p_stack->mem         = mem;
+    p_stack->workspace   = (stack_node_t *) (p_adts_stack + 1);
+    p_stack->elems_limit = bytes - sizeof(*p_adts_stack);
+    p_stack->elems_limit = p_stack->elems_limit / sizeof(stack_node_t);
+
+exception:
+    return p_adts_stack;
+} /* adts_stack_create_embedded() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   All memory is sourced from the arena, destroy is O(1) and the memory is
+ *   reclaimed on arena reset.  The workspace never shrinks.
+ *
+ ****************************************************************************
+ */
+adts_stack_t *
+adts_stack_create_arena( adts_arena_t *p_arena )
+{
+    adts_stack_t *p_adts_stack = NULL;
+
+    if (p_arena) {
+        p_adts_stack = stack_create(p_arena, ADTS_STACK_OPTS_NONE);
     }
 
     return p_adts_stack;
+} /* adts_stack_create_arena() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+adts_stack_t *
+adts_stack_create_ext( const adts_stack_create_t *p_op )
+{
+    adts_stack_t *p_adts_stack = NULL;
+
+    if (p_op && (0 == (~(ADTS_STACK_OPTS_HUGEPAGE) & p_op->options))) {
+        p_adts_stack = stack_create(NULL, p_op->options);
+    }
+
+    return p_adts_stack;
+} /* adts_stack_create_ext() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+adts_stack_t *
+adts_stack_create( void )
+{
+    return stack_create(NULL, ADTS_STACK_OPTS_NONE);
 } /* adts_stack_create() */
 
 
@@ -747,6 +967,44 @@ utest_control( void )
         adts_stack_destroy(p_stack);
     }
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: embedded, fixed capacity, no allocation");
+
+        uint64_t          arr[ 128 ];
+        size_t            limit   = 0;
+        adts_stack_t     *p_stack = NULL;
+        adts_mem_stats_t  before  = {0};
+        adts_mem_stats_t  after   = {0};
+
+        assert(NULL == adts_stack_create_embedded(arr, sizeof(adts_stack_t)));
+        assert(NULL == adts_stack_create_embedded((char *) arr + 4,
+                                                  sizeof(arr) - 4));
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_STACK, &(before));
+        p_stack = adts_stack_create_embedded(arr, sizeof(arr));
+        assert((void *) p_stack == (void *) arr);
+
+        limit = (sizeof(arr) - sizeof(adts_stack_t)) / sizeof(stack_node_t);
+        assert(adts_stack_embedded_bytes(limit) <= sizeof(arr));
+        for (uintptr_t idx = 1; idx <= limit; idx++) {
+            assert(0 == adts_stack_push(p_stack, (void *) idx, 0));
+        }
+        assert(ENOSPC == adts_stack_push(p_stack, NULL, 0));
+        assert(limit == adts_stack_entries(p_stack));
+
+        for (uintptr_t idx = limit; idx >= 1; idx--) {
+            assert(idx == (uintptr_t) adts_stack_pop(p_stack));
+        }
+        assert(adts_stack_is_empty(p_stack));
+        assert(0 == adts_stack_push(p_stack, NULL, 0));
+
+        adts_stack_destroy(p_stack);
+        adts_mem_stats_type(ADTS_MEM_TYPE_STACK, &(after));
+        assert(before.allocs == after.allocs);
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
     return;
 } /* utest_control() */
 
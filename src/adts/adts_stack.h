@@ -3,6 +3,8 @@
 #include <string.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <adts_arena.h>
+#include <adts_memory.h>
 #include <adts_snapshot.h>
 
 
@@ -12,7 +14,7 @@
  *
  **************************************************************************
  */
-#define ADTS_STACK_BYTES (128)
+#define ADTS_STACK_BYTES (512)
 
 
 /**
@@ -26,6 +28,24 @@ typedef struct {
 } adts_stack_t;
 
 
+/**
+ **************************************************************************
+ * \details
+ *   stack create options
+ *     - HUGEPAGE: place the workspace in huge page backed memory once it
+ *       spans a huge page, see adts_mem_align_hugepage().
+ *
+ **************************************************************************
+ */
+#define ADTS_STACK_OPTS_NONE          (0) /**< Default */
+#define ADTS_STACK_OPTS_HUGEPAGE (1 << 1)
+typedef uint64_t adts_stack_options_t;
+
+typedef struct {
+    adts_stack_options_t options; /**< options bitfield */
+} adts_stack_create_t;
+
+
 
 /**
  **************************************************************************
@@ -59,6 +79,12 @@ void
 adts_stack_display_worker( adts_stack_t   *p_adts_stack,
                            char            *p_msg,
                            adts_snapshot_t *p_snap );
+void
+adts_stack_mem_stats( adts_stack_t     *p_adts_stack,
+                      adts_mem_stats_t *p_stats );
+size_t
+adts_stack_hugepage_bytes( adts_stack_t *p_adts_stack );
+
 bool
 adts_stack_is_empty( adts_stack_t *p_adts_stack );
 
@@ -82,6 +108,19 @@ adts_stack_push( adts_stack_t *p_adts_stack,
 void
 adts_stack_destroy( adts_stack_t *p_adts_stack );
 
+size_t
+adts_stack_embedded_bytes( size_t elems );
+
+adts_stack_t *
+adts_stack_create_embedded( void   *p_mem,
+                            size_t  bytes );
+
+adts_stack_t *
+adts_stack_create_arena( adts_arena_t *p_arena );
+
+adts_stack_t *
+adts_stack_create_ext( const adts_stack_create_t *p_op );
+
 adts_stack_t *
 adts_stack_create( void );
 
@@ -1,11 +1,13 @@
 
 #include <time.h>  /* clock_gettime() */
 #include <errno.h>
+#include <assert.h>
 #include <string.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_time.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -97,7 +99,7 @@ adts_tstamp( void )
     struct timespec *p_ts   = &(ts);
 
     clock_gettime(CLOCK_MONOTONIC_RAW, p_ts);
-    tsval = p_ts->tv_sec + p_ts->tv_nsec;
+    tsval = (p_ts->tv_sec * 1000000000ULL) + p_ts->tv_nsec;
 
     return tsval;
 } /* adts_tstamp() */
@@ -113,18 +115,20 @@ adts_tstamp( void )
 void
 adts_tstamp_destroy( adts_time_t *p_adts_time )
 {
-    size_t        bytes        = 0;
-    tstamp_mgr_t *p_tstamp_mgr = (tstamp_mgr_t *) p_adts_time;
+    tstamp_mgr_t     *p_tstamp_mgr = (tstamp_mgr_t *) p_adts_time;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_TIME);
+    adts_sanity_t    *p_sanity     = &(p_tstamp_mgr->sanity);
 
-    adts_sanity_t *p_sanity = &(p_tstamp_mgr->sanity);
-
-/*
     adts_sanity_entry(p_sanity);
 
-    bytes = sizeof(*p_tstamp_mgr);
-    memset(p_tstamp_mgr, 0, bytes);
-    free(p_tstamp_mgr);
-*/
+    /*
+     * tstamp_mgr_t fills its handle and carries no instance record, only
+     * the per type totals are accounted.
+     */
+    mem.bytes_curr = sizeof(adts_time_t);
+    adts_mem_free_acct(&(mem), p_tstamp_mgr, sizeof(adts_time_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
     /* No adts_sanity_exit() since we've freed the memory */
 
     return;
@@ -141,11 +145,13 @@ adts_tstamp_destroy( adts_time_t *p_adts_time )
 adts_time_t *
 adts_tstamp_create( void )
 {
-    int32_t        rc           = 0;
-    adts_time_t   *p_adts_time  = NULL;
-    tstamp_mgr_t  *p_tstamp_mgr = NULL;
+    int32_t           rc           = 0;
+    adts_time_t      *p_adts_time  = NULL;
+    tstamp_mgr_t     *p_tstamp_mgr = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_TIME);
 
-    p_adts_time = adts_mem_zalloc(sizeof(*p_adts_time));
+    p_adts_time = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_time),
+                                       ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_adts_time) {
         rc = ENOMEM;
         goto exception;
@@ -25,6 +25,16 @@ typedef struct {
 
 
 
+/**
+ **************************************************************************
+ * \details
+ *   Monotonic timestamp in nanoseconds
+ *
+ **************************************************************************
+ */
+uint64_t
+adts_tstamp( void );
+
 void
 utest_adts_time( void );
 
@@ -5,12 +5,13 @@
 #include <string.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
 /* Toolbox */
 #include <adts_tree.h>
-#include <adts_stack.h>
-#include <adts_queue.h>
+#include <adts_time.h>
+#include <adts_memory.h>
 #include <adts_sanity.h>
 #include <adts_private.h>
 #include <adts_display.h>
@@ -39,9 +40,15 @@ typedef struct tree_node_s {
     struct tree_s      *p_tree;
     struct tree_node_s *p_left;
     struct tree_node_s *p_right;
-    size_t              balance;
+    size_t              height;  /**< leaf is 1 */
 } tree_node_t;
 
+/*
+ * AVL height is bounded by 1.44 * log2(n + 2), thus 96 levels exceeds any
+ * tree addressable in memory.
+ */
+#define TREE_HEIGHT_MAX (96)
+
 
 /**
  **************************************************************************
@@ -54,9 +61,28 @@ typedef struct tree_s {
     tree_node_t      *p_root;
     adts_sanity_t     sanity;
     adts_tree_type_t  type;
+    adts_tree_cmp_t   cmp;
+    adts_mem_stats_t  mem;
 } tree_t;
 
 
+/**
+ **************************************************************************
+ * \details
+ *   The path top is the node under the cursor, see tree_iter_init().
+ *
+ *************************************************************************
+ */
+typedef struct {
+    tree_node_t            *a_path[ TREE_HEIGHT_MAX ];
+    tree_node_t            *p_root;
+    uint32_t                depth;
+    uint32_t                level;  /**< level order, depth visited */
+    adts_tree_iter_order_t  order;
+    bool                    more;   /**< level order, a deeper level exists */
+} tree_iter_t;
+
+
 
 /******************************************************************************
  * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
@@ -91,38 +117,268 @@ tree_node_display( tree_node_t *p_node )
 
 /**
  **************************************************************************
+ * \details
+ *   Default ordering is p_data as a signed integer.
  *
  *************************************************************************
  */
-void
-adts_tree_display_preorder( adts_tree_node_t *p_adts_tree_node )
+static inline int32_t
+tree_cmp( const tree_t *p_tree,
+          const void   *p_a,
+          const void   *p_b )
 {
-    assert(p_adts_tree_node);
+    if (p_tree->cmp) {
+        return p_tree->cmp(p_a, p_b);
+    }
 
-    tree_node_t   *p_node   = (tree_node_t *) p_adts_tree_node;
-    tree_t        *p_tree   = p_node->p_tree;
-    adts_stack_t  *p_stack  = adts_stack_create();
-    adts_sanity_t *p_sanity = &(p_tree->sanity);
+    return ((int64_t) p_a > (int64_t) p_b) - ((int64_t) p_a < (int64_t) p_b);
+} /* tree_cmp() */
 
-    //adts_sanity_entry(p_sanity);
 
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            tree_node_display(p_node);
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            p_node = (tree_node_t *) adts_stack_pop(p_stack);
-            p_node = p_node->p_right;
+/**
+ **************************************************************************
+ * \details
+ *   In-order, push p_node and its leftmost descendants, or rightmost when
+ *   descending.  The path top is the node under the cursor and below it
+ *   the ancestors yet to be visited.
+ *
+ *************************************************************************
+ */
+static inline void
+tree_iter_push_edge( tree_iter_t *p_iter,
+                     tree_node_t *p_node,
+                     bool         reverse )
+{
+    while (p_node) {
+        p_iter->a_path[p_iter->depth++] = p_node;
+        p_node = (reverse) ? p_node->p_right : p_node->p_left;
+    }
+
+    return;
+} /* tree_iter_push_edge() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Post-order, push p_node and descend to the first leaf, preferring the
+ *   left child.  The path is the root to leaf path.
+ *
+ *************************************************************************
+ */
+static inline void
+tree_iter_push_leaf( tree_iter_t *p_iter,
+                     tree_node_t *p_node )
+{
+    while (p_node) {
+        p_iter->a_path[p_iter->depth++] = p_node;
+        p_node = (p_node->p_left) ? p_node->p_left : p_node->p_right;
+    }
+
+    return;
+} /* tree_iter_push_leaf() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Level order, depth first search for the next node at depth level,
+ *   resuming from the path top having returned from its child p_up, NULL
+ *   on first arrival.  The path is the root to node path.
+ *
+ *************************************************************************
+ */
+static tree_node_t *
+tree_iter_level_scan( tree_iter_t *p_iter,
+                      tree_node_t *p_up )
+{
+    tree_node_t *p_top  = NULL;
+    tree_node_t *p_next = NULL;
+
+    while (p_iter->depth) {
+        p_top  = p_iter->a_path[p_iter->depth - 1];
+        p_next = NULL;
+
+        if (NULL == p_up) {
+            if ((p_iter->depth - 1) == p_iter->level) {
+                p_iter->more |= (p_top->p_left || p_top->p_right);
+                return p_top;
+            }
+            p_next = (p_top->p_left) ? p_top->p_left : p_top->p_right;
+        } else if (p_up == p_top->p_left) {
+            p_next = p_top->p_right;
         }
+
+        if (p_next) {
+            p_iter->a_path[p_iter->depth++] = p_next;
+            p_up = NULL;
+        } else {
+            p_up = p_top;
+            p_iter->depth--;
+        }
+    }
+
+    return NULL;
+} /* tree_iter_level_scan() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Next level down, while the level just completed had children.
+ *
+ *************************************************************************
+ */
+static tree_node_t *
+tree_iter_level_descend( tree_iter_t *p_iter )
+{
+    tree_node_t *p_node = NULL;
+
+    while ((NULL == p_node) && p_iter->more) {
+        p_iter->more  = false;
+        p_iter->level++;
+        p_iter->depth = 0;
+        p_iter->a_path[p_iter->depth++] = p_iter->p_root;
+        p_node = tree_iter_level_scan(p_iter, NULL);
+    }
+
+    return p_node;
+} /* tree_iter_level_descend() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static inline tree_node_t *
+tree_iter_curr( const tree_iter_t *p_iter )
+{
+    return (p_iter->depth) ? p_iter->a_path[p_iter->depth - 1] : NULL;
+} /* tree_iter_curr() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Iterate the subtree at p_root, which need not be a tree root.
+ *
+ *************************************************************************
+ */
+static tree_node_t *
+tree_iter_init( tree_iter_t            *p_iter,
+                tree_node_t            *p_root,
+                adts_tree_iter_order_t  order )
+{
+    p_iter->p_root = p_root;
+    p_iter->depth  = 0;
+    p_iter->level  = 0;
+    p_iter->order  = order;
+    p_iter->more   = false;
+
+    if (NULL == p_root) {
+        goto exception;
+    }
+
+    switch (order) {
+        case ADTS_TREE_ITER_INORDER:
+            tree_iter_push_edge(p_iter, p_root, false);
+            break;
+        case ADTS_TREE_ITER_REVERSE:
+            tree_iter_push_edge(p_iter, p_root, true);
+            break;
+        case ADTS_TREE_ITER_PREORDER:
+            p_iter->a_path[p_iter->depth++] = p_root;
+            break;
+        case ADTS_TREE_ITER_POSTORDER:
+            tree_iter_push_leaf(p_iter, p_root);
+            break;
+        case ADTS_TREE_ITER_LEVEL:
+            p_iter->a_path[p_iter->depth++] = p_root;
+            (void) tree_iter_level_scan(p_iter, NULL);
+            break;
+        default:
+            break;
     }
 
 exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    return tree_iter_curr(p_iter);
+} /* tree_iter_init() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static tree_node_t *
+tree_iter_next( tree_iter_t *p_iter )
+{
+    tree_node_t *p_node = NULL;
+    tree_node_t *p_top  = NULL;
+
+    if (unlikely(0 == p_iter->depth)) {
+        goto exception;
+    }
+
+    p_node = p_iter->a_path[--p_iter->depth];
+
+    switch (p_iter->order) {
+        case ADTS_TREE_ITER_INORDER:
+            tree_iter_push_edge(p_iter, p_node->p_right, false);
+            break;
+        case ADTS_TREE_ITER_REVERSE:
+            tree_iter_push_edge(p_iter, p_node->p_left, true);
+            break;
+        case ADTS_TREE_ITER_PREORDER:
+            /* pending right subtrees beneath, left on top */
+            if (p_node->p_right) {
+                p_iter->a_path[p_iter->depth++] = p_node->p_right;
+            }
+            if (p_node->p_left) {
+                p_iter->a_path[p_iter->depth++] = p_node->p_left;
+            }
+            break;
+        case ADTS_TREE_ITER_POSTORDER:
+            p_top = tree_iter_curr(p_iter);
+            if (p_top && (p_node == p_top->p_left)) {
+                tree_iter_push_leaf(p_iter, p_top->p_right);
+            }
+            break;
+        case ADTS_TREE_ITER_LEVEL:
+            if (NULL == tree_iter_level_scan(p_iter, p_node)) {
+                (void) tree_iter_level_descend(p_iter);
+            }
+            break;
+        default:
+            break;
+    }
+
+exception:
+    return tree_iter_curr(p_iter);
+} /* tree_iter_next() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+void
+adts_tree_display_preorder( adts_tree_node_t *p_adts_tree_node )
+{
+    assert(p_adts_tree_node);
+
+    tree_iter_t  iter;
+    tree_node_t *p_node = NULL;
+
+    for (p_node = tree_iter_init(&(iter), (tree_node_t *) p_adts_tree_node,
+                                 ADTS_TREE_ITER_PREORDER);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
+        tree_node_display(p_node);
     }
 
-    //adts_sanity_exit(p_sanity);
     return;
 } /* adts_tree_display_preorder() */
 
@@ -137,30 +393,16 @@ adts_tree_display_inorder( adts_tree_node_t *p_adts_tree_node )
 {
     assert(p_adts_tree_node);
 
-    tree_node_t   *p_node   = (tree_node_t *) p_adts_tree_node;
-    tree_t        *p_tree   = p_node->p_tree;
-    adts_stack_t  *p_stack  = adts_stack_create();
-    adts_sanity_t *p_sanity = &(p_tree->sanity);
-
-    //adts_sanity_entry(p_sanity);
-
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            p_node = (tree_node_t *) adts_stack_pop(p_stack);
-            tree_node_display(p_node);
-            p_node = p_node->p_right;
-        }
-    }
+    tree_iter_t  iter;
+    tree_node_t *p_node = NULL;
 
-exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    for (p_node = tree_iter_init(&(iter), (tree_node_t *) p_adts_tree_node,
+                                 ADTS_TREE_ITER_INORDER);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
+        tree_node_display(p_node);
     }
 
-    //adts_sanity_exit(p_sanity);
     return;
 } /* adts_tree_display_inorder() */
 
@@ -175,42 +417,16 @@ adts_tree_display_postorder( adts_tree_node_t *p_adts_tree_node )
 {
     assert(p_adts_tree_node);
 
-    tree_node_t   *p_node   = (tree_node_t *) p_adts_tree_node;
-    tree_node_t   *p_last   = NULL;
-    tree_t        *p_tree   = p_node->p_tree;
-    adts_stack_t  *p_stack  = adts_stack_create();
-    adts_sanity_t *p_sanity = &(p_tree->sanity);
-
-    //adts_sanity_entry(p_sanity);
-
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            tree_node_t *p_peek = NULL;
-
-            /* If last node processed was not p_right, then process p_right. */
-            p_peek = (tree_node_t *) adts_stack_peek(p_stack);
-            if (p_peek->p_right && (p_peek->p_right != p_last)) {
-                p_node = p_peek->p_right;
-            }else {
-                /* Pop and discard since we already have the node pointer via
-                 * p_peek.  We cannot use p_node since ir has a predefined
-                 * meaning in this loop. */
-                (void) adts_stack_pop(p_stack);
-                tree_node_display(p_peek);
-                p_last = p_peek;
-            }
-        }
-    }
+    tree_iter_t  iter;
+    tree_node_t *p_node = NULL;
 
-exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
+    for (p_node = tree_iter_init(&(iter), (tree_node_t *) p_adts_tree_node,
+                                 ADTS_TREE_ITER_POSTORDER);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
+        tree_node_display(p_node);
     }
 
-    //adts_sanity_exit(p_sanity);
     return;
 } /* adts_tree_display_postorder() */
 
@@ -225,40 +441,94 @@ adts_tree_display_level( adts_tree_node_t *p_adts_tree_node )
 {
     assert(p_adts_tree_node);
 
-    tree_node_t   *p_node   = (tree_node_t *) p_adts_tree_node;
-    tree_t        *p_tree   = p_node->p_tree;
-    adts_queue_t  *p_queue  = adts_queue_create();
-    adts_sanity_t *p_sanity = &(p_tree->sanity);
+    tree_iter_t  iter;
+    tree_node_t *p_node = NULL;
 
-    //adts_sanity_entry(p_sanity);
+    for (p_node = tree_iter_init(&(iter), (tree_node_t *) p_adts_tree_node,
+                                 ADTS_TREE_ITER_LEVEL);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
+        tree_node_display(p_node);
+    }
 
-    while (p_node) {
+    return;
+} /* adts_tree_display_level() */
 
-        tree_node_display(p_node);
 
-        if (p_node->p_left) {
-            adts_queue_enqueue(p_queue,
-                    p_node->p_left, sizeof(*(p_node->p_left)));
-        }
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_iter_begin( adts_tree_t            *p_adts_tree,
+                      adts_tree_iter_t       *p_adts_iter,
+                      adts_tree_iter_order_t  order )
+{
+    tree_t      *p_tree = (tree_t *) p_adts_tree;
+    tree_iter_t *p_iter = (tree_iter_t *) p_adts_iter;
 
-        if (p_node->p_right) {
-            adts_queue_enqueue(p_queue,
-                    p_node->p_right, sizeof(*(p_node->p_right)));
-        }
+    return (adts_tree_node_t *) tree_iter_init(p_iter, p_tree->p_root, order);
+} /* adts_tree_iter_begin() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Descend toward p_key retaining only the ancestors yet to be visited,
+ *   those left of the descent for ascending order, right for descending.
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_iter_seek( adts_tree_t            *p_adts_tree,
+                     adts_tree_iter_t       *p_adts_iter,
+                     adts_tree_iter_order_t  order,
+                     const void             *p_key )
+{
+    int32_t      cmp    = 0;
+    int32_t      sign   = (ADTS_TREE_ITER_REVERSE == order) ? -1 : 1;
+    tree_t      *p_tree = (tree_t *) p_adts_tree;
+    tree_node_t *p_node = p_tree->p_root;
+    tree_iter_t *p_iter = (tree_iter_t *) p_adts_iter;
 
-        p_node = adts_queue_dequeue(p_queue);
+    (void) tree_iter_init(p_iter, NULL, order);
+    p_iter->p_root = p_tree->p_root;
+
+    if ((ADTS_TREE_ITER_INORDER != order) &&
+        (ADTS_TREE_ITER_REVERSE != order)) {
+        goto exception;
     }
 
-exception:
-    if (p_queue) {
-        adts_queue_destroy(p_queue);
+    while (p_node) {
+        cmp = sign * tree_cmp(p_tree, p_key, p_node->p_data);
+        if (cmp <= 0) {
+            p_iter->a_path[p_iter->depth++] = p_node;
+            if (0 == cmp) {
+                break;
+            }
+        }
+        p_node = ((cmp < 0) == (sign > 0)) ? p_node->p_left : p_node->p_right;
     }
 
-    //adts_sanity_exit(p_sanity);
-    return;
-} /* adts_tree_display_level() */
+exception:
+    return (adts_tree_node_t *) tree_iter_curr(p_iter);
+} /* adts_tree_iter_seek() */
 
 
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_iter_next( adts_tree_iter_t *p_adts_iter )
+{
+    tree_iter_t *p_iter = (tree_iter_t *) p_adts_iter;
+
+    return (adts_tree_node_t *) tree_iter_next(p_iter);
+} /* adts_tree_iter_next() */
+
 
 /**
  **************************************************************************
@@ -272,41 +542,32 @@ adts_tree_bst_invalid( adts_tree_t *p_adts_tree )
 
     bool           rc       = false;
     tree_t        *p_tree   = (tree_t *) p_adts_tree;
-    int64_t        lastval  = -1;
-    tree_node_t   *p_node   = p_tree->p_root;
-    adts_stack_t  *p_stack  = adts_stack_create();
+    tree_node_t   *p_last   = NULL;
+    tree_node_t   *p_node   = NULL;
     adts_sanity_t *p_sanity = &(p_tree->sanity);
+    tree_iter_t    iter;
 
     adts_sanity_entry(p_sanity);
 
-    while (p_node || adts_stack_is_not_empty(p_stack)) {
-        if (p_node) {
-            (void) adts_stack_push(p_stack, p_node, sizeof(*p_node));
-            p_node = p_node->p_left;
-        }else {
-            p_node = (tree_node_t *) adts_stack_pop(p_stack);
-
-            /* Iterative inorder LNR requires we ensure the values are in
-             * ascending order only and adjust p_lastval on each pass */
-            tree_node_display(p_node);
-
-            /* Cast to avoid implicit compiler promotion on compare */
-            if (lastval < (int64_t) p_node->p_data) {
-                lastval = p_node->p_data;
-            }else {
-                rc = true;
-                goto exception;
-            }
+    for (p_node = tree_iter_init(&(iter), p_tree->p_root,
+                                 ADTS_TREE_ITER_INORDER);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
 
-            p_node = p_node->p_right;
+        /* Iterative inorder LNR requires we ensure the values are in
+         * ascending order only and adjust p_lastval on each pass */
+        tree_node_display(p_node);
+
+        if ((NULL == p_last) ||
+            (tree_cmp(p_tree, p_last->p_data, p_node->p_data) < 0)) {
+            p_last = p_node;
+        }else {
+            rc = true;
+            goto exception;
         }
     }
 
 exception:
-    if (p_stack) {
-        adts_stack_destroy(p_stack);
-    }
-
     adts_sanity_exit(p_sanity);
     return rc;
 } /* adts_tree_bst_invalid() */
@@ -338,54 +599,389 @@ adts_tree_entries( adts_tree_t *p_adts_tree )
 } /* adts_tree_entries() */
 
 
-// adts_tree_find()
-// adts_tree_peek_min()
-// adts_tree_peek_max()
-// adts_tree_remove_min()
-// adts_tree_remove_max()
-// adts_tree_remove_all()
-// adts_tree_remove()
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static inline size_t
+tree_height( const tree_node_t *p_node )
+{
+    return (p_node) ? p_node->height : 0;
+} /* tree_height() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static inline void
+tree_height_update( tree_node_t *p_node )
+{
+    p_node->height = 1 + MAX(tree_height(p_node->p_left),
+                             tree_height(p_node->p_right));
+
+    return;
+} /* tree_height_update() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Rotations operate on the link referencing the subtree root, such
+ *   that the parent is updated in place.
+ *
+ *        n            l
+ *       / \          / \
+ *      l   c  ->    a   n
+ *     / \              / \
+ *    a   b            b   c
+ *
+ *************************************************************************
+ */
+static void
+tree_rotate_right( tree_node_t **pp_link )
+{
+    tree_node_t *p_node = *pp_link;
+    tree_node_t *p_left = p_node->p_left;
+
+    p_node->p_left  = p_left->p_right;
+    p_left->p_right = p_node;
+    tree_height_update(p_node);
+    tree_height_update(p_left);
+    *pp_link = p_left;
+
+    return;
+} /* tree_rotate_right() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static void
+tree_rotate_left( tree_node_t **pp_link )
+{
+    tree_node_t *p_node  = *pp_link;
+    tree_node_t *p_right = p_node->p_right;
+
+    p_node->p_right = p_right->p_left;
+    p_right->p_left = p_node;
+    tree_height_update(p_node);
+    tree_height_update(p_right);
+    *pp_link = p_right;
+
+    return;
+} /* tree_rotate_left() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Restore the AVL invariant at the subtree referenced by pp_link, given
+ *   its children are balanced and differ in height by at most two.
+ *
+ *************************************************************************
+ */
+static void
+tree_rebalance( tree_node_t **pp_link )
+{
+    tree_node_t *p_node = *pp_link;
+    size_t       left   = tree_height(p_node->p_left);
+    size_t       right  = tree_height(p_node->p_right);
+
+    if (left > (right + 1)) {
+        if (tree_height(p_node->p_left->p_left) <
+            tree_height(p_node->p_left->p_right)) {
+            /* left-right */
+            tree_rotate_left(&(p_node->p_left));
+        }
+        tree_rotate_right(pp_link);
+    } else if (right > (left + 1)) {
+        if (tree_height(p_node->p_right->p_right) <
+            tree_height(p_node->p_right->p_left)) {
+            /* right-left */
+            tree_rotate_right(&(p_node->p_right));
+        }
+        tree_rotate_left(pp_link);
+    } else {
+        p_node->height = 1 + MAX(left, right);
+    }
+
+    return;
+} /* tree_rebalance() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Walk the recorded path leaf to root, rebalancing.  Once a subtree
+ *   retains its prior height the ancestors are unaffected.
+ *
+ *************************************************************************
+ */
+static void
+tree_rebalance_path( tree_node_t **a_path[],
+                     size_t        depth )
+{
+    size_t height = 0;
+
+    while (depth) {
+        depth--;
+        height = (*(a_path[depth]))->height;
+        tree_rebalance(a_path[depth]);
+        if (height == (*(a_path[depth]))->height) {
+            break;
+        }
+    }
+
+    return;
+} /* tree_rebalance_path() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+static tree_node_t *
+tree_remove( tree_t      *p_tree,
+             const void  *p_key )
+{
+    int32_t       cmp     = 0;
+    size_t        depth   = 0;
+    size_t        slot    = 0;
+    tree_node_t  *p_node  = NULL;
+    tree_node_t  *p_succ  = NULL;
+    tree_node_t **pp_link = &(p_tree->p_root);
+    tree_node_t **pp_succ = NULL;
+    tree_node_t **a_path[ TREE_HEIGHT_MAX ];
+
+    while (*pp_link) {
+        cmp = tree_cmp(p_tree, p_key, (*pp_link)->p_data);
+        if (0 == cmp) {
+            break;
+        }
+        a_path[depth++] = pp_link;
+        pp_link = (cmp < 0) ? &((*pp_link)->p_left) : &((*pp_link)->p_right);
+    }
+
+    p_node = *pp_link;
+    if (NULL == p_node) {
+        /* absent */
+        goto exception;
+    }
+
+    if ((NULL == p_node->p_left) || (NULL == p_node->p_right)) {
+        *pp_link = (p_node->p_left) ? p_node->p_left : p_node->p_right;
+    } else {
+        /* replace with the in-order successor, recording its path */
+        slot            = depth;
+        a_path[depth++] = pp_link;
+        pp_succ         = &(p_node->p_right);
+        while ((*pp_succ)->p_left) {
+            a_path[depth++] = pp_succ;
+            pp_succ         = &((*pp_succ)->p_left);
+        }
+
+        p_succ           = *pp_succ;
+        *pp_succ         = p_succ->p_right;
+        p_succ->p_left   = p_node->p_left;
+        p_succ->p_right  = p_node->p_right;
+        p_succ->height   = p_node->height;
+        *pp_link         = p_succ;
+
+        if (depth > (slot + 1)) {
+            /* the path descended through the removed node's right link */
+            a_path[slot + 1] = &(p_succ->p_right);
+        }
+    }
+
+    tree_rebalance_path(a_path, depth);
+
+    p_node->p_tree  = NULL;
+    p_node->p_left  = NULL;
+    p_node->p_right = NULL;
+    p_node->height  = 0;
+    p_tree->elems_curr--;
+
+exception:
+    return p_node;
+} /* tree_remove() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+size_t
+adts_tree_height( adts_tree_t *p_adts_tree )
+{
+    tree_t *p_tree = (tree_t *) p_adts_tree;
+
+    return tree_height(p_tree->p_root);
+} /* adts_tree_height() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_find( adts_tree_t *p_adts_tree,
+                const void  *p_key )
+{
+    int32_t        cmp      = 0;
+    tree_t        *p_tree   = (tree_t *) p_adts_tree;
+    tree_node_t   *p_node   = p_tree->p_root;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    while (p_node) {
+        cmp = tree_cmp(p_tree, p_key, p_node->p_data);
+        if (0 == cmp) {
+            break;
+        }
+        p_node = (cmp < 0) ? p_node->p_left : p_node->p_right;
+    }
+
+    adts_sanity_exit(p_sanity);
+    return (adts_tree_node_t *) p_node;
+} /* adts_tree_find() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_peek_min( adts_tree_t *p_adts_tree )
+{
+    tree_t      *p_tree = (tree_t *) p_adts_tree;
+    tree_node_t *p_node = p_tree->p_root;
+
+    while (p_node && p_node->p_left) {
+        p_node = p_node->p_left;
+    }
+
+    return (adts_tree_node_t *) p_node;
+} /* adts_tree_peek_min() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_peek_max( adts_tree_t *p_adts_tree )
+{
+    tree_t      *p_tree = (tree_t *) p_adts_tree;
+    tree_node_t *p_node = p_tree->p_root;
+
+    while (p_node && p_node->p_right) {
+        p_node = p_node->p_right;
+    }
+
+    return (adts_tree_node_t *) p_node;
+} /* adts_tree_peek_max() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_remove( adts_tree_t *p_adts_tree,
+                  const void  *p_key )
+{
+    tree_t        *p_tree   = (tree_t *) p_adts_tree;
+    tree_node_t   *p_node   = NULL;
+    adts_sanity_t *p_sanity = &(p_tree->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    p_node = tree_remove(p_tree, p_key);
+
+    adts_sanity_exit(p_sanity);
+    return (adts_tree_node_t *) p_node;
+} /* adts_tree_remove() */
+
+
+/**
+ **************************************************************************
+ *
+ *************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_remove_min( adts_tree_t *p_adts_tree )
+{
+    adts_tree_node_t *p_min = adts_tree_peek_min(p_adts_tree);
+
+    return (p_min) ? adts_tree_remove(p_adts_tree, p_min->pub.p_data) : NULL;
+} /* adts_tree_remove_min() */
 
 
 /**
  **************************************************************************
- * \details
  *
  *************************************************************************
  */
-void *
-adts_tree_remove( adts_tree_t *p_adts_tree )
+adts_tree_node_t *
+adts_tree_remove_max( adts_tree_t *p_adts_tree )
 {
-    void *p_data = NULL;
-
-    CDISPLAY("Incomplete...");
+    adts_tree_node_t *p_max = adts_tree_peek_max(p_adts_tree);
 
-    return p_data;
-} /* adts_tree_remove() */
+    return (p_max) ? adts_tree_remove(p_adts_tree, p_max->pub.p_data) : NULL;
+} /* adts_tree_remove_max() */
 
 
 /**
  **************************************************************************
  * \details
+ *   Descend recording the path, link the new leaf, then rebalance upward.
+ *   At most a single (double) rotation is performed.
  *
  *************************************************************************
  */
-static void
+static int32_t
 tree_insert( tree_t      *p_tree,
              tree_node_t *p_node )
 {
-    int32_t      rc      = 0;
-    tree_node_t  tnode   = {0};
-    tree_node_t *p_tnode = &(tnode); /* tmp node */
-
-    p_tnode->p_right = p_tree->p_root;
+    int32_t       rc      = 0;
+    int32_t       cmp     = 0;
+    size_t        depth   = 0;
+    tree_node_t **pp_link = &(p_tree->p_root);
+    tree_node_t **a_path[ TREE_HEIGHT_MAX ];
+
+    /* traverse and save the rebalance path */
+    while (*pp_link) {
+        cmp = tree_cmp(p_tree, p_node->p_data, (*pp_link)->p_data);
+        if (0 == cmp) {
+            rc = EEXIST;
+            goto exception;
+        }
+        a_path[depth++] = pp_link;
+        pp_link = (cmp < 0) ? &((*pp_link)->p_left) : &((*pp_link)->p_right);
+    }
 
-    /* traverse and save the rebalance point */
-    CDISPLAY("Incomplete...");
+    p_node->p_left  = NULL;
+    p_node->p_right = NULL;
+    p_node->height  = 1;
+    *pp_link        = p_node;
 
+    tree_rebalance_path(a_path, depth);
 
 exception:
-    return;
+    return rc;
 } /* tree_insert() */
 
 
@@ -411,21 +1007,19 @@ adts_tree_insert( adts_tree_t      *p_adts_tree,
 
     adts_sanity_entry(p_sanity);
 
-    p_node->p_tree = p_tree;
     p_node->p_data = p_data;
     p_node->bytes  = bytes;
 
-    if (NULL == p_tree->p_root) {
-        /* First entry */
-        p_tree->p_root = p_node;
-    }else {
-        /* Not first entry */
-        tree_insert(p_tree, p_node);
+    rc = tree_insert(p_tree, p_node);
+    if (rc) {
+        goto exception;
     }
 
+    p_node->p_tree = p_tree;
     p_tree->elems_curr++;
     p_tree->elems_max = MAX(p_tree->elems_max, p_tree->elems_curr);
 
+exception:
     adts_sanity_exit(p_sanity);
     return rc;
 } /* adts_tree_insert() */
@@ -434,18 +1028,113 @@ adts_tree_insert( adts_tree_t      *p_adts_tree,
 /**
  **************************************************************************
  * \details
+ *   Each range is rooted at its middle entry, left ranges are never
+ *   smaller than right ones, thus a range of n entries has height
+ *   floor(log2(n)) + 1 and every node balances within one.  The pending
+ *   ranges are held on the stack, at most two per level.
  *
  *************************************************************************
  */
-void
-adts_tree_destroy( adts_tree_t *p_adts_tree )
+int32_t
+adts_tree_build_sorted( adts_tree_t                   *p_adts_tree,
+                        adts_tree_node_t              *a_nodes,
+                        const adts_tree_node_public_t *a_entries,
+                        size_t                         elems )
 {
+    int32_t        rc       = 0;
+    size_t         top      = 0;
+    size_t         lo       = 0;
+    size_t         hi       = 0;
+    size_t         mid      = 0;
     tree_t        *p_tree   = (tree_t *) p_adts_tree;
+    tree_node_t   *p_node   = NULL;
+    tree_node_t  **pp_link  = NULL;
     adts_sanity_t *p_sanity = &(p_tree->sanity);
+    struct {
+        size_t        lo;
+        size_t        hi;
+        tree_node_t **pp_link;
+    } a_range[ 2 * TREE_HEIGHT_MAX ];
+
+    adts_sanity_entry(p_sanity);
+
+    if (p_tree->p_root) {
+        rc = EINVAL;
+        goto exception;
+    }
+
+    for (size_t idx = 1; idx < elems; idx++) {
+        if (tree_cmp(p_tree, a_entries[idx - 1].p_data,
+                     a_entries[idx].p_data) >= 0) {
+            /* not strictly ascending */
+            rc = EINVAL;
+            goto exception;
+        }
+    }
+
+    a_range[top].lo      = 0;
+    a_range[top].hi      = elems;
+    a_range[top].pp_link = &(p_tree->p_root);
+    top++;
+
+    while (top) {
+        top--;
+        lo      = a_range[top].lo;
+        hi      = a_range[top].hi;
+        pp_link = a_range[top].pp_link;
+
+        if (lo == hi) {
+            *pp_link = NULL;
+            continue;
+        }
+
+        mid             = lo + ((hi - lo) / 2);
+        p_node          = (tree_node_t *) &(a_nodes[mid]);
+        p_node->p_data  = a_entries[mid].p_data;
+        p_node->bytes   = a_entries[mid].bytes;
+        p_node->p_tree  = p_tree;
+        p_node->height  = 64 - __builtin_clzll(hi - lo);
+        *pp_link        = p_node;
+
+        a_range[top].lo      = mid + 1;
+        a_range[top].hi      = hi;
+        a_range[top].pp_link = &(p_node->p_right);
+        top++;
+        a_range[top].lo      = lo;
+        a_range[top].hi      = mid;
+        a_range[top].pp_link = &(p_node->p_left);
+        top++;
+    }
+
+    p_tree->elems_curr = elems;
+    p_tree->elems_max  = MAX(p_tree->elems_max, elems);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_tree_build_sorted() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Nodes are consumer owned and not released.
+ *
+ *************************************************************************
+ */
+void
+adts_tree_destroy( adts_tree_t *p_adts_tree )
+{
+    tree_t           *p_tree   = (tree_t *) p_adts_tree;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_tree->sanity);
 
     adts_sanity_entry(p_sanity);
 
-    free(p_tree);
+    /* the record is released along with the handle */
+    mem = p_tree->mem;
+    adts_mem_free_acct(&(mem), p_tree, sizeof(adts_tree_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
 
     /* No adts_sanity_exit() since we've freed the memory */
 
@@ -460,21 +1149,46 @@ adts_tree_destroy( adts_tree_t *p_adts_tree )
  *************************************************************************
  */
 adts_tree_t *
-adts_tree_create( adts_tree_type_t  type )
+adts_tree_create_ext( const adts_tree_create_t *p_op )
 {
-    tree_t      *p_tree      = NULL;
-    adts_tree_t *p_adts_tree = NULL;
+    tree_t           *p_tree      = NULL;
+    adts_tree_t      *p_adts_tree = NULL;
+    adts_mem_stats_t  mem         = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_TREE);
 
-    p_adts_tree = adts_mem_zalloc(sizeof(*p_adts_tree));
+    if ((NULL == p_op) || (ADTS_TREE_AVL != p_op->type)) {
+        goto exception;
+    }
+
+    p_adts_tree = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_tree),
+                                       ADTS_MEM_ALIGN_DEFAULT);
     if (NULL == p_adts_tree) {
         goto exception;
     }
 
     p_tree       = (tree_t *) p_adts_tree;
-    p_tree->type = type;
+    p_tree->type = p_op->type;
+    p_tree->cmp  = p_op->cmp;
+    p_tree->mem  = mem;
 
 exception:
     return p_adts_tree;
+} /* adts_tree_create_ext() */
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ *************************************************************************
+ */
+adts_tree_t *
+adts_tree_create( adts_tree_type_t  type )
+{
+    adts_tree_create_t op = {0};
+
+    op.type = type;
+
+    return adts_tree_create_ext(&(op));
 } /* adts_tree_create() */
 
 
@@ -520,6 +1234,12 @@ utest_tree_bytes( void )
     _Static_assert(sizeof(tree_node_t) <= sizeof(adts_tree_node_t),
         "Mismatch structs detected");
 
+    CDISPLAY("[%u]", sizeof(tree_iter_t));
+    CDISPLAY("[%u]", sizeof(adts_tree_iter_t));
+
+    _Static_assert(sizeof(tree_iter_t) <= sizeof(adts_tree_iter_t),
+        "Mismatch structs detected");
+
     return;
 } /* utest_tree_bytes() */
 
@@ -602,6 +1322,338 @@ utest_tree_generate_number( void )
 } /* utest_tree_generate_number() */
 
 
+/*
+ ****************************************************************************
+ * \details
+ *   Release a generated tree, post-order.
+ *
+ ****************************************************************************
+ */
+static void
+utest_tree_generate_free( tree_node_t *p_node )
+{
+    if (p_node) {
+        utest_tree_generate_free(p_node->p_left);
+        utest_tree_generate_free(p_node->p_right);
+        free(p_node);
+    }
+
+    return;
+} /* utest_tree_generate_free() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Walk the subtree at p_root in order and match the keys to expect.
+ *
+ ****************************************************************************
+ */
+static void
+utest_tree_iter_expect( adts_tree_node_t       *p_root,
+                        adts_tree_iter_order_t  order,
+                        const char             *p_expect )
+{
+    size_t       idx    = 0;
+    tree_node_t *p_node = NULL;
+    tree_iter_t  iter;
+
+    for (p_node = tree_iter_init(&(iter), (tree_node_t *) p_root, order);
+         p_node;
+         p_node = tree_iter_next(&(iter))) {
+        assert(p_expect[idx] == (char) (uintptr_t) p_node->p_data);
+        idx++;
+    }
+    assert('\0' == p_expect[idx]);
+    assert(NULL == tree_iter_next(&(iter)));
+
+    return;
+} /* utest_tree_iter_expect() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Recursive reference traversals, bounded by the tree height.
+ *
+ ****************************************************************************
+ */
+static void
+utest_tree_ref_order( tree_node_t            *p_node,
+                      adts_tree_iter_order_t  order,
+                      tree_node_t           **a_out,
+                      size_t                 *p_idx )
+{
+    if (NULL == p_node) {
+        return;
+    }
+
+    if (ADTS_TREE_ITER_PREORDER == order) {
+        a_out[(*p_idx)++] = p_node;
+    }
+    utest_tree_ref_order(p_node->p_left, order, a_out, p_idx);
+    if (ADTS_TREE_ITER_INORDER == order) {
+        a_out[(*p_idx)++] = p_node;
+    }
+    utest_tree_ref_order(p_node->p_right, order, a_out, p_idx);
+    if (ADTS_TREE_ITER_POSTORDER == order) {
+        a_out[(*p_idx)++] = p_node;
+    }
+
+    return;
+} /* utest_tree_ref_order() */
+
+static void
+utest_tree_ref_level( tree_node_t  *p_root,
+                      tree_node_t **a_out )
+{
+    size_t head = 0;
+    size_t tail = 0;
+
+    if (p_root) {
+        a_out[tail++] = p_root;
+    }
+    while (head < tail) {
+        tree_node_t *p_node = a_out[head++];
+
+        if (p_node->p_left) {
+            a_out[tail++] = p_node->p_left;
+        }
+        if (p_node->p_right) {
+            a_out[tail++] = p_node->p_right;
+        }
+    }
+
+    return;
+} /* utest_tree_ref_level() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Recursive structural check, bounded by the tree height: key order,
+ *   recorded heights, AVL balance, node ownership and entry count.
+ *
+ ****************************************************************************
+ */
+static size_t
+utest_tree_avl_node_valid( tree_t      *p_tree,
+                           tree_node_t *p_node,
+                           tree_node_t *p_lo,
+                           tree_node_t *p_hi,
+                           size_t      *p_count )
+{
+    size_t left  = 0;
+    size_t right = 0;
+
+    if (NULL == p_node) {
+        return 0;
+    }
+
+    assert(p_node->p_tree == p_tree);
+    assert((NULL == p_lo) ||
+           (tree_cmp(p_tree, p_lo->p_data, p_node->p_data) < 0));
+    assert((NULL == p_hi) ||
+           (tree_cmp(p_tree, p_node->p_data, p_hi->p_data) < 0));
+
+    left  = utest_tree_avl_node_valid(p_tree, p_node->p_left, p_lo, p_node,
+                                      p_count);
+    right = utest_tree_avl_node_valid(p_tree, p_node->p_right, p_node, p_hi,
+                                      p_count);
+
+    assert((left <= (right + 1)) && (right <= (left + 1)));
+    assert(p_node->height == (1 + MAX(left, right)));
+    (*p_count)++;
+
+    return p_node->height;
+} /* utest_tree_avl_node_valid() */
+
+static void
+utest_tree_avl_valid( tree_t *p_tree )
+{
+    size_t count = 0;
+
+    (void) utest_tree_avl_node_valid(p_tree, p_tree->p_root, NULL, NULL,
+                                     &(count));
+    assert(count == p_tree->elems_curr);
+
+    return;
+} /* utest_tree_avl_valid() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static int32_t
+utest_tree_cmp_str( const void *p_a,
+                    const void *p_b )
+{
+    return strcmp((const char *) p_a, (const char *) p_b);
+} /* utest_tree_cmp_str() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   p_key[0 .. elems) = a shuffle of { 0, step, 2 * step, ... }
+ *
+ ****************************************************************************
+ */
+static void
+utest_tree_shuffle( uint64_t *p_key,
+                    size_t    elems,
+                    uint64_t  step,
+                    uint64_t *p_seed )
+{
+    for (size_t idx = 0; idx < elems; idx++) {
+        p_key[idx] = idx * step;
+    }
+
+    for (size_t idx = elems - 1; idx > 0; idx--) {
+        size_t   jdx = 0;
+        uint64_t tmp = 0;
+
+        *p_seed ^= *p_seed << 13;
+        *p_seed ^= *p_seed >> 7;
+        *p_seed ^= *p_seed << 17;
+
+        jdx        = *p_seed % (idx + 1);
+        tmp        = p_key[idx];
+        p_key[idx] = p_key[jdx];
+        p_key[jdx] = tmp;
+    }
+
+    return;
+} /* utest_tree_shuffle() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Random insert, find and remove, and bulk load against inserting the
+ *   same sorted keys one at a time.
+ *
+ ****************************************************************************
+ */
+static void
+utest_tree_benchmark( void )
+{
+    const size_t sizes[] = { 1000 * 1000, 4 * 1000 * 1000 };
+    uint64_t     seed    = 0x9E3779B97F4A7C15ULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: AVL tree");
+
+    for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+        const size_t              elems   = sizes[sdx];
+        uint64_t                  t_ins   = 0;
+        uint64_t                  t_find  = 0;
+        uint64_t                  t_del   = 0;
+        uint64_t                  t_seq   = 0;
+        uint64_t                  t_bulk  = 0;
+        uint64_t                  t_scan  = 0;
+        uint64_t                  t_level = 0;
+        uint64_t                  sum     = 0;
+        size_t                    height  = 0;
+        adts_tree_node_t         *p_node  = NULL;
+        adts_tree_iter_t          iter    = {0};
+        uint64_t                 *p_key   = NULL;
+        adts_tree_t              *p_adts  = NULL;
+        adts_tree_node_t         *p_nodes = NULL;
+        adts_tree_node_public_t  *p_ents  = NULL;
+
+        p_key   = calloc(elems, sizeof(*p_key));
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        p_ents  = calloc(elems, sizeof(*p_ents));
+        assert(p_key && p_nodes && p_ents);
+        utest_tree_shuffle(p_key, elems, 1, &(seed));
+
+        p_adts = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_adts);
+
+        t_ins = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_insert(p_adts, &(p_nodes[idx]),
+                                    (void *) p_key[idx], 0);
+        }
+        t_ins  = adts_tstamp() - t_ins;
+        height = adts_tree_height(p_adts);
+
+        utest_tree_shuffle(p_key, elems, 1, &(seed));
+        t_find = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            if (NULL == adts_tree_find(p_adts, (void *) p_key[idx])) {
+                assert(0);
+            }
+        }
+        t_find = adts_tstamp() - t_find;
+
+        t_scan = adts_tstamp();
+        for (p_node = adts_tree_iter_begin(p_adts, &(iter),
+                                           ADTS_TREE_ITER_INORDER);
+             p_node;
+             p_node = adts_tree_iter_next(&(iter))) {
+            sum += (uint64_t) p_node->pub.p_data;
+        }
+        t_scan = adts_tstamp() - t_scan;
+
+        t_level = adts_tstamp();
+        for (p_node = adts_tree_iter_begin(p_adts, &(iter),
+                                           ADTS_TREE_ITER_LEVEL);
+             p_node;
+             p_node = adts_tree_iter_next(&(iter))) {
+            sum -= (uint64_t) p_node->pub.p_data;
+        }
+        t_level = adts_tstamp() - t_level;
+        assert(0 == sum);
+
+        t_del = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_remove(p_adts, (void *) p_key[idx]);
+        }
+        t_del = adts_tstamp() - t_del;
+        assert(0 == adts_tree_entries(p_adts));
+
+        /* sorted keys, one at a time */
+        t_seq = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            (void) adts_tree_insert(p_adts, &(p_nodes[idx]),
+                                    (void *) idx, 0);
+        }
+        t_seq = adts_tstamp() - t_seq;
+        adts_tree_destroy(p_adts);
+
+        /* sorted keys, bulk */
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_ents[idx].p_data = (void *) idx;
+        }
+        p_adts = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_adts);
+        t_bulk = adts_tstamp();
+        assert(0 == adts_tree_build_sorted(p_adts, p_nodes, p_ents, elems));
+        t_bulk = adts_tstamp() - t_bulk;
+
+        CDISPLAY("%8zu keys  height %zu / %zu  random insert %llu  find %llu"
+                 "  remove %llu ns/op", elems, height,
+                 adts_tree_height(p_adts), t_ins / elems, t_find / elems,
+                 t_del / elems);
+        CDISPLAY("%8zu keys  sorted insert %llu ms  build_sorted %llu ms",
+                 elems, t_seq / (1000 * 1000), t_bulk / (1000 * 1000));
+        CDISPLAY("%8zu keys  iterate in-order %llu  level %llu ns/node",
+                 elems, t_scan / elems, t_level / elems);
+
+        adts_tree_destroy(p_adts);
+        free(p_ents);
+        free(p_nodes);
+        free(p_key);
+    }
+
+    return;
+} /* utest_tree_benchmark() */
+
+
 /*
  ****************************************************************************
  * test control
@@ -697,7 +1749,7 @@ utest_control( void )
 
         adts_tree_destroy(p_tree);
     }
-return;
+
     CDISPLAY("=========================================================");
     {
         CDISPLAY("Test 7: bst is valid ");
@@ -756,7 +1808,7 @@ return;
         #define UTEST_ELEMS (32)
         int32_t           key[] = {'A','B','C','D','E','F','G','H','I'};
         adts_tree_node_t  node[ UTEST_ELEMS ] = {0};
-        int32_t           elems = 1;
+        int32_t           elems = sizeof(key) / sizeof(key[0]);
 
         p_tree = adts_tree_create(type);
         assert(p_tree);
@@ -768,12 +1820,331 @@ return;
             adts_tree_display_inorder(&(node[idx]));
         }
 
+        /* ascending input, rotations keep 9 nodes within 4 levels */
+        rc = adts_tree_insert(p_tree, &(node[elems]), key[0], sizeof(key[0]));
+        assert(EEXIST == rc);
+        assert(elems == adts_tree_entries(p_tree));
+        assert(4 == adts_tree_height(p_tree));
+        assert(adts_tree_bst_valid(p_tree));
+        utest_tree_avl_valid((tree_t *) p_tree);
+
         adts_tree_destroy(p_tree);
     }
 
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 10: insert -> find -> remove, random order");
+
+        const size_t      elems   = 4096;
+        uint64_t          seed    = 0x9E3779B97F4A7C15ULL;
+        uint64_t         *p_key   = NULL;
+        tree_t           *p_tree  = NULL;
+        adts_tree_t      *p_adts  = NULL;
+        adts_tree_node_t *p_nodes = NULL;
+        adts_tree_node_t *p_node  = NULL;
+
+        p_key   = calloc(elems, sizeof(*p_key));
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        p_adts  = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_key && p_nodes && p_adts);
+        p_tree  = (tree_t *) p_adts;
+
+        assert(NULL == adts_tree_create(0));
+        assert(NULL == adts_tree_peek_min(p_adts));
+        assert(NULL == adts_tree_remove_max(p_adts));
+
+        /* even keys, odd keys remain absent */
+        utest_tree_shuffle(p_key, elems, 2, &(seed));
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_tree_insert(p_adts, &(p_nodes[idx]),
+                                         (void *) p_key[idx], idx));
+            if (0 == (idx % 256)) {
+                utest_tree_avl_valid(p_tree);
+            }
+        }
+        utest_tree_avl_valid(p_tree);
+        assert(elems == adts_tree_entries(p_adts));
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_node = adts_tree_find(p_adts, (void *) p_key[idx]);
+            assert(p_node == &(p_nodes[idx]));
+            assert(idx == p_node->pub.bytes);
+            assert(NULL == adts_tree_find(p_adts, (void *) (p_key[idx] + 1)));
+        }
+        assert(0 == (uint64_t) adts_tree_peek_min(p_adts)->pub.p_data);
+        assert((2 * (elems - 1)) ==
+               (uint64_t) adts_tree_peek_max(p_adts)->pub.p_data);
+
+        /* remove half in random order, then the extremes */
+        for (size_t idx = 0; idx < elems / 2; idx++) {
+            assert(NULL == adts_tree_remove(p_adts, (void *) (p_key[idx] + 1)));
+            p_node = adts_tree_remove(p_adts, (void *) p_key[idx]);
+            assert(p_node == &(p_nodes[idx]));
+            assert(NULL == adts_tree_find(p_adts, (void *) p_key[idx]));
+            if (0 == (idx % 256)) {
+                utest_tree_avl_valid(p_tree);
+            }
+        }
+        utest_tree_avl_valid(p_tree);
+
+        /* alternate extremes, min ascending and max descending */
+        for (uint64_t idx = 0, lo = 0, hi = UINT64_MAX;
+             adts_tree_entries(p_adts);
+             idx++) {
+            uint64_t key = 0;
+
+            p_node = (idx & 1) ? adts_tree_remove_max(p_adts) :
+                                 adts_tree_remove_min(p_adts);
+            assert(p_node);
+            key = (uint64_t) p_node->pub.p_data;
+            assert((lo <= key) && (key < hi));
+            if (idx & 1) {
+                hi = key;
+            } else {
+                lo = key + 1;
+            }
+        }
+        assert(NULL == p_tree->p_root);
+
+        adts_tree_destroy(p_adts);
+        free(p_nodes);
+        free(p_key);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 11: comparator");
+
+        const char        *keys[] = { "pear", "apple", "fig", "kiwi", "lime" };
+        const size_t       elems  = sizeof(keys) / sizeof(keys[0]);
+        adts_tree_t       *p_adts = NULL;
+        adts_tree_node_t   nodes[ 8 ];
+        adts_tree_create_t op     = {0};
+
+        memset(nodes, 0, sizeof(nodes));
+        assert(NULL == adts_tree_create_ext(NULL));
+
+        op.type = ADTS_TREE_AVL;
+        op.cmp  = utest_tree_cmp_str;
+        p_adts  = adts_tree_create_ext(&(op));
+        assert(p_adts);
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_tree_insert(p_adts, &(nodes[idx]),
+                                         (void *) keys[idx], 0));
+        }
+
+        /* found by value, not by address */
+        {
+            char probe[] = "kiwi";
+
+            assert(&(nodes[3]) == adts_tree_find(p_adts, probe));
+        }
+        assert(&(nodes[1]) == adts_tree_peek_min(p_adts));
+        assert(&(nodes[0]) == adts_tree_peek_max(p_adts));
+        assert(adts_tree_bst_valid(p_adts));
+
+        adts_tree_destroy(p_adts);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 12: build sorted");
+
+        const size_t              sizes[] = { 0, 1, 2, 3, 7, 8, 1000, 4095 };
+        const size_t              limit   = 4096;
+        tree_t                   *p_tree  = NULL;
+        adts_tree_t              *p_adts  = NULL;
+        adts_tree_node_t         *p_nodes = NULL;
+        adts_tree_node_t          extra   = {0};
+        adts_tree_node_public_t  *p_ents  = NULL;
+
+        p_nodes = calloc(limit, sizeof(*p_nodes));
+        p_ents  = calloc(limit, sizeof(*p_ents));
+        assert(p_nodes && p_ents);
+
+        for (size_t idx = 0; idx < limit; idx++) {
+            p_ents[idx].p_data = (void *) (2 * idx);
+            p_ents[idx].bytes  = idx;
+        }
+
+        for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+            const size_t elems = sizes[sdx];
+
+            p_adts = adts_tree_create(ADTS_TREE_AVL);
+            assert(p_adts);
+            p_tree = (tree_t *) p_adts;
+
+            assert(0 == adts_tree_build_sorted(p_adts, p_nodes, p_ents,
+                                               elems));
+            assert(elems == adts_tree_entries(p_adts));
+            assert((elems ? (64 - __builtin_clzll(elems)) : 0) ==
+                   adts_tree_height(p_adts));
+            utest_tree_avl_valid(p_tree);
+
+            /* a non empty tree is rejected */
+            if (elems) {
+                assert(EINVAL == adts_tree_build_sorted(p_adts, p_nodes,
+                                                        p_ents, elems));
+            }
+
+            /* remains a working AVL tree */
+            assert(0 == adts_tree_insert(p_adts, &(extra), (void *) 1, 0));
+            utest_tree_avl_valid(p_tree);
+            for (size_t idx = 0; idx < elems; idx += 3) {
+                assert(&(p_nodes[idx]) ==
+                       adts_tree_remove(p_adts, p_ents[idx].p_data));
+            }
+            utest_tree_avl_valid(p_tree);
+
+            adts_tree_destroy(p_adts);
+        }
+
+        /* out of order or duplicate input is rejected */
+        p_adts = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_adts);
+        p_ents[5].p_data = p_ents[4].p_data;
+        assert(EINVAL == adts_tree_build_sorted(p_adts, p_nodes, p_ents, 8));
+        assert(0 == adts_tree_entries(p_adts));
+        assert(NULL == adts_tree_peek_min(p_adts));
+        adts_tree_destroy(p_adts);
+
+        free(p_ents);
+        free(p_nodes);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test 13: iterators");
+
+        const size_t             elems   = 4096;
+        const adts_tree_iter_order_t orders[] = {
+            ADTS_TREE_ITER_INORDER,  ADTS_TREE_ITER_PREORDER,
+            ADTS_TREE_ITER_POSTORDER, ADTS_TREE_ITER_LEVEL };
+        uint64_t                 seed    = 0x9E3779B97F4A7C15ULL;
+        uint64_t                *p_key   = NULL;
+        tree_t                  *p_tree  = NULL;
+        tree_node_t            **p_ref   = NULL;
+        adts_tree_t             *p_adts  = NULL;
+        adts_tree_node_t        *p_nodes = NULL;
+        adts_tree_node_t        *p_root  = NULL;
+        adts_tree_node_t        *p_node  = NULL;
+        adts_tree_node_t        *p_other = NULL;
+        adts_tree_iter_t         iter    = {0};
+        adts_tree_iter_t         other   = {0};
+
+        /* unbalanced shape, F(B(A, D(C, E)), G(-, I(H, -))) */
+        p_root = utest_tree_generate_ascii();
+        utest_tree_iter_expect(p_root, ADTS_TREE_ITER_INORDER,   "ABCDEFGHI");
+        utest_tree_iter_expect(p_root, ADTS_TREE_ITER_REVERSE,   "IHGFEDCBA");
+        utest_tree_iter_expect(p_root, ADTS_TREE_ITER_PREORDER,  "FBADCEGIH");
+        utest_tree_iter_expect(p_root, ADTS_TREE_ITER_POSTORDER, "ACEDBHIGF");
+        utest_tree_iter_expect(p_root, ADTS_TREE_ITER_LEVEL,     "FBGADICEH");
+        utest_tree_iter_expect(p_root, 0, "");
+        utest_tree_generate_free((tree_node_t *) p_root);
+
+        p_key   = calloc(elems, sizeof(*p_key));
+        p_nodes = calloc(elems, sizeof(*p_nodes));
+        p_ref   = calloc(elems, sizeof(*p_ref));
+        p_adts  = adts_tree_create(ADTS_TREE_AVL);
+        assert(p_key && p_nodes && p_ref && p_adts);
+        p_tree  = (tree_t *) p_adts;
+
+        /* empty */
+        for (size_t odx = 0; odx < sizeof(orders) / sizeof(orders[0]); odx++) {
+            assert(NULL == adts_tree_iter_begin(p_adts, &(iter), orders[odx]));
+            assert(NULL == adts_tree_iter_next(&(iter)));
+        }
+        assert(NULL == adts_tree_iter_seek(p_adts, &(iter),
+                                           ADTS_TREE_ITER_INORDER, 0));
+
+        /* even keys */
+        utest_tree_shuffle(p_key, elems, 2, &(seed));
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_tree_insert(p_adts, &(p_nodes[idx]),
+                                         (void *) p_key[idx], idx));
+        }
+
+        for (size_t odx = 0; odx < sizeof(orders) / sizeof(orders[0]); odx++) {
+            size_t count = 0;
+
+            memset(p_ref, 0, elems * sizeof(*p_ref));
+            if (ADTS_TREE_ITER_LEVEL == orders[odx]) {
+                utest_tree_ref_level(p_tree->p_root, p_ref);
+            } else {
+                utest_tree_ref_order(p_tree->p_root, orders[odx], p_ref,
+                                     &(count));
+            }
+
+            count = 0;
+            for (p_node = adts_tree_iter_begin(p_adts, &(iter), orders[odx]);
+                 p_node;
+                 p_node = adts_tree_iter_next(&(iter))) {
+                assert(p_node == (adts_tree_node_t *) p_ref[count]);
+                count++;
+            }
+            assert(elems == count);
+        }
 
+        /* descending */
+        p_node = adts_tree_iter_begin(p_adts, &(iter), ADTS_TREE_ITER_REVERSE);
+        for (size_t idx = elems; idx > 0; idx--) {
+            assert((2 * (idx - 1)) == (uint64_t) p_node->pub.p_data);
+            p_node = adts_tree_iter_next(&(iter));
+        }
+        assert(NULL == p_node);
+
+        /* seek, present, absent and out of range keys */
+        for (int64_t key = -3; key < (int64_t) (2 * elems + 3); key++) {
+            int64_t ceil  = (key < 0) ? 0 : ((key + 1) & ~1LL);
+            int64_t floor = key & ~1LL;
+            size_t  count = 0;
+
+            p_node = adts_tree_iter_seek(p_adts, &(iter),
+                                         ADTS_TREE_ITER_INORDER, (void *) key);
+            for (; p_node && (count < 4); count++) {
+                assert((ceil + (2 * (int64_t) count)) ==
+                       (int64_t) p_node->pub.p_data);
+                p_node = adts_tree_iter_next(&(iter));
+            }
+            assert(count == MIN(4, (ceil < (int64_t) (2 * elems)) ?
+                                   (((2 * elems) - ceil) / 2) : 0));
+
+            p_node = adts_tree_iter_seek(p_adts, &(iter),
+                                         ADTS_TREE_ITER_REVERSE, (void *) key);
+            if (key < 0) {
+                assert(NULL == p_node);
+            } else {
+                floor = MIN(floor, (int64_t) (2 * (elems - 1)));
+                assert(floor == (int64_t) p_node->pub.p_data);
+                p_node = adts_tree_iter_next(&(iter));
+                assert((floor ? (floor - 2) : -1) ==
+                       (p_node ? (int64_t) p_node->pub.p_data : -1));
+            }
+        }
+        assert(NULL == adts_tree_iter_seek(p_adts, &(iter),
+                                           ADTS_TREE_ITER_LEVEL, 0));
+
+        /* resumable, two cursors advance independently */
+        p_node  = adts_tree_iter_begin(p_adts, &(iter), ADTS_TREE_ITER_INORDER);
+        p_other = adts_tree_iter_seek(p_adts, &(other),
+                                      ADTS_TREE_ITER_INORDER,
+                                      (void *) (uint64_t) elems);
+        for (size_t idx = 0; idx < elems / 2; idx++) {
+            assert((2 * idx) == (uint64_t) p_node->pub.p_data);
+            assert((elems + (2 * idx)) == (uint64_t) p_other->pub.p_data);
+            p_node  = adts_tree_iter_next(&(iter));
+            p_other = adts_tree_iter_next(&(other));
+        }
+        assert(NULL == p_other);
 
+        adts_tree_destroy(p_adts);
+        free(p_ref);
+        free(p_nodes);
+        free(p_key);
+    }
 
+    utest_tree_benchmark();
 
     return;
 } /* utest_control() */
@@ -11,8 +11,9 @@
  *
  *************************************************************************
  */
-#define ADTS_TREE_BYTES      (64)
+#define ADTS_TREE_BYTES      (256)
 #define ADTS_TREE_NODE_BYTES (64)
+#define ADTS_TREE_ITER_BYTES (800)
 
 
 /**
@@ -37,9 +38,192 @@ typedef struct {
 } adts_tree_t;
 
 typedef struct {
-    const char reserved[ ADTS_TREE_NODE_BYTES ];
+    void   *p_data;
+    size_t  bytes;
+} adts_tree_node_public_t;
+
+typedef union {
+    const char                    reserved[ ADTS_TREE_NODE_BYTES ];
+    const adts_tree_node_public_t pub; /**< read only */
 } adts_tree_node_t;
 
+typedef struct {
+    const char reserved[ ADTS_TREE_ITER_BYTES ];
+} adts_tree_iter_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   AVL tree over consumer owned nodes, keyed by p_data.  Keys are unique
+ *   and ordered by cmp, which returns <0, 0, >0 as a orders before, equal
+ *   to, or after b.  A NULL cmp orders p_data as a signed integer.
+ *
+ *   Insert and remove are iterative, retaining the root to leaf path on
+ *   the stack, and no memory is allocated per node.
+ *
+ *   tree create parameters
+ *     - type: ADTS_TREE_AVL
+ *     - cmp:  key comparator, optional
+ *
+ **************************************************************************
+ */
+typedef int32_t (*adts_tree_cmp_t)( const void *p_a,
+                                    const void *p_b );
+
+typedef struct {
+    adts_tree_type_t type;
+    adts_tree_cmp_t  cmp;
+} adts_tree_create_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Traversal orders, see adts_tree_iter_begin().
+ *
+ **************************************************************************
+ */
+typedef enum {
+    ADTS_TREE_ITER_INORDER = 1, /**< ascending */
+    ADTS_TREE_ITER_REVERSE,     /**< descending */
+    ADTS_TREE_ITER_PREORDER,
+    ADTS_TREE_ITER_POSTORDER,
+    ADTS_TREE_ITER_LEVEL,       /**< breadth first, left to right */
+} adts_tree_iter_order_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+void
+adts_tree_display_preorder( adts_tree_node_t *p_adts_tree_node );
+
+void
+adts_tree_display_inorder( adts_tree_node_t *p_adts_tree_node );
+
+void
+adts_tree_display_postorder( adts_tree_node_t *p_adts_tree_node );
+
+void
+adts_tree_display_level( adts_tree_node_t *p_adts_tree_node );
+
+bool
+adts_tree_bst_invalid( adts_tree_t *p_adts_tree );
+
+bool
+adts_tree_bst_valid( adts_tree_t *p_adts_tree );
+
+size_t
+adts_tree_entries( adts_tree_t *p_adts_tree );
+
+size_t
+adts_tree_height( adts_tree_t *p_adts_tree );
+
+adts_tree_node_t *
+adts_tree_find( adts_tree_t *p_adts_tree,
+                const void  *p_key );
+
+adts_tree_node_t *
+adts_tree_peek_min( adts_tree_t *p_adts_tree );
+
+adts_tree_node_t *
+adts_tree_peek_max( adts_tree_t *p_adts_tree );
+
+/**
+ **************************************************************************
+ * \details
+ *   EEXIST if the key is already present.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_tree_insert( adts_tree_t      *p_adts_tree,
+                  adts_tree_node_t *p_adts_tree_node,
+                  void             *p_data,
+                  size_t            bytes );
+
+/**
+ **************************************************************************
+ * \details
+ *   The removed node is returned to the consumer, NULL if absent.
+ *
+ **************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_remove( adts_tree_t *p_adts_tree,
+                  const void  *p_key );
+
+adts_tree_node_t *
+adts_tree_remove_min( adts_tree_t *p_adts_tree );
+
+adts_tree_node_t *
+adts_tree_remove_max( adts_tree_t *p_adts_tree );
+
+/**
+ **************************************************************************
+ * \details
+ *   Populate an empty tree, in O(n), from elems entries in strictly
+ *   ascending key order.  a_nodes[idx] is linked for a_entries[idx], and
+ *   the result is perfectly balanced, each subtree rooted at the middle
+ *   of its range.  EINVAL if the tree is not empty or the entries are not
+ *   strictly ascending, in which case the tree is left unchanged.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_tree_build_sorted( adts_tree_t                   *p_adts_tree,
+                        adts_tree_node_t              *a_nodes,
+                        const adts_tree_node_public_t *a_entries,
+                        size_t                         elems );
+
+/**
+ **************************************************************************
+ * \details
+ *   Cursor iteration, allocation free.  The iterator retains the root to
+ *   current path, bounded by the tree height, and is resumable: each call
+ *   returns the node under the cursor, NULL once exhausted.  Level order
+ *   revisits the upper levels once per level, O(n) overall as the tree is
+ *   balanced.  Any modification of the tree invalidates the iterator.
+ *
+ *   seek positions an in-order iteration at the first node >= p_key, or
+ *   for ADTS_TREE_ITER_REVERSE the last node <= p_key.  Other orders have
+ *   no key position and the iterator is returned exhausted.
+ *
+ *   for (p_node = adts_tree_iter_begin(p_tree, &(iter), order);
+ *        p_node;
+ *        p_node = adts_tree_iter_next(&(iter))) {
+ *       ...
+ *   }
+ *
+ **************************************************************************
+ */
+adts_tree_node_t *
+adts_tree_iter_begin( adts_tree_t            *p_adts_tree,
+                      adts_tree_iter_t       *p_iter,
+                      adts_tree_iter_order_t  order );
+
+adts_tree_node_t *
+adts_tree_iter_seek( adts_tree_t            *p_adts_tree,
+                     adts_tree_iter_t       *p_iter,
+                     adts_tree_iter_order_t  order,
+                     const void             *p_key );
+
+adts_tree_node_t *
+adts_tree_iter_next( adts_tree_iter_t *p_iter );
+
+void
+adts_tree_destroy( adts_tree_t *p_adts_tree );
+
+adts_tree_t *
+adts_tree_create_ext( const adts_tree_create_t *p_op );
+
+adts_tree_t *
+adts_tree_create( adts_tree_type_t type );
+
 
 
 /**
@@ -0,0 +1,1209 @@
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Toolbox */
+#include <adts_list.h>
+#include <adts_time.h>
+#include <adts_ulist.h>
+#include <adts_memory.h>
+#include <adts_sanity.h>
+#include <adts_private.h>
+#include <adts_display.h>
+
+
+/******************************************************************************
+ #####  ####### ######  #     #  #####  ####### #     # ######  #######  #####
+#     #    #    #     # #     # #     #    #    #     # #     # #       #     #
+#          #    #     # #     # #          #    #     # #     # #       #
+ #####     #    ######  #     # #          #    #     # ######  #####    #####
+      #    #    #   #   #     # #          #    #     # #   #   #             #
+#     #    #    #    #  #     # #     #    #    #     # #    #  #       #     #
+ #####     #    #     #  #####   #####     #     #####  #     # #######  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ * \details
+ *   Block, occupied entries are [lo, hi).  Append fills toward the end and
+ *   prepend toward the start of a block, such that both ends are O(1)
+ *   without shifting.  The 32B header keeps the 16B entries from
+ *   straddling a cacheline.
+ *
+ ****************************************************************************
+ */
+typedef struct ulist_block_s {
+    struct ulist_block_s    *p_prev;
+    struct ulist_block_s    *p_next;
+    size_t                   lo;
+    size_t                   hi;
+    adts_list_node_public_t  entry[];
+} ulist_block_t;
+
+#define ULIST_CACHELINE_BYTES (64)
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    size_t            elems;
+    size_t            blocks;
+    size_t            block_entries;
+    size_t            block_bytes;
+    ulist_block_t    *p_head;
+    ulist_block_t    *p_tail;
+    ulist_block_t    *p_spare;  /**< one released block, avoids churn */
+    adts_sanity_t     sanity;
+    adts_mem_stats_t  mem;
+} ulist_t;
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+typedef struct {
+    ulist_t       *p_list;
+    ulist_block_t *p_block;  /**< NULL at the end of the list */
+    size_t         idx;
+} ulist_iter_t;
+
+
+
+/******************************************************************************
+ * ####### #     # #     #  #####  #######   ###   ####### #     #  #####
+ * #       #     # ##    # #     #    #       #    #     # ##    # #     #
+ * #       #     # # #   # #          #       #    #     # # #   # #
+ * #####   #     # #  #  # #          #       #    #     # #  #  #  #####
+ * #       #     # #   # # #          #       #    #     # #   # #       #
+ * #       #     # #    ## #     #    #       #    #     # #    ## #     #
+ * #        #####  #     #  #####     #      ###   ####### #     #  #####
+******************************************************************************/
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline size_t
+ulist_block_count( const ulist_block_t *p_block )
+{
+    return (p_block->hi - p_block->lo);
+} /* ulist_block_count() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static ulist_block_t *
+ulist_block_alloc( ulist_t *p_list )
+{
+    ulist_block_t *p_block = p_list->p_spare;
+
+    if (p_block) {
+        p_list->p_spare = NULL;
+    } else {
+        p_block = adts_mem_zalloc_acct(&(p_list->mem), p_list->block_bytes,
+                                       ADTS_MEM_ALIGN_CACHELINE);
+        if (NULL == p_block) {
+            goto exception;
+        }
+    }
+
+    p_block->p_prev = NULL;
+    p_block->p_next = NULL;
+    p_block->lo     = 0;
+    p_block->hi     = 0;
+    p_list->blocks++;
+
+exception:
+    return p_block;
+} /* ulist_block_alloc() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The first released block is retained as the spare, such that a queue
+ *   crossing a block boundary does not allocate and free per crossing.
+ *
+ ****************************************************************************
+ */
+static void
+ulist_block_release( ulist_t       *p_list,
+                     ulist_block_t *p_block )
+{
+    p_list->blocks--;
+
+    if (NULL == p_list->p_spare) {
+        p_list->p_spare = p_block;
+        return;
+    }
+
+    adts_mem_free_acct(&(p_list->mem), p_block, p_list->block_bytes,
+                       ADTS_MEM_ALIGN_CACHELINE);
+
+    return;
+} /* ulist_block_release() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static void
+ulist_block_unlink( ulist_t       *p_list,
+                    ulist_block_t *p_block )
+{
+    if (p_block->p_prev) {
+        p_block->p_prev->p_next = p_block->p_next;
+    } else {
+        p_list->p_head = p_block->p_next;
+    }
+
+    if (p_block->p_next) {
+        p_block->p_next->p_prev = p_block->p_prev;
+    } else {
+        p_list->p_tail = p_block->p_prev;
+    }
+
+    return;
+} /* ulist_block_unlink() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Merge adjacent blocks a -> b into one, moving the fewest entries.  The
+ *   iterator, when positioned within either block, follows its entry.
+ *
+ ****************************************************************************
+ */
+static void
+ulist_block_merge( ulist_t       *p_list,
+                   ulist_block_t *p_a,
+                   ulist_block_t *p_b,
+                   ulist_iter_t  *p_iter )
+{
+    const size_t   ca      = ulist_block_count(p_a);
+    const size_t   cb      = ulist_block_count(p_b);
+    const size_t   lo_a    = p_a->lo;
+    const size_t   lo_b    = p_b->lo;
+    size_t         base_a  = 0;
+    size_t         base_b  = 0;
+    ulist_block_t *p_keep  = p_a;
+    ulist_block_t *p_drop  = p_b;
+
+    if ((p_a->hi + cb) <= p_list->block_entries) {
+        /* b fits after a */
+        memcpy(&(p_a->entry[p_a->hi]), &(p_b->entry[lo_b]),
+               cb * sizeof(p_a->entry[0]));
+        base_a     = lo_a;
+        base_b     = p_a->hi;
+        p_a->hi   += cb;
+    } else if (lo_b >= ca) {
+        /* a fits before b */
+        memcpy(&(p_b->entry[lo_b - ca]), &(p_a->entry[lo_a]),
+               ca * sizeof(p_a->entry[0]));
+        base_a  = lo_b - ca;
+        base_b  = lo_b;
+        p_b->lo = base_a;
+        p_keep  = p_b;
+        p_drop  = p_a;
+    } else {
+        /* compact a to the start, then b after it */
+        memmove(&(p_a->entry[0]), &(p_a->entry[lo_a]),
+                ca * sizeof(p_a->entry[0]));
+        memcpy(&(p_a->entry[ca]), &(p_b->entry[lo_b]),
+               cb * sizeof(p_a->entry[0]));
+        base_a  = 0;
+        base_b  = ca;
+        p_a->lo = 0;
+        p_a->hi = ca + cb;
+    }
+
+    if (p_iter && (p_iter->p_block == p_a)) {
+        p_iter->p_block = p_keep;
+        p_iter->idx     = base_a + (p_iter->idx - lo_a);
+    } else if (p_iter && (p_iter->p_block == p_b)) {
+        p_iter->p_block = p_keep;
+        p_iter->idx     = base_b + (p_iter->idx - lo_b);
+    }
+
+    ulist_block_unlink(p_list, p_drop);
+    ulist_block_release(p_list, p_drop);
+
+    return;
+} /* ulist_block_merge() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Called once an entry left the block.  An empty block is released, a
+ *   block below half full is merged with a neighbour that fits.
+ *
+ ****************************************************************************
+ */
+static void
+ulist_block_rebalance( ulist_t       *p_list,
+                       ulist_block_t *p_block,
+                       ulist_iter_t  *p_iter )
+{
+    const size_t   count  = ulist_block_count(p_block);
+    const size_t   limit  = p_list->block_entries;
+    ulist_block_t *p_prev = p_block->p_prev;
+    ulist_block_t *p_next = p_block->p_next;
+
+    if (0 == count) {
+        if (p_iter && (p_iter->p_block == p_block)) {
+            p_iter->p_block = p_next;
+            p_iter->idx     = p_next ? p_next->lo : 0;
+        }
+        ulist_block_unlink(p_list, p_block);
+        ulist_block_release(p_list, p_block);
+        goto exception;
+    }
+
+    if (count >= (limit / 2)) {
+        /* dense enough */
+        goto exception;
+    }
+
+    if (p_next && ((count + ulist_block_count(p_next)) <= limit)) {
+        ulist_block_merge(p_list, p_block, p_next, p_iter);
+    } else if (p_prev && ((count + ulist_block_count(p_prev)) <= limit)) {
+        ulist_block_merge(p_list, p_prev, p_block, p_iter);
+    }
+
+exception:
+    return;
+} /* ulist_block_rebalance() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline const adts_list_node_public_t *
+ulist_iter_entry( ulist_iter_t *p_iter )
+{
+    if (NULL == p_iter->p_block) {
+        return NULL;
+    }
+
+    if (p_iter->idx >= p_iter->p_block->hi) {
+        /* past the end of this block */
+        p_iter->p_block = p_iter->p_block->p_next;
+        if (NULL == p_iter->p_block) {
+            return NULL;
+        }
+        p_iter->idx = p_iter->p_block->lo;
+    }
+
+    return &(p_iter->p_block->entry[p_iter->idx]);
+} /* ulist_iter_entry() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+bool
+adts_ulist_is_empty( adts_ulist_t *p_adts_ulist )
+{
+    ulist_t *p_list = (ulist_t *) p_adts_ulist;
+
+    return (0 == p_list->elems);
+} /* adts_ulist_is_empty() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ulist_entries( adts_ulist_t *p_adts_ulist )
+{
+    ulist_t *p_list = (ulist_t *) p_adts_ulist;
+
+    return p_list->elems;
+} /* adts_ulist_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ulist_blocks( adts_ulist_t *p_adts_ulist )
+{
+    ulist_t *p_list = (ulist_t *) p_adts_ulist;
+
+    return p_list->blocks;
+} /* adts_ulist_blocks() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+size_t
+adts_ulist_block_entries( adts_ulist_t *p_adts_ulist )
+{
+    ulist_t *p_list = (ulist_t *) p_adts_ulist;
+
+    return p_list->block_entries;
+} /* adts_ulist_block_entries() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+void
+adts_ulist_display( adts_ulist_t *p_adts_ulist )
+{
+    size_t          idx      = 0;
+    ulist_t        *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t  *p_block  = NULL;
+    adts_sanity_t  *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    printf("\nulist: %10p  entries: %zu  blocks: %zu  block entries: %zu\n",
+           p_list, p_list->elems, p_list->blocks, p_list->block_entries);
+
+    for (p_block = p_list->p_head; p_block; p_block = p_block->p_next) {
+        printf("[%6zu]  block: %10p  lo: %3zu  hi: %3zu  prev: %10p  next: %10p\n",
+               idx, p_block, p_block->lo, p_block->hi, p_block->p_prev,
+               p_block->p_next);
+        for (size_t e = p_block->lo; e < p_block->hi; e++) {
+            printf("          [%3zu]  data: %p  bytes: %zu\n", e,
+                   p_block->entry[e].p_data, p_block->entry[e].bytes);
+        }
+        idx++;
+    }
+
+    adts_sanity_exit(p_sanity);
+    return;
+} /* adts_ulist_display() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Blocks are list owned and included, the spare among them.
+ *
+ ****************************************************************************
+ */
+void
+adts_ulist_mem_stats( adts_ulist_t     *p_adts_ulist,
+                      adts_mem_stats_t *p_stats )
+{
+    ulist_t *p_list = (ulist_t *) p_adts_ulist;
+
+    *p_stats = p_list->mem;
+
+    return;
+} /* adts_ulist_mem_stats() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ulist_append( adts_ulist_t *p_adts_ulist,
+                   void         *p_data,
+                   size_t        bytes )
+{
+    int32_t        rc       = 0;
+    ulist_t       *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t *p_block  = p_list->p_tail;
+    adts_sanity_t *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely((NULL == p_block) ||
+                 (p_block->hi == p_list->block_entries))) {
+        p_block = ulist_block_alloc(p_list);
+        if (NULL == p_block) {
+            rc = ENOMEM;
+            goto exception;
+        }
+
+        /* link at the tail */
+        p_block->p_prev = p_list->p_tail;
+        if (p_list->p_tail) {
+            p_list->p_tail->p_next = p_block;
+        } else {
+            p_list->p_head = p_block;
+        }
+        p_list->p_tail = p_block;
+    }
+
+    p_block->entry[p_block->hi].p_data = p_data;
+    p_block->entry[p_block->hi].bytes  = bytes;
+    p_block->hi++;
+    p_list->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ulist_append() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   A new head block is filled from its end, such that further prepends
+ *   share it.
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ulist_prepend( adts_ulist_t *p_adts_ulist,
+                    void         *p_data,
+                    size_t        bytes )
+{
+    int32_t        rc       = 0;
+    ulist_t       *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t *p_block  = p_list->p_head;
+    adts_sanity_t *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely((NULL == p_block) || (0 == p_block->lo))) {
+        p_block = ulist_block_alloc(p_list);
+        if (NULL == p_block) {
+            rc = ENOMEM;
+            goto exception;
+        }
+        p_block->lo = p_list->block_entries;
+        p_block->hi = p_list->block_entries;
+
+        /* link at the head */
+        p_block->p_next = p_list->p_head;
+        if (p_list->p_head) {
+            p_list->p_head->p_prev = p_block;
+        } else {
+            p_list->p_tail = p_block;
+        }
+        p_list->p_head = p_block;
+    }
+
+    p_block->lo--;
+    p_block->entry[p_block->lo].p_data = p_data;
+    p_block->entry[p_block->lo].bytes  = bytes;
+    p_list->elems++;
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ulist_prepend() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ulist_remove_head( adts_ulist_t            *p_adts_ulist,
+                        adts_list_node_public_t *p_entry )
+{
+    int32_t        rc       = 0;
+    ulist_t       *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t *p_block  = p_list->p_head;
+    adts_sanity_t *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(NULL == p_block)) {
+        /* empty list */
+        rc = ENOENT;
+        goto exception;
+    }
+
+    *p_entry = p_block->entry[p_block->lo];
+    p_block->lo++;
+    p_list->elems--;
+
+    ulist_block_rebalance(p_list, p_block, NULL);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ulist_remove_head() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+int32_t
+adts_ulist_remove_tail( adts_ulist_t            *p_adts_ulist,
+                        adts_list_node_public_t *p_entry )
+{
+    int32_t        rc       = 0;
+    ulist_t       *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t *p_block  = p_list->p_tail;
+    adts_sanity_t *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (unlikely(NULL == p_block)) {
+        /* empty list */
+        rc = ENOENT;
+        goto exception;
+    }
+
+    p_block->hi--;
+    *p_entry = p_block->entry[p_block->hi];
+    p_list->elems--;
+
+    ulist_block_rebalance(p_list, p_block, NULL);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return rc;
+} /* adts_ulist_remove_tail() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+const adts_list_node_public_t *
+adts_ulist_iter_head( adts_ulist_t      *p_adts_ulist,
+                      adts_ulist_iter_t *p_adts_iter )
+{
+    ulist_t      *p_list = (ulist_t *) p_adts_ulist;
+    ulist_iter_t *p_iter = (ulist_iter_t *) p_adts_iter;
+
+    p_iter->p_list  = p_list;
+    p_iter->p_block = p_list->p_head;
+    p_iter->idx     = p_list->p_head ? p_list->p_head->lo : 0;
+
+    return ulist_iter_entry(p_iter);
+} /* adts_ulist_iter_head() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+const adts_list_node_public_t *
+adts_ulist_iter_next( adts_ulist_iter_t *p_adts_iter )
+{
+    ulist_iter_t *p_iter = (ulist_iter_t *) p_adts_iter;
+
+    if (p_iter->p_block) {
+        p_iter->idx++;
+    }
+
+    return ulist_iter_entry(p_iter);
+} /* adts_ulist_iter_next() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   The shorter side of the block is shifted over the removed entry.
+ *
+ ****************************************************************************
+ */
+const adts_list_node_public_t *
+adts_ulist_iter_remove( adts_ulist_iter_t *p_adts_iter )
+{
+    size_t                          idx      = 0;
+    ulist_iter_t                   *p_iter   = (ulist_iter_t *) p_adts_iter;
+    ulist_t                        *p_list   = p_iter->p_list;
+    ulist_block_t                  *p_block  = p_iter->p_block;
+    const adts_list_node_public_t  *p_entry  = NULL;
+    adts_sanity_t                  *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    if (NULL == p_block) {
+        /* end of list */
+        goto exception;
+    }
+
+    idx = p_iter->idx;
+    if ((idx - p_block->lo) < (p_block->hi - idx - 1)) {
+        memmove(&(p_block->entry[p_block->lo + 1]),
+                &(p_block->entry[p_block->lo]),
+                (idx - p_block->lo) * sizeof(p_block->entry[0]));
+        p_block->lo++;
+        p_iter->idx++;
+    } else {
+        memmove(&(p_block->entry[idx]), &(p_block->entry[idx + 1]),
+                (p_block->hi - idx - 1) * sizeof(p_block->entry[0]));
+        p_block->hi--;
+    }
+    p_list->elems--;
+
+    ulist_block_rebalance(p_list, p_block, p_iter);
+    p_entry = ulist_iter_entry(p_iter);
+
+exception:
+    adts_sanity_exit(p_sanity);
+    return p_entry;
+} /* adts_ulist_iter_remove() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+void
+adts_ulist_destroy( adts_ulist_t *p_adts_ulist )
+{
+    ulist_t          *p_list   = (ulist_t *) p_adts_ulist;
+    ulist_block_t    *p_block  = NULL;
+    ulist_block_t    *p_next   = NULL;
+    adts_mem_stats_t  mem      = {0};
+    adts_sanity_t    *p_sanity = &(p_list->sanity);
+
+    adts_sanity_entry(p_sanity);
+
+    for (p_block = p_list->p_head; p_block; p_block = p_next) {
+        p_next = p_block->p_next;
+        adts_mem_free_acct(&(p_list->mem), p_block, p_list->block_bytes,
+                           ADTS_MEM_ALIGN_CACHELINE);
+    }
+    if (p_list->p_spare) {
+        adts_mem_free_acct(&(p_list->mem), p_list->p_spare,
+                           p_list->block_bytes, ADTS_MEM_ALIGN_CACHELINE);
+    }
+
+    /* the record is released along with the handle */
+    mem = p_list->mem;
+    adts_mem_free_acct(&(mem), p_list, sizeof(adts_ulist_t),
+                       ADTS_MEM_ALIGN_DEFAULT);
+
+    /* No adts_sanity_exit() since we've freed the memory */
+
+    return;
+} /* adts_ulist_destroy() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Block bytes are rounded up to whole cachelines and the entries grown
+ *   to fill them.
+ *
+ ****************************************************************************
+ */
+adts_ulist_t *
+adts_ulist_create_ext( const adts_ulist_create_t *p_op )
+{
+    size_t            entries      = 0;
+    size_t            bytes        = 0;
+    ulist_t          *p_list       = NULL;
+    adts_ulist_t     *p_adts_ulist = NULL;
+    adts_mem_stats_t  mem          = ADTS_MEM_STATS_INIT(ADTS_MEM_TYPE_LIST);
+
+    if (NULL == p_op) {
+        goto exception;
+    }
+
+    entries = p_op->block_entries ? p_op->block_entries :
+                                    ADTS_ULIST_BLOCK_ENTRIES_DEFAULT;
+    if ((2 > entries) || (ADTS_ULIST_BLOCK_ENTRIES_MAX < entries)) {
+        goto exception;
+    }
+
+    bytes   = sizeof(ulist_block_t) + (entries * sizeof(adts_list_node_public_t));
+    bytes   = (bytes + ULIST_CACHELINE_BYTES - 1) & ~(ULIST_CACHELINE_BYTES - 1);
+    entries = (bytes - sizeof(ulist_block_t)) / sizeof(adts_list_node_public_t);
+
+    p_adts_ulist = adts_mem_zalloc_acct(&(mem), sizeof(*p_adts_ulist),
+                                        ADTS_MEM_ALIGN_DEFAULT);
+    if (NULL == p_adts_ulist) {
+        goto exception;
+    }
+
+    p_list                = (ulist_t *) p_adts_ulist;
+    p_list->block_entries = entries;
+    p_list->block_bytes   = bytes;
+    p_list->mem           = mem;
+
+exception:
+    return p_adts_ulist;
+} /* adts_ulist_create_ext() */
+
+
+/*
+ ****************************************************************************
+ *
+ *
+ ****************************************************************************
+ */
+adts_ulist_t *
+adts_ulist_create( void )
+{
+    adts_ulist_create_t op = {0};
+
+    return adts_ulist_create_ext(&(op));
+} /* adts_ulist_create() */
+
+
+
+
+
+/******************************************************************************
+ * #     # #     #   ###   ####### ####### #######  #####  #######  #####
+ * #     # ##    #    #       #       #    #       #     #    #    #     #
+ * #     # # #   #    #       #       #    #       #          #    #
+ * #     # #  #  #    #       #       #    #####    #####     #     #####
+ * #     # #   # #    #       #       #    #             #    #          #
+ * #     # #    ##    #       #       #    #       #     #    #    #     #
+ *  #####  #     #   ###      #       #    #######  #####     #     #####
+******************************************************************************/
+
+
+/**
+ **************************************************************************
+ * \brief
+ *   Compile time structure sanity
+ *
+ * \details
+ *   Sanitize the abstract data type interface.  Enforced in header file so
+ *   as to catch improper usage/include by unauthorized callers.
+ *
+ **************************************************************************
+ */
+static void
+utest_ulist_bytes( void )
+{
+
+    CDISPLAY("[%u]", sizeof(ulist_t));
+    CDISPLAY("[%u]", sizeof(adts_ulist_t));
+
+    _Static_assert(sizeof(ulist_t) <= sizeof(adts_ulist_t),
+        "Mismatch structs detected");
+
+    CDISPLAY("[%u]", sizeof(ulist_iter_t));
+    CDISPLAY("[%u]", sizeof(adts_ulist_iter_t));
+
+    _Static_assert(sizeof(ulist_iter_t) <= sizeof(adts_ulist_iter_t),
+        "Mismatch structs detected");
+
+    _Static_assert(0 == (sizeof(ulist_block_t) % 16),
+        "Mismatch structs detected");
+
+    return;
+} /* utest_ulist_bytes() */
+
+
+/*
+ ****************************************************************************
+ *
+ ****************************************************************************
+ */
+static inline uint64_t
+utest_ulist_rand( uint64_t *p_seed )
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 7;
+    *p_seed ^= *p_seed << 17;
+
+    return *p_seed;
+} /* utest_ulist_rand() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   Structural check, linkage, non empty blocks and the entry total, and
+ *   the contents in order against p_expect.
+ *
+ ****************************************************************************
+ */
+static void
+utest_ulist_valid( adts_ulist_t   *p_adts_ulist,
+                   const uint64_t *p_expect,
+                   size_t          elems )
+{
+    size_t          count   = 0;
+    size_t          blocks  = 0;
+    ulist_t        *p_list  = (ulist_t *) p_adts_ulist;
+    ulist_block_t  *p_block = NULL;
+    ulist_block_t  *p_prev  = NULL;
+
+    for (p_block = p_list->p_head; p_block; p_block = p_block->p_next) {
+        assert(p_block->p_prev == p_prev);
+        assert(p_block->lo < p_block->hi);
+        assert(p_block->hi <= p_list->block_entries);
+        for (size_t e = p_block->lo; e < p_block->hi; e++) {
+            assert(count < elems);
+            assert((uintptr_t) p_block->entry[e].p_data == p_expect[count]);
+            count++;
+        }
+        p_prev = p_block;
+        blocks++;
+    }
+    assert(p_list->p_tail == p_prev);
+    assert(elems == count);
+    assert(elems == p_list->elems);
+    assert(blocks == p_list->blocks);
+
+    return;
+} /* utest_ulist_valid() */
+
+
+/*
+ ****************************************************************************
+ * \details
+ *   adts_list vs unrolled list, N elements appended, walked and removed.
+ *   The adts_list nodes are appended in a shuffled order, as nodes
+ *   embedded within independently allocated objects are scattered.
+ *
+ ****************************************************************************
+ */
+static void
+utest_ulist_benchmark( void )
+{
+    const size_t      sizes[] = { 1000 * 1000, 10 * 1000 * 1000 };
+    const size_t      limit   = sizes[1];
+    uint64_t          seed    = 0x9E3779B97F4A7C15ULL;
+    uint32_t         *p_perm  = NULL;
+    adts_list_node_t *p_nodes = NULL;
+
+    CDISPLAY("=========================================================");
+    CDISPLAY("Benchmark: adts_list vs unrolled list");
+
+    p_perm  = calloc(limit, sizeof(*p_perm));
+    p_nodes = calloc(limit, sizeof(*p_nodes));
+    assert(p_perm && p_nodes);
+
+    for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+        const size_t             elems   = sizes[sdx];
+        uint64_t                 add[2]  = {0};
+        uint64_t                 walk[2] = {0};
+        uint64_t                 del[2]  = {0};
+        uintptr_t                sum[2]  = {0};
+        adts_list_t             *p_list  = NULL;
+        adts_ulist_t            *p_ulist = NULL;
+        adts_list_node_t        *p_node  = NULL;
+        adts_mem_stats_t         stats   = {0};
+        adts_ulist_iter_t        iter    = {0};
+        adts_list_node_public_t  entry   = {0};
+
+        for (size_t idx = 0; idx < elems; idx++) {
+            p_perm[idx] = idx;
+        }
+        for (size_t idx = elems - 1; idx > 0; idx--) {
+            size_t   j   = utest_ulist_rand(&(seed)) % (idx + 1);
+            uint32_t tmp = p_perm[idx];
+
+            p_perm[idx] = p_perm[j];
+            p_perm[j]   = tmp;
+        }
+
+        /* adts_list */
+        p_list = adts_list_create();
+        assert(p_list);
+        add[0] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            adts_list_node_public_t *p_pub = NULL;
+
+            p_node        = &(p_nodes[p_perm[idx]]);
+            p_pub         = (adts_list_node_public_t *) &(p_node->pub);
+            p_pub->p_data = (void *) (uintptr_t) idx;
+            p_pub->bytes  = 1;
+            assert(0 == adts_list_append(p_list, p_node));
+        }
+        add[0] = adts_tstamp() - add[0];
+
+        walk[0] = adts_tstamp();
+        for (p_node = adts_list_peek_head(p_list);
+             p_node;
+             p_node = adts_list_node_peek_next(p_node)) {
+            sum[0] += (uintptr_t) p_node->pub.p_data;
+        }
+        walk[0] = adts_tstamp() - walk[0];
+
+        del[0] = adts_tstamp();
+        while (adts_list_remove_head(p_list));
+        del[0] = adts_tstamp() - del[0];
+        adts_list_destroy(p_list);
+
+        /* unrolled list */
+        p_ulist = adts_ulist_create();
+        assert(p_ulist);
+        add[1] = adts_tstamp();
+        for (size_t idx = 0; idx < elems; idx++) {
+            assert(0 == adts_ulist_append(p_ulist, (void *) (uintptr_t) idx,
+                                          1));
+        }
+        add[1] = adts_tstamp() - add[1];
+
+        walk[1] = adts_tstamp();
+        for (const adts_list_node_public_t *p_e =
+                 adts_ulist_iter_head(p_ulist, &(iter));
+             p_e;
+             p_e = adts_ulist_iter_next(&(iter))) {
+            sum[1] += (uintptr_t) p_e->p_data;
+        }
+        walk[1] = adts_tstamp() - walk[1];
+        adts_ulist_mem_stats(p_ulist, &(stats));
+
+        del[1] = adts_tstamp();
+        while (0 == adts_ulist_remove_head(p_ulist, &(entry)));
+        del[1] = adts_tstamp() - del[1];
+        adts_ulist_destroy(p_ulist);
+
+        assert(sum[0] == sum[1]);
+        CDISPLAY("%9zu elems  append: %3llu / %3llu  walk: %3llu / %3llu"
+                 "  remove_head: %3llu / %3llu ns/op  (adts_list / unrolled)",
+                 elems, add[0] / elems, add[1] / elems, walk[0] / elems,
+                 walk[1] / elems, del[0] / elems, del[1] / elems);
+        CDISPLAY("%9zu elems  bytes: %zu / %zu", elems,
+                 elems * sizeof(adts_list_node_t), stats.bytes_peak);
+    }
+
+    free(p_nodes);
+    free(p_perm);
+
+    return;
+} /* utest_ulist_benchmark() */
+
+
+/*
+ ****************************************************************************
+ * test control
+ *
+ ****************************************************************************
+ */
+static void
+utest_control( void )
+{
+    utest_ulist_bytes();
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: create -> destroy, block sizing, accounting");
+
+        adts_ulist_t            *p_ulist = NULL;
+        adts_ulist_create_t      op      = {0};
+        adts_ulist_iter_t        iter    = {0};
+        adts_list_node_public_t  entry   = {0};
+        adts_mem_stats_t         before  = {0};
+        adts_mem_stats_t         after   = {0};
+
+        assert(NULL == adts_ulist_create_ext(NULL));
+        op.block_entries = 1;
+        assert(NULL == adts_ulist_create_ext(&(op)));
+        op.block_entries = ADTS_ULIST_BLOCK_ENTRIES_MAX + 1;
+        assert(NULL == adts_ulist_create_ext(&(op)));
+
+        /* rounded to whole cachelines, 32B header + 16B entries */
+        op.block_entries = 3;
+        p_ulist = adts_ulist_create_ext(&(op));
+        assert(p_ulist);
+        assert(6 == adts_ulist_block_entries(p_ulist));
+        adts_ulist_destroy(p_ulist);
+
+        adts_mem_stats_type(ADTS_MEM_TYPE_LIST, &(before));
+        p_ulist = adts_ulist_create();
+        assert(p_ulist);
+        assert(ADTS_ULIST_BLOCK_ENTRIES_DEFAULT ==
+               adts_ulist_block_entries(p_ulist));
+        assert(adts_ulist_is_empty(p_ulist));
+        assert(ENOENT == adts_ulist_remove_head(p_ulist, &(entry)));
+        assert(ENOENT == adts_ulist_remove_tail(p_ulist, &(entry)));
+        assert(NULL == adts_ulist_iter_head(p_ulist, &(iter)));
+        assert(NULL == adts_ulist_iter_next(&(iter)));
+        assert(NULL == adts_ulist_iter_remove(&(iter)));
+
+        for (size_t idx = 0; idx < 100; idx++) {
+            assert(0 == adts_ulist_append(p_ulist, (void *) idx, 8));
+        }
+        adts_ulist_display(p_ulist);
+        adts_ulist_destroy(p_ulist);
+        adts_mem_stats_type(ADTS_MEM_TYPE_LIST, &(after));
+        assert(before.bytes_curr == after.bytes_curr);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: deque operations against a reference");
+
+        const size_t             limit    = 64 * 1024;
+        const size_t             sizes[]  = { 2, 6, ADTS_ULIST_BLOCK_ENTRIES_DEFAULT };
+        uint64_t                 seed     = 0x9E3779B97F4A7C15ULL;
+        uint64_t                *p_ref    = NULL;
+        adts_ulist_t            *p_ulist  = NULL;
+        adts_ulist_create_t      op       = {0};
+        adts_list_node_public_t  entry    = {0};
+
+        /* reference deque, centred such that either end may grow */
+        p_ref = calloc(limit * 2, sizeof(*p_ref));
+        assert(p_ref);
+
+        for (size_t sdx = 0; sdx < sizeof(sizes) / sizeof(sizes[0]); sdx++) {
+            size_t   lo    = limit;
+            size_t   hi    = limit;
+            uint64_t value = 1;
+
+            op.block_entries = sizes[sdx];
+            p_ulist          = adts_ulist_create_ext(&(op));
+            assert(p_ulist);
+
+            for (size_t idx = 0; idx < limit; idx++) {
+                uint64_t r = utest_ulist_rand(&(seed));
+
+                /* bias toward growth for the first half */
+                switch (r % ((idx < limit / 2) ? 6 : 4)) {
+                    case 0:
+                    case 4:
+                        assert(0 == adts_ulist_append(p_ulist,
+                                                      (void *) value, 1));
+                        p_ref[hi++] = value++;
+                        break;
+                    case 1:
+                    case 5:
+                        assert(0 == adts_ulist_prepend(p_ulist,
+                                                       (void *) value, 1));
+                        p_ref[--lo] = value++;
+                        break;
+                    case 2:
+                        if (lo == hi) {
+                            assert(ENOENT == adts_ulist_remove_head(p_ulist,
+                                                                    &(entry)));
+                            break;
+                        }
+                        assert(0 == adts_ulist_remove_head(p_ulist, &(entry)));
+                        assert((uintptr_t) entry.p_data == p_ref[lo++]);
+                        break;
+                    default:
+                        if (lo == hi) {
+                            assert(ENOENT == adts_ulist_remove_tail(p_ulist,
+                                                                    &(entry)));
+                            break;
+                        }
+                        assert(0 == adts_ulist_remove_tail(p_ulist, &(entry)));
+                        assert((uintptr_t) entry.p_data == p_ref[--hi]);
+                }
+
+                if (0 == (idx % 1024)) {
+                    utest_ulist_valid(p_ulist, &(p_ref[lo]), hi - lo);
+                }
+            }
+            utest_ulist_valid(p_ulist, &(p_ref[lo]), hi - lo);
+
+            adts_ulist_destroy(p_ulist);
+        }
+
+        free(p_ref);
+    }
+
+    CDISPLAY("=========================================================");
+    {
+        CDISPLAY("Test: iterator remove, rebalance density");
+
+        const size_t                    limit   = 16 * 1024;
+        size_t                          elems   = 0;
+        size_t                          idx     = 0;
+        size_t                          k       = 0;
+        uint64_t                       *p_ref   = NULL;
+        adts_ulist_t                   *p_ulist = NULL;
+        adts_ulist_iter_t               iter    = {0};
+        const adts_list_node_public_t  *p_e     = NULL;
+
+        p_ref = calloc(limit, sizeof(*p_ref));
+        assert(p_ref);
+
+        p_ulist = adts_ulist_create();
+        assert(p_ulist);
+        k = adts_ulist_block_entries(p_ulist);
+        for (idx = 0; idx < limit; idx++) {
+            assert(0 == adts_ulist_append(p_ulist, (void *) idx, 1));
+            p_ref[idx] = idx;
+        }
+        elems = limit;
+
+        /* remove every entry not a multiple of 2, then of 3, then of 5 */
+        for (size_t m = 2; m <= 5; m += (2 == m) ? 1 : 2) {
+            size_t keep = 0;
+
+            idx = 0;
+            p_e = adts_ulist_iter_head(p_ulist, &(iter));
+            while (p_e) {
+                assert((uintptr_t) p_e->p_data == p_ref[idx]);
+                if (p_ref[idx] % m) {
+                    p_e = adts_ulist_iter_remove(&(iter));
+                } else {
+                    p_ref[keep++] = p_ref[idx];
+                    p_e = adts_ulist_iter_next(&(iter));
+                }
+                idx++;
+            }
+            assert(elems == idx);
+            elems = keep;
+            utest_ulist_valid(p_ulist, p_ref, elems);
+
+            /* at least half dense, bar the end blocks */
+            assert(adts_ulist_blocks(p_ulist) <= ((2 * elems) / (k / 2)) + 2);
+        }
+
+        /* remove all through the iterator */
+        p_e = adts_ulist_iter_head(p_ulist, &(iter));
+        while (p_e) {
+            p_e = adts_ulist_iter_remove(&(iter));
+        }
+        assert(adts_ulist_is_empty(p_ulist));
+        assert(0 == adts_ulist_blocks(p_ulist));
+
+        adts_ulist_destroy(p_ulist);
+        free(p_ref);
+    }
+
+    utest_ulist_benchmark();
+
+    return;
+} /* utest_control() */
+
+
+/*
+ ****************************************************************************
+ * test entrypoint
+ *
+ ****************************************************************************
+ */
+void
+utest_adts_ulist( void )
+{
+    utest_control();
+
+    return;
+} /* utest_adts_ulist() */
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <adts_list.h>
+#include <adts_memory.h>
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+#define ADTS_ULIST_BYTES      (256)
+#define ADTS_ULIST_ITER_BYTES (32)
+
+typedef struct {
+    const char reserved[ ADTS_ULIST_BYTES ];
+} adts_ulist_t;
+
+typedef struct {
+    const char reserved[ ADTS_ULIST_ITER_BYTES ];
+} adts_ulist_iter_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unrolled list, a doubly linked list of cacheline aligned blocks, each
+ *   holding up to block_entries entries by value.  A walk costs one
+ *   dependent miss per block rather than per element.  Entries are the
+ *   adts_list public view, {p_data, bytes}, and are owned by the list.
+ *
+ *   Blocks are rebalanced on removal.  A block below half full is merged
+ *   with a neighbour whenever the two fit a single block, such that the
+ *   list stays at least half dense outside of its end blocks.
+ *
+ *   unrolled list create parameters
+ *     - block_entries: entries per block, 0 selects
+ *       ADTS_ULIST_BLOCK_ENTRIES_DEFAULT.  Rounded up to fill whole
+ *       cachelines, see adts_ulist_block_entries().
+ *
+ **************************************************************************
+ */
+#define ADTS_ULIST_BLOCK_ENTRIES_DEFAULT (30) /**< 512B blocks */
+#define ADTS_ULIST_BLOCK_ENTRIES_MAX     (1024)
+
+typedef struct {
+    size_t block_entries;
+} adts_ulist_create_t;
+
+
+/**
+ **************************************************************************
+ * \details
+ *
+ **************************************************************************
+ */
+bool
+adts_ulist_is_empty( adts_ulist_t *p_adts_ulist );
+
+size_t
+adts_ulist_entries( adts_ulist_t *p_adts_ulist );
+
+size_t
+adts_ulist_blocks( adts_ulist_t *p_adts_ulist );
+
+size_t
+adts_ulist_block_entries( adts_ulist_t *p_adts_ulist );
+
+void
+adts_ulist_display( adts_ulist_t *p_adts_ulist );
+
+void
+adts_ulist_mem_stats( adts_ulist_t     *p_adts_ulist,
+                      adts_mem_stats_t *p_stats );
+
+int32_t
+adts_ulist_append( adts_ulist_t *p_adts_ulist,
+                   void         *p_data,
+                   size_t        bytes );
+int32_t
+adts_ulist_prepend( adts_ulist_t *p_adts_ulist,
+                    void         *p_data,
+                    size_t        bytes );
+
+/**
+ **************************************************************************
+ * \details
+ *   The removed entry is copied to p_entry, ENOENT if empty.
+ *
+ **************************************************************************
+ */
+int32_t
+adts_ulist_remove_head( adts_ulist_t            *p_adts_ulist,
+                        adts_list_node_public_t *p_entry );
+int32_t
+adts_ulist_remove_tail( adts_ulist_t            *p_adts_ulist,
+                        adts_list_node_public_t *p_entry );
+
+/**
+ **************************************************************************
+ * \details
+ *   Head to tail iteration.  Each call returns the entry under the
+ *   iterator, NULL at the end of the list.  The entry resides within a
+ *   block and is valid until the list is next modified.
+ *
+ *   adts_ulist_iter_remove() removes the entry under the iterator and
+ *   returns its successor, the only modification an iteration survives.
+ *
+ *   for (p_e = adts_ulist_iter_head(p_list, &(iter));
+ *        p_e;
+ *        p_e = adts_ulist_iter_next(&(iter))) {
+ *       ...
+ *   }
+ *
+ **************************************************************************
+ */
+const adts_list_node_public_t *
+adts_ulist_iter_head( adts_ulist_t      *p_adts_ulist,
+                      adts_ulist_iter_t *p_iter );
+
+const adts_list_node_public_t *
+adts_ulist_iter_next( adts_ulist_iter_t *p_iter );
+
+const adts_list_node_public_t *
+adts_ulist_iter_remove( adts_ulist_iter_t *p_iter );
+
+void
+adts_ulist_destroy( adts_ulist_t *p_adts_ulist );
+
+adts_ulist_t *
+adts_ulist_create_ext( const adts_ulist_create_t *p_op );
+
+adts_ulist_t *
+adts_ulist_create( void );
+
+
+/**
+ **************************************************************************
+ * \details
+ *   Unit Test prototypes
+ *
+ **************************************************************************
+ */
+void
+utest_adts_ulist( void );
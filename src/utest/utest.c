@@ -27,20 +27,29 @@ utest_control( void )
 
     //utest_adts_rbt();
     //utest_adts_eyec();
+    //utest_adts_arena();
     //utest_adts_bits();
     //utest_adts_time();
     //utest_adts_list();
+    //utest_adts_ulist();
     //utest_adts_heap();
+    //utest_adts_multiq();
     //utest_adts_math();
     //utest_adts_hash();
     //utest_adts_sort();
     //utest_adts_tree();
+    //utest_adts_btree();
     //utest_adts_trie();
     //utest_adts_time();
 	//utest_adts_meas();
+    //utest_adts_memory();
+    //utest_adts_pheap();
+    //utest_adts_pool();
     //utest_adts_cycles();
     //utest_adts_stack();
     //utest_adts_queue();
+    //utest_adts_ring();
+    //utest_adts_region();
     //utest_adts_graph();
     //utest_adts_matrix();
     //utest_adts_hexdump();